@@ -0,0 +1,138 @@
+/**
+ * Tsyne pprof - Pull Go profiles from a running tsyne-bridge
+ *
+ * The bridge serves net/http/pprof on a Unix socket when started with
+ * TSYNE_PPROF=1: tsyne-<pid>-pprof.sock, next to its msgpack socket in
+ * TSYNE_SOCKET_DIR (or the temp directory). No network port is opened.
+ *
+ * Usage:
+ *   npx tsx cli/tsyne-pprof.ts [kind] [seconds] [--pid <pid> | --socket <path>] [-o <file>]
+ *
+ *   kind:    cpu (default), heap, mutex, goroutine, allocs, block
+ *   seconds: profile window (default 10 for cpu; heap/mutex/allocs
+ *            record only the window when given, else since startup)
+ *
+ * Examples:
+ *   TSYNE_PPROF=1 npx tsx ported-apps/boing/boing.ts
+ *   npx tsx cli/tsyne-pprof.ts cpu 30 -o boing-cpu.pprof
+ *   go tool pprof -http=:8080 boing-cpu.pprof
+ */
+
+import * as fs from 'fs';
+import * as http from 'http';
+import * as os from 'os';
+import * as path from 'path';
+
+const KINDS = ['cpu', 'heap', 'mutex', 'goroutine', 'allocs', 'block'];
+
+interface Options {
+  kind: string;
+  seconds?: number;
+  pid?: string;
+  socket?: string;
+  output?: string;
+}
+
+function usage(): never {
+  console.error('Tsyne pprof - Pull Go profiles from a running tsyne-bridge');
+  console.error('');
+  console.error('Usage: npx tsx cli/tsyne-pprof.ts [kind] [seconds] [--pid <pid> | --socket <path>] [-o <file>]');
+  console.error('');
+  console.error(`Kinds: ${KINDS.join(', ')} (default cpu)`);
+  console.error('');
+  console.error('The bridge must run with TSYNE_PPROF=1. Open the result with:');
+  console.error('  go tool pprof -http=:8080 <file>');
+  process.exit(1);
+}
+
+function parseArgs(args: string[]): Options {
+  const options: Options = { kind: 'cpu' };
+  for (let i = 0; i < args.length; i++) {
+    const arg = args[i];
+    if (arg === '--pid') {
+      options.pid = args[++i];
+    } else if (arg === '--socket') {
+      options.socket = args[++i];
+    } else if (arg === '-o' || arg === '--output') {
+      options.output = args[++i];
+    } else if (KINDS.includes(arg)) {
+      options.kind = arg;
+    } else if (/^\d+$/.test(arg)) {
+      options.seconds = parseInt(arg, 10);
+    } else {
+      usage();
+    }
+  }
+  if (options.kind === 'cpu' && options.seconds === undefined) {
+    options.seconds = 10;
+  }
+  return options;
+}
+
+/**
+ * Find the bridge's pprof socket: by pid, or the only one in the socket dir
+ */
+function findSocket(options: Options): string {
+  if (options.socket) {
+    return options.socket;
+  }
+  const socketDir = process.env.TSYNE_SOCKET_DIR || os.tmpdir();
+  if (options.pid) {
+    return path.join(socketDir, `tsyne-${options.pid}-pprof.sock`);
+  }
+
+  const sockets = fs.readdirSync(socketDir).filter((f) => /^tsyne-\d+-pprof\.sock$/.test(f));
+  if (sockets.length === 0) {
+    throw new Error(`No tsyne-<pid>-pprof.sock in ${socketDir}; was the bridge started with TSYNE_PPROF=1?`);
+  }
+  if (sockets.length > 1) {
+    throw new Error(`Several bridges are running (${sockets.join(', ')}); pick one with --pid`);
+  }
+  return path.join(socketDir, sockets[0]);
+}
+
+function fetchProfile(socketPath: string, urlPath: string, timeoutMs: number): Promise<Buffer> {
+  return new Promise((resolve, reject) => {
+    const req = http.get({ socketPath, path: urlPath, timeout: timeoutMs }, (res) => {
+      const chunks: Buffer[] = [];
+      res.on('data', (chunk: Buffer) => chunks.push(chunk));
+      res.on('end', () => {
+        const body = Buffer.concat(chunks);
+        if (res.statusCode !== 200) {
+          reject(new Error(`HTTP ${res.statusCode}: ${body.toString().trim()}`));
+        } else {
+          resolve(body);
+        }
+      });
+    });
+    req.on('timeout', () => req.destroy(new Error('Timed out waiting for the profile')));
+    req.on('error', reject);
+  });
+}
+
+async function main() {
+  const args = process.argv.slice(2);
+  if (args.includes('-h') || args.includes('--help')) {
+    usage();
+  }
+  const options = parseArgs(args);
+  const socketPath = findSocket(options);
+
+  const endpoint = options.kind === 'cpu' ? 'profile' : options.kind;
+  const query = options.seconds !== undefined ? `?seconds=${options.seconds}` : '';
+  const output = options.output || `tsyne-${options.kind}-${Date.now()}.pprof`;
+
+  if (options.seconds) {
+    console.error(`Recording ${options.kind} profile for ${options.seconds}s from ${socketPath}...`);
+  }
+  const profile = await fetchProfile(socketPath, `/debug/pprof/${endpoint}${query}`, ((options.seconds || 0) + 30) * 1000);
+  fs.writeFileSync(output, profile);
+
+  console.error(`Wrote ${output} (${profile.length} bytes)`);
+  console.error(`Open with: go tool pprof -http=:8080 ${output}`);
+}
+
+main().catch(err => {
+  console.error('tsyne-pprof error:', err.message || err);
+  process.exit(1);
+});
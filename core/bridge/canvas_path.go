@@ -83,7 +83,7 @@ func (pr *PathRaster) Raster() *canvas.Raster {
 
 // Refresh triggers a redraw
 func (pr *PathRaster) Refresh() {
-	fyne.Do(func() {
+	fyneDo(func() {
 		pr.raster.Refresh()
 	})
 }
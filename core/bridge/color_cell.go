@@ -251,7 +251,7 @@ func (b *Bridge) handleUpdateColorCell(msg Message) Response {
 		}
 	}
 
-	fyne.Do(func() {
+	fyneDo(func() {
 		if text, ok := msg.Payload["text"].(string); ok {
 			cell.SetText(text)
 		}
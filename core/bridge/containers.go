@@ -88,7 +88,7 @@ func (b *Bridge) handleSetContent(msg Message) Response {
 	}
 
 	// Setting window content must happen on the main thread
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		win.SetContent(widget)
 	})
 
@@ -142,6 +142,15 @@ func (b *Bridge) removeWidgetTree(widgetID string) {
 	delete(b.listData, widgetID)
 	delete(b.childToParent, widgetID)
 
+	// Bridge-resident canvases: stop the particle loop, free buffers and tiles
+	if f, exists := b.particleFields[widgetID]; exists {
+		f.mu.Lock()
+		f.halt()
+		f.mu.Unlock()
+		delete(b.particleFields, widgetID)
+	}
+	delete(b.tileMaps, widgetID)
+
 	// Remove from customIds using O(1) reverse lookup (optimized GC)
 	if customID, exists := b.widgetToCustomId[widgetID]; exists {
 		delete(b.customIds, customID)
@@ -177,7 +186,7 @@ func (b *Bridge) handleContainerAdd(msg Message) Response {
 	// Cast to container and add the child
 	if cont, ok := containerObj.(*fyne.Container); ok {
 		// UI updates must happen on the main thread
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			cont.Add(childObj)
 			// If container is already attached to a canvas, mark it dirty to trigger repaint.
 			// Without this, Add() on an already-displayed container won't visually update
@@ -224,7 +233,7 @@ func (b *Bridge) handleContainerRemoveAll(msg Message) Response {
 	// Cast to container and remove all children
 	if cont, ok := containerObj.(*fyne.Container); ok {
 		// UI updates must happen on the main thread
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			cont.RemoveAll() // Use Fyne's RemoveAll which handles refresh internally
 		})
 
@@ -259,7 +268,7 @@ func (b *Bridge) handleContainerRefresh(msg Message) Response {
 	// Cast to container and refresh
 	if cont, ok := containerObj.(*fyne.Container); ok {
 		// UI updates must happen on the main thread
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			cont.Refresh()
 		})
 
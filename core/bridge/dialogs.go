@@ -607,7 +607,7 @@ func (b *Bridge) handleShowColorPicker(msg Message) Response {
 	}
 
 	// Create and show the color picker dialog on the main thread
-	fyne.Do(func() {
+	fyneDo(func() {
 		picker := dialog.NewColorPicker(title, "Select a color", func(c color.Color) {
 			if c == nil {
 				// User cancelled
@@ -11,7 +11,9 @@ import "C"
 import (
 	"encoding/json"
 	"log"
+	"os"
 	"sync"
+	"time"
 	"unsafe"
 )
 
@@ -41,6 +43,11 @@ func TsyneInit(headless C.int) C.int {
 
 	testMode := headless != 0
 
+	// Initialize performance monitoring, as the other entry points do
+	perfEnabled := os.Getenv("TSYNE_PERF_SAMPLE") == "true"
+	InitPerfMonitor(perfEnabled)
+	InitTracer()
+
 	ffiBridge = NewBridge(testMode)
 	// FFI uses callback, not transport - but set this to avoid stdout writes
 	ffiBridge.transport = "ffi"
@@ -105,7 +112,13 @@ func TsyneSendMessage(messageJson *C.char) *C.char {
 	}
 
 	// Handle the message
+	timer := StartOp(msg.Type, msg.ID)
+	bridgeTracer.beginMessage(msg.ID)
+	handleStart := time.Now()
 	resp := bridge.handleMessage(msg)
+	traceSince(msg.Type, msg.ID, handleStart)
+	bridgeTracer.endMessage()
+	timer.End()
 
 	// Return response as JSON
 	respJson, err := json.Marshal(resp)
@@ -0,0 +1,189 @@
+// geo_kernels.cpp - Native batch geometry projection kernels
+//
+// Scalar implementation of the kernels declared in geo_kernels.h. Each kernel
+// is one tight loop over interleaved coordinate arrays; projection keeps
+// doubles until the final pixel offset so high zooms stay precise.
+
+#include "geo_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+const double kMaxLatitude = 85.051129;
+
+inline double mercatorX(double lng) {
+    return (180.0 + lng) / 360.0;
+}
+
+inline double mercatorY(double lat) {
+    lat = std::max(-kMaxLatitude, std::min(kMaxLatitude, lat));
+    return (180.0 - (180.0 / kPi * std::log(std::tan(kPi / 4.0 + lat * kPi / 360.0)))) / 360.0;
+}
+
+// Liang-Barsky: narrow [t0, t1] to the part of the segment inside the
+// rectangle. Returns false when nothing is left.
+inline bool clipSegment(float x0, float y0, float x1, float y1,
+                        float minX, float minY, float maxX, float maxY,
+                        float& t0, float& t1) {
+    const float dx = x1 - x0;
+    const float dy = y1 - y0;
+    const float p[4] = {-dx, dx, -dy, dy};
+    const float q[4] = {x0 - minX, maxX - x0, y0 - minY, maxY - y0};
+    t0 = 0.0f;
+    t1 = 1.0f;
+    for (int i = 0; i < 4; i++) {
+        if (p[i] == 0.0f) {
+            if (q[i] < 0.0f) {
+                return false;
+            }
+            continue;
+        }
+        const float t = q[i] / p[i];
+        if (p[i] < 0.0f) {
+            if (t > t1) return false;
+            if (t > t0) t0 = t;
+        } else {
+            if (t < t0) return false;
+            if (t < t1) t1 = t;
+        }
+    }
+    return true;
+}
+
+// One Sutherland-Hodgman pass against the half-plane
+// sign * (axis coordinate) <= sign * edge.
+void clipAgainstEdge(const std::vector<float>& in, std::vector<float>& out,
+                     int axis, float edge, float sign) {
+    out.clear();
+    const size_t n = in.size() / 2;
+    if (n == 0) {
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        const size_t j = (i + n - 1) % n;
+        const float cx = in[i * 2], cy = in[i * 2 + 1];
+        const float px = in[j * 2], py = in[j * 2 + 1];
+        const float c = axis == 0 ? cx : cy;
+        const float pv = axis == 0 ? px : py;
+        const bool curIn = sign * c <= sign * edge;
+        const bool prevIn = sign * pv <= sign * edge;
+        if (curIn != prevIn) {
+            const float t = (edge - pv) / (c - pv);
+            out.push_back(px + (cx - px) * t);
+            out.push_back(py + (cy - py) * t);
+        }
+        if (curIn) {
+            out.push_back(cx);
+            out.push_back(cy);
+        }
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+int TsyneGeoVersion(void) {
+    return TSYNE_GEO_ABI_VERSION;
+}
+
+void TsyneGeoLngLatToMercator(const double* lngLat, int count, double* outXY) {
+    if (lngLat == nullptr || outXY == nullptr) {
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        outXY[i * 2] = mercatorX(lngLat[i * 2]);
+        outXY[i * 2 + 1] = mercatorY(lngLat[i * 2 + 1]);
+    }
+}
+
+void TsyneGeoLngLatToPixels(const double* lngLat, int count,
+                            double centerX, double centerY, double worldSize,
+                            double width, double height, float* outXY) {
+    if (lngLat == nullptr || outXY == nullptr) {
+        return;
+    }
+    const double offsetX = width / 2.0 - centerX * worldSize;
+    const double offsetY = height / 2.0 - centerY * worldSize;
+    for (int i = 0; i < count; i++) {
+        outXY[i * 2] = static_cast<float>(mercatorX(lngLat[i * 2]) * worldSize + offsetX);
+        outXY[i * 2 + 1] = static_cast<float>(mercatorY(lngLat[i * 2 + 1]) * worldSize + offsetY);
+    }
+}
+
+int TsyneGeoClipPolyline(const float* xy, int count,
+                         float minX, float minY, float maxX, float maxY,
+                         float* outXY, int* outStarts) {
+    if (xy == nullptr || outXY == nullptr || outStarts == nullptr || count < 2) {
+        return 0;
+    }
+    int runs = 0;
+    int points = 0;
+    bool open = false;  // The last written point is the unclipped end of the previous segment
+
+    for (int i = 0; i + 1 < count; i++) {
+        const float x0 = xy[i * 2], y0 = xy[i * 2 + 1];
+        const float x1 = xy[i * 2 + 2], y1 = xy[i * 2 + 3];
+        float t0, t1;
+        if (!clipSegment(x0, y0, x1, y1, minX, minY, maxX, maxY, t0, t1)) {
+            open = false;
+            continue;
+        }
+        if (!open || t0 > 0.0f) {
+            outStarts[runs++] = points;
+            outXY[points * 2] = x0 + (x1 - x0) * t0;
+            outXY[points * 2 + 1] = y0 + (y1 - y0) * t0;
+            points++;
+        }
+        outXY[points * 2] = x0 + (x1 - x0) * t1;
+        outXY[points * 2 + 1] = y0 + (y1 - y0) * t1;
+        points++;
+        open = t1 >= 1.0f;
+    }
+    outStarts[runs] = points;
+    return runs;
+}
+
+int TsyneGeoClipPolygon(const float* xy, int count,
+                        float minX, float minY, float maxX, float maxY,
+                        float* outXY, int capacity) {
+    if (xy == nullptr || count < 3) {
+        return 0;
+    }
+    std::vector<float> a(xy, xy + static_cast<size_t>(count) * 2);
+    std::vector<float> b;
+    b.reserve(a.size() + 8);
+
+    clipAgainstEdge(a, b, 0, minX, -1.0f);
+    clipAgainstEdge(b, a, 0, maxX, 1.0f);
+    clipAgainstEdge(a, b, 1, minY, -1.0f);
+    clipAgainstEdge(b, a, 1, maxY, 1.0f);
+
+    const int n = static_cast<int>(a.size() / 2);
+    if (outXY != nullptr && capacity > 0) {
+        std::copy(a.begin(), a.begin() + std::min(n, capacity) * 2, outXY);
+    }
+    return n < 3 ? 0 : n;
+}
+
+int TsyneGeoCullPoints(const float* xy, int count,
+                       float minX, float minY, float maxX, float maxY,
+                       uint32_t* outIndex) {
+    if (xy == nullptr || outIndex == nullptr) {
+        return 0;
+    }
+    int n = 0;
+    for (int i = 0; i < count; i++) {
+        const float x = xy[i * 2], y = xy[i * 2 + 1];
+        if (x >= minX && x <= maxX && y >= minY && y <= maxY) {
+            outIndex[n++] = static_cast<uint32_t>(i);
+        }
+    }
+    return n;
+}
+
+} // extern "C"
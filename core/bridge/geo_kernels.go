@@ -0,0 +1,104 @@
+package main
+
+/*
+#cgo CXXFLAGS: -O3 -std=c++11
+#include "geo_kernels.h"
+*/
+import "C"
+
+import "unsafe"
+
+// ============================================================================
+// Native Geometry Kernels
+// ============================================================================
+//
+// geo_kernels.cpp projects and clips interleaved lng/lat geometry in bulk. The
+// C ABI is exported from libtsyne.so for the TypeScript side
+// (core/src/geo/native-geo.ts); these wrappers let bridge-resident widgets
+// project their own overlays with the same code.
+
+// geoPixelTransform places Mercator coordinates in a viewport
+type geoPixelTransform struct {
+	centerX, centerY float64 // Viewport center in Mercator units (0-1)
+	worldSize        float64 // World width in pixels at the current zoom
+	width, height    float64
+}
+
+// geoLngLatToPixels projects interleaved lng/lat pairs into out, growing it
+// when needed, and returns the interleaved pixel coordinates.
+func geoLngLatToPixels(lngLat []float64, t geoPixelTransform, out []float32) []float32 {
+	n := len(lngLat) / 2
+	if cap(out) < n*2 {
+		out = make([]float32, n*2)
+	}
+	out = out[:n*2]
+	if n == 0 {
+		return out
+	}
+	C.TsyneGeoLngLatToPixels((*C.double)(unsafe.Pointer(&lngLat[0])), C.int(n),
+		C.double(t.centerX), C.double(t.centerY), C.double(t.worldSize),
+		C.double(t.width), C.double(t.height), (*C.float)(unsafe.Pointer(&out[0])))
+	return out
+}
+
+// geoClipPolyline clips a pixel-space polyline to [minX, maxX] x [minY, maxY]
+// into out and returns the number of visible runs; run i is
+// out[starts[i]*2 : starts[i+1]*2].
+func geoClipPolyline(xy []float32, minX, minY, maxX, maxY float32, out []float32, starts []int32) (int, []float32, []int32) {
+	n := len(xy) / 2
+	if n < 2 {
+		return 0, out, starts
+	}
+	if cap(out) < (n-1)*4 {
+		out = make([]float32, (n-1)*4)
+	}
+	out = out[:(n-1)*4]
+	if cap(starts) < n {
+		starts = make([]int32, n)
+	}
+	starts = starts[:n]
+
+	runs := int(C.TsyneGeoClipPolyline((*C.float)(unsafe.Pointer(&xy[0])), C.int(n),
+		C.float(minX), C.float(minY), C.float(maxX), C.float(maxY),
+		(*C.float)(unsafe.Pointer(&out[0])), (*C.int)(unsafe.Pointer(&starts[0]))))
+
+	return runs, out, starts
+}
+
+// geoClipPolygon clips a pixel-space polygon ring to the rectangle, reusing
+// out for the result.
+func geoClipPolygon(xy []float32, minX, minY, maxX, maxY float32, out []float32) []float32 {
+	n := len(xy) / 2
+	if n < 3 {
+		return out[:0]
+	}
+	for {
+		if cap(out) < 2 {
+			out = make([]float32, n*2+8)
+		}
+		out = out[:cap(out)]
+		got := int(C.TsyneGeoClipPolygon((*C.float)(unsafe.Pointer(&xy[0])), C.int(n),
+			C.float(minX), C.float(minY), C.float(maxX), C.float(maxY),
+			(*C.float)(unsafe.Pointer(&out[0])), C.int(len(out)/2)))
+		if got*2 <= len(out) {
+			return out[:got*2]
+		}
+		out = make([]float32, got*2)
+	}
+}
+
+// geoCullPoints returns the indices of pixel-space points inside the rectangle.
+func geoCullPoints(xy []float32, minX, minY, maxX, maxY float32, out []uint32) []uint32 {
+	n := len(xy) / 2
+	if cap(out) < n {
+		out = make([]uint32, n)
+	}
+	out = out[:n]
+	if n == 0 {
+		return out
+	}
+	got := int(C.TsyneGeoCullPoints((*C.float)(unsafe.Pointer(&xy[0])), C.int(n),
+		C.float(minX), C.float(minY), C.float(maxX), C.float(maxY),
+		(*C.uint32_t)(unsafe.Pointer(&out[0]))))
+	return out[:got]
+}
@@ -0,0 +1,70 @@
+// geo_kernels.h - Native batch geometry projection kernels (C ABI)
+//
+// Project and clip large lng/lat geometries (GPS tracks, polygons with 100k+
+// vertices) in one call, without per-point allocation. Coordinates are
+// interleaved: lng0, lat0, lng1, lat1, ... in, x0, y0, x1, y1, ... out.
+// Compiled into libtsyne.so by cgo next to raster_kernels.cpp, so the
+// TypeScript side can call them over FFI (core/src/geo/native-geo.ts) and
+// bridge-resident widgets can project their overlays every frame.
+//
+// Projection matches core/src/geo/geo.ts (mercatorXfromLng/mercatorYfromLat),
+// with latitude clamped to the Web Mercator limit.
+
+#ifndef TSYNE_GEO_KERNELS_H
+#define TSYNE_GEO_KERNELS_H
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define TSYNE_GEO_API __declspec(dllexport)
+#else
+#define TSYNE_GEO_API __attribute__((visibility("default")))
+#endif
+
+// Bumped whenever a kernel signature changes.
+#define TSYNE_GEO_ABI_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returns TSYNE_GEO_ABI_VERSION.
+TSYNE_GEO_API int TsyneGeoVersion(void);
+
+// Project count lng/lat pairs to Mercator units (0-1, y down).
+TSYNE_GEO_API void TsyneGeoLngLatToMercator(const double* lngLat, int count, double* outXY);
+
+// Project count lng/lat pairs straight to viewport pixels.
+// centerX/centerY are the viewport center in Mercator units, worldSize the
+// width of the whole world in pixels at the current zoom.
+TSYNE_GEO_API void TsyneGeoLngLatToPixels(const double* lngLat, int count,
+                                          double centerX, double centerY, double worldSize,
+                                          double width, double height, float* outXY);
+
+// Clip a polyline of count points to a rectangle (Liang-Barsky per segment).
+// Writes the visible runs to outXY (room for 2 * (count - 1) points) and the
+// first point index of each run to outStarts (room for count entries), plus
+// the total point count after the last run. Returns the number of runs.
+TSYNE_GEO_API int TsyneGeoClipPolyline(const float* xy, int count,
+                                       float minX, float minY, float maxX, float maxY,
+                                       float* outXY, int* outStarts);
+
+// Clip a polygon ring of count points to a rectangle (Sutherland-Hodgman).
+// Returns the number of output points; only the first capacity are written,
+// so a result larger than capacity means the call should be repeated with a
+// bigger buffer.
+TSYNE_GEO_API int TsyneGeoClipPolygon(const float* xy, int count,
+                                      float minX, float minY, float maxX, float maxY,
+                                      float* outXY, int capacity);
+
+// Write the indices of points inside the rectangle to outIndex (room for
+// count entries). Returns how many there are.
+TSYNE_GEO_API int TsyneGeoCullPoints(const float* xy, int count,
+                                     float minX, float minY, float maxX, float maxY,
+                                     uint32_t* outIndex);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TSYNE_GEO_KERNELS_H
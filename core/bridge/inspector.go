@@ -375,7 +375,7 @@ func (b *Bridge) handleOpenInspector(msg Message) Response {
 	}
 
 	log.Printf("[Inspector] Creating inspector window...")
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		inspector := NewInspector(b, windowID)
 		inspector.Show()
 		log.Printf("[Inspector] Inspector window shown")
@@ -405,7 +405,7 @@ func (b *Bridge) handleGetInspectorTree(msg Message) Response {
 
 	var tree map[string]interface{}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		content := win.Content()
 		if content != nil {
 			tree = b.buildInspectorTree(content, "root")
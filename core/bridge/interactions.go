@@ -466,7 +466,7 @@ func (b *Bridge) handleTypeText(msg Message) Response {
 			test.Type(entry, text)
 		} else {
 			// UI operations must be called on the main thread
-			fyne.DoAndWait(func() {
+			fyneDoAndWait(func() {
 				entry.SetText(text)
 			})
 		}
@@ -514,7 +514,7 @@ func (b *Bridge) handleSubmitEntry(msg Message) Response {
 		if entry, ok := entryObj.(*widget.Entry); ok {
 			if entry.OnSubmitted != nil {
 				// Trigger the OnSubmitted callback
-				fyne.DoAndWait(func() {
+				fyneDoAndWait(func() {
 					entry.OnSubmitted(entry.Text)
 				})
 				return Response{
@@ -529,7 +529,7 @@ func (b *Bridge) handleSubmitEntry(msg Message) Response {
 	if entry, ok := obj.(*widget.Entry); ok {
 		if entry.OnSubmitted != nil {
 			// Trigger the OnSubmitted callback
-			fyne.DoAndWait(func() {
+			fyneDoAndWait(func() {
 				entry.OnSubmitted(entry.Text)
 			})
 			return Response{
@@ -543,7 +543,7 @@ func (b *Bridge) handleSubmitEntry(msg Message) Response {
 	if te, ok := obj.(*TsyneEntry); ok {
 		if te.OnSubmitted != nil {
 			// Trigger the OnSubmitted callback
-			fyne.DoAndWait(func() {
+			fyneDoAndWait(func() {
 				te.OnSubmitted(te.Text)
 			})
 			return Response{
@@ -557,7 +557,7 @@ func (b *Bridge) handleSubmitEntry(msg Message) Response {
 	if ce, ok := obj.(*xWidget.CompletionEntry); ok {
 		if ce.OnSubmitted != nil {
 			// Trigger the OnSubmitted callback
-			fyne.DoAndWait(func() {
+			fyneDoAndWait(func() {
 				ce.OnSubmitted(ce.Text)
 			})
 			return Response{
@@ -672,7 +672,7 @@ func (b *Bridge) handleFocusWidget(msg Message) Response {
 			for _, win := range b.windows {
 				canvas := win.Canvas()
 				if canvas != nil {
-					fyne.DoAndWait(func() {
+					fyneDoAndWait(func() {
 						canvas.Focus(entry)
 					})
 					return Response{
@@ -690,7 +690,7 @@ func (b *Bridge) handleFocusWidget(msg Message) Response {
 		for _, win := range b.windows {
 			canvas := win.Canvas()
 			if canvas != nil {
-				fyne.DoAndWait(func() {
+				fyneDoAndWait(func() {
 					canvas.Focus(focusable)
 				})
 				return Response{
@@ -952,7 +952,7 @@ func (b *Bridge) handleGetWidgetInfo(msg Message) Response {
 	}
 
 	// Get current widget properties - must happen on main thread
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		pos := obj.Position()
 		size := obj.Size()
 
@@ -1044,7 +1044,7 @@ func (b *Bridge) handleGetAllWidgets(msg Message) Response {
 	// Now access widget properties on the main thread
 	widgets := make([]map[string]interface{}, 0, len(widgetList))
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		for _, wd := range widgetList {
 			widgetInfo := map[string]interface{}{
 				"id":   wd.id,
@@ -1340,7 +1340,7 @@ func (b *Bridge) handleGetWidgetTree(msg Message) Response {
 
 	var tree map[string]interface{}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		tree = b.buildWidgetTree(obj, widgetID)
 	})
 
@@ -1388,7 +1388,7 @@ func (b *Bridge) handleTypeRune(msg Message) Response {
 	}
 
 	// Inject the rune to the focused widget
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		focused.TypedRune(r)
 	})
 
@@ -1489,7 +1489,7 @@ func (b *Bridge) handleTypeKey(msg Message) Response {
 	}
 
 	// Inject the key event to the focused widget
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		focused.TypedKey(&fyne.KeyEvent{Name: fyneKey})
 	})
 
@@ -18,6 +18,7 @@ import (
 	"log"
 	"net"
 	"os"
+	"time"
 
 	"google.golang.org/grpc"
 	"google.golang.org/grpc/metadata"
@@ -28,6 +29,8 @@ func (b *Bridge) handleMessage(msg Message) Response {
 	switch msg.Type {
 	case "ping":
 		return Response{Success: true, Result: map[string]interface{}{"pong": true}}
+	case "getNativeRasterInfo":
+		return Response{ID: msg.ID, Success: true, Result: nativeRasterInfo()}
 	case "createWindow":
 		return b.handleCreateWindow(msg)
 	case "setContent":
@@ -350,6 +353,16 @@ func (b *Bridge) handleMessage(msg Message) Response {
 		return b.handleSetWidgetContextMenu(msg)
 	case "quit":
 		return b.handleQuit(msg)
+	case "getTraceEvents":
+		return b.handleGetTraceEvents(msg)
+	case "getPerfStats":
+		return b.handleGetPerfStats(msg)
+	case "subscribePerfStats":
+		return b.handleSubscribePerfStats(msg)
+	case "unsubscribePerfStats":
+		return b.handleUnsubscribePerfStats(msg)
+	case "captureProfile":
+		return b.handleCaptureProfile(msg)
 	// Testing methods
 	case "findWidget":
 		return b.handleFindWidget(msg)
@@ -530,6 +543,24 @@ func (b *Bridge) handleMessage(msg Message) Response {
 		return b.handleUpdateCanvasSphere(msg)
 	case "updateCanvasSphereBuffer":
 		return b.handleUpdateCanvasSphereBuffer(msg)
+	case "createCanvasParticles":
+		return b.handleCreateCanvasParticles(msg)
+	case "updateCanvasParticles":
+		return b.handleUpdateCanvasParticles(msg)
+	case "getCanvasParticlesInfo":
+		return b.handleGetCanvasParticlesInfo(msg)
+	case "createCanvasTileMap":
+		return b.handleCreateCanvasTileMap(msg)
+	case "setCanvasTileMapViewport":
+		return b.handleSetCanvasTileMapViewport(msg)
+	case "putCanvasTileMapTiles":
+		return b.handlePutCanvasTileMapTiles(msg)
+	case "getCanvasTileMapInfo":
+		return b.handleGetCanvasTileMapInfo(msg)
+	case "setCanvasTileMapOverlay":
+		return b.handleSetCanvasTileMapOverlay(msg)
+	case "removeCanvasTileMapOverlay":
+		return b.handleRemoveCanvasTileMapOverlay(msg)
 	case "createCanvasRadialGradient":
 		return b.handleCreateCanvasRadialGradient(msg)
 	case "updateCanvasRadialGradient":
@@ -853,17 +884,25 @@ func runStdioMode(testMode bool) {
 			}
 
 			// Parse JSON message
+			decodeStart := time.Now()
 			var msg Message
 			if err := json.Unmarshal(jsonData, &msg); err != nil {
 				log.Printf("Error parsing message: %v", err)
 				continue
 			}
+			traceSince("decode", msg.ID, decodeStart)
 
 			// Handle the message and send response
 			timer := StartOp(msg.Type, msg.ID)
+			bridgeTracer.beginMessage(msg.ID)
+			handleStart := time.Now()
 			resp := bridge.handleMessage(msg)
+			traceSince(msg.Type, msg.ID, handleStart)
+			bridgeTracer.endMessage()
 			timer.End()
+			respondStart := time.Now()
 			bridge.sendResponse(resp)
+			traceSince("respond", msg.ID, respondStart)
 		}
 
 		// If stdin closes, signal quit
@@ -924,6 +963,7 @@ func StartBridgeMsgpackUDS(testMode C.int) C.int {
 	// Initialize performance monitoring
 	perfEnabled := os.Getenv("TSYNE_PERF_SAMPLE") == "true"
 	InitPerfMonitor(perfEnabled)
+	InitTracer()
 
 	// Run in msgpack-uds mode (the default for IPC)
 	runMsgpackUdsMode(testMode != 0)
@@ -947,6 +987,7 @@ func StartBridgeMsgpackUDSWithDir(testMode C.int, socketDir *C.char) C.int {
 	// Initialize performance monitoring
 	perfEnabled := os.Getenv("TSYNE_PERF_SAMPLE") == "true"
 	InitPerfMonitor(perfEnabled)
+	InitTracer()
 
 	// Run in msgpack-uds mode (the default for IPC)
 	runMsgpackUdsMode(testMode != 0)
@@ -962,6 +1003,7 @@ func StartBridgeGrpc(testMode C.int) C.int {
 
 	perfEnabled := os.Getenv("TSYNE_PERF_SAMPLE") == "true"
 	InitPerfMonitor(perfEnabled)
+	InitTracer()
 
 	runGrpcMode(testMode != 0)
 
@@ -993,6 +1035,8 @@ func main() {
 	// Initialize performance monitoring (env: TSYNE_PERF_SAMPLE=true)
 	perfEnabled := os.Getenv("TSYNE_PERF_SAMPLE") == "true"
 	InitPerfMonitor(perfEnabled)
+	// Initialize cross-process tracing (env: TSYNE_TRACE=<trace.json>)
+	InitTracer()
 
 	// Parse command-line flags
 	mode := flag.String("mode", "stdio", "Communication mode: stdio, grpc, or msgpack-uds")
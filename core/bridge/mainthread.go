@@ -0,0 +1,75 @@
+package main
+
+import (
+	"time"
+
+	"fyne.io/fyne/v2"
+)
+
+// ============================================================================
+// Main Thread Dispatch
+// ============================================================================
+//
+// All bridge code reaches the Fyne main thread through fyneDo and
+// fyneDoAndWait instead of calling fyne.Do/fyne.DoAndWait directly, so that
+// instrumentation has one place to hook in: tracing spans (trace.go) and
+// per-call-site stall detection (perf_mainthread.go). With both off they add
+// two nil checks.
+
+// fyneDo schedules fn on the Fyne main thread without waiting
+func fyneDo(fn func()) {
+	if bridgeTracer == nil && !mainThreadTimingEnabled() {
+		fyne.Do(fn)
+		return
+	}
+	fyne.Do(instrumentMainThread(fn, false))
+}
+
+// fyneDoAndWait runs fn on the Fyne main thread and waits for it to finish
+func fyneDoAndWait(fn func()) {
+	if bridgeTracer == nil && !mainThreadTimingEnabled() {
+		fyne.DoAndWait(fn)
+		return
+	}
+	fyne.DoAndWait(instrumentMainThread(fn, true))
+}
+
+// instrumentMainThread wraps fn to time its queue wait and run
+func instrumentMainThread(fn func(), wait bool) func() {
+	name := "fyne.Do"
+	if wait {
+		name = "fyne.DoAndWait"
+	}
+	msgID := bridgeTracer.currentMessage()
+	site, op := "", ""
+	if mainThreadTimingEnabled() {
+		site = perfMon.callSite()
+		op = perfMon.currentOpName()
+		perfMon.mainThreadPending.Add(1)
+	}
+	queued := time.Now()
+
+	return func() {
+		if site != "" {
+			perfMon.mainThreadPending.Add(-1)
+		}
+		start := time.Now()
+		fn()
+		end := time.Now()
+
+		if bridgeTracer != nil {
+			// DoAndWait blocks the message handler, so its wait nests inside the
+			// handler span; async calls and callers outside message handling
+			// (animations, timers) may overlap and go on the queue lane
+			if wait && msgID != "" {
+				bridgeTracer.record(name+" wait", "main", msgID, traceLaneIPC, false, queued, start)
+			} else {
+				bridgeTracer.record(name+" wait", "main", msgID, traceLaneQueue, true, queued, start)
+			}
+			bridgeTracer.record(name, "main", msgID, traceLaneMain, false, start, end)
+		}
+		if site != "" {
+			perfMon.recordMainThread(site, op, start.Sub(queued), end.Sub(start))
+		}
+	}
+}
@@ -87,7 +87,7 @@ func (b *Bridge) handleSetMainMenu(msg Message) Response {
 
 	mainMenu := fyne.NewMainMenu(menus...)
 	// Setting window menu must happen on the main thread
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		win.SetMainMenu(mainMenu)
 	})
 
@@ -221,7 +221,7 @@ func (b *Bridge) handleSetWidgetStyle(msg Message) Response {
 	}
 
 	// UI updates must happen on the main thread
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		// Apply font style if specified
 		if fontStyle, ok := msg.Payload["fontStyle"].(string); ok {
 			switch w := obj.(type) {
@@ -345,7 +345,7 @@ func (b *Bridge) handleSetWidgetMinSize(msg Message) Response {
 		}
 	}
 
-	fyne.Do(func() {
+	fyneDo(func() {
 		// Try to call SetMinSize if the widget supports it
 		if sizable, ok := obj.(interface{ SetMinSize(fyne.Size) }); ok {
 			sizable.SetMinSize(fyne.NewSize(minWidth, minHeight))
@@ -477,7 +477,7 @@ func (b *Bridge) handleSetTheme(msg Message) Response {
 
 	// Re-apply theme to trigger Fyne's theme change notification
 	// This properly invalidates cached colors across all canvases
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		b.app.Settings().SetTheme(b.scalableTheme)
 	})
 
@@ -534,7 +534,7 @@ func (b *Bridge) handleSetFontScale(msg Message) Response {
 	b.scalableTheme.SetFontScale(float32(scale))
 
 	// Re-apply theme to trigger Fyne's theme change notification
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		b.app.Settings().SetTheme(b.scalableTheme)
 	})
 
@@ -624,7 +624,7 @@ func (b *Bridge) handleSetCustomTheme(msg Message) Response {
 
 	// Re-apply theme to trigger Fyne's theme change notification
 	// This properly invalidates cached colors across all canvases
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		b.app.Settings().SetTheme(b.scalableTheme)
 	})
 
@@ -647,7 +647,7 @@ func (b *Bridge) handleClearCustomTheme(msg Message) Response {
 	b.scalableTheme.ClearCustomColors()
 
 	// Re-apply theme to trigger Fyne's theme change notification
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		b.app.Settings().SetTheme(b.scalableTheme)
 	})
 
@@ -705,7 +705,7 @@ func (b *Bridge) handleSetCustomSizes(msg Message) Response {
 	b.scalableTheme.SetCustomSizes(customSizes)
 
 	// Re-apply theme to trigger Fyne's theme change notification
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		b.app.Settings().SetTheme(b.scalableTheme)
 	})
 
@@ -727,7 +727,7 @@ func (b *Bridge) handleClearCustomSizes(msg Message) Response {
 	b.scalableTheme.ClearCustomSizes()
 
 	// Re-apply theme to trigger Fyne's theme change notification
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		b.app.Settings().SetTheme(b.scalableTheme)
 	})
 
@@ -876,7 +876,7 @@ func (b *Bridge) handleSetCustomFont(msg Message) Response {
 	}
 
 	// Re-apply theme to trigger Fyne's theme change notification
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		b.app.Settings().SetTheme(b.scalableTheme)
 	})
 
@@ -919,7 +919,7 @@ func (b *Bridge) handleClearCustomFont(msg Message) Response {
 	}
 
 	// Re-apply theme to trigger Fyne's theme change notification
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		b.app.Settings().SetTheme(b.scalableTheme)
 	})
 
@@ -964,7 +964,7 @@ func (b *Bridge) handleQuit(msg Message) Response {
 	}
 
 	// UI operations must be called on the main thread
-	fyne.Do(func() {
+	fyneDo(func() {
 		b.app.Quit()
 	})
 
@@ -39,6 +39,8 @@ type MsgpackServer struct {
 	batchQueue    [][]byte       // Queued serialized messages
 	batchTimer    *time.Timer    // Flush timer
 	batchFlushCh  chan struct{}  // Signal to flush immediately
+
+	pprof *pprofServer // nil unless TSYNE_PPROF is set
 }
 
 // MsgpackMessage represents a message in MessagePack format
@@ -63,12 +65,11 @@ type MsgpackEvent struct {
 	Data     map[string]interface{} `msgpack:"data,omitempty"`
 }
 
-// NewMsgpackServer creates a new MessagePack UDS server
-func NewMsgpackServer(bridge *Bridge) *MsgpackServer {
-	// Create socket in temp directory, prioritizing:
-	// 1. socketDirOverride (set via StartBridgeMsgpackUDSWithDir for Android)
-	// 2. TSYNE_SOCKET_DIR env var
-	// 3. os.TempDir()
+// bridgeSocketDir returns the directory for the bridge's sockets, prioritizing:
+// 1. socketDirOverride (set via StartBridgeMsgpackUDSWithDir for Android)
+// 2. TSYNE_SOCKET_DIR env var
+// 3. os.TempDir()
+func bridgeSocketDir() string {
 	socketDir := socketDirOverride
 	if socketDir == "" {
 		socketDir = os.Getenv("TSYNE_SOCKET_DIR")
@@ -76,7 +77,12 @@ func NewMsgpackServer(bridge *Bridge) *MsgpackServer {
 	if socketDir == "" {
 		socketDir = os.TempDir()
 	}
-	socketPath := filepath.Join(socketDir, fmt.Sprintf("tsyne-%d.sock", os.Getpid()))
+	return socketDir
+}
+
+// NewMsgpackServer creates a new MessagePack UDS server
+func NewMsgpackServer(bridge *Bridge) *MsgpackServer {
+	socketPath := filepath.Join(bridgeSocketDir(), fmt.Sprintf("tsyne-%d.sock", os.Getpid()))
 
 	server := &MsgpackServer{
 		bridge:       bridge,
@@ -137,6 +143,13 @@ func (s *MsgpackServer) Start() error {
 	// Start accepting connections in background
 	go s.acceptConnections()
 
+	// Serve pprof on a second socket alongside (env: TSYNE_PPROF=1)
+	if pprofEnabled() {
+		if s.pprof, err = startPprofServer(filepath.Dir(s.socketPath)); err != nil {
+			log.Printf("[pprof] %v", err)
+		}
+	}
+
 	return nil
 }
 
@@ -151,6 +164,7 @@ func (s *MsgpackServer) Close() {
 		s.listener.Close()
 	}
 	os.Remove(s.socketPath)
+	s.pprof.Close()
 }
 
 // SendEvent sends an event to all connected clients synchronously
@@ -273,16 +287,19 @@ func (s *MsgpackServer) handleClient(conn net.Conn) {
 		}
 
 		// Decode MessagePack
+		decodeStart := time.Now()
 		var msg MsgpackMessage
 		if err := msgpack.Unmarshal(msgBuf, &msg); err != nil {
 			log.Printf("[msgpack] Error decoding message: %v", err)
 			continue
 		}
+		traceSince("decode", msg.ID, decodeStart)
 
 		// Handle the message
 		response := s.handleMessage(msg)
 
 		// Encode response using pooled encoder (#6 optimization)
+		respondStart := time.Now()
 		respBuf, err := s.encodeWithPool(response)
 		if err != nil {
 			log.Printf("[msgpack] Error encoding response: %v", err)
@@ -298,6 +315,7 @@ func (s *MsgpackServer) handleClient(conn net.Conn) {
 		s.mu.Lock()
 		conn.Write(frameBuf[:4+len(respBuf)])
 		s.mu.Unlock()
+		traceSince("respond", msg.ID, respondStart)
 
 		// Return buffer to pool
 		s.putFrameBuffer(frameBuf)
@@ -314,7 +332,11 @@ func (s *MsgpackServer) handleMessage(msg MsgpackMessage) MsgpackResponse {
 
 	// Dispatch to bridge handler chain - now returns Response directly
 	timer := StartOp(msg.Type, msg.ID)
+	bridgeTracer.beginMessage(msg.ID)
+	handleStart := time.Now()
 	resp := s.bridge.handleMessage(bridgeMsg)
+	traceSince(msg.Type, msg.ID, handleStart)
+	bridgeTracer.endMessage()
 	timer.End()
 
 	return MsgpackResponse{
@@ -7,6 +7,7 @@ import (
 	"os"
 	"sort"
 	"sync"
+	"sync/atomic"
 	"time"
 )
 
@@ -16,14 +17,6 @@ type PerfConfig struct {
 	Verbose bool // Log every operation
 }
 
-// PerfSample records a single timing measurement
-type PerfSample struct {
-	Name    string  `json:"name"`
-	DurMs   float64 `json:"dur_ms"`
-	StartNs int64   `json:"start_ns"` // Nanosecond timestamp for correlation
-	OpID    string  `json:"op_id"`    // Message ID for correlation with client
-}
-
 // PerfStats tracks aggregated statistics for an operation
 type PerfStats struct {
 	Name      string  `json:"name"`
@@ -32,30 +25,35 @@ type PerfStats struct {
 	MaxMs     float64 `json:"max_ms"`
 	AvgMs     float64 `json:"avg_ms"`
 	MedianMs  float64 `json:"median_ms"`
+	P90Ms     float64 `json:"p90_ms"`
+	P99Ms     float64 `json:"p99_ms"`
+	P999Ms    float64 `json:"p999_ms"`
 	StddevMs  float64 `json:"stddev_ms"`
 	TotalMs   float64 `json:"total_ms"`
-	RecentDur float64 `json:"recent_dur_ms"` // Last 30s window
+	RecentDur float64 `json:"recent_dur_ms"` // Average since the previous report
 }
 
-// PerfMonitor collects and reports performance metrics
+// PerfMonitor collects and reports performance metrics.
+// Recording never takes a lock: each operation has its own latencyHistogram,
+// looked up through a sync.Map.
 type PerfMonitor struct {
-	config     PerfConfig
-	mu         sync.RWMutex
-	samples    []PerfSample
-	opStats    map[string]*opStats
-	lastReport time.Time
-	startTime  time.Time
+	mainThreadMonitor
+	config       PerfConfig
+	enabled      atomic.Bool // Starts as config.Enabled; getPerfStats can turn it on
+	ops          sync.Map    // name -> *opStats
+	reportMu     sync.Mutex
+	lastReportNs atomic.Int64
+	startTime    time.Time
 }
 
 // Internal operation stats tracking
 type opStats struct {
-	name      string
-	samples   []float64   // Keep last 60 samples for rolling window
-	durations []time.Time // For windowed stats
-	count     int64
-	sum       float64
-	minVal    float64
-	maxVal    float64
+	name string
+	hist *latencyHistogram
+
+	// Count and sum at the previous report, for RecentDur (guarded by reportMu)
+	reportedCount uint64
+	reportedSumUs uint64
 }
 
 var perfMon *PerfMonitor
@@ -63,26 +61,39 @@ var perfMon *PerfMonitor
 // InitPerfMonitor initializes the global performance monitor
 func InitPerfMonitor(enabled bool) {
 	verbose := os.Getenv("TSYNE_PERF_VERBOSE") == "true"
-	perfMon = &PerfMonitor{
-		config: PerfConfig{
-			Enabled: enabled,
-			Verbose: verbose,
-		},
-		opStats:    make(map[string]*opStats),
-		lastReport: time.Now(),
-		startTime:  time.Now(),
-	}
+	perfMon = newPerfMonitor(PerfConfig{
+		Enabled: enabled,
+		Verbose: verbose,
+	})
+	perfMon.stallThreshold = stallThresholdFromEnv()
 	if enabled {
-		log.Printf("[perf] Performance monitoring ENABLED (verbose=%v)", verbose)
+		log.Printf("[perf] Performance monitoring ENABLED (verbose=%v, stall threshold=%v)", verbose, perfMon.stallThreshold)
 	}
 }
 
+func newPerfMonitor(config PerfConfig) *PerfMonitor {
+	pm := &PerfMonitor{
+		config:    config,
+		startTime: time.Now(),
+	}
+	pm.enabled.Store(config.Enabled)
+	pm.lastReportNs.Store(pm.startTime.UnixNano())
+	return pm
+}
+
+// Enabled reports whether samples are being recorded. Safe on a nil monitor.
+func (pm *PerfMonitor) Enabled() bool {
+	return pm != nil && pm.enabled.Load()
+}
+
 // StartOp marks the start of a timed operation
 // Returns an OpTimer that should be called with End() to record the measurement
+// Until End(), main-thread stalls are attributed to this operation.
 func StartOp(name string, msgID string) *OpTimer {
-	if perfMon == nil || !perfMon.config.Enabled {
+	if !perfMon.Enabled() {
 		return &OpTimer{}
 	}
+	perfMon.setCurrentOp(&name)
 	return &OpTimer{
 		name:    name,
 		msgID:   msgID,
@@ -100,130 +111,92 @@ type OpTimer struct {
 	ended   bool
 }
 
-// End records the operation duration
+// End records the operation duration. A timer started while sampling was
+// off records nothing, even if sampling was turned on since.
 func (ot *OpTimer) End() {
-	if perfMon == nil || !perfMon.config.Enabled || ot.ended {
+	if !perfMon.Enabled() || ot.ended || ot.start.IsZero() {
 		return
 	}
 	ot.ended = true
+	perfMon.setCurrentOp(nil)
 
 	dur := time.Since(ot.start)
-	durMs := float64(dur.Microseconds()) / 1000.0
 
 	if perfMon.config.Verbose {
-		log.Printf("[perf] %s: %.2fms (msgID=%s)", ot.name, durMs, ot.msgID)
+		log.Printf("[perf] %s: %.2fms (msgID=%s)", ot.name, float64(dur.Microseconds())/1000.0, ot.msgID)
 	}
 
-	sample := PerfSample{
-		Name:    ot.name,
-		DurMs:   durMs,
-		StartNs: ot.startNs,
-		OpID:    ot.msgID,
-	}
-
-	perfMon.recordSample(sample)
+	perfMon.recordSample(ot.name, dur)
 }
 
-// recordSample adds a sample and updates statistics
-func (pm *PerfMonitor) recordSample(sample PerfSample) {
-	pm.mu.Lock()
-	defer pm.mu.Unlock()
-
-	pm.samples = append(pm.samples, sample)
-	if len(pm.samples) > 10000 {
-		// Keep last 10000 samples to avoid unbounded memory growth
-		pm.samples = pm.samples[1:]
-	}
-
-	// Update operation stats
-	if pm.opStats[sample.Name] == nil {
-		pm.opStats[sample.Name] = &opStats{
-			name:   sample.Name,
-			minVal: sample.DurMs,
-			maxVal: sample.DurMs,
-		}
+// op returns the stats for an operation, creating them on first use
+func (pm *PerfMonitor) op(name string) *opStats {
+	if s, ok := pm.ops.Load(name); ok {
+		return s.(*opStats)
 	}
+	s, _ := pm.ops.LoadOrStore(name, &opStats{name: name, hist: newLatencyHistogram()})
+	return s.(*opStats)
+}
 
-	stat := pm.opStats[sample.Name]
-	stat.samples = append(stat.samples, sample.DurMs)
-	if len(stat.samples) > 60 {
-		stat.samples = stat.samples[1:]
-	}
-	stat.durations = append(stat.durations, time.Now())
-	if len(stat.durations) > 60 {
-		stat.durations = stat.durations[1:]
+// recordSample adds a sample to the operation's histogram
+func (pm *PerfMonitor) recordSample(name string, dur time.Duration) {
+	us := dur.Microseconds()
+	if us < 0 {
+		us = 0
 	}
+	pm.op(name).hist.Record(uint64(us))
 
-	stat.count++
-	stat.sum += sample.DurMs
-	if sample.DurMs < stat.minVal {
-		stat.minVal = sample.DurMs
-	}
-	if sample.DurMs > stat.maxVal {
-		stat.maxVal = sample.DurMs
+	// Report stats periodically (every 10 seconds); the CAS picks one reporter
+	now := time.Now().UnixNano()
+	last := pm.lastReportNs.Load()
+	if now-last > int64(10*time.Second) && pm.lastReportNs.CompareAndSwap(last, now) {
+		pm.reportStats()
 	}
+}
 
-	// Report stats periodically (every 10 seconds)
-	if time.Since(pm.lastReport) > 10*time.Second {
-		pm.reportStats()
-		pm.lastReport = time.Now()
+// statsFor summarizes one operation
+func statsFor(s *opStats, snap *histSnapshot) *PerfStats {
+	return &PerfStats{
+		Name:     s.name,
+		Count:    int64(snap.count),
+		MinMs:    float64(snap.minUs) / 1000.0,
+		MaxMs:    float64(snap.maxUs) / 1000.0,
+		AvgMs:    snap.Mean() / 1000.0,
+		MedianMs: snap.Quantile(0.5) / 1000.0,
+		P90Ms:    snap.Quantile(0.9) / 1000.0,
+		P99Ms:    snap.Quantile(0.99) / 1000.0,
+		P999Ms:   snap.Quantile(0.999) / 1000.0,
+		StddevMs: snap.Stddev() / 1000.0,
+		TotalMs:  float64(snap.sumUs) / 1000.0,
 	}
 }
 
 // reportStats logs current performance statistics
 func (pm *PerfMonitor) reportStats() {
-	pm.mu.RLock()
-	defer pm.mu.RUnlock()
-
-	if len(pm.opStats) == 0 {
-		return
-	}
+	pm.reportMu.Lock()
+	defer pm.reportMu.Unlock()
 
 	uptime := time.Since(pm.startTime).Seconds()
 
 	// Compile stats in sorted order
 	var stats []*PerfStats
-	for name, s := range pm.opStats {
-		stat := &PerfStats{
-			Name:    name,
-			Count:   s.count,
-			MinMs:   s.minVal,
-			MaxMs:   s.maxVal,
-			TotalMs: s.sum,
-			AvgMs:   s.sum / float64(s.count),
+	pm.ops.Range(func(_, value interface{}) bool {
+		s := value.(*opStats)
+		snap := s.hist.Snapshot()
+		if snap.count == 0 {
+			return true
 		}
-
-		// Calculate median
-		if len(s.samples) > 0 {
-			sorted := make([]float64, len(s.samples))
-			copy(sorted, s.samples)
-			sort.Float64s(sorted)
-			stat.MedianMs = sorted[len(sorted)/2]
-
-			// Calculate stddev
-			var sumSquares float64
-			for _, val := range sorted {
-				diff := val - stat.AvgMs
-				sumSquares += diff * diff
-			}
-			stat.StddevMs = Math.Sqrt(sumSquares / float64(len(sorted)))
-
-			// Recent window (last 30 seconds)
-			var recentSum float64
-			recentCount := 0
-			cutoff := time.Now().Add(-30 * time.Second)
-			for i, dur := range s.durations {
-				if dur.After(cutoff) {
-					recentSum += s.samples[i]
-					recentCount++
-				}
-			}
-			if recentCount > 0 {
-				stat.RecentDur = recentSum / float64(recentCount)
-			}
+		stat := statsFor(s, snap)
+		if snap.count > s.reportedCount {
+			stat.RecentDur = float64(snap.sumUs-s.reportedSumUs) / float64(snap.count-s.reportedCount) / 1000.0
 		}
-
+		s.reportedCount = snap.count
+		s.reportedSumUs = snap.sumUs
 		stats = append(stats, stat)
+		return true
+	})
+	if len(stats) == 0 {
+		return
 	}
 
 	// Sort by total time descending
@@ -231,11 +204,15 @@ func (pm *PerfMonitor) reportStats() {
 		return stats[i].TotalMs > stats[j].TotalMs
 	})
 
+	mainThread, stallsByOp := pm.mainThreadStats()
+
 	// Output as JSON
 	report := map[string]interface{}{
-		"uptime_sec": uptime,
-		"operations": stats,
-		"timestamp":  time.Now().Unix(),
+		"uptime_sec":   uptime,
+		"operations":   stats,
+		"main_thread":  mainThread,
+		"stalls_by_op": stallsByOp,
+		"timestamp":    time.Now().Unix(),
 	}
 
 	if data, err := json.Marshal(report); err == nil {
@@ -245,40 +222,29 @@ func (pm *PerfMonitor) reportStats() {
 
 // GetStats returns current statistics (for embedding in responses if needed)
 func (pm *PerfMonitor) GetStats(name string) map[string]float64 {
-	if pm == nil || !pm.config.Enabled {
+	if !pm.Enabled() {
 		return nil
 	}
 
-	pm.mu.RLock()
-	defer pm.mu.RUnlock()
-
-	stat, exists := pm.opStats[name]
-	if !exists || stat.count == 0 {
+	value, exists := pm.ops.Load(name)
+	if !exists {
+		return nil
+	}
+	snap := value.(*opStats).hist.Snapshot()
+	if snap.count == 0 {
 		return nil
 	}
+	stat := statsFor(value.(*opStats), snap)
 
 	return map[string]float64{
-		"count": float64(stat.count),
-		"min":   stat.minVal,
-		"max":   stat.maxVal,
-		"avg":   stat.sum / float64(stat.count),
-		"total": stat.sum,
+		"count": float64(stat.Count),
+		"min":   stat.MinMs,
+		"max":   stat.MaxMs,
+		"avg":   stat.AvgMs,
+		"total": stat.TotalMs,
+		"p50":   stat.MedianMs,
+		"p90":   stat.P90Ms,
+		"p99":   stat.P99Ms,
+		"p999":  stat.P999Ms,
 	}
 }
-
-// Math helper (Go doesn't have math.Sqrt in standard, using inline)
-var Math = struct {
-	Sqrt func(float64) float64
-}{
-	Sqrt: func(x float64) float64 {
-		// Simple Newton's method for sqrt
-		if x < 0 {
-			return 0
-		}
-		z := x
-		for i := 0; i < 20; i++ {
-			z = (z + x/z) / 2
-		}
-		return z
-	},
-}
@@ -0,0 +1,163 @@
+package main
+
+import (
+	"math"
+	"math/bits"
+	"sync/atomic"
+)
+
+// ============================================================================
+// Latency Histogram
+// ============================================================================
+//
+// Log-linear histogram of durations in microseconds with fixed memory. Values
+// below 128us get one bucket each; above that every power of two is split
+// into 64 equal sub-buckets, so any recorded value is within 1/64 (1.6%) of
+// its bucket's bounds. Recording is a handful of atomic adds with no locks
+// or allocation, which keeps perf sampling cheap enough to leave on.
+
+const (
+	histSubBucketBits  = 6
+	histSubBucketCount = 1 << histSubBucketBits
+	histMaxBits        = 36 // ~19 hours in microseconds
+	histMaxValueUs     = 1<<histMaxBits - 1
+	histBucketCount    = (histMaxBits - histSubBucketBits + 1) * histSubBucketCount
+)
+
+// latencyHistogram is safe for concurrent Record and Snapshot calls
+type latencyHistogram struct {
+	counts [histBucketCount]atomic.Uint64
+	count  atomic.Uint64
+	sumUs  atomic.Uint64
+	minUs  atomic.Uint64
+	maxUs  atomic.Uint64
+}
+
+func newLatencyHistogram() *latencyHistogram {
+	h := &latencyHistogram{}
+	h.minUs.Store(math.MaxUint64)
+	return h
+}
+
+// histBucketIndex maps a value to its bucket
+func histBucketIndex(us uint64) int {
+	if us < histSubBucketCount {
+		return int(us)
+	}
+	exp := bits.Len64(us) - histSubBucketBits - 1
+	return (exp+1)*histSubBucketCount + int(us>>uint(exp)) - histSubBucketCount
+}
+
+// histBucketRange returns the lowest value of a bucket and its width
+func histBucketRange(index int) (lower, width uint64) {
+	exp := index/histSubBucketCount - 1
+	if exp <= 0 {
+		return uint64(index), 1
+	}
+	sub := uint64(index%histSubBucketCount + histSubBucketCount)
+	return sub << uint(exp), 1 << uint(exp)
+}
+
+// Record adds one duration in microseconds
+func (h *latencyHistogram) Record(us uint64) {
+	if us > histMaxValueUs {
+		us = histMaxValueUs
+	}
+	h.counts[histBucketIndex(us)].Add(1)
+	h.count.Add(1)
+	h.sumUs.Add(us)
+	for {
+		cur := h.minUs.Load()
+		if us >= cur || h.minUs.CompareAndSwap(cur, us) {
+			break
+		}
+	}
+	for {
+		cur := h.maxUs.Load()
+		if us <= cur || h.maxUs.CompareAndSwap(cur, us) {
+			break
+		}
+	}
+}
+
+// histSnapshot is a point-in-time copy of a histogram for computing statistics
+type histSnapshot struct {
+	counts [histBucketCount]uint64
+	count  uint64 // Sum of counts, so quantiles are consistent with the buckets
+	sumUs  uint64
+	minUs  uint64
+	maxUs  uint64
+}
+
+// Snapshot copies the histogram. Samples recorded concurrently may be only
+// partly reflected (e.g. in the sum but not yet in a bucket).
+func (h *latencyHistogram) Snapshot() *histSnapshot {
+	s := &histSnapshot{
+		sumUs: h.sumUs.Load(),
+		minUs: h.minUs.Load(),
+		maxUs: h.maxUs.Load(),
+	}
+	for i := range h.counts {
+		c := h.counts[i].Load()
+		s.counts[i] = c
+		s.count += c
+	}
+	if s.count == 0 {
+		s.minUs = 0
+	}
+	return s
+}
+
+// Quantile returns the value at quantile q (0-1) in microseconds: the top of
+// the bucket holding that rank, clamped to the observed min and max.
+func (s *histSnapshot) Quantile(q float64) float64 {
+	if s.count == 0 {
+		return 0
+	}
+	rank := uint64(math.Ceil(q * float64(s.count)))
+	if rank < 1 {
+		rank = 1
+	}
+	var seen uint64
+	for i, c := range s.counts {
+		seen += c
+		if seen >= rank {
+			lower, width := histBucketRange(i)
+			v := lower + width - 1
+			if v > s.maxUs {
+				v = s.maxUs
+			}
+			if v < s.minUs {
+				v = s.minUs
+			}
+			return float64(v)
+		}
+	}
+	return float64(s.maxUs)
+}
+
+// Mean returns the average in microseconds
+func (s *histSnapshot) Mean() float64 {
+	if s.count == 0 {
+		return 0
+	}
+	return float64(s.sumUs) / float64(s.count)
+}
+
+// Stddev estimates the standard deviation in microseconds from bucket midpoints
+func (s *histSnapshot) Stddev() float64 {
+	if s.count == 0 {
+		return 0
+	}
+	mean := s.Mean()
+	var sumSquares float64
+	for i, c := range s.counts {
+		if c == 0 {
+			continue
+		}
+		lower, width := histBucketRange(i)
+		diff := float64(lower) + float64(width-1)/2 - mean
+		sumSquares += diff * diff * float64(c)
+	}
+	return math.Sqrt(sumSquares / float64(s.count))
+}
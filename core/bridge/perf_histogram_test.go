@@ -0,0 +1,115 @@
+package main
+
+import (
+	"math"
+	"sync"
+	"testing"
+	"time"
+)
+
+// TestHistBucketRoundTrip checks every value lands in a bucket that contains it
+func TestHistBucketRoundTrip(t *testing.T) {
+	values := []uint64{0, 1, 63, 64, 127, 128, 129, 255, 256, 1000, 16667, 1 << 20, histMaxValueUs}
+	for v := uint64(0); v < 5000; v++ {
+		values = append(values, v)
+	}
+	for _, v := range values {
+		index := histBucketIndex(v)
+		if index < 0 || index >= histBucketCount {
+			t.Fatalf("value %d: bucket %d out of range", v, index)
+		}
+		lower, width := histBucketRange(index)
+		if v < lower || v >= lower+width {
+			t.Errorf("value %d: bucket %d covers [%d, %d)", v, index, lower, lower+width)
+		}
+		if v >= 128 && float64(width-1)/float64(lower) > 1.0/histSubBucketCount {
+			t.Errorf("value %d: bucket width %d too coarse", v, width)
+		}
+	}
+}
+
+// TestHistogramQuantiles checks quantiles of a uniform 1..10000us distribution
+func TestHistogramQuantiles(t *testing.T) {
+	h := newLatencyHistogram()
+	for us := uint64(1); us <= 10000; us++ {
+		h.Record(us)
+	}
+	snap := h.Snapshot()
+
+	if snap.count != 10000 || snap.minUs != 1 || snap.maxUs != 10000 {
+		t.Fatalf("count/min/max = %d/%d/%d", snap.count, snap.minUs, snap.maxUs)
+	}
+	for _, tc := range []struct{ q, want float64 }{
+		{0.5, 5000}, {0.9, 9000}, {0.99, 9900}, {0.999, 9990},
+	} {
+		got := snap.Quantile(tc.q)
+		if math.Abs(got-tc.want)/tc.want > 1.0/histSubBucketCount {
+			t.Errorf("p%g = %.0f, want %.0f within 1/64", tc.q*100, got, tc.want)
+		}
+	}
+	if mean := snap.Mean(); mean != 5000.5 {
+		t.Errorf("mean = %f, want 5000.5", mean)
+	}
+	// Uniform distribution: stddev = n / sqrt(12)
+	if sd := snap.Stddev(); math.Abs(sd-2886.75)/2886.75 > 0.02 {
+		t.Errorf("stddev = %f, want ~2886.75", sd)
+	}
+}
+
+// TestHistogramConcurrentRecord records from many goroutines without losing samples
+func TestHistogramConcurrentRecord(t *testing.T) {
+	h := newLatencyHistogram()
+	var wg sync.WaitGroup
+	for g := 0; g < 8; g++ {
+		wg.Add(1)
+		go func(g int) {
+			defer wg.Done()
+			for i := 0; i < 10000; i++ {
+				h.Record(uint64(g*1000 + i%1000))
+			}
+		}(g)
+	}
+	wg.Wait()
+
+	snap := h.Snapshot()
+	if snap.count != 80000 {
+		t.Errorf("count = %d, want 80000", snap.count)
+	}
+	if snap.minUs != 0 || snap.maxUs != 7999 {
+		t.Errorf("min/max = %d/%d, want 0/7999", snap.minUs, snap.maxUs)
+	}
+}
+
+// TestPerfMonitorGetStats checks per-op stats come from the histogram
+func TestPerfMonitorGetStats(t *testing.T) {
+	pm := newPerfMonitor(PerfConfig{Enabled: true})
+
+	for i := 1; i <= 100; i++ {
+		pm.recordSample("setText", time.Duration(i)*time.Millisecond)
+	}
+	stats := pm.GetStats("setText")
+	if stats == nil {
+		t.Fatal("expected stats for setText")
+	}
+	if stats["count"] != 100 || stats["min"] != 1 || stats["max"] != 100 {
+		t.Errorf("count/min/max = %v/%v/%v", stats["count"], stats["min"], stats["max"])
+	}
+	if math.Abs(stats["p99"]-99)/99 > 1.0/histSubBucketCount {
+		t.Errorf("p99 = %v, want ~99", stats["p99"])
+	}
+	if pm.GetStats("unknown") != nil {
+		t.Error("expected nil stats for an unrecorded op")
+	}
+}
+
+func BenchmarkPerfMonitorRecord(b *testing.B) {
+	pm := newPerfMonitor(PerfConfig{Enabled: true})
+	b.ReportAllocs()
+	b.RunParallel(func(pb *testing.PB) {
+		d := time.Duration(0)
+		for pb.Next() {
+			d += time.Microsecond
+			pm.recordSample("refresh", d%(20*time.Millisecond))
+		}
+	})
+}
@@ -0,0 +1,195 @@
+package main
+
+import (
+	"log"
+	"os"
+	"runtime"
+	"sort"
+	"strconv"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+// ============================================================================
+// Main Thread Stall Detection
+// ============================================================================
+//
+// With perf sampling on, every fyneDo/fyneDoAndWait call is timed per call
+// site (the bridge function that made it): how long it sat in Fyne's queue
+// and how long it ran on the main thread. Runs longer than the stall
+// threshold (TSYNE_STALL_MS, default 16ms = one frame at 60fps) are logged
+// with the message type being handled and counted in the perf report.
+
+const defaultStallThreshold = 16 * time.Millisecond
+
+// mainThreadSite aggregates main-thread calls from one bridge function
+type mainThreadSite struct {
+	site      string
+	wait      *latencyHistogram // Queue delay before the main thread ran it
+	run       *latencyHistogram // Time on the main thread
+	stalls    atomic.Uint64
+	lastLogNs atomic.Int64
+}
+
+// MainThreadStats summarizes one call site for the perf report
+type MainThreadStats struct {
+	Site      string  `json:"site"`
+	Count     int64   `json:"count"`
+	Stalls    uint64  `json:"stalls"`
+	WaitP50Ms float64 `json:"wait_p50_ms"`
+	WaitP99Ms float64 `json:"wait_p99_ms"`
+	WaitMaxMs float64 `json:"wait_max_ms"`
+	RunP50Ms  float64 `json:"run_p50_ms"`
+	RunP99Ms  float64 `json:"run_p99_ms"`
+	RunMaxMs  float64 `json:"run_max_ms"`
+	RunTotMs  float64 `json:"run_total_ms"`
+}
+
+// mainThreadMonitor holds the per-site stats. Embedded in PerfMonitor.
+type mainThreadMonitor struct {
+	stallThreshold time.Duration
+	sites          sync.Map // site -> *mainThreadSite
+	stallsByOp     sync.Map // message type -> *atomic.Uint64
+	currentOp      sync.Map // goroutine ID -> message type it is handling
+
+	// Instrumented calls queued but not yet run
+	mainThreadPending atomic.Int64
+}
+
+// stallThresholdFromEnv reads TSYNE_STALL_MS
+func stallThresholdFromEnv() time.Duration {
+	if ms, err := strconv.ParseFloat(os.Getenv("TSYNE_STALL_MS"), 64); err == nil && ms > 0 {
+		return time.Duration(ms * float64(time.Millisecond))
+	}
+	return defaultStallThreshold
+}
+
+// mainThreadTimingEnabled reports whether fyneDo calls should be timed
+func mainThreadTimingEnabled() bool {
+	return perfMon.Enabled()
+}
+
+// callSite names the bridge function that called fyneDo/fyneDoAndWait, e.g.
+// "handleUpdateTableData". Closures are folded into their enclosing function.
+// Frames are walked with CallersFrames so inlined wrappers resolve correctly.
+func (m *mainThreadMonitor) callSite() string {
+	var pcs [8]uintptr
+	n := runtime.Callers(2, pcs[:])
+	frames := runtime.CallersFrames(pcs[:n])
+	for {
+		frame, more := frames.Next()
+		name := frame.Function
+		// Drop the package: "main." in the binary, the module path under go test
+		name = name[strings.LastIndex(name, "/")+1:]
+		name = name[strings.Index(name, ".")+1:]
+		switch name {
+		case "instrumentMainThread", "fyneDo", "fyneDoAndWait":
+		default:
+			name = strings.TrimPrefix(name, "(*Bridge).")
+			// handleFoo.func1.2 -> handleFoo
+			if i := strings.Index(name, ".func"); i > 0 {
+				name = name[:i]
+			}
+			if name != "" {
+				return name
+			}
+		}
+		if !more {
+			return "unknown"
+		}
+	}
+}
+
+func (m *mainThreadMonitor) site(name string) *mainThreadSite {
+	if s, ok := m.sites.Load(name); ok {
+		return s.(*mainThreadSite)
+	}
+	s, _ := m.sites.LoadOrStore(name, &mainThreadSite{
+		site: name,
+		wait: newLatencyHistogram(),
+		run:  newLatencyHistogram(),
+	})
+	return s.(*mainThreadSite)
+}
+
+// recordMainThread adds one main-thread call and flags it when it stalled
+func (m *mainThreadMonitor) recordMainThread(site, op string, wait, run time.Duration) {
+	s := m.site(site)
+	s.wait.Record(uint64(wait.Microseconds()))
+	s.run.Record(uint64(run.Microseconds()))
+	if run < m.stallThreshold {
+		return
+	}
+
+	s.stalls.Add(1)
+	if op == "" {
+		op = "(no message)"
+	}
+	counter, _ := m.stallsByOp.LoadOrStore(op, new(atomic.Uint64))
+	counter.(*atomic.Uint64).Add(1)
+
+	// Log at most once a second per site so a stuck animation can't flood stderr
+	now := time.Now().UnixNano()
+	last := s.lastLogNs.Load()
+	if now-last > int64(time.Second) && s.lastLogNs.CompareAndSwap(last, now) {
+		log.Printf("[perf] Main-thread stall: %s ran %.1fms (queued %.1fms) handling %s",
+			site, float64(run.Microseconds())/1000.0, float64(wait.Microseconds())/1000.0, op)
+	}
+}
+
+// mainThreadStats summarizes every call site, busiest first
+func (m *mainThreadMonitor) mainThreadStats() ([]*MainThreadStats, map[string]uint64) {
+	var stats []*MainThreadStats
+	m.sites.Range(func(_, value interface{}) bool {
+		s := value.(*mainThreadSite)
+		wait := s.wait.Snapshot()
+		run := s.run.Snapshot()
+		if run.count == 0 {
+			return true
+		}
+		stats = append(stats, &MainThreadStats{
+			Site:      s.site,
+			Count:     int64(run.count),
+			Stalls:    s.stalls.Load(),
+			WaitP50Ms: wait.Quantile(0.5) / 1000.0,
+			WaitP99Ms: wait.Quantile(0.99) / 1000.0,
+			WaitMaxMs: float64(wait.maxUs) / 1000.0,
+			RunP50Ms:  run.Quantile(0.5) / 1000.0,
+			RunP99Ms:  run.Quantile(0.99) / 1000.0,
+			RunMaxMs:  float64(run.maxUs) / 1000.0,
+			RunTotMs:  float64(run.sumUs) / 1000.0,
+		})
+		return true
+	})
+	sort.Slice(stats, func(i, j int) bool {
+		return stats[i].RunTotMs > stats[j].RunTotMs
+	})
+
+	byOp := map[string]uint64{}
+	m.stallsByOp.Range(func(key, value interface{}) bool {
+		byOp[key.(string)] = value.(*atomic.Uint64).Load()
+		return true
+	})
+	return stats, byOp
+}
+
+// setCurrentOp records the message type the calling goroutine is handling
+// (nil clears it). Per goroutine, since msgpack connections are served
+// concurrently.
+func (m *mainThreadMonitor) setCurrentOp(op *string) {
+	if op == nil {
+		m.currentOp.Delete(goroutineID())
+	} else {
+		m.currentOp.Store(goroutineID(), *op)
+	}
+}
+
+// currentOpName returns the message type the calling goroutine is handling, if any
+func (m *mainThreadMonitor) currentOpName() string {
+	if op, ok := m.currentOp.Load(goroutineID()); ok {
+		return op.(string)
+	}
+	return ""
+}
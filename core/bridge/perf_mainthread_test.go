@@ -0,0 +1,97 @@
+package main
+
+import (
+	"sync"
+	"testing"
+	"time"
+)
+
+// queueFromHandler stands in for a bridge handler calling fyneDo
+func queueFromHandler(fn func()) func() {
+	return instrumentMainThread(fn, false)
+}
+
+// TestMainThreadCallSite attributes main-thread calls to the calling function
+func TestMainThreadCallSite(t *testing.T) {
+	saved := perfMon
+	defer func() { perfMon = saved }()
+	perfMon = newPerfMonitor(PerfConfig{Enabled: true})
+	perfMon.stallThreshold = time.Hour
+
+	ran := false
+	queueFromHandler(func() { ran = true })()
+	if !ran {
+		t.Fatal("wrapped function did not run")
+	}
+
+	stats, _ := perfMon.mainThreadStats()
+	if len(stats) != 1 || stats[0].Site != "queueFromHandler" || stats[0].Count != 1 {
+		t.Fatalf("stats = %+v, want one call from queueFromHandler", stats)
+	}
+	if stats[0].Stalls != 0 {
+		t.Errorf("stalls = %d, want 0", stats[0].Stalls)
+	}
+}
+
+// TestMainThreadStalls flags runs over the threshold with the current message type
+func TestMainThreadStalls(t *testing.T) {
+	m := &mainThreadMonitor{stallThreshold: 16 * time.Millisecond}
+	op := "updateTableData"
+	m.setCurrentOp(&op)
+
+	m.recordMainThread("handleUpdateTableData", m.currentOpName(), time.Millisecond, 40*time.Millisecond)
+	m.recordMainThread("handleUpdateTableData", m.currentOpName(), 0, 2*time.Millisecond)
+	m.setCurrentOp(nil)
+	m.recordMainThread("animationTick", m.currentOpName(), 30*time.Millisecond, 20*time.Millisecond)
+
+	stats, byOp := m.mainThreadStats()
+	if len(stats) != 2 {
+		t.Fatalf("got %d sites, want 2", len(stats))
+	}
+	site := stats[0]
+	if site.Site != "handleUpdateTableData" || site.Count != 2 || site.Stalls != 1 {
+		t.Errorf("site = %+v, want handleUpdateTableData with 2 calls and 1 stall", site)
+	}
+	if site.RunMaxMs != 40 {
+		t.Errorf("run max = %v, want 40", site.RunMaxMs)
+	}
+	if byOp["updateTableData"] != 1 || byOp["(no message)"] != 1 {
+		t.Errorf("stalls by op = %v", byOp)
+	}
+	if stats[1].WaitMaxMs != 30 {
+		t.Errorf("wait max = %v, want 30", stats[1].WaitMaxMs)
+	}
+}
+
+// TestMainThreadCurrentOpPerGoroutine keeps the message types of concurrent
+// handlers apart, as when msgpack serves several connections at once
+func TestMainThreadCurrentOpPerGoroutine(t *testing.T) {
+	m := &mainThreadMonitor{stallThreshold: time.Millisecond}
+	ops := []string{"setText", "updateTableData", "createButton", "refresh"}
+	var started, done sync.WaitGroup
+	started.Add(len(ops))
+	done.Add(len(ops))
+
+	for _, op := range ops {
+		go func(op string) {
+			defer done.Done()
+			m.setCurrentOp(&op)
+			started.Done()
+			started.Wait() // Every handler has begun before any records
+			m.recordMainThread("handle"+op, m.currentOpName(), 0, 5*time.Millisecond)
+			m.setCurrentOp(nil)
+		}(op)
+	}
+	done.Wait()
+
+	_, byOp := m.mainThreadStats()
+	for _, op := range ops {
+		if byOp[op] != 1 {
+			t.Errorf("stalls by op = %v, want one for each of %v", byOp, ops)
+			break
+		}
+	}
+	if got := m.currentOpName(); got != "" {
+		t.Errorf("currentOpName = %q outside any handler, want empty", got)
+	}
+}
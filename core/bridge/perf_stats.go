@@ -0,0 +1,217 @@
+package main
+
+import (
+	"encoding/json"
+	"log"
+	"runtime"
+	"sort"
+	"time"
+)
+
+// ============================================================================
+// Perf Stats Query and Stream
+// ============================================================================
+//
+// getPerfStats returns the same numbers reportStats logs to stderr, plus queue
+// depths and Go runtime stats, as a message response. subscribePerfStats
+// pushes the same snapshot as a "perfStats" event every intervalMs until
+// unsubscribePerfStats. Both go through handleMessage/sendEvent, so they work
+// on stdio, msgpack-uds and FFI (TsyneSendMessage). gRPC is not supported:
+// its client has no route for these messages and SubscribeEvents flattens
+// event data to strings.
+//
+// Payload options (both messages):
+//   enable:     true turns on perf sampling if TSYNE_PERF_SAMPLE was not set
+//   histograms: true adds the non-empty buckets of each op histogram
+
+const (
+	defaultPerfStreamInterval = time.Second
+	minPerfStreamInterval     = 100 * time.Millisecond
+	perfRecentGCPauses        = 16
+)
+
+// jsonValue converts v to plain maps and slices via its JSON form, so every
+// transport encodes it with the same field names as the stderr report
+func jsonValue(v interface{}) interface{} {
+	data, err := json.Marshal(v)
+	if err != nil {
+		return nil
+	}
+	var out interface{}
+	if err := json.Unmarshal(data, &out); err != nil {
+		return nil
+	}
+	return out
+}
+
+// nonZeroBuckets lists [upper bound in us, count] for each used bucket
+func (s *histSnapshot) nonZeroBuckets() [][2]uint64 {
+	var buckets [][2]uint64
+	for i, c := range s.counts {
+		if c == 0 {
+			continue
+		}
+		lower, width := histBucketRange(i)
+		buckets = append(buckets, [2]uint64{lower + width - 1, c})
+	}
+	return buckets
+}
+
+// operationStats summarizes every operation, busiest first
+func (pm *PerfMonitor) operationStats(histograms bool) []map[string]interface{} {
+	type entry struct {
+		stat    *PerfStats
+		buckets [][2]uint64
+	}
+	var entries []entry
+	pm.ops.Range(func(_, value interface{}) bool {
+		s := value.(*opStats)
+		snap := s.hist.Snapshot()
+		if snap.count == 0 {
+			return true
+		}
+		e := entry{stat: statsFor(s, snap)}
+		if histograms {
+			e.buckets = snap.nonZeroBuckets()
+		}
+		entries = append(entries, e)
+		return true
+	})
+	sort.Slice(entries, func(i, j int) bool {
+		return entries[i].stat.TotalMs > entries[j].stat.TotalMs
+	})
+
+	ops := make([]map[string]interface{}, 0, len(entries))
+	for _, e := range entries {
+		op, _ := jsonValue(e.stat).(map[string]interface{})
+		if op == nil {
+			continue
+		}
+		if e.buckets != nil {
+			op["buckets_us"] = e.buckets
+		}
+		ops = append(ops, op)
+	}
+	return ops
+}
+
+// perfStatsSnapshot collects everything getPerfStats and the perfStats event report
+func (b *Bridge) perfStatsSnapshot(histograms bool) map[string]interface{} {
+	snapshot := map[string]interface{}{
+		"enabled":      perfMon.Enabled(),
+		"timestamp_ms": time.Now().UnixMilli(),
+	}
+
+	if perfMon != nil {
+		mainThread, stallsByOp := perfMon.mainThreadStats()
+		snapshot["uptime_sec"] = time.Since(perfMon.startTime).Seconds()
+		snapshot["operations"] = perfMon.operationStats(histograms)
+		snapshot["main_thread"] = jsonValue(mainThread)
+		snapshot["stalls_by_op"] = jsonValue(stallsByOp)
+	}
+
+	queues := map[string]interface{}{}
+	if perfMon != nil {
+		queues["main_thread_pending"] = perfMon.mainThreadPending.Load()
+	}
+	if b.msgpackServer != nil {
+		b.msgpackServer.batchMu.Lock()
+		queues["msgpack_batch"] = len(b.msgpackServer.batchQueue)
+		b.msgpackServer.batchMu.Unlock()
+	}
+	if b.transport == "ffi" {
+		eventQueueMu.Lock()
+		queues["ffi_events"] = len(eventQueue)
+		eventQueueMu.Unlock()
+	}
+	snapshot["queues"] = queues
+
+	var mem runtime.MemStats
+	runtime.ReadMemStats(&mem)
+	// Most recent GC pauses, newest first
+	pauses := make([]float64, 0, perfRecentGCPauses)
+	for i := uint32(0); i < mem.NumGC && i < perfRecentGCPauses; i++ {
+		// PauseNs is a circular buffer; the latest pause is at (NumGC+255)%256
+		pauses = append(pauses, float64(mem.PauseNs[(mem.NumGC-i+255)%256])/1e6)
+	}
+	snapshot["runtime"] = map[string]interface{}{
+		"goroutines":          runtime.NumGoroutine(),
+		"heap_alloc_bytes":    mem.HeapAlloc,
+		"heap_sys_bytes":      mem.HeapSys,
+		"heap_objects":        mem.HeapObjects,
+		"gc_count":            mem.NumGC,
+		"gc_pause_total_ms":   float64(mem.PauseTotalNs) / 1e6,
+		"gc_recent_pauses_ms": pauses,
+	}
+	return snapshot
+}
+
+// perfStatsOptions reads the enable/histograms payload flags
+func perfStatsOptions(msg Message) (histograms bool) {
+	if enable, _ := msg.Payload["enable"].(bool); enable && perfMon != nil && !perfMon.Enabled() {
+		perfMon.enabled.Store(true)
+		log.Printf("[perf] Performance monitoring ENABLED by %s", msg.Type)
+	}
+	histograms, _ = msg.Payload["histograms"].(bool)
+	return histograms
+}
+
+// handleGetPerfStats returns a perf snapshot
+func (b *Bridge) handleGetPerfStats(msg Message) Response {
+	histograms := perfStatsOptions(msg)
+	return Response{
+		ID:      msg.ID,
+		Success: true,
+		Result:  b.perfStatsSnapshot(histograms),
+	}
+}
+
+// handleSubscribePerfStats starts (or restarts) the perfStats event stream
+func (b *Bridge) handleSubscribePerfStats(msg Message) Response {
+	histograms := perfStatsOptions(msg)
+	interval := defaultPerfStreamInterval
+	if ms := toFloat64(msg.Payload["intervalMs"]); ms > 0 {
+		interval = time.Duration(ms * float64(time.Millisecond))
+	}
+	if interval < minPerfStreamInterval {
+		interval = minPerfStreamInterval
+	}
+
+	stop := make(chan struct{})
+	b.mu.Lock()
+	if b.perfStream != nil {
+		close(b.perfStream)
+	}
+	b.perfStream = stop
+	b.mu.Unlock()
+
+	go func() {
+		ticker := time.NewTicker(interval)
+		defer ticker.Stop()
+		for {
+			select {
+			case <-stop:
+				return
+			case <-ticker.C:
+				b.sendEvent(Event{Type: "perfStats", Data: b.perfStatsSnapshot(histograms)})
+			}
+		}
+	}()
+
+	return Response{
+		ID:      msg.ID,
+		Success: true,
+		Result:  map[string]interface{}{"intervalMs": interval.Milliseconds()},
+	}
+}
+
+// handleUnsubscribePerfStats stops the perfStats event stream
+func (b *Bridge) handleUnsubscribePerfStats(msg Message) Response {
+	b.mu.Lock()
+	if b.perfStream != nil {
+		close(b.perfStream)
+		b.perfStream = nil
+	}
+	b.mu.Unlock()
+	return Response{ID: msg.ID, Success: true}
+}
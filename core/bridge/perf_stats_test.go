@@ -0,0 +1,130 @@
+package main
+
+import (
+	"testing"
+	"time"
+)
+
+// TestGetPerfStats returns op stats, histograms and runtime stats
+func TestGetPerfStats(t *testing.T) {
+	saved := perfMon
+	defer func() { perfMon = saved }()
+	perfMon = newPerfMonitor(PerfConfig{Enabled: true})
+	perfMon.recordSample("setText", 2*time.Millisecond)
+	perfMon.recordSample("setText", 4*time.Millisecond)
+
+	bridge := &Bridge{}
+	resp := bridge.handleGetPerfStats(Message{
+		ID:      "perf_1",
+		Type:    "getPerfStats",
+		Payload: map[string]interface{}{"histograms": true},
+	})
+	if !resp.Success {
+		t.Fatalf("getPerfStats failed: %s", resp.Error)
+	}
+	result := resp.Result
+
+	ops := result["operations"].([]map[string]interface{})
+	if len(ops) != 1 || ops[0]["name"] != "setText" || ops[0]["count"] != float64(2) {
+		t.Fatalf("operations = %v", ops)
+	}
+	buckets := ops[0]["buckets_us"].([][2]uint64)
+	if len(buckets) != 2 || buckets[0][1] != 1 {
+		t.Errorf("buckets = %v, want two buckets of one sample", buckets)
+	}
+
+	rt := result["runtime"].(map[string]interface{})
+	if rt["goroutines"].(int) < 1 || rt["heap_alloc_bytes"].(uint64) == 0 {
+		t.Errorf("runtime = %v", rt)
+	}
+	if _, ok := result["queues"].(map[string]interface{})["main_thread_pending"]; !ok {
+		t.Error("expected main_thread_pending queue depth")
+	}
+}
+
+// TestGetPerfStatsEnable turns sampling on at runtime
+func TestGetPerfStatsEnable(t *testing.T) {
+	saved := perfMon
+	defer func() { perfMon = saved }()
+	perfMon = newPerfMonitor(PerfConfig{Enabled: false})
+
+	bridge := &Bridge{}
+	result := bridge.handleGetPerfStats(Message{ID: "perf_1", Type: "getPerfStats", Payload: map[string]interface{}{}}).Result
+	if result["enabled"] != false {
+		t.Fatal("expected sampling off")
+	}
+	bridge.handleGetPerfStats(Message{ID: "perf_2", Type: "getPerfStats", Payload: map[string]interface{}{"enable": true}})
+	if !perfMon.Enabled() {
+		t.Error("expected enable:true to turn sampling on")
+	}
+}
+
+// TestGetPerfStatsEnableSkipsOwnTimer records nothing for the request that
+// turned sampling on, since its timer started while sampling was off
+func TestGetPerfStatsEnableSkipsOwnTimer(t *testing.T) {
+	saved := perfMon
+	defer func() { perfMon = saved }()
+	perfMon = newPerfMonitor(PerfConfig{Enabled: false})
+
+	bridge := &Bridge{}
+	timer := StartOp("getPerfStats", "perf_1")
+	bridge.handleGetPerfStats(Message{ID: "perf_1", Type: "getPerfStats", Payload: map[string]interface{}{"enable": true}})
+	timer.End()
+
+	timer = StartOp("getPerfStats", "perf_2")
+	result := bridge.handleGetPerfStats(Message{ID: "perf_2", Type: "getPerfStats", Payload: map[string]interface{}{}}).Result
+	timer.End()
+
+	if ops := result["operations"].([]map[string]interface{}); len(ops) != 0 {
+		t.Fatalf("operations = %v before any timed op ended, want none", ops)
+	}
+	ops := perfMon.operationStats(false)
+	if len(ops) != 1 || ops[0]["name"] != "getPerfStats" || ops[0]["count"] != float64(1) {
+		t.Errorf("operations = %v, want only the second getPerfStats", ops)
+	}
+}
+
+// TestPerfStatsStream pushes perfStats events until unsubscribed
+func TestPerfStatsStream(t *testing.T) {
+	saved := perfMon
+	defer func() { perfMon = saved }()
+	perfMon = newPerfMonitor(PerfConfig{Enabled: true})
+
+	events := make(chan Event, 16)
+	bridge := &Bridge{}
+	bridge.SetEventCallback(func(e Event) {
+		select {
+		case events <- e:
+		default:
+		}
+	})
+
+	resp := bridge.handleSubscribePerfStats(Message{
+		ID:      "perf_1",
+		Type:    "subscribePerfStats",
+		Payload: map[string]interface{}{"intervalMs": float64(10)},
+	})
+	if got := resp.Result["intervalMs"]; got != int64(100) {
+		t.Errorf("intervalMs = %v, want clamped to 100", got)
+	}
+
+	select {
+	case e := <-events:
+		if e.Type != "perfStats" || e.Data["runtime"] == nil {
+			t.Errorf("event = %+v", e)
+		}
+	case <-time.After(2 * time.Second):
+		t.Fatal("no perfStats event")
+	}
+
+	bridge.handleUnsubscribePerfStats(Message{ID: "perf_2", Type: "unsubscribePerfStats"})
+	time.Sleep(150 * time.Millisecond)
+	for len(events) > 0 {
+		<-events
+	}
+	select {
+	case e := <-events:
+		t.Errorf("event after unsubscribe: %+v", e)
+	case <-time.After(300 * time.Millisecond):
+	}
+}
@@ -45,7 +45,7 @@ func (b *Bridge) handleSetSystemTray(msg Message) Response {
 		menu := fyne.NewMenu("", menuItems...)
 
 		// Set up the system tray
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			desk.SetSystemTrayMenu(menu)
 
 			// Set tray icon if provided
@@ -79,7 +79,7 @@ func (b *Bridge) handleSendNotification(msg Message) Response {
 
 	notification := fyne.NewNotification(title, content)
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		b.app.SendNotification(notification)
 	})
 
@@ -106,7 +106,7 @@ func (b *Bridge) handleClipboardGet(msg Message) Response {
 	}
 
 	var content string
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		content = win.Clipboard().Content()
 	})
 
@@ -136,7 +136,7 @@ func (b *Bridge) handleClipboardSet(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		win.Clipboard().SetContent(content)
 	})
 
@@ -0,0 +1,237 @@
+package main
+
+import (
+	"bytes"
+	"fmt"
+	"log"
+	"net"
+	"net/http"
+	"net/http/pprof"
+	"net/url"
+	"os"
+	"path/filepath"
+	"runtime"
+	"strconv"
+	"strings"
+	"sync"
+	"time"
+)
+
+// ============================================================================
+// Profiling (pprof over UDS)
+// ============================================================================
+//
+// With TSYNE_PPROF=1 the msgpack server also serves net/http/pprof on
+// tsyne-<pid>-pprof.sock, next to its tsyne-<pid>.sock. Nothing listens on
+// the network; cli/tsyne-pprof.ts (or curl --unix-socket) pulls profiles from
+// the socket and `go tool pprof` reads them.
+//
+// The captureProfile message records a profile to a file instead, without
+// TSYNE_PPROF, over stdio, msgpack-uds or FFI (the gRPC client has no route
+// for it):
+//   kind:    "cpu" (default), "heap" or "mutex"
+//   seconds: profile window; default 10 for cpu/mutex, heap defaults to a
+//            snapshot and with seconds set records allocations in the window
+//   path:    output file name, written in the socket directory; defaults to
+//            tsyne-<pid>-<kind>-<time>.pprof. Directories are rejected so a
+//            message can't write anywhere else.
+// It responds at once with the path and sends a "profileWritten" event
+// ({kind, path, bytes} or {kind, path, error}) when the file is complete.
+
+const (
+	defaultProfileSeconds = 10
+	maxProfileSeconds     = 300
+	mutexProfileFraction  = 5 // Sample 1 in 5 contention events while profiling
+)
+
+// profileHandlers serve each profile kind, for both the socket and captureProfile
+var profileHandlers = map[string]http.Handler{
+	"cpu":   http.HandlerFunc(pprof.Profile),
+	"heap":  pprof.Handler("heap"),
+	"mutex": withMutexProfiling(pprof.Handler("mutex")),
+}
+
+// pprofEnabled reports whether TSYNE_PPROF asks for the pprof socket
+func pprofEnabled() bool {
+	v := os.Getenv("TSYNE_PPROF")
+	return v != "" && v != "0" && v != "false"
+}
+
+// pprofServer serves net/http/pprof on a Unix socket
+type pprofServer struct {
+	listener   net.Listener
+	socketPath string
+}
+
+// startPprofServer listens on tsyne-<pid>-pprof.sock in socketDir
+func startPprofServer(socketDir string) (*pprofServer, error) {
+	socketPath := filepath.Join(socketDir, fmt.Sprintf("tsyne-%d-pprof.sock", os.Getpid()))
+	os.Remove(socketPath)
+
+	listener, err := net.Listen("unix", socketPath)
+	if err != nil {
+		return nil, fmt.Errorf("failed to listen on pprof socket: %w", err)
+	}
+	// Profiles expose memory contents; only our user may connect
+	os.Chmod(socketPath, 0600)
+
+	mux := http.NewServeMux()
+	mux.HandleFunc("/debug/pprof/", pprof.Index)
+	mux.HandleFunc("/debug/pprof/cmdline", pprof.Cmdline)
+	mux.HandleFunc("/debug/pprof/profile", pprof.Profile)
+	mux.HandleFunc("/debug/pprof/symbol", pprof.Symbol)
+	mux.HandleFunc("/debug/pprof/trace", pprof.Trace)
+	mux.Handle("/debug/pprof/mutex", profileHandlers["mutex"])
+	go http.Serve(listener, mux)
+
+	log.Printf("[pprof] Serving pprof on %s", socketPath)
+	return &pprofServer{listener: listener, socketPath: socketPath}, nil
+}
+
+// Close stops the server and removes its socket
+func (s *pprofServer) Close() {
+	if s == nil {
+		return
+	}
+	s.listener.Close()
+	os.Remove(s.socketPath)
+}
+
+var (
+	mutexProfilingMu    sync.Mutex
+	mutexProfilingUsers int
+	mutexProfilingPrev  int
+)
+
+// withMutexProfiling turns mutex sampling on while h runs. Sampling is off
+// by default, so a timed mutex profile would otherwise come back empty.
+func withMutexProfiling(h http.Handler) http.Handler {
+	return http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		mutexProfilingMu.Lock()
+		if mutexProfilingUsers == 0 {
+			mutexProfilingPrev = runtime.SetMutexProfileFraction(mutexProfileFraction)
+		}
+		mutexProfilingUsers++
+		mutexProfilingMu.Unlock()
+
+		defer func() {
+			mutexProfilingMu.Lock()
+			mutexProfilingUsers--
+			if mutexProfilingUsers == 0 {
+				runtime.SetMutexProfileFraction(mutexProfilingPrev)
+			}
+			mutexProfilingMu.Unlock()
+		}()
+		h.ServeHTTP(w, r)
+	})
+}
+
+// profileRecorder collects a pprof handler's response in memory
+type profileRecorder struct {
+	header http.Header
+	status int
+	body   bytes.Buffer
+}
+
+func (r *profileRecorder) Header() http.Header { return r.header }
+
+func (r *profileRecorder) WriteHeader(status int) {
+	if r.status == 0 {
+		r.status = status
+	}
+}
+
+func (r *profileRecorder) Write(p []byte) (int, error) {
+	r.WriteHeader(http.StatusOK)
+	return r.body.Write(p)
+}
+
+// writeProfile runs the kind's pprof handler with query and writes the
+// result to path, returning its size
+func writeProfile(kind string, query url.Values, path string) (int, error) {
+	req, err := http.NewRequest("GET", "/debug/pprof/"+kind+"?"+query.Encode(), nil)
+	if err != nil {
+		return 0, err
+	}
+	rec := &profileRecorder{header: http.Header{}}
+	profileHandlers[kind].ServeHTTP(rec, req)
+	if rec.status != http.StatusOK {
+		return 0, fmt.Errorf("%s profile failed: %s", kind, strings.TrimSpace(rec.body.String()))
+	}
+	// Replace rather than follow whatever is already at path: the socket
+	// directory is often the shared temp dir, where it could be a symlink
+	os.Remove(path)
+	f, err := os.OpenFile(path, os.O_WRONLY|os.O_CREATE|os.O_EXCL, 0600)
+	if err != nil {
+		return 0, err
+	}
+	_, err = f.Write(rec.body.Bytes())
+	if closeErr := f.Close(); err == nil {
+		err = closeErr
+	}
+	if err != nil {
+		return 0, err
+	}
+	return rec.body.Len(), nil
+}
+
+// handleCaptureProfile records a CPU, heap or mutex profile to a file in the
+// background and reports it with a profileWritten event
+func (b *Bridge) handleCaptureProfile(msg Message) Response {
+	kind, _ := msg.Payload["kind"].(string)
+	if kind == "" {
+		kind = "cpu"
+	}
+	if _, ok := profileHandlers[kind]; !ok {
+		return Response{
+			ID:      msg.ID,
+			Success: false,
+			Error:   fmt.Sprintf("Unknown profile kind %q (expected cpu, heap or mutex)", kind),
+		}
+	}
+
+	seconds := int(toFloat64(msg.Payload["seconds"]))
+	if seconds <= 0 && kind != "heap" {
+		seconds = defaultProfileSeconds
+	}
+	if seconds > maxProfileSeconds {
+		seconds = maxProfileSeconds
+	}
+	query := url.Values{}
+	if seconds > 0 {
+		query.Set("seconds", strconv.Itoa(seconds))
+	} else {
+		// Heap snapshot: collect first so it shows live objects only
+		query.Set("gc", "1")
+	}
+
+	name, _ := msg.Payload["path"].(string)
+	if name == "" {
+		name = fmt.Sprintf("tsyne-%d-%s-%s.pprof", os.Getpid(), kind, time.Now().Format("20060102-150405"))
+	} else if strings.ContainsAny(name, `/\`) || name == "." || name == ".." {
+		return Response{
+			ID:      msg.ID,
+			Success: false,
+			Error:   fmt.Sprintf("Profile path %q must be a file name; profiles are written to the socket directory", name),
+		}
+	}
+	path := filepath.Join(bridgeSocketDir(), name)
+
+	go func() {
+		data := map[string]interface{}{"kind": kind, "path": path}
+		if size, err := writeProfile(kind, query, path); err != nil {
+			log.Printf("[pprof] %v", err)
+			data["error"] = err.Error()
+		} else {
+			log.Printf("[pprof] Wrote %s profile to %s (%d bytes)", kind, path, size)
+			data["bytes"] = size
+		}
+		b.sendEvent(Event{Type: "profileWritten", Data: data})
+	}()
+
+	return Response{
+		ID:      msg.ID,
+		Success: true,
+		Result:  map[string]interface{}{"kind": kind, "path": path, "seconds": seconds},
+	}
+}
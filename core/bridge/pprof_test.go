@@ -0,0 +1,111 @@
+package main
+
+import (
+	"context"
+	"io"
+	"net"
+	"net/http"
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+)
+
+// TestCaptureHeapProfile writes a heap snapshot and reports it with an event
+func TestCaptureHeapProfile(t *testing.T) {
+	events := make(chan Event, 1)
+	bridge := &Bridge{}
+	bridge.SetEventCallback(func(e Event) { events <- e })
+	dir := t.TempDir()
+	prevDir := socketDirOverride
+	socketDirOverride = dir
+	defer func() { socketDirOverride = prevDir }()
+
+	path := filepath.Join(dir, "heap.pprof")
+	resp := bridge.handleCaptureProfile(Message{
+		ID:      "prof_1",
+		Type:    "captureProfile",
+		Payload: map[string]interface{}{"kind": "heap", "path": "heap.pprof"},
+	})
+	if !resp.Success {
+		t.Fatalf("captureProfile failed: %s", resp.Error)
+	}
+
+	select {
+	case e := <-events:
+		if e.Type != "profileWritten" || e.Data["path"] != path || e.Data["error"] != nil {
+			t.Fatalf("event = %+v", e)
+		}
+	case <-time.After(5 * time.Second):
+		t.Fatal("no profileWritten event")
+	}
+	data, err := os.ReadFile(path)
+	if err != nil {
+		t.Fatal(err)
+	}
+	// pprof protos are gzipped
+	if len(data) < 2 || data[0] != 0x1f || data[1] != 0x8b {
+		t.Errorf("profile is not gzip data (%d bytes)", len(data))
+	}
+}
+
+// TestCaptureProfileRejectsPaths only accepts a file name in the socket directory
+func TestCaptureProfileRejectsPaths(t *testing.T) {
+	bridge := &Bridge{}
+	for _, path := range []string{"/tmp/cpu.pprof", "../cpu.pprof", "sub/cpu.pprof", `..\cpu.pprof`, "..", "."} {
+		resp := bridge.handleCaptureProfile(Message{
+			ID:      "prof_1",
+			Type:    "captureProfile",
+			Payload: map[string]interface{}{"kind": "heap", "path": path},
+		})
+		if resp.Success {
+			t.Errorf("path %q was accepted", path)
+		}
+	}
+}
+
+// TestCaptureProfileUnknownKind rejects kinds other than cpu, heap and mutex
+func TestCaptureProfileUnknownKind(t *testing.T) {
+	bridge := &Bridge{}
+	resp := bridge.handleCaptureProfile(Message{
+		ID:      "prof_1",
+		Type:    "captureProfile",
+		Payload: map[string]interface{}{"kind": "goroutines"},
+	})
+	if resp.Success {
+		t.Error("expected an error for an unknown kind")
+	}
+}
+
+// TestPprofServer serves profiles over its Unix socket
+func TestPprofServer(t *testing.T) {
+	// os.TempDir rather than t.TempDir keeps the path under the socket length limit
+	server, err := startPprofServer(os.TempDir())
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer server.Close()
+
+	client := &http.Client{Transport: &http.Transport{
+		DialContext: func(ctx context.Context, _, _ string) (net.Conn, error) {
+			return (&net.Dialer{}).DialContext(ctx, "unix", server.socketPath)
+		},
+	}}
+	resp, err := client.Get("http://tsyne/debug/pprof/heap")
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer resp.Body.Close()
+	body, _ := io.ReadAll(resp.Body)
+	if resp.StatusCode != http.StatusOK || len(body) == 0 {
+		t.Errorf("status %d, %d bytes", resp.StatusCode, len(body))
+	}
+
+	info, err := os.Stat(server.socketPath)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if info.Mode().Perm()&0077 != 0 {
+		t.Errorf("socket mode = %v, want owner-only", info.Mode().Perm())
+	}
+}
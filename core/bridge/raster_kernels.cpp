@@ -0,0 +1,382 @@
+// raster_kernels.cpp - Native software rasterizer kernels
+//
+// Scalar reference implementation of the kernels declared in raster_kernels.h.
+// Every primitive is reduced to row spans and funnels through blendSpan() /
+// storeSpan(), which walk contiguous memory with a constant source color and
+// no per-pixel bounds checks. Those two functions are the seam for SSE2/NEON
+// specializations; everything above them only does clipping and edge setup.
+
+#include "raster_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+inline int clampByte(int v) {
+    return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+// Math.round() semantics for non-negative values.
+inline int roundPos(float v) {
+    return static_cast<int>(v + 0.5f);
+}
+
+// Blend n pixels starting at row with a constant color.
+inline void blendSpan(uint8_t* row, int n, int r, int g, int b, int a) {
+    if (a <= 0 || n <= 0) {
+        return;
+    }
+    const float alpha = a / 255.0f;
+    const float inv = 1.0f - alpha;
+    const float sr = r * alpha;
+    const float sg = g * alpha;
+    const float sb = b * alpha;
+    for (int i = 0; i < n; i++) {
+        uint8_t* p = row + i * 4;
+        p[0] = static_cast<uint8_t>(roundPos(p[0] * inv + sr));
+        p[1] = static_cast<uint8_t>(roundPos(p[1] * inv + sg));
+        p[2] = static_cast<uint8_t>(roundPos(p[2] * inv + sb));
+        const int da = p[3] + a;
+        p[3] = static_cast<uint8_t>(da > 255 ? 255 : da);
+    }
+}
+
+// Overwrite n pixels starting at row with a constant color.
+inline void storeSpan(uint8_t* row, int n, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    for (int i = 0; i < n; i++) {
+        uint8_t* p = row + i * 4;
+        p[0] = r;
+        p[1] = g;
+        p[2] = b;
+        p[3] = a;
+    }
+}
+
+// Blend a single pixel with per-pixel alpha (edges, blits).
+inline void blendOne(uint8_t* p, int r, int g, int b, int a) {
+    if (a <= 0) {
+        return;
+    }
+    const float alpha = a / 255.0f;
+    const float inv = 1.0f - alpha;
+    p[0] = static_cast<uint8_t>(roundPos(p[0] * inv + r * alpha));
+    p[1] = static_cast<uint8_t>(roundPos(p[1] * inv + g * alpha));
+    p[2] = static_cast<uint8_t>(roundPos(p[2] * inv + b * alpha));
+    const int da = p[3] + a;
+    p[3] = static_cast<uint8_t>(da > 255 ? 255 : da);
+}
+
+inline bool validTarget(const uint8_t* pixels, int width, int height) {
+    return pixels != nullptr && width > 0 && height > 0;
+}
+
+} // namespace
+
+extern "C" {
+
+int TsyneRasterVersion(void) {
+    return TSYNE_RASTER_ABI_VERSION;
+}
+
+const char* TsyneRasterBackend(void) {
+    return "scalar";
+}
+
+void TsyneRasterClear(uint8_t* pixels, int width, int height, int r, int g, int b, int a) {
+    if (!validTarget(pixels, width, height)) {
+        return;
+    }
+    storeSpan(pixels, width * height,
+              static_cast<uint8_t>(clampByte(r)), static_cast<uint8_t>(clampByte(g)),
+              static_cast<uint8_t>(clampByte(b)), static_cast<uint8_t>(clampByte(a)));
+}
+
+void TsyneRasterFillSpan(uint8_t* pixels, int width, int height,
+                         int y, int x0, int x1, int r, int g, int b, int a) {
+    if (!validTarget(pixels, width, height) || y < 0 || y >= height) {
+        return;
+    }
+    if (x0 > x1) {
+        std::swap(x0, x1);
+    }
+    x0 = std::max(0, x0);
+    x1 = std::min(width - 1, x1);
+    if (x0 > x1) {
+        return;
+    }
+    blendSpan(pixels + (static_cast<size_t>(y) * width + x0) * 4, x1 - x0 + 1,
+              clampByte(r), clampByte(g), clampByte(b), clampByte(a));
+}
+
+void TsyneRasterFillRect(uint8_t* pixels, int width, int height,
+                         float x, float y, float w, float h, int r, int g, int b, int a) {
+    if (!validTarget(pixels, width, height)) {
+        return;
+    }
+    const int x1 = std::max(0, static_cast<int>(std::floor(x)));
+    const int y1 = std::max(0, static_cast<int>(std::floor(y)));
+    const int x2 = std::min(width, static_cast<int>(std::ceil(x + w)));
+    const int y2 = std::min(height, static_cast<int>(std::ceil(y + h)));
+    if (x1 >= x2) {
+        return;
+    }
+    r = clampByte(r);
+    g = clampByte(g);
+    b = clampByte(b);
+    a = clampByte(a);
+    for (int py = y1; py < y2; py++) {
+        blendSpan(pixels + (static_cast<size_t>(py) * width + x1) * 4, x2 - x1, r, g, b, a);
+    }
+}
+
+void TsyneRasterFillCircle(uint8_t* pixels, int width, int height,
+                           float cx, float cy, float radius, int r, int g, int b, int a) {
+    if (!validTarget(pixels, width, height) || radius <= 0) {
+        return;
+    }
+    r = clampByte(r);
+    g = clampByte(g);
+    b = clampByte(b);
+    a = clampByte(a);
+
+    const float r2 = radius * radius;
+    const int minY = std::max(0, static_cast<int>(std::floor(cy - radius)));
+    const int maxY = std::min(height - 1, static_cast<int>(std::ceil(cy + radius)));
+    const int minX = std::max(0, static_cast<int>(std::floor(cx - radius)));
+    const int maxX = std::min(width - 1, static_cast<int>(std::ceil(cx + radius)));
+    // Pixels this far inside the edge are fully covered.
+    const float inner = radius - 1.0f;
+    const float inner2 = inner > 0 ? inner * inner : -1.0f;
+
+    for (int y = minY; y <= maxY; y++) {
+        const float dy = y - cy;
+        const float dy2 = dy * dy;
+        if (dy2 > r2) {
+            continue;
+        }
+        uint8_t* row = pixels + static_cast<size_t>(y) * width * 4;
+
+        // Solid interior span, anti-aliased pixels on either side.
+        int spanStart = maxX + 1;
+        int spanEnd = minX - 1;
+        if (inner2 >= 0 && dy2 < inner2) {
+            const float half = std::sqrt(inner2 - dy2);
+            spanStart = std::max(minX, static_cast<int>(std::ceil(cx - half)));
+            spanEnd = std::min(maxX, static_cast<int>(std::floor(cx + half)));
+            // Boundary pixels are re-tested below so the split matches the JS reference.
+            while (spanStart <= spanEnd) {
+                const float ddx = spanStart - cx;
+                if (radius - std::sqrt(ddx * ddx + dy2) >= 1.0f) break;
+                spanStart++;
+            }
+            while (spanEnd >= spanStart) {
+                const float ddx = spanEnd - cx;
+                if (radius - std::sqrt(ddx * ddx + dy2) >= 1.0f) break;
+                spanEnd--;
+            }
+            if (spanStart <= spanEnd) {
+                blendSpan(row + spanStart * 4, spanEnd - spanStart + 1, r, g, b, a);
+            }
+        }
+
+        for (int x = minX; x <= maxX; x++) {
+            if (x >= spanStart && x <= spanEnd) {
+                x = spanEnd;
+                continue;
+            }
+            const float dx = x - cx;
+            const float d2 = dx * dx + dy2;
+            if (d2 > r2) {
+                continue;
+            }
+            const float edgeDist = radius - std::sqrt(d2);
+            const int pa = edgeDist < 1.0f ? roundPos(a * edgeDist) : a;
+            blendOne(row + x * 4, r, g, b, pa);
+        }
+    }
+}
+
+void TsyneRasterFillCircles(uint8_t* pixels, int width, int height,
+                            const float* xyr, const uint32_t* rgba, int count) {
+    if (!validTarget(pixels, width, height) || xyr == nullptr || rgba == nullptr) {
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        const uint32_t c = rgba[i];
+        const int a = static_cast<int>(c >> 24);
+        if (a == 0) {
+            continue;
+        }
+        TsyneRasterFillCircle(pixels, width, height, xyr[i * 3], xyr[i * 3 + 1], xyr[i * 3 + 2],
+                              static_cast<int>(c & 255), static_cast<int>((c >> 8) & 255),
+                              static_cast<int>((c >> 16) & 255), a);
+    }
+}
+
+void TsyneRasterFillPolygon(uint8_t* pixels, int width, int height,
+                            const float* xy, int count, int r, int g, int b, int a) {
+    if (!validTarget(pixels, width, height) || xy == nullptr || count < 3) {
+        return;
+    }
+    r = clampByte(r);
+    g = clampByte(g);
+    b = clampByte(b);
+    a = clampByte(a);
+
+    float minYf = xy[1];
+    float maxYf = xy[1];
+    for (int i = 1; i < count; i++) {
+        minYf = std::min(minYf, xy[i * 2 + 1]);
+        maxYf = std::max(maxYf, xy[i * 2 + 1]);
+    }
+    const int minY = std::max(0, static_cast<int>(std::floor(minYf)));
+    const int maxY = std::min(height - 1, static_cast<int>(std::ceil(maxYf)));
+
+    // Small polygons (quads, cylinder caps) stay on the stack.
+    float stackHits[64];
+    std::vector<float> heapHits;
+    float* hits = stackHits;
+    if (count > 64) {
+        heapHits.resize(count);
+        hits = heapHits.data();
+    }
+
+    for (int y = minY; y <= maxY; y++) {
+        const float fy = static_cast<float>(y);
+        int n = 0;
+        for (int i = 0; i < count; i++) {
+            const int j = (i + 1) % count;
+            const float x1 = xy[i * 2], y1 = xy[i * 2 + 1];
+            const float x2 = xy[j * 2], y2 = xy[j * 2 + 1];
+            if ((y1 <= fy && y2 > fy) || (y2 <= fy && y1 > fy)) {
+                hits[n++] = x1 + (fy - y1) / (y2 - y1) * (x2 - x1);
+            }
+        }
+        std::sort(hits, hits + n);
+
+        uint8_t* row = pixels + static_cast<size_t>(y) * width * 4;
+        for (int i = 0; i + 1 < n; i += 2) {
+            const int xa = std::max(0, static_cast<int>(std::floor(hits[i])));
+            const int xb = std::min(width - 1, static_cast<int>(std::ceil(hits[i + 1])));
+            if (xa <= xb) {
+                blendSpan(row + xa * 4, xb - xa + 1, r, g, b, a);
+            }
+        }
+    }
+}
+
+void TsyneRasterStrokePolyline(uint8_t* pixels, int width, int height,
+                               const float* xy, int count, float lineWidth,
+                               int r, int g, int b, int a) {
+    if (!validTarget(pixels, width, height) || xy == nullptr || count < 2 || lineWidth <= 0) {
+        return;
+    }
+    const float half = lineWidth / 2.0f;
+    float quad[8];
+    for (int i = 0; i + 1 < count; i++) {
+        const float x0 = xy[i * 2], y0 = xy[i * 2 + 1];
+        const float x1 = xy[i * 2 + 2], y1 = xy[i * 2 + 3];
+        const float dx = x1 - x0;
+        const float dy = y1 - y0;
+        const float len = std::sqrt(dx * dx + dy * dy);
+        if (len == 0.0f) {
+            continue;
+        }
+        const float nx = -dy / len * half;
+        const float ny = dx / len * half;
+        quad[0] = x0 + nx; quad[1] = y0 + ny;
+        quad[2] = x1 + nx; quad[3] = y1 + ny;
+        quad[4] = x1 - nx; quad[5] = y1 - ny;
+        quad[6] = x0 - nx; quad[7] = y0 - ny;
+        TsyneRasterFillPolygon(pixels, width, height, quad, 4, r, g, b, a);
+    }
+}
+
+void TsyneRasterTexturedColumn(uint8_t* pixels, int width, int height,
+                               int x, int yStart, int yEnd,
+                               const uint8_t* texture, int texWidth, int texHeight,
+                               float u, float vStart, float vStep,
+                               int r, int g, int b,
+                               float shade, float fogFactor,
+                               int fogR, int fogG, int fogB) {
+    if (!validTarget(pixels, width, height) || x < 0 || x >= width) {
+        return;
+    }
+    const int y0 = std::max(0, yStart);
+    const int y1 = std::min(height - 1, yEnd);
+    if (y0 > y1) {
+        return;
+    }
+    const bool textured = texture != nullptr && texWidth > 0 && texHeight > 0;
+
+    int texX = 0;
+    if (textured) {
+        const float cu = std::min(1.0f, std::max(0.0f, u));
+        texX = std::min(static_cast<int>(std::floor(cu * texWidth)), texWidth - 1);
+    }
+
+    const size_t stride = static_cast<size_t>(width) * 4;
+    uint8_t* p = pixels + static_cast<size_t>(y0) * stride + static_cast<size_t>(x) * 4;
+    float v = vStart + (y0 - yStart) * vStep;
+
+    for (int y = y0; y <= y1; y++, p += stride, v += vStep) {
+        int sr = r, sg = g, sb = b;
+        if (textured) {
+            const float cv = std::min(1.0f, std::max(0.0f, v));
+            const int texY = std::min(static_cast<int>(std::floor(cv * texHeight)), texHeight - 1);
+            const uint8_t* t = texture + (static_cast<size_t>(texY) * texWidth + texX) * 4;
+            sr = t[0];
+            sg = t[1];
+            sb = t[2];
+        }
+        sr = static_cast<int>(std::floor(sr * shade));
+        sg = static_cast<int>(std::floor(sg * shade));
+        sb = static_cast<int>(std::floor(sb * shade));
+        if (fogFactor > 0) {
+            sr = static_cast<int>(std::floor(sr + (fogR - sr) * fogFactor));
+            sg = static_cast<int>(std::floor(sg + (fogG - sg) * fogFactor));
+            sb = static_cast<int>(std::floor(sb + (fogB - sb) * fogFactor));
+        }
+        p[0] = static_cast<uint8_t>(clampByte(sr));
+        p[1] = static_cast<uint8_t>(clampByte(sg));
+        p[2] = static_cast<uint8_t>(clampByte(sb));
+        p[3] = 255;
+    }
+}
+
+void TsyneRasterBlit(uint8_t* pixels, int width, int height,
+                     const uint8_t* src, int srcWidth, int srcHeight,
+                     float dx, float dy, float dw, float dh) {
+    if (!validTarget(pixels, width, height) || src == nullptr || srcWidth <= 0 || srcHeight <= 0 ||
+        dw <= 0 || dh <= 0) {
+        return;
+    }
+    const float scaleX = srcWidth / dw;
+    const float scaleY = srcHeight / dh;
+
+    for (int y = 0; y < dh; y++) {
+        const int destY = static_cast<int>(std::floor(dy + y + 0.5f));
+        if (destY < 0 || destY >= height) {
+            continue;
+        }
+        const int srcY = std::min(srcHeight - 1, static_cast<int>(std::floor(y * scaleY)));
+        const uint8_t* srcRow = src + static_cast<size_t>(srcY) * srcWidth * 4;
+        uint8_t* dstRow = pixels + static_cast<size_t>(destY) * width * 4;
+
+        for (int x = 0; x < dw; x++) {
+            const int destX = static_cast<int>(std::floor(dx + x + 0.5f));
+            if (destX < 0 || destX >= width) {
+                continue;
+            }
+            const int srcX = std::min(srcWidth - 1, static_cast<int>(std::floor(x * scaleX)));
+            const uint8_t* s = srcRow + srcX * 4;
+            if (s[3] > 0) {
+                blendOne(dstRow + destX * 4, s[0], s[1], s[2], s[3]);
+            }
+        }
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,83 @@
+package main
+
+/*
+#cgo CXXFLAGS: -O3 -std=c++11
+#include "raster_kernels.h"
+*/
+import "C"
+
+import "unsafe"
+
+// ============================================================================
+// Native Raster Kernels
+// ============================================================================
+//
+// raster_kernels.cpp is compiled into the bridge by cgo. The C ABI is exported
+// from libtsyne.so for the TypeScript side (core/src/graphics/native-raster.ts);
+// these wrappers let bridge-resident widgets draw into their own RGBA buffers
+// with the same kernels.
+
+// nativeRasterInfo reports the kernel ABI version and active backend.
+func nativeRasterInfo() map[string]interface{} {
+	return map[string]interface{}{
+		"version": int(C.TsyneRasterVersion()),
+		"backend": C.GoString(C.TsyneRasterBackend()),
+	}
+}
+
+func rasterPixels(buf []byte) *C.uint8_t {
+	if len(buf) == 0 {
+		return nil
+	}
+	return (*C.uint8_t)(unsafe.Pointer(&buf[0]))
+}
+
+// rasterClear overwrites an RGBA buffer with a solid color.
+func rasterClear(buf []byte, width, height int, r, g, b, a uint8) {
+	if len(buf) < width*height*4 {
+		return
+	}
+	C.TsyneRasterClear(rasterPixels(buf), C.int(width), C.int(height),
+		C.int(r), C.int(g), C.int(b), C.int(a))
+}
+
+// rasterFillCircles blends a batch of circles: xyr holds cx, cy, radius per
+// circle and rgba one packed color each (r in the low byte).
+func rasterFillCircles(buf []byte, width, height int, xyr []float32, rgba []uint32) {
+	n := len(rgba)
+	if len(buf) < width*height*4 || n == 0 || len(xyr) < n*3 {
+		return
+	}
+	C.TsyneRasterFillCircles(rasterPixels(buf), C.int(width), C.int(height),
+		(*C.float)(unsafe.Pointer(&xyr[0])), (*C.uint32_t)(unsafe.Pointer(&rgba[0])), C.int(n))
+}
+
+// rasterFillPolygon blends a filled polygon given interleaved x,y vertices.
+func rasterFillPolygon(buf []byte, width, height int, xy []float32, r, g, b, a uint8) {
+	if len(buf) < width*height*4 || len(xy) < 6 {
+		return
+	}
+	C.TsyneRasterFillPolygon(rasterPixels(buf), C.int(width), C.int(height),
+		(*C.float)(unsafe.Pointer(&xy[0])), C.int(len(xy)/2),
+		C.int(r), C.int(g), C.int(b), C.int(a))
+}
+
+// rasterBlit blends an RGBA image into the buffer, scaled to dw x dh.
+func rasterBlit(buf []byte, width, height int, src []byte, srcWidth, srcHeight int, dx, dy, dw, dh float32) {
+	if len(buf) < width*height*4 || len(src) < srcWidth*srcHeight*4 {
+		return
+	}
+	C.TsyneRasterBlit(rasterPixels(buf), C.int(width), C.int(height),
+		rasterPixels(src), C.int(srcWidth), C.int(srcHeight),
+		C.float(dx), C.float(dy), C.float(dw), C.float(dh))
+}
+
+// rasterStrokePolyline blends a polyline given interleaved x,y vertices.
+func rasterStrokePolyline(buf []byte, width, height int, xy []float32, lineWidth float32, r, g, b, a uint8) {
+	if len(buf) < width*height*4 || len(xy) < 4 {
+		return
+	}
+	C.TsyneRasterStrokePolyline(rasterPixels(buf), C.int(width), C.int(height),
+		(*C.float)(unsafe.Pointer(&xy[0])), C.int(len(xy)/2), C.float(lineWidth),
+		C.int(r), C.int(g), C.int(b), C.int(a))
+}
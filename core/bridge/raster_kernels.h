@@ -0,0 +1,96 @@
+// raster_kernels.h - Native software rasterizer kernels (C ABI)
+//
+// These kernels operate on caller-owned RGBA8 buffers (width * height * 4
+// bytes, row-major, no padding). They are compiled into libtsyne.so by cgo
+// alongside the Go exports in libtsyne-bridge.h, so the TypeScript side can
+// call them over FFI (koffi) on the same Uint8Array it later ships to a
+// raster widget, and the Go side can call them on its own pixel buffers.
+//
+// Blending matches core/src/graphics/platform.ts blendPixel():
+//   dst.rgb = round(dst.rgb * (1 - a/255) + src.rgb * a/255)
+//   dst.a   = min(255, dst.a + a)
+
+#ifndef TSYNE_RASTER_KERNELS_H
+#define TSYNE_RASTER_KERNELS_H
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define TSYNE_RASTER_API __declspec(dllexport)
+#else
+#define TSYNE_RASTER_API __attribute__((visibility("default")))
+#endif
+
+// Bumped whenever a kernel signature changes.
+#define TSYNE_RASTER_ABI_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returns TSYNE_RASTER_ABI_VERSION.
+TSYNE_RASTER_API int TsyneRasterVersion(void);
+
+// Returns a short description of the active code path ("scalar", "sse2", "neon").
+TSYNE_RASTER_API const char* TsyneRasterBackend(void);
+
+// Overwrite every pixel with a solid color (no blending).
+TSYNE_RASTER_API void TsyneRasterClear(uint8_t* pixels, int width, int height,
+                                       int r, int g, int b, int a);
+
+// Blend a horizontal span [x0, x1] (inclusive) on row y.
+TSYNE_RASTER_API void TsyneRasterFillSpan(uint8_t* pixels, int width, int height,
+                                          int y, int x0, int x1,
+                                          int r, int g, int b, int a);
+
+// Blend an axis-aligned rectangle. Same rounding as rasterizer.ts fillRect().
+TSYNE_RASTER_API void TsyneRasterFillRect(uint8_t* pixels, int width, int height,
+                                          float x, float y, float w, float h,
+                                          int r, int g, int b, int a);
+
+// Blend a filled circle with a one-pixel anti-aliased edge.
+TSYNE_RASTER_API void TsyneRasterFillCircle(uint8_t* pixels, int width, int height,
+                                            float cx, float cy, float radius,
+                                            int r, int g, int b, int a);
+
+// Blend count circles in one call (particle systems).
+// xyr holds cx, cy, radius per circle; rgba holds one packed color per circle
+// with r in the low byte and alpha in the high byte.
+TSYNE_RASTER_API void TsyneRasterFillCircles(uint8_t* pixels, int width, int height,
+                                             const float* xyr, const uint32_t* rgba, int count);
+
+// Blend a filled polygon (even-odd scanline fill).
+// xy holds count interleaved vertices: x0, y0, x1, y1, ...
+TSYNE_RASTER_API void TsyneRasterFillPolygon(uint8_t* pixels, int width, int height,
+                                             const float* xy, int count,
+                                             int r, int g, int b, int a);
+
+// Blend a polyline of count points as lineWidth-wide quads, one per segment.
+// xy holds interleaved vertices like TsyneRasterFillPolygon.
+TSYNE_RASTER_API void TsyneRasterStrokePolyline(uint8_t* pixels, int width, int height,
+                                                const float* xy, int count, float lineWidth,
+                                                int r, int g, int b, int a);
+
+// Draw one opaque textured wall column (raycaster stripe).
+// Rows yStart..yEnd (inclusive) sample texture column u (0-1) with
+// v = vStart + (y - yStart) * vStep, multiply by shade, then mix toward the
+// fog color by fogFactor (0-1). A NULL texture draws the solid color r,g,b.
+TSYNE_RASTER_API void TsyneRasterTexturedColumn(uint8_t* pixels, int width, int height,
+                                                int x, int yStart, int yEnd,
+                                                const uint8_t* texture, int texWidth, int texHeight,
+                                                float u, float vStart, float vStep,
+                                                int r, int g, int b,
+                                                float shade, float fogFactor,
+                                                int fogR, int fogG, int fogB);
+
+// Blend an RGBA image onto the target, scaled to dw x dh with nearest sampling.
+// Same sampling as rasterizer.ts drawImage().
+TSYNE_RASTER_API void TsyneRasterBlit(uint8_t* pixels, int width, int height,
+                                      const uint8_t* src, int srcWidth, int srcHeight,
+                                      float dx, float dy, float dw, float dh);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TSYNE_RASTER_KERNELS_H
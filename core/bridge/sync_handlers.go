@@ -143,7 +143,7 @@ func (b *Bridge) GetTextSync(widgetID string) GetTextResult {
 	// If we have a separate entry reference, use that
 	if hasEntry {
 		if entry, ok := entryObj.(*widget.Entry); ok {
-			fyne.DoAndWait(func() {
+			fyneDoAndWait(func() {
 				text = entry.Text
 			})
 			return GetTextResult{
@@ -153,7 +153,7 @@ func (b *Bridge) GetTextSync(widgetID string) GetTextResult {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		switch w := obj.(type) {
 		case *widget.Entry:
 			text = w.Text
@@ -202,7 +202,7 @@ func (b *Bridge) GetCheckedSync(widgetID string) GetCheckedResult {
 	var checked bool
 	var found bool
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		if checkbox, ok := obj.(*widget.Check); ok {
 			checked = checkbox.Checked
 			found = true
@@ -245,7 +245,7 @@ func (b *Bridge) GetProgressSync(widgetID string) GetProgressResult {
 	var value float64
 	var found bool
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		if progress, ok := obj.(*widget.ProgressBar); ok {
 			value = progress.Value
 			found = true
@@ -305,7 +305,7 @@ func (b *Bridge) GetWidgetInfoSync(widgetID string) WidgetInfoResult {
 		result.Text = meta.Text
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		pos := obj.Position()
 		size := obj.Size()
 		absPos := b.app.Driver().AbsolutePositionForObject(obj)
@@ -365,7 +365,7 @@ func (b *Bridge) GetAllWidgetsSync() AllWidgetsResult {
 
 	widgets := make([]map[string]interface{}, 0, len(widgetList))
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		for _, wd := range widgetList {
 			widgetInfo := map[string]interface{}{
 				"id":   wd.id,
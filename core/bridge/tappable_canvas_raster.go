@@ -96,7 +96,7 @@ func (t *TappableCanvasRaster) generateImage(w, h int) image.Image {
 func (t *TappableCanvasRaster) SetPixels(pixels []byte) {
 	if len(pixels) == len(t.pixelBuffer) {
 		copy(t.pixelBuffer, pixels)
-		fyne.Do(func() {
+		fyneDo(func() {
 			t.raster.Refresh()
 		})
 	}
@@ -142,7 +142,7 @@ func (t *TappableCanvasRaster) SetPixelRect(x, y, rectWidth, rectHeight int, pix
 		copy(t.pixelBuffer[destOffset:destOffset+copyLen], pixels[srcOffset+srcStartOffset:srcOffset+srcStartOffset+copyLen])
 	}
 
-	fyne.Do(func() {
+	fyneDo(func() {
 		t.raster.Refresh()
 	})
 }
@@ -151,7 +151,7 @@ func (t *TappableCanvasRaster) SetPixelRect(x, y, rectWidth, rectHeight int, pix
 // For setting many pixels, use SetPixelNoRefresh followed by Refresh().
 func (t *TappableCanvasRaster) SetPixel(x, y int, r, g, b, a uint8) {
 	t.SetPixelNoRefresh(x, y, r, g, b, a)
-	fyne.Do(func() {
+	fyneDo(func() {
 		t.raster.Refresh()
 	})
 }
@@ -172,7 +172,7 @@ func (t *TappableCanvasRaster) SetPixelNoRefresh(x, y int, r, g, b, a uint8) {
 
 // RefreshCanvas triggers a visual refresh of the canvas.
 func (t *TappableCanvasRaster) RefreshCanvas() {
-	fyne.Do(func() {
+	fyneDo(func() {
 		t.raster.Refresh()
 	})
 }
@@ -193,7 +193,7 @@ func (t *TappableCanvasRaster) ResizeBuffer(width, height int) {
 		t.pixelBuffer[i+3] = 0 // A (transparent)
 	}
 
-	fyne.Do(func() {
+	fyneDo(func() {
 		t.raster.Refresh()
 		t.Refresh()
 	})
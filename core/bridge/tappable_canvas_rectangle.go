@@ -58,7 +58,7 @@ func (t *TappableCanvasRectangle) MinSize() fyne.Size {
 // SetFillColor sets the fill color of the rectangle.
 func (t *TappableCanvasRectangle) SetFillColor(c color.Color) {
 	t.rect.FillColor = c
-	fyne.Do(func() {
+	fyneDo(func() {
 		t.rect.Refresh()
 	})
 }
@@ -66,7 +66,7 @@ func (t *TappableCanvasRectangle) SetFillColor(c color.Color) {
 // SetStrokeColor sets the stroke color of the rectangle.
 func (t *TappableCanvasRectangle) SetStrokeColor(c color.Color) {
 	t.rect.StrokeColor = c
-	fyne.Do(func() {
+	fyneDo(func() {
 		t.rect.Refresh()
 	})
 }
@@ -74,7 +74,7 @@ func (t *TappableCanvasRectangle) SetStrokeColor(c color.Color) {
 // SetStrokeWidth sets the stroke width of the rectangle.
 func (t *TappableCanvasRectangle) SetStrokeWidth(w float32) {
 	t.rect.StrokeWidth = w
-	fyne.Do(func() {
+	fyneDo(func() {
 		t.rect.Refresh()
 	})
 }
@@ -82,7 +82,7 @@ func (t *TappableCanvasRectangle) SetStrokeWidth(w float32) {
 // SetCornerRadius sets the corner radius of the rectangle.
 func (t *TappableCanvasRectangle) SetCornerRadius(r float32) {
 	t.rect.CornerRadius = r
-	fyne.Do(func() {
+	fyneDo(func() {
 		t.rect.Refresh()
 	})
 }
@@ -0,0 +1,217 @@
+package main
+
+import (
+	"bytes"
+	"log"
+	"os"
+	"runtime"
+	"strconv"
+	"sync"
+	"time"
+)
+
+// ============================================================================
+// Cross-Process Tracing
+// ============================================================================
+//
+// With TSYNE_TRACE set (the TypeScript side sets the same variable and the
+// bridge inherits it), every message is broken into spans: decode, handler,
+// fyne.Do queue wait and run on the main thread, and response write. Spans
+// carry the message ID and go into a fixed-size ring buffer. The TypeScript
+// side fetches them with getTraceEvents and merges them with its own spans
+// (send, transport write, resolve) into one Chrome/Perfetto trace.
+// Timestamps are wall-clock microseconds since the Unix epoch, so both
+// processes share a timeline.
+
+// Trace lanes (Chrome trace "tid"); goroutines have no stable IDs
+const (
+	traceLaneIPC      = 1 // Message reader: decode, handler, response write
+	traceLaneMain     = 2 // Fyne main thread
+	traceLaneQueue    = 3 // Async fyne.Do calls waiting for the main thread
+	traceDefaultSpans = 65536
+)
+
+// traceSpan is one recorded interval
+type traceSpan struct {
+	name    string
+	cat     string
+	msgID   string
+	lane    int
+	async   bool // Overlapping waits are exported as async (b/e) events
+	startUs int64
+	durUs   int64
+}
+
+// spanTracer keeps the most recent spans in a ring buffer
+type spanTracer struct {
+	mu    sync.Mutex
+	ring  []traceSpan
+	next  int
+	total uint64
+	// Message each handler goroutine is working on, for fyne.Do spans. Keyed
+	// by goroutine because msgpack serves every connection concurrently.
+	current sync.Map // goroutine ID -> message ID
+}
+
+// bridgeTracer is nil unless TSYNE_TRACE is set
+var bridgeTracer *spanTracer
+
+// InitTracer enables tracing when TSYNE_TRACE is set. TSYNE_TRACE_SPANS
+// overrides the ring buffer size.
+func InitTracer() {
+	if os.Getenv("TSYNE_TRACE") == "" {
+		return
+	}
+	size := traceDefaultSpans
+	if n, err := strconv.Atoi(os.Getenv("TSYNE_TRACE_SPANS")); err == nil && n > 0 {
+		size = n
+	}
+	bridgeTracer = &spanTracer{ring: make([]traceSpan, size)}
+	log.Printf("[trace] Tracing ENABLED (%d span buffer)", size)
+}
+
+// record stores a span from start to end
+func (t *spanTracer) record(name, cat, msgID string, lane int, async bool, start, end time.Time) {
+	span := traceSpan{
+		name:    name,
+		cat:     cat,
+		msgID:   msgID,
+		lane:    lane,
+		async:   async,
+		startUs: start.UnixMicro(),
+		durUs:   end.Sub(start).Microseconds(),
+	}
+	t.mu.Lock()
+	t.ring[t.next] = span
+	t.next = (t.next + 1) % len(t.ring)
+	t.total++
+	t.mu.Unlock()
+}
+
+// beginMessage marks msgID as the message the calling goroutine is handling.
+// Safe on a nil tracer.
+func (t *spanTracer) beginMessage(msgID string) {
+	if t != nil {
+		t.current.Store(goroutineID(), msgID)
+	}
+}
+
+// endMessage clears the calling goroutine's message. Safe on a nil tracer.
+func (t *spanTracer) endMessage() {
+	if t != nil {
+		t.current.Delete(goroutineID())
+	}
+}
+
+// currentMessage returns the message the calling goroutine is handling, if
+// any. Safe on a nil tracer.
+func (t *spanTracer) currentMessage() string {
+	if t == nil {
+		return ""
+	}
+	if id, ok := t.current.Load(goroutineID()); ok {
+		return id.(string)
+	}
+	return ""
+}
+
+// goroutineID parses the calling goroutine's ID from its stack header
+// ("goroutine 42 [running]:"). Costs about a microsecond, so it is only
+// called while tracing or main-thread timing is on.
+func goroutineID() uint64 {
+	var buf [64]byte
+	header := buf[:runtime.Stack(buf[:], false)]
+	header = bytes.TrimPrefix(header, []byte("goroutine "))
+	if i := bytes.IndexByte(header, ' '); i >= 0 {
+		header = header[:i]
+	}
+	id, _ := strconv.ParseUint(string(header), 10, 64)
+	return id
+}
+
+// traceSince records a span on the IPC lane from start to now. No-op when
+// tracing is off.
+func traceSince(name, msgID string, start time.Time) {
+	if bridgeTracer == nil {
+		return
+	}
+	bridgeTracer.record(name, "bridge", msgID, traceLaneIPC, false, start, time.Now())
+}
+
+// snapshot returns the buffered spans oldest first, and how many were
+// dropped because the ring wrapped
+func (t *spanTracer) snapshot() ([]traceSpan, uint64) {
+	t.mu.Lock()
+	defer t.mu.Unlock()
+	if t.total <= uint64(len(t.ring)) {
+		return append([]traceSpan(nil), t.ring[:t.next]...), 0
+	}
+	spans := make([]traceSpan, 0, len(t.ring))
+	spans = append(spans, t.ring[t.next:]...)
+	spans = append(spans, t.ring[:t.next]...)
+	return spans, t.total - uint64(len(t.ring))
+}
+
+// chromeEvents converts the buffered spans to Chrome trace events. Decode
+// spans end the "request" flow started by the TypeScript send span, and
+// respond spans start the "response" flow ended by its resolve span.
+func (t *spanTracer) chromeEvents() ([]map[string]interface{}, uint64) {
+	spans, dropped := t.snapshot()
+	pid := os.Getpid()
+	events := make([]map[string]interface{}, 0, len(spans)+8)
+
+	events = append(events,
+		map[string]interface{}{"name": "process_name", "ph": "M", "pid": pid, "args": map[string]interface{}{"name": "tsyne-bridge (Go)"}},
+		map[string]interface{}{"name": "thread_name", "ph": "M", "pid": pid, "tid": traceLaneIPC, "args": map[string]interface{}{"name": "IPC"}},
+		map[string]interface{}{"name": "thread_name", "ph": "M", "pid": pid, "tid": traceLaneMain, "args": map[string]interface{}{"name": "Fyne main thread"}},
+		map[string]interface{}{"name": "thread_name", "ph": "M", "pid": pid, "tid": traceLaneQueue, "args": map[string]interface{}{"name": "fyne.Do queue"}},
+	)
+
+	for i, s := range spans {
+		args := map[string]interface{}{}
+		if s.msgID != "" {
+			args["msgId"] = s.msgID
+		}
+		if s.async {
+			id := "q" + strconv.Itoa(i)
+			events = append(events,
+				map[string]interface{}{"name": s.name, "cat": s.cat, "ph": "b", "id": id, "ts": s.startUs, "pid": pid, "tid": s.lane, "args": args},
+				map[string]interface{}{"name": s.name, "cat": s.cat, "ph": "e", "id": id, "ts": s.startUs + s.durUs, "pid": pid, "tid": s.lane},
+			)
+			continue
+		}
+		events = append(events, map[string]interface{}{
+			"name": s.name, "cat": s.cat, "ph": "X", "ts": s.startUs, "dur": s.durUs, "pid": pid, "tid": s.lane, "args": args,
+		})
+		if s.msgID == "" {
+			continue
+		}
+		switch s.name {
+		case "decode":
+			events = append(events, map[string]interface{}{
+				"name": "request", "cat": "ipc", "ph": "f", "bp": "e", "id": "req:" + s.msgID, "ts": s.startUs, "pid": pid, "tid": s.lane,
+			})
+		case "respond":
+			events = append(events, map[string]interface{}{
+				"name": "response", "cat": "ipc", "ph": "s", "id": "resp:" + s.msgID, "ts": s.startUs, "pid": pid, "tid": s.lane,
+			})
+		}
+	}
+	return events, dropped
+}
+
+// handleGetTraceEvents returns the buffered spans as Chrome trace events
+func (b *Bridge) handleGetTraceEvents(msg Message) Response {
+	if bridgeTracer == nil {
+		return Response{ID: msg.ID, Success: false, Error: "Tracing is not enabled (set TSYNE_TRACE)"}
+	}
+	events, dropped := bridgeTracer.chromeEvents()
+	return Response{
+		ID:      msg.ID,
+		Success: true,
+		Result: map[string]interface{}{
+			"events":  events,
+			"dropped": dropped,
+		},
+	}
+}
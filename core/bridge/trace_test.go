@@ -0,0 +1,108 @@
+package main
+
+import (
+	"fmt"
+	"sync"
+	"testing"
+	"time"
+)
+
+// TestSpanTracerRingWraps keeps only the newest spans, oldest first
+func TestSpanTracerRingWraps(t *testing.T) {
+	tracer := &spanTracer{ring: make([]traceSpan, 4)}
+	start := time.Now()
+	for i := 0; i < 6; i++ {
+		tracer.record("op", "bridge", string(rune('a'+i)), traceLaneIPC, false, start, start.Add(time.Millisecond))
+	}
+
+	spans, dropped := tracer.snapshot()
+	if dropped != 2 {
+		t.Errorf("dropped = %d, want 2", dropped)
+	}
+	got := ""
+	for _, s := range spans {
+		got += s.msgID
+	}
+	if got != "cdef" {
+		t.Errorf("spans = %q, want cdef", got)
+	}
+	if spans[0].durUs != 1000 {
+		t.Errorf("durUs = %d, want 1000", spans[0].durUs)
+	}
+}
+
+// TestSpanTracerChromeEvents links decode and respond spans to the TypeScript flows
+func TestSpanTracerChromeEvents(t *testing.T) {
+	tracer := &spanTracer{ring: make([]traceSpan, 16)}
+	start := time.Now()
+	tracer.record("decode", "bridge", "msg_1", traceLaneIPC, false, start, start)
+	tracer.record("setText", "bridge", "msg_1", traceLaneIPC, false, start, start.Add(time.Millisecond))
+	tracer.record("fyne.Do wait", "main", "msg_1", traceLaneQueue, true, start, start.Add(time.Millisecond))
+	tracer.record("respond", "bridge", "msg_1", traceLaneIPC, false, start, start)
+
+	events, _ := tracer.chromeEvents()
+	phases := map[string]int{}
+	flows := map[string]bool{}
+	for _, e := range events {
+		ph := e["ph"].(string)
+		phases[ph]++
+		if ph == "s" || ph == "f" {
+			flows[e["id"].(string)] = true
+		}
+	}
+	if phases["X"] != 3 || phases["b"] != 1 || phases["e"] != 1 {
+		t.Errorf("phases = %v", phases)
+	}
+	if !flows["req:msg_1"] || !flows["resp:msg_1"] {
+		t.Errorf("flows = %v, want req:msg_1 and resp:msg_1", flows)
+	}
+}
+
+// TestSpanTracerCurrentMessage tracks the message fyne.Do spans belong to
+func TestSpanTracerCurrentMessage(t *testing.T) {
+	var disabled *spanTracer
+	disabled.beginMessage("msg_1") // No-op on a nil tracer
+	disabled.endMessage()
+
+	tracer := &spanTracer{ring: make([]traceSpan, 4)}
+	tracer.beginMessage("msg_7")
+	if got := tracer.currentMessage(); got != "msg_7" {
+		t.Errorf("currentMessage = %q, want msg_7", got)
+	}
+	tracer.endMessage()
+	if got := tracer.currentMessage(); got != "" {
+		t.Errorf("currentMessage = %q after endMessage, want empty", got)
+	}
+}
+
+// TestSpanTracerCurrentMessagePerGoroutine keeps concurrent handlers apart,
+// as when msgpack serves several connections at once
+func TestSpanTracerCurrentMessagePerGoroutine(t *testing.T) {
+	tracer := &spanTracer{ring: make([]traceSpan, 4)}
+	const handlers = 8
+	var started, checked sync.WaitGroup
+	started.Add(handlers)
+	checked.Add(handlers)
+	errs := make(chan string, handlers)
+
+	for i := 0; i < handlers; i++ {
+		go func(msgID string) {
+			defer checked.Done()
+			tracer.beginMessage(msgID)
+			started.Done()
+			started.Wait() // Every handler has begun before any reads back
+			if got := tracer.currentMessage(); got != msgID {
+				errs <- fmt.Sprintf("handler %s sees %q", msgID, got)
+			}
+			tracer.endMessage()
+		}(fmt.Sprintf("msg_%d", i))
+	}
+	checked.Wait()
+	close(errs)
+	for err := range errs {
+		t.Error(err)
+	}
+	if got := tracer.currentMessage(); got != "" {
+		t.Errorf("currentMessage = %q outside any handler, want empty", got)
+	}
+}
@@ -212,7 +212,10 @@ type Bridge struct {
 	pathData             map[string]*PathRaster           // path widget ID -> path raster
 	customDialogs   map[string]interface{}           // dialog ID -> custom dialog instance
 	rasterSprites   map[string]*RasterSpriteSystem   // raster ID -> sprite system
+	particleFields  map[string]*ParticleField        // particle widget ID -> simulation
+	tileMaps        map[string]*TileMap              // tile map widget ID -> tile compositor
 	msgpackServer   *MsgpackServer                   // MessagePack UDS server (when in msgpack-uds mode)
+	perfStream      chan struct{}                    // closed to stop the perfStats event stream
 	ffiEventCallback func(Event)                     // FFI event callback (when in FFI mode)
 }
 
@@ -1834,7 +1837,7 @@ func NewTsyneDesktopMDI(id string, bgColor color.Color, bridge *Bridge) *TsyneDe
 // AddIcon adds an icon to the desktop at the specified position
 func (dm *TsyneDesktopMDI) AddIcon(icon *TsyneDraggableIcon) {
 	dm.icons = append(dm.icons, icon)
-	fyne.Do(func() {
+	fyneDo(func() {
 		dm.Refresh()
 	})
 }
@@ -1843,7 +1846,7 @@ func (dm *TsyneDesktopMDI) AddIcon(icon *TsyneDraggableIcon) {
 func (dm *TsyneDesktopMDI) AddWindow(win *container.InnerWindow) {
 	dm.setupWindowCallbacks(win)
 	dm.windows = append(dm.windows, win)
-	fyne.Do(func() {
+	fyneDo(func() {
 		dm.Refresh()
 	})
 }
@@ -1879,7 +1882,7 @@ func (dm *TsyneDesktopMDI) RemoveWindow(win *container.InnerWindow) {
 			break
 		}
 	}
-	fyne.Do(func() {
+	fyneDo(func() {
 		dm.Refresh()
 	})
 }
@@ -1900,7 +1903,7 @@ func (dm *TsyneDesktopMDI) RaiseWindow(win *container.InnerWindow) {
 	// Move the window to the end of the slice so it renders last (top-most)
 	dm.windows = append(dm.windows[:index], dm.windows[index+1:]...)
 	dm.windows = append(dm.windows, win)
-	fyne.Do(func() {
+	fyneDo(func() {
 		dm.Refresh()
 	})
 }
@@ -1917,7 +1920,7 @@ func (dm *TsyneDesktopMDI) GetIcon(id string) *TsyneDraggableIcon {
 
 // MoveIcon updates the position of an icon (implements DesktopIconContainer)
 func (dm *TsyneDesktopMDI) MoveIcon(icon *TsyneDraggableIcon) {
-	fyne.Do(func() {
+	fyneDo(func() {
 		dm.Refresh()
 	})
 }
@@ -75,7 +75,7 @@ func (b *Bridge) handleUpdateCanvasLinearGradient(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		// Update start color if provided
 		if startHex, ok := msg.Payload["startColor"].(string); ok {
 			gradient.StartColor = parseHexColorSimple(startHex)
@@ -167,7 +167,7 @@ func (b *Bridge) handleUpdateCanvasRadialGradient(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		// Update start color if provided
 		if startHex, ok := msg.Payload["startColor"].(string); ok {
 			gradient.StartColor = parseHexColorSimple(startHex)
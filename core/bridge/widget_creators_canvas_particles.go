@@ -0,0 +1,527 @@
+package main
+
+import (
+	"image"
+	"image/color"
+	"math"
+	"math/rand"
+	"sync"
+	"time"
+
+	"fyne.io/fyne/v2"
+	"fyne.io/fyne/v2/canvas"
+)
+
+// ============================================================================
+// Canvas Particles - bridge-resident particle simulation
+// ============================================================================
+//
+// The particle state lives entirely in the bridge: a goroutine with its own
+// clock emits, integrates and composites particles into an RGBA buffer with
+// the native raster kernels, then refreshes the raster on the main thread.
+// The TypeScript side only sends parameter changes and bursts, so an effect
+// costs no IPC per frame.
+
+// maxParticleFPS caps the simulation rate; much higher rates would round the
+// tick interval down to zero, which time.NewTicker rejects with a panic
+const maxParticleFPS = 240
+
+// ParticleEmitterParams describes how a particle field spawns and moves particles
+type ParticleEmitterParams struct {
+	X, Y        float32       // Emitter position in buffer pixels
+	Rate        float64       // Particles per second (0 = bursts only)
+	Angle       float64       // Emission direction in radians
+	Spread      float64       // Full width of the emission cone in radians
+	SpeedMin    float64       // px/s
+	SpeedMax    float64       // px/s
+	LifeMin     float64       // ms
+	LifeMax     float64       // ms
+	RadiusStart float32       // Radius at birth
+	RadiusEnd   float32       // Radius at death
+	GravityX    float64       // px/s^2
+	GravityY    float64       // px/s^2
+	Friction    float64       // Velocity multiplier per 1/60 s (1 = none)
+	Colors      []color.NRGBA // Color ramp over the particle's life, evenly spaced
+}
+
+// ParticleField holds one particle widget's simulation and frame buffers
+type ParticleField struct {
+	mu           sync.Mutex
+	params       ParticleEmitterParams
+	width        int
+	height       int
+	background   color.NRGBA
+	fps          int
+	maxParticles int
+	rng          *rand.Rand
+
+	// Live particles at [0, count), one slice per attribute
+	count      int
+	posX, posY []float32
+	velX, velY []float32
+	age, life  []float32 // ms
+	emitCarry  float64
+
+	ramp [256]uint32 // Packed RGBA (r in the low byte) by age / life
+	xyr  []float32   // Circle batch for rasterFillCircles
+	rgba []uint32
+
+	front, back *image.RGBA // front is shown, back is drawn by the simulation
+	raster      *canvas.Raster
+	drawn       bool // Last presented frame had particles in it
+	stop        chan struct{}
+}
+
+func defaultParticleEmitterParams() ParticleEmitterParams {
+	return ParticleEmitterParams{
+		Rate:        50,
+		Angle:       -math.Pi / 2,
+		Spread:      math.Pi / 4,
+		SpeedMin:    60,
+		SpeedMax:    120,
+		LifeMin:     800,
+		LifeMax:     1200,
+		RadiusStart: 3,
+		RadiusEnd:   1,
+		Friction:    1,
+		Colors:      []color.NRGBA{{R: 255, G: 255, B: 255, A: 255}, {R: 255, G: 255, B: 255, A: 0}},
+	}
+}
+
+// applyParticleEmitterParams copies every field present in m onto p
+func applyParticleEmitterParams(p *ParticleEmitterParams, m map[string]interface{}) {
+	if v, ok := getFloat64(m["x"]); ok {
+		p.X = float32(v)
+	}
+	if v, ok := getFloat64(m["y"]); ok {
+		p.Y = float32(v)
+	}
+	if v, ok := getFloat64(m["rate"]); ok {
+		p.Rate = math.Max(0, v)
+	}
+	if v, ok := getFloat64(m["angle"]); ok {
+		p.Angle = v
+	}
+	if v, ok := getFloat64(m["spread"]); ok {
+		p.Spread = v
+	}
+	if v, ok := getFloat64(m["speedMin"]); ok {
+		p.SpeedMin = v
+	}
+	if v, ok := getFloat64(m["speedMax"]); ok {
+		p.SpeedMax = v
+	}
+	if v, ok := getFloat64(m["lifeMin"]); ok {
+		p.LifeMin = v
+	}
+	if v, ok := getFloat64(m["lifeMax"]); ok {
+		p.LifeMax = v
+	}
+	if v, ok := getFloat64(m["radius"]); ok {
+		p.RadiusStart = float32(v)
+		p.RadiusEnd = float32(v)
+	}
+	if v, ok := getFloat64(m["radiusStart"]); ok {
+		p.RadiusStart = float32(v)
+	}
+	if v, ok := getFloat64(m["radiusEnd"]); ok {
+		p.RadiusEnd = float32(v)
+	}
+	if v, ok := getFloat64(m["gravityX"]); ok {
+		p.GravityX = v
+	}
+	if v, ok := getFloat64(m["gravityY"]); ok {
+		p.GravityY = v
+	}
+	if v, ok := getFloat64(m["friction"]); ok {
+		p.Friction = v
+	}
+	if colors, ok := m["colors"].([]interface{}); ok {
+		ramp := make([]color.NRGBA, 0, len(colors))
+		for _, c := range colors {
+			if s, ok := c.(string); ok {
+				if parsed, ok := parseHexColor(s); ok {
+					ramp = append(ramp, parsed)
+				}
+			}
+		}
+		if len(ramp) > 0 {
+			p.Colors = ramp
+		}
+	}
+	if p.SpeedMax < p.SpeedMin {
+		p.SpeedMax = p.SpeedMin
+	}
+	if p.LifeMax < p.LifeMin {
+		p.LifeMax = p.LifeMin
+	}
+}
+
+func newParticleField(width, height int) *ParticleField {
+	f := &ParticleField{
+		params:       defaultParticleEmitterParams(),
+		width:        width,
+		height:       height,
+		background:   color.NRGBA{A: 255},
+		fps:          60,
+		maxParticles: 20000,
+		rng:          rand.New(rand.NewSource(time.Now().UnixNano())),
+		front:        image.NewRGBA(image.Rect(0, 0, width, height)),
+		back:         image.NewRGBA(image.Rect(0, 0, width, height)),
+	}
+	f.buildRamp()
+	return f
+}
+
+// buildRamp samples the color ramp into a 256-entry lookup table
+func (f *ParticleField) buildRamp() {
+	colors := f.params.Colors
+	for i := range f.ramp {
+		t := float64(i) / 255
+		var c color.NRGBA
+		if len(colors) == 1 {
+			c = colors[0]
+		} else {
+			pos := t * float64(len(colors)-1)
+			k := int(pos)
+			if k >= len(colors)-1 {
+				k = len(colors) - 2
+			}
+			frac := pos - float64(k)
+			lerp := func(a, b uint8) uint32 {
+				return uint32(math.Round(float64(a) + (float64(b)-float64(a))*frac))
+			}
+			c0, c1 := colors[k], colors[k+1]
+			f.ramp[i] = lerp(c0.A, c1.A)<<24 | lerp(c0.B, c1.B)<<16 | lerp(c0.G, c1.G)<<8 | lerp(c0.R, c1.R)
+			continue
+		}
+		f.ramp[i] = uint32(c.A)<<24 | uint32(c.B)<<16 | uint32(c.G)<<8 | uint32(c.R)
+	}
+}
+
+// spawn adds up to n particles at (x, y), capped at maxParticles
+func (f *ParticleField) spawn(n int, x, y float32) {
+	p := &f.params
+	for k := 0; k < n && f.count < f.maxParticles; k++ {
+		if f.count == len(f.posX) {
+			f.grow()
+		}
+		i := f.count
+		angle := p.Angle + (f.rng.Float64()-0.5)*p.Spread
+		speed := p.SpeedMin + f.rng.Float64()*(p.SpeedMax-p.SpeedMin)
+		life := p.LifeMin + f.rng.Float64()*(p.LifeMax-p.LifeMin)
+		if life <= 0 {
+			life = 1
+		}
+		f.posX[i] = x
+		f.posY[i] = y
+		f.velX[i] = float32(math.Cos(angle) * speed)
+		f.velY[i] = float32(math.Sin(angle) * speed)
+		f.age[i] = 0
+		f.life[i] = float32(life)
+		f.count++
+	}
+}
+
+func (f *ParticleField) grow() {
+	n := len(f.posX) * 2
+	if n < 256 {
+		n = 256
+	}
+	grow := func(s []float32) []float32 {
+		next := make([]float32, n)
+		copy(next, s)
+		return next
+	}
+	f.posX, f.posY = grow(f.posX), grow(f.posY)
+	f.velX, f.velY = grow(f.velX), grow(f.velY)
+	f.age, f.life = grow(f.age), grow(f.life)
+}
+
+// step emits and advances the simulation by dt seconds
+func (f *ParticleField) step(dt float64) {
+	p := &f.params
+	if p.Rate > 0 {
+		f.emitCarry += p.Rate * dt
+		n := int(f.emitCarry)
+		f.emitCarry -= float64(n)
+		f.spawn(n, p.X, p.Y)
+	}
+
+	drag := float32(1)
+	if p.Friction > 0 && p.Friction < 1 {
+		drag = float32(math.Pow(p.Friction, dt*60))
+	}
+	dvx := float32(p.GravityX * dt)
+	dvy := float32(p.GravityY * dt)
+	fdt := float32(dt)
+	ms := float32(dt * 1000)
+
+	for i := 0; i < f.count; {
+		age := f.age[i] + ms
+		if age >= f.life[i] {
+			// Swap-remove; the particle moved into slot i is stepped next
+			f.count--
+			last := f.count
+			f.posX[i], f.posY[i] = f.posX[last], f.posY[last]
+			f.velX[i], f.velY[i] = f.velX[last], f.velY[last]
+			f.age[i], f.life[i] = f.age[last], f.life[last]
+			continue
+		}
+		f.age[i] = age
+		vx := (f.velX[i] + dvx) * drag
+		vy := (f.velY[i] + dvy) * drag
+		f.velX[i] = vx
+		f.velY[i] = vy
+		f.posX[i] += vx * fdt
+		f.posY[i] += vy * fdt
+		i++
+	}
+}
+
+// render composites the live particles into the back buffer
+func (f *ParticleField) render() {
+	p := &f.params
+	bg := f.background
+	rasterClear(f.back.Pix, f.width, f.height, bg.R, bg.G, bg.B, bg.A)
+
+	f.xyr = f.xyr[:0]
+	f.rgba = f.rgba[:0]
+	for i := 0; i < f.count; i++ {
+		t := f.age[i] / f.life[i]
+		f.xyr = append(f.xyr, f.posX[i], f.posY[i], p.RadiusStart+(p.RadiusEnd-p.RadiusStart)*t)
+		f.rgba = append(f.rgba, f.ramp[int(t*255)])
+	}
+	rasterFillCircles(f.back.Pix, f.width, f.height, f.xyr, f.rgba)
+}
+
+// frontImage is the raster generator; it runs on the main thread
+func (f *ParticleField) frontImage(w, h int) image.Image {
+	f.mu.Lock()
+	defer f.mu.Unlock()
+	return f.front
+}
+
+// present swaps the buffers and refreshes the raster; it runs on the main thread
+func (f *ParticleField) present() {
+	f.mu.Lock()
+	f.front, f.back = f.back, f.front
+	raster := f.raster
+	f.mu.Unlock()
+	raster.Refresh()
+}
+
+// start launches the simulation loop if it is not already running
+func (f *ParticleField) start(b *Bridge, widgetID string) {
+	if f.stop != nil {
+		return
+	}
+	f.stop = make(chan struct{})
+	go f.run(b, widgetID, f.stop, f.fps)
+}
+
+// halt stops the simulation loop; the last frame stays on screen
+func (f *ParticleField) halt() {
+	if f.stop != nil {
+		close(f.stop)
+		f.stop = nil
+	}
+}
+
+func (f *ParticleField) run(b *Bridge, widgetID string, stop chan struct{}, fps int) {
+	ticker := time.NewTicker(time.Second / time.Duration(fps))
+	defer ticker.Stop()
+	last := time.Now()
+
+	for {
+		select {
+		case <-stop:
+			return
+		case <-ticker.C:
+		}
+
+		// The loop ends with its widget
+		b.mu.RLock()
+		_, alive := b.widgets[widgetID]
+		b.mu.RUnlock()
+		if !alive {
+			f.mu.Lock()
+			if f.stop == stop {
+				f.stop = nil
+			}
+			f.mu.Unlock()
+			return
+		}
+
+		// Monotonic clock; long stalls are clamped so particles don't jump
+		now := time.Now()
+		dt := now.Sub(last).Seconds()
+		last = now
+		if dt > 0.1 {
+			dt = 0.1
+		}
+
+		f.mu.Lock()
+		f.step(dt)
+		// An empty field is only drawn once, after the last particle dies
+		draw := f.count > 0 || f.drawn
+		if draw {
+			f.render()
+			f.drawn = f.count > 0
+		}
+		f.mu.Unlock()
+
+		if draw {
+			fyneDoAndWait(f.present)
+		}
+	}
+}
+
+// ============================================================================
+// Canvas Particles Handlers
+// ============================================================================
+
+// handleCreateCanvasParticles creates a particle widget that simulates and
+// renders inside the bridge
+func (b *Bridge) handleCreateCanvasParticles(msg Message) Response {
+	widgetID := msg.Payload["id"].(string)
+	width := toInt(msg.Payload["width"])
+	height := toInt(msg.Payload["height"])
+	if width <= 0 || height <= 0 {
+		return Response{
+			ID:      msg.ID,
+			Success: false,
+			Error:   "Invalid particle canvas dimensions",
+		}
+	}
+
+	f := newParticleField(width, height)
+	if bg, ok := msg.Payload["background"].(string); ok {
+		if c, ok := parseHexColor(bg); ok {
+			f.background = c
+		}
+	}
+	if fps := toInt(msg.Payload["fps"]); fps > 0 {
+		f.fps = min(fps, maxParticleFPS)
+	}
+	if maxParticles := toInt(msg.Payload["maxParticles"]); maxParticles > 0 {
+		f.maxParticles = maxParticles
+	}
+	if emitter, ok := msg.Payload["emitter"].(map[string]interface{}); ok {
+		applyParticleEmitterParams(&f.params, emitter)
+		f.buildRamp()
+	}
+	bg := f.background
+	rasterClear(f.front.Pix, width, height, bg.R, bg.G, bg.B, bg.A)
+
+	raster := canvas.NewRaster(f.frontImage)
+	raster.SetMinSize(fyne.NewSize(float32(width), float32(height)))
+	f.raster = raster
+
+	b.mu.Lock()
+	if b.particleFields == nil {
+		b.particleFields = make(map[string]*ParticleField)
+	}
+	b.particleFields[widgetID] = f
+	b.widgets[widgetID] = raster
+	b.widgetMeta[widgetID] = WidgetMetadata{Type: "canvasparticles", Text: ""}
+	b.mu.Unlock()
+
+	running := true
+	if r, ok := msg.Payload["running"].(bool); ok {
+		running = r
+	}
+	if running {
+		f.mu.Lock()
+		f.start(b, widgetID)
+		f.mu.Unlock()
+	}
+
+	return Response{
+		ID:      msg.ID,
+		Success: true,
+		Result:  map[string]interface{}{"widgetId": widgetID},
+	}
+}
+
+// handleUpdateCanvasParticles applies emitter changes, bursts and start/stop
+func (b *Bridge) handleUpdateCanvasParticles(msg Message) Response {
+	widgetID := msg.Payload["widgetId"].(string)
+
+	b.mu.RLock()
+	f, exists := b.particleFields[widgetID]
+	b.mu.RUnlock()
+	if !exists {
+		return Response{
+			ID:      msg.ID,
+			Success: false,
+			Error:   "Particle widget not found",
+		}
+	}
+
+	f.mu.Lock()
+	defer f.mu.Unlock()
+
+	if emitter, ok := msg.Payload["emitter"].(map[string]interface{}); ok {
+		applyParticleEmitterParams(&f.params, emitter)
+		f.buildRamp()
+	}
+	if reset, ok := msg.Payload["clear"].(bool); ok && reset {
+		f.count = 0
+		f.emitCarry = 0
+	}
+	// Bursts: [{x, y, count}, ...]
+	if bursts, ok := msg.Payload["bursts"].([]interface{}); ok {
+		for _, burst := range bursts {
+			if m, ok := burst.(map[string]interface{}); ok {
+				x, y := f.params.X, f.params.Y
+				if v, ok := getFloat64(m["x"]); ok {
+					x = float32(v)
+				}
+				if v, ok := getFloat64(m["y"]); ok {
+					y = float32(v)
+				}
+				f.spawn(toInt(m["count"]), x, y)
+			}
+		}
+	}
+	if running, ok := msg.Payload["running"].(bool); ok {
+		if running {
+			f.start(b, widgetID)
+		} else {
+			f.halt()
+		}
+	}
+
+	return Response{
+		ID:      msg.ID,
+		Success: true,
+	}
+}
+
+// handleGetCanvasParticlesInfo reports the live particle count
+func (b *Bridge) handleGetCanvasParticlesInfo(msg Message) Response {
+	widgetID := msg.Payload["widgetId"].(string)
+
+	b.mu.RLock()
+	f, exists := b.particleFields[widgetID]
+	b.mu.RUnlock()
+	if !exists {
+		return Response{
+			ID:      msg.ID,
+			Success: false,
+			Error:   "Particle widget not found",
+		}
+	}
+
+	f.mu.Lock()
+	defer f.mu.Unlock()
+	return Response{
+		ID:      msg.ID,
+		Success: true,
+		Result: map[string]interface{}{
+			"count":   f.count,
+			"running": f.stop != nil,
+		},
+	}
+}
@@ -0,0 +1,227 @@
+package main
+
+import (
+	"image/color"
+	"math"
+	"math/rand"
+	"testing"
+
+	"fyne.io/fyne/v2"
+	"fyne.io/fyne/v2/canvas"
+)
+
+// newTestParticleField is a field with a fixed seed and no emission
+func newTestParticleField() *ParticleField {
+	f := newParticleField(32, 32)
+	f.rng = rand.New(rand.NewSource(1))
+	f.params.Rate = 0
+	return f
+}
+
+// addParticle appends one particle with the given state
+func addParticle(f *ParticleField, x, y, vx, vy, age, life float32) {
+	if f.count == len(f.posX) {
+		f.grow()
+	}
+	i := f.count
+	f.posX[i], f.posY[i] = x, y
+	f.velX[i], f.velY[i] = vx, vy
+	f.age[i], f.life[i] = age, life
+	f.count++
+}
+
+func approx(a, b float32) bool {
+	return math.Abs(float64(a-b)) < 1e-3
+}
+
+func TestParticleFieldBuildRamp(t *testing.T) {
+	white := color.NRGBA{R: 255, G: 255, B: 255, A: 255}
+	clear := color.NRGBA{R: 255, G: 255, B: 255, A: 0}
+	red := color.NRGBA{R: 255, A: 255}
+	green := color.NRGBA{G: 255, A: 255}
+	blue := color.NRGBA{B: 255, A: 255}
+
+	tests := []struct {
+		name   string
+		colors []color.NRGBA
+		want   map[int]uint32 // ramp index -> packed RGBA (r in the low byte)
+	}{
+		{"single color", []color.NRGBA{red}, map[int]uint32{0: 0xff0000ff, 128: 0xff0000ff, 255: 0xff0000ff}},
+		{"fade out", []color.NRGBA{white, clear}, map[int]uint32{0: 0xffffffff, 128: 0x7fffffff, 255: 0x00ffffff}},
+		{"three stops", []color.NRGBA{red, green, blue}, map[int]uint32{0: 0xff0000ff, 255: 0xffff0000}},
+	}
+	for _, tc := range tests {
+		t.Run(tc.name, func(t *testing.T) {
+			f := newTestParticleField()
+			f.params.Colors = tc.colors
+			f.buildRamp()
+			for i, want := range tc.want {
+				if f.ramp[i] != want {
+					t.Errorf("ramp[%d] = %#08x, want %#08x", i, f.ramp[i], want)
+				}
+			}
+		})
+	}
+}
+
+func TestParticleFieldSpawn(t *testing.T) {
+	tests := []struct {
+		name      string
+		existing  int
+		n         int
+		max       int
+		lifeMin   float64
+		lifeMax   float64
+		wantCount int
+		wantLife  [2]float32
+	}{
+		{"spawns n", 0, 10, 100, 500, 1000, 10, [2]float32{500, 1000}},
+		{"grows past the first allocation", 250, 20, 1000, 500, 1000, 270, [2]float32{500, 1000}},
+		{"capped at maxParticles", 95, 10, 100, 500, 1000, 100, [2]float32{500, 1000}},
+		{"zero life becomes 1ms", 0, 3, 100, 0, 0, 3, [2]float32{1, 1}},
+	}
+	for _, tc := range tests {
+		t.Run(tc.name, func(t *testing.T) {
+			f := newTestParticleField()
+			f.maxParticles = tc.max
+			f.params.LifeMin, f.params.LifeMax = tc.lifeMin, tc.lifeMax
+			f.params.Angle, f.params.Spread = 0, math.Pi/2
+			f.params.SpeedMin, f.params.SpeedMax = 10, 20
+			for i := 0; i < tc.existing; i++ {
+				addParticle(f, 0, 0, 0, 0, 0, 1000)
+			}
+
+			f.spawn(tc.n, 5, 7)
+			if f.count != tc.wantCount {
+				t.Fatalf("count = %d, want %d", f.count, tc.wantCount)
+			}
+			for i := tc.existing; i < f.count; i++ {
+				if f.posX[i] != 5 || f.posY[i] != 7 || f.age[i] != 0 {
+					t.Errorf("particle %d at (%v, %v) age %v", i, f.posX[i], f.posY[i], f.age[i])
+				}
+				if f.life[i] < tc.wantLife[0] || f.life[i] > tc.wantLife[1] {
+					t.Errorf("particle %d life %v outside %v", i, f.life[i], tc.wantLife)
+				}
+				speed := math.Hypot(float64(f.velX[i]), float64(f.velY[i]))
+				angle := math.Atan2(float64(f.velY[i]), float64(f.velX[i]))
+				if speed < 10-1e-3 || speed > 20+1e-3 || math.Abs(angle) > math.Pi/4+1e-6 {
+					t.Errorf("particle %d speed %v angle %v outside the cone", i, speed, angle)
+				}
+			}
+		})
+	}
+}
+
+func TestParticleFieldStep(t *testing.T) {
+	type particle struct{ x, y, vx, vy, age, life float32 }
+
+	tests := []struct {
+		name   string
+		params func(p *ParticleEmitterParams)
+		start  []particle
+		dt     float64
+		want   []particle
+	}{
+		{
+			name:   "gravity integrates velocity then position",
+			params: func(p *ParticleEmitterParams) { p.GravityY = 100 },
+			start:  []particle{{0, 0, 10, 0, 0, 1000}},
+			dt:     0.1,
+			want:   []particle{{1, 1, 10, 10, 100, 1000}},
+		},
+		{
+			name:   "friction is per 1/60s",
+			params: func(p *ParticleEmitterParams) { p.Friction = 0.5 },
+			start:  []particle{{0, 0, 60, 0, 0, 1000}},
+			dt:     1.0 / 60,
+			want:   []particle{{0.5, 0, 30, 0, 1000.0 / 60, 1000}},
+		},
+		{
+			name:   "expired particles are swap-removed",
+			params: func(p *ParticleEmitterParams) {},
+			start:  []particle{{0, 0, 0, 0, 950, 1000}, {1, 1, 10, 0, 0, 1000}, {2, 2, 0, 0, 990, 1000}},
+			dt:     0.1,
+			want:   []particle{{2, 1, 10, 0, 100, 1000}},
+		},
+	}
+	for _, tc := range tests {
+		t.Run(tc.name, func(t *testing.T) {
+			f := newTestParticleField()
+			tc.params(&f.params)
+			for _, p := range tc.start {
+				addParticle(f, p.x, p.y, p.vx, p.vy, p.age, p.life)
+			}
+
+			f.step(tc.dt)
+			if f.count != len(tc.want) {
+				t.Fatalf("count = %d, want %d", f.count, len(tc.want))
+			}
+			for i, w := range tc.want {
+				got := particle{f.posX[i], f.posY[i], f.velX[i], f.velY[i], f.age[i], f.life[i]}
+				if !approx(got.x, w.x) || !approx(got.y, w.y) || !approx(got.vx, w.vx) ||
+					!approx(got.vy, w.vy) || !approx(got.age, w.age) || got.life != w.life {
+					t.Errorf("particle %d = %+v, want %+v", i, got, w)
+				}
+			}
+		})
+	}
+}
+
+// TestParticleFieldEmission carries fractional particles between steps
+func TestParticleFieldEmission(t *testing.T) {
+	f := newTestParticleField()
+	f.params.Rate = 30
+	f.params.LifeMin, f.params.LifeMax = 10000, 10000
+
+	for _, want := range []int{1, 3, 4, 6} {
+		f.step(0.05)
+		if f.count != want {
+			t.Fatalf("count = %d, want %d", f.count, want)
+		}
+	}
+}
+
+// TestRemoveWidgetTreeFreesParticleField stops and drops the simulation with its widget
+func TestRemoveWidgetTreeFreesParticleField(t *testing.T) {
+	f := newTestParticleField()
+	f.stop = make(chan struct{})
+	stop := f.stop
+	bridge := &Bridge{
+		widgets:        map[string]fyne.CanvasObject{"particles_1": canvas.NewRaster(f.frontImage)},
+		widgetMeta:     map[string]WidgetMetadata{"particles_1": {Type: "canvasparticles"}},
+		particleFields: map[string]*ParticleField{"particles_1": f},
+	}
+
+	bridge.removeWidgetTree("particles_1")
+	if len(bridge.particleFields) != 0 {
+		t.Error("particle field still registered after removal")
+	}
+	select {
+	case <-stop:
+	default:
+		t.Error("simulation loop was not stopped")
+	}
+}
+
+func TestCreateCanvasParticlesClampsFPS(t *testing.T) {
+	bridge := &Bridge{
+		widgets:    map[string]fyne.CanvasObject{},
+		widgetMeta: map[string]WidgetMetadata{},
+	}
+	resp := bridge.handleCreateCanvasParticles(Message{ID: "1", Payload: map[string]interface{}{
+		"id": "particles_1", "width": 8.0, "height": 8.0, "fps": 2e9, "running": false,
+	}})
+	if !resp.Success {
+		t.Fatalf("create failed: %s", resp.Error)
+	}
+	f := bridge.particleFields["particles_1"]
+	if f.fps != maxParticleFPS {
+		t.Errorf("fps = %d, want %d", f.fps, maxParticleFPS)
+	}
+
+	// The clamped rate must make a usable ticker
+	f.mu.Lock()
+	f.start(bridge, "particles_1")
+	f.halt()
+	f.mu.Unlock()
+}
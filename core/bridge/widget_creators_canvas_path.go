@@ -1,7 +1,6 @@
 package main
 
 import (
-	"fyne.io/fyne/v2"
 	"github.com/fogleman/gg"
 )
 
@@ -19,7 +18,7 @@ func (b *Bridge) handleCreateCanvasPath(msg Message) Response {
 	var pr *PathRaster
 
 	// Create the path raster on Fyne thread
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		pr = NewPathRaster(width, height)
 	})
 
@@ -232,7 +232,7 @@ func (b *Bridge) handleUpdateCanvasPolygon(msg Message) Response {
 	minX, minY, width, height := calculatePolygonBounds(polyInfo.Points)
 	b.mu.Unlock()
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		raster.SetMinSize(fyne.NewSize(width, height))
 		raster.Resize(fyne.NewSize(width, height))
 		raster.Move(fyne.NewPos(minX, minY))
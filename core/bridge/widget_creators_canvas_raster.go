@@ -141,7 +141,7 @@ func (b *Bridge) handleUpdateCanvasRaster(msg Message) Response {
 	}
 
 	// Refresh the raster to show updates (must be done on main thread)
-	fyne.Do(func() {
+	fyneDo(func() {
 		raster.Refresh()
 	})
 
@@ -215,7 +215,7 @@ func (b *Bridge) handleFillCanvasRasterRect(msg Message) Response {
 	b.mu.Unlock()
 
 	// Refresh the raster
-	fyne.Do(func() {
+	fyneDo(func() {
 		raster.Refresh()
 	})
 
@@ -337,7 +337,7 @@ func (b *Bridge) handleBlitToCanvasRaster(msg Message) Response {
 	b.mu.Unlock()
 
 	// Refresh the raster
-	fyne.Do(func() {
+	fyneDo(func() {
 		raster.Refresh()
 	})
 
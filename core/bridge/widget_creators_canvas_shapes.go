@@ -69,7 +69,7 @@ func (b *Bridge) handleUpdateCanvasLine(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		// Update position if provided
 		if x1, ok := getFloat64(msg.Payload["x1"]); ok {
 			if y1, ok := getFloat64(msg.Payload["y1"]); ok {
@@ -169,7 +169,7 @@ func (b *Bridge) handleUpdateCanvasCircle(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		// Update position if provided
 		if x, ok := getFloat64(msg.Payload["x"]); ok {
 			if y, ok := getFloat64(msg.Payload["y"]); ok {
@@ -303,7 +303,7 @@ func (b *Bridge) handleUpdateCanvasRectangle(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		if isPlainRect {
 			// Update plain canvas.Rectangle
 			if x, ok := getFloat64(msg.Payload["x"]); ok {
@@ -536,7 +536,7 @@ func (b *Bridge) handleUpdateCanvasEllipse(msg Message) Response {
 	newY := data.Y
 	b.mu.Unlock()
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		raster.Move(fyne.NewPos(newX, newY))
 		raster.Refresh()
 	})
@@ -750,7 +750,7 @@ func (b *Bridge) handleUpdateCanvasArc(msg Message) Response {
 	}
 	b.mu.Unlock()
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		raster.Refresh()
 	})
 
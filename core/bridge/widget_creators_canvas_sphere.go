@@ -757,7 +757,7 @@ func (b *Bridge) handleUpdateCanvasSphere(msg Message) Response {
 
 	// Refresh the raster to re-render with updated rotation/texture/lighting
 	// Note: Don't call Move() here as it conflicts with Fyne layout containers
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		raster.Refresh()
 	})
 
@@ -832,7 +832,7 @@ func (b *Bridge) handleUpdateCanvasSphereBuffer(msg Message) Response {
 
 	if exists {
 		if raster, ok := w.(*canvas.Raster); ok {
-			fyne.DoAndWait(func() {
+			fyneDoAndWait(func() {
 				raster.Refresh()
 			})
 		}
@@ -201,7 +201,7 @@ func (b *Bridge) handleUpdateCanvasSphericalPatch(msg Message) Response {
 	}
 	b.mu.Unlock()
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		raster.Refresh()
 	})
 
@@ -403,7 +403,7 @@ func (b *Bridge) handleUpdateCanvasCheckeredSphere(msg Message) Response {
 	b.mu.Unlock()
 
 	// Update raster position/size
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		raster.Move(fyne.NewPos(newCx-newRadius, newCy-newRadius))
 		raster.Refresh()
 	})
@@ -7,7 +7,6 @@ import (
 	"image/color"
 	"sort"
 
-	"fyne.io/fyne/v2"
 	"fyne.io/fyne/v2/canvas"
 )
 
@@ -578,7 +577,7 @@ func (b *Bridge) handleFlushRasterSprites(msg Message) Response {
 	b.mu.Unlock()
 
 	// Refresh the raster
-	fyne.Do(func() {
+	fyneDo(func() {
 		raster.Refresh()
 	})
 
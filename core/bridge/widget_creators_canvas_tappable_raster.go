@@ -203,7 +203,7 @@ func (b *Bridge) handleFocusTappableCanvasRaster(msg Message) Response {
 		}
 	}
 
-	fyne.Do(func() {
+	fyneDo(func() {
 		tappable.RequestFocus()
 	})
 
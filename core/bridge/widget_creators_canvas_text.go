@@ -99,7 +99,7 @@ func (b *Bridge) handleUpdateCanvasText(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		// Update text if provided
 		if text, ok := msg.Payload["text"].(string); ok {
 			canvasText.Text = text
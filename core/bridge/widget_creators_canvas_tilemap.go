@@ -0,0 +1,618 @@
+package main
+
+import (
+	"bytes"
+	"container/list"
+	"encoding/base64"
+	"encoding/binary"
+	"fmt"
+	"image"
+	"image/color"
+	"image/draw"
+	"math"
+	"sync"
+
+	"fyne.io/fyne/v2"
+	"fyne.io/fyne/v2/canvas"
+)
+
+// ============================================================================
+// Canvas Tile Map - bridge-resident map tile compositor
+// ============================================================================
+//
+// Tiles are sent once as encoded bytes keyed by z/x/y, decoded here and kept
+// in an LRU texture cache. Pan and zoom only send the new viewport: the
+// bridge composites the visible tiles with the native blit kernel and tells
+// the caller which tiles it still lacks. Missing tiles are covered by the
+// nearest cached ancestor, scaled up, until they arrive.
+//
+// Geometry overlays (tracks, areas, point sets) are likewise sent once as
+// lng/lat arrays and re-projected and clipped natively on every composite.
+
+const (
+	tileMapMaxZoom      = 22
+	tileMapMaxLatitude  = 85.0511287798
+	tileMapAncestorHops = 3 // How many zoom levels up to look for a stand-in tile
+)
+
+// tileMapTile is one decoded tile in the cache
+type tileMapTile struct {
+	key           string
+	pix           []byte // Non-premultiplied RGBA
+	width, height int
+	elem          *list.Element
+	drawnAt       uint64 // Composite that last drew it, exact or as a stand-in
+}
+
+// TileMap holds one tile map widget's viewport, tile cache and frame buffers
+type TileMap struct {
+	mu         sync.Mutex
+	width      int
+	height     int
+	tileSize   int
+	background color.NRGBA
+	lng, lat   float64
+	zoom       float64
+	maxTiles   int
+
+	tiles map[string]*tileMapTile
+	lru   *list.List // Most recently drawn at the front
+	frame uint64     // Composites so far
+
+	front, back *image.RGBA // front is shown, back is composited into
+	composed    bool        // back holds a composite that present hasn't shown yet
+	resized     bool        // width/height changed since the raster was last sized
+	raster      *canvas.Raster
+	missing     []string // Visible tiles not in the cache at the last composite
+
+	overlays     map[string]*tileMapOverlay
+	overlayOrder []string // Draw order: first added at the bottom
+
+	// Scratch buffers reused by every overlay on every composite
+	projected []float32
+	clipped   []float32
+	runStarts []int32
+	indices   []uint32
+	circles   []float32
+	colors    []uint32
+}
+
+// tileMapOverlay is geometry drawn over the tiles
+type tileMapOverlay struct {
+	kind   string    // "line", "polygon" or "points"
+	lngLat []float64 // Interleaved lng, lat
+	color  color.NRGBA
+	size   float32 // Line width or point radius in pixels
+}
+
+// tileMapPlacement is a cached tile and where it lands in the viewport
+type tileMapPlacement struct {
+	tile       *tileMapTile
+	x, y, size float32
+}
+
+func newTileMap(width, height int) *TileMap {
+	return &TileMap{
+		width:      width,
+		height:     height,
+		tileSize:   256,
+		background: color.NRGBA{R: 240, G: 240, B: 240, A: 255},
+		maxTiles:   128,
+		tiles:      make(map[string]*tileMapTile),
+		lru:        list.New(),
+		overlays:   make(map[string]*tileMapOverlay),
+		front:      image.NewRGBA(image.Rect(0, 0, width, height)),
+		back:       image.NewRGBA(image.Rect(0, 0, width, height)),
+	}
+}
+
+func tileMapKey(z, x, y int) string {
+	return fmt.Sprintf("%d/%d/%d", z, x, y)
+}
+
+func containsString(list []string, s string) bool {
+	for _, v := range list {
+		if v == s {
+			return true
+		}
+	}
+	return false
+}
+
+// applyViewport copies every viewport field present in m. A new size reaches
+// the back buffer at the next composite and the raster at the next present.
+func (t *TileMap) applyViewport(m map[string]interface{}) {
+	if v, ok := getFloat64(m["lng"]); ok {
+		t.lng = v
+	}
+	if v, ok := getFloat64(m["lat"]); ok {
+		t.lat = math.Max(-tileMapMaxLatitude, math.Min(tileMapMaxLatitude, v))
+	}
+	if v, ok := getFloat64(m["zoom"]); ok {
+		t.zoom = math.Max(0, math.Min(tileMapMaxZoom, v))
+	}
+	width, height := toInt(m["width"]), toInt(m["height"])
+	if width > 0 && height > 0 && (width != t.width || height != t.height) {
+		t.width = width
+		t.height = height
+		t.resized = true
+	}
+}
+
+// put decodes a PNG/JPEG tile into the cache, evicting the least recently
+// drawn tiles beyond maxTiles. Tiles in the current view, drawn or still
+// missing, are never evicted: when the viewport needs more than maxTiles the
+// cache grows rather than thrash.
+func (t *TileMap) put(z, x, y int, data []byte) error {
+	decoded, _, err := image.Decode(bytes.NewReader(data))
+	if err != nil {
+		return err
+	}
+	bounds := decoded.Bounds()
+	nrgba := image.NewNRGBA(image.Rect(0, 0, bounds.Dx(), bounds.Dy()))
+	draw.Draw(nrgba, nrgba.Bounds(), decoded, bounds.Min, draw.Src)
+
+	key := tileMapKey(z, x, y)
+	if old, ok := t.tiles[key]; ok {
+		t.lru.Remove(old.elem)
+	}
+	tile := &tileMapTile{key: key, pix: nrgba.Pix, width: bounds.Dx(), height: bounds.Dy()}
+	if containsString(t.missing, key) {
+		tile.drawnAt = t.frame
+	}
+	tile.elem = t.lru.PushFront(tile)
+	t.tiles[key] = tile
+
+	for e := t.lru.Back(); e != nil && t.lru.Len() > t.maxTiles; {
+		prev := e.Prev()
+		if old := e.Value.(*tileMapTile); t.frame == 0 || old.drawnAt != t.frame {
+			t.lru.Remove(e)
+			delete(t.tiles, old.key)
+		}
+		e = prev
+	}
+	return nil
+}
+
+// composite draws the current viewport into the back buffer and records which
+// visible tiles are missing; present then shows it
+func (t *TileMap) composite() {
+	if b := t.back.Bounds(); b.Dx() != t.width || b.Dy() != t.height {
+		t.back = image.NewRGBA(image.Rect(0, 0, t.width, t.height))
+	}
+	bg := t.background
+	rasterClear(t.back.Pix, t.width, t.height, bg.R, bg.G, bg.B, bg.A)
+
+	// Tiles come from the nearest integer zoom and are scaled by the rest
+	z := int(math.Round(t.zoom))
+	scale := math.Pow(2, t.zoom-float64(z))
+	n := 1 << uint(z)
+	ts := float64(t.tileSize)
+	world := ts * float64(n)
+
+	latRad := t.lat * math.Pi / 180
+	centerX := (t.lng + 180) / 360 * world
+	centerY := (1 - math.Log(math.Tan(latRad)+1/math.Cos(latRad))/math.Pi) / 2 * world
+
+	halfW := float64(t.width) / 2 / scale
+	halfH := float64(t.height) / 2 / scale
+	minX := int(math.Floor((centerX - halfW) / ts))
+	maxX := int(math.Floor((centerX + halfW) / ts))
+	minY := int(math.Max(0, math.Floor((centerY-halfH)/ts)))
+	maxY := int(math.Min(float64(n-1), math.Floor((centerY+halfH)/ts)))
+
+	place := func(tx, ty int) (float32, float32) {
+		return float32((float64(tx)*ts-centerX)*scale + float64(t.width)/2),
+			float32((float64(ty)*ts-centerY)*scale + float64(t.height)/2)
+	}
+	size := float32(ts * scale)
+
+	var found []tileMapPlacement
+	standIns := make(map[string]tileMapPlacement)
+	t.missing = t.missing[:0]
+	t.frame++
+	// At low zoom the viewport can span the world more than once, and the
+	// wrapped columns would report the same tile again
+	wraps := maxX-minX+1 > n
+
+	for ty := minY; ty <= maxY; ty++ {
+		for tx := minX; tx <= maxX; tx++ {
+			// Wrap around the antimeridian
+			wx := ((tx % n) + n) % n
+			x, y := place(tx, ty)
+
+			key := tileMapKey(z, wx, ty)
+			if tile, ok := t.tiles[key]; ok {
+				t.lru.MoveToFront(tile.elem)
+				tile.drawnAt = t.frame
+				found = append(found, tileMapPlacement{tile, x, y, size})
+				continue
+			}
+			if !wraps || !containsString(t.missing, key) {
+				t.missing = append(t.missing, key)
+			}
+
+			for up := 1; up <= tileMapAncestorHops && up <= z; up++ {
+				ancestor, ok := t.tiles[tileMapKey(z-up, wx>>uint(up), ty>>uint(up))]
+				if !ok {
+					continue
+				}
+				// Origin of the ancestor in tile units at z, on the unwrapped grid
+				ox := tx - wx + (wx>>uint(up))<<uint(up)
+				oy := (ty >> uint(up)) << uint(up)
+				standInKey := fmt.Sprintf("%s@%d", ancestor.key, ox)
+				if _, seen := standIns[standInKey]; !seen {
+					t.lru.MoveToFront(ancestor.elem)
+					ancestor.drawnAt = t.frame
+					ax, ay := place(ox, oy)
+					standIns[standInKey] = tileMapPlacement{ancestor, ax, ay, size * float32(int(1)<<uint(up))}
+				}
+				break
+			}
+		}
+	}
+
+	// Stand-ins first so exact tiles always end up on top
+	for _, p := range standIns {
+		t.blit(p)
+	}
+	for _, p := range found {
+		t.blit(p)
+	}
+
+	t.drawOverlays(geoPixelTransform{
+		centerX:   centerX / world,
+		centerY:   centerY / world,
+		worldSize: world * scale,
+		width:     float64(t.width),
+		height:    float64(t.height),
+	})
+
+	t.composed = true
+}
+
+// swap moves the last composite to the front; callers hold t.mu
+func (t *TileMap) swap() {
+	if t.composed {
+		t.front, t.back = t.back, t.front
+		t.composed = false
+	}
+}
+
+// drawOverlays projects every overlay into the viewport, clips it to the
+// visible area (widened by the stroke so edges don't show) and draws it
+func (t *TileMap) drawOverlays(transform geoPixelTransform) {
+	for _, id := range t.overlayOrder {
+		o := t.overlays[id]
+		t.projected = geoLngLatToPixels(o.lngLat, transform, t.projected)
+		pad := o.size + 1
+		minX, minY := -pad, -pad
+		maxX, maxY := float32(t.width)+pad, float32(t.height)+pad
+		c := o.color
+
+		switch o.kind {
+		case "polygon":
+			t.clipped = geoClipPolygon(t.projected, minX, minY, maxX, maxY, t.clipped)
+			rasterFillPolygon(t.back.Pix, t.width, t.height, t.clipped, c.R, c.G, c.B, c.A)
+		case "line":
+			var runs int
+			runs, t.clipped, t.runStarts = geoClipPolyline(t.projected, minX, minY, maxX, maxY, t.clipped, t.runStarts)
+			for i := 0; i < runs; i++ {
+				run := t.clipped[t.runStarts[i]*2 : t.runStarts[i+1]*2]
+				rasterStrokePolyline(t.back.Pix, t.width, t.height, run, o.size, c.R, c.G, c.B, c.A)
+			}
+		case "points":
+			t.indices = geoCullPoints(t.projected, minX, minY, maxX, maxY, t.indices)
+			t.circles = t.circles[:0]
+			t.colors = t.colors[:0]
+			packed := uint32(c.R) | uint32(c.G)<<8 | uint32(c.B)<<16 | uint32(c.A)<<24
+			for _, i := range t.indices {
+				t.circles = append(t.circles, t.projected[i*2], t.projected[i*2+1], o.size)
+				t.colors = append(t.colors, packed)
+			}
+			rasterFillCircles(t.back.Pix, t.width, t.height, t.circles, t.colors)
+		}
+	}
+}
+
+func (t *TileMap) blit(p tileMapPlacement) {
+	rasterBlit(t.back.Pix, t.width, t.height, p.tile.pix, p.tile.width, p.tile.height,
+		p.x, p.y, p.size, p.size)
+}
+
+// frontImage is the raster generator
+func (t *TileMap) frontImage(w, h int) image.Image {
+	t.mu.Lock()
+	defer t.mu.Unlock()
+	return t.front
+}
+
+// present shows the last composite and applies a pending resize. It runs on
+// the main thread: paints happen there too, so the front buffer never changes
+// under a paint, and composite only ever writes the buffer that isn't shown.
+func (t *TileMap) present() {
+	t.mu.Lock()
+	t.swap()
+	resized := t.resized
+	t.resized = false
+	size := fyne.NewSize(float32(t.width), float32(t.height))
+	raster := t.raster
+	t.mu.Unlock()
+
+	if resized {
+		raster.SetMinSize(size)
+		raster.Resize(size)
+	}
+	raster.Refresh()
+}
+
+// refresh composites under the lock and presents on the main thread
+func (t *TileMap) refresh() []string {
+	t.mu.Lock()
+	t.composite()
+	missing := append([]string(nil), t.missing...)
+	t.mu.Unlock()
+
+	fyneDo(t.present)
+	return missing
+}
+
+func (b *Bridge) getTileMap(msg Message) (*TileMap, *Response) {
+	widgetID := msg.Payload["widgetId"].(string)
+
+	b.mu.RLock()
+	t, exists := b.tileMaps[widgetID]
+	b.mu.RUnlock()
+	if !exists {
+		return nil, &Response{
+			ID:      msg.ID,
+			Success: false,
+			Error:   "Tile map widget not found",
+		}
+	}
+	return t, nil
+}
+
+// ============================================================================
+// Canvas Tile Map Handlers
+// ============================================================================
+
+// handleCreateCanvasTileMap creates a map widget that composites its tiles
+// inside the bridge
+func (b *Bridge) handleCreateCanvasTileMap(msg Message) Response {
+	widgetID := msg.Payload["id"].(string)
+	width := toInt(msg.Payload["width"])
+	height := toInt(msg.Payload["height"])
+	if width <= 0 || height <= 0 {
+		return Response{
+			ID:      msg.ID,
+			Success: false,
+			Error:   "Invalid tile map dimensions",
+		}
+	}
+
+	t := newTileMap(width, height)
+	if tileSize := toInt(msg.Payload["tileSize"]); tileSize > 0 {
+		t.tileSize = tileSize
+	}
+	if maxTiles := toInt(msg.Payload["maxTiles"]); maxTiles > 0 {
+		t.maxTiles = maxTiles
+	}
+	if bg, ok := msg.Payload["background"].(string); ok {
+		if c, ok := parseHexColor(bg); ok {
+			t.background = c
+		}
+	}
+
+	t.applyViewport(msg.Payload)
+	t.resized = false
+	t.composite()
+	t.swap() // Not on screen yet
+	raster := canvas.NewRaster(t.frontImage)
+	raster.SetMinSize(fyne.NewSize(float32(t.width), float32(t.height)))
+	t.raster = raster
+
+	b.mu.Lock()
+	if b.tileMaps == nil {
+		b.tileMaps = make(map[string]*TileMap)
+	}
+	b.tileMaps[widgetID] = t
+	b.widgets[widgetID] = raster
+	b.widgetMeta[widgetID] = WidgetMetadata{Type: "canvastilemap", Text: ""}
+	b.mu.Unlock()
+
+	return Response{
+		ID:      msg.ID,
+		Success: true,
+		Result: map[string]interface{}{
+			"widgetId": widgetID,
+			"missing":  append([]string(nil), t.missing...),
+		},
+	}
+}
+
+// handleSetCanvasTileMapViewport moves the map and reports the visible tiles
+// the cache doesn't have
+func (b *Bridge) handleSetCanvasTileMapViewport(msg Message) Response {
+	t, errResp := b.getTileMap(msg)
+	if errResp != nil {
+		return *errResp
+	}
+
+	t.mu.Lock()
+	t.applyViewport(msg.Payload)
+	t.mu.Unlock()
+
+	return Response{
+		ID:      msg.ID,
+		Success: true,
+		Result:  map[string]interface{}{"missing": t.refresh()},
+	}
+}
+
+// handlePutCanvasTileMapTiles adds encoded tiles to the cache and redraws.
+// Payload: tiles [{z, x, y, data (base64 PNG/JPEG)}, ...], clear (drop the
+// cache first)
+func (b *Bridge) handlePutCanvasTileMapTiles(msg Message) Response {
+	t, errResp := b.getTileMap(msg)
+	if errResp != nil {
+		return *errResp
+	}
+
+	var failed []string
+	t.mu.Lock()
+	if reset, ok := msg.Payload["clear"].(bool); ok && reset {
+		t.tiles = make(map[string]*tileMapTile)
+		t.lru.Init()
+	}
+	if tiles, ok := msg.Payload["tiles"].([]interface{}); ok {
+		for _, entry := range tiles {
+			m, ok := entry.(map[string]interface{})
+			if !ok {
+				continue
+			}
+			z, x, y := toInt(m["z"]), toInt(m["x"]), toInt(m["y"])
+			encoded, _ := m["data"].(string)
+			data, err := base64.StdEncoding.DecodeString(encoded)
+			if err == nil {
+				err = t.put(z, x, y, data)
+			}
+			if err != nil {
+				failed = append(failed, tileMapKey(z, x, y))
+			}
+		}
+	}
+	t.mu.Unlock()
+
+	missing := t.refresh()
+	if len(failed) > 0 {
+		return Response{
+			ID:      msg.ID,
+			Success: false,
+			Error:   fmt.Sprintf("Failed to decode tiles: %v", failed),
+			Result:  map[string]interface{}{"missing": missing, "failed": failed},
+		}
+	}
+	return Response{
+		ID:      msg.ID,
+		Success: true,
+		Result:  map[string]interface{}{"missing": missing},
+	}
+}
+
+// handleSetCanvasTileMapOverlay adds or replaces a geometry overlay and
+// redraws. Payload: overlayId, kind ("line", "polygon", "points"),
+// coordinates (base64 little-endian Float64Array of lng, lat pairs), color,
+// width (line width) or radius (point radius)
+func (b *Bridge) handleSetCanvasTileMapOverlay(msg Message) Response {
+	t, errResp := b.getTileMap(msg)
+	if errResp != nil {
+		return *errResp
+	}
+
+	overlayID, _ := msg.Payload["overlayId"].(string)
+	kind, _ := msg.Payload["kind"].(string)
+	if overlayID == "" || (kind != "line" && kind != "polygon" && kind != "points") {
+		return Response{
+			ID:      msg.ID,
+			Success: false,
+			Error:   "Overlay needs an overlayId and a kind of line, polygon or points",
+		}
+	}
+	encoded, _ := msg.Payload["coordinates"].(string)
+	raw, err := base64.StdEncoding.DecodeString(encoded)
+	if err != nil || len(raw)%16 != 0 {
+		return Response{
+			ID:      msg.ID,
+			Success: false,
+			Error:   "Overlay coordinates must be base64 Float64 lng/lat pairs",
+		}
+	}
+
+	overlay := &tileMapOverlay{
+		kind:   kind,
+		lngLat: make([]float64, len(raw)/8),
+		color:  color.NRGBA{R: 33, G: 150, B: 243, A: 255},
+		size:   2,
+	}
+	for i := range overlay.lngLat {
+		overlay.lngLat[i] = math.Float64frombits(binary.LittleEndian.Uint64(raw[i*8:]))
+	}
+	if c, ok := msg.Payload["color"].(string); ok {
+		if parsed, ok := parseHexColor(c); ok {
+			overlay.color = parsed
+		}
+	}
+	if kind == "points" {
+		overlay.size = 4
+		if v, ok := getFloat64(msg.Payload["radius"]); ok && v > 0 {
+			overlay.size = float32(v)
+		}
+	} else if v, ok := getFloat64(msg.Payload["width"]); ok && v > 0 {
+		overlay.size = float32(v)
+	}
+
+	t.mu.Lock()
+	if _, exists := t.overlays[overlayID]; !exists {
+		t.overlayOrder = append(t.overlayOrder, overlayID)
+	}
+	t.overlays[overlayID] = overlay
+	t.mu.Unlock()
+
+	return Response{
+		ID:      msg.ID,
+		Success: true,
+		Result:  map[string]interface{}{"missing": t.refresh()},
+	}
+}
+
+// handleRemoveCanvasTileMapOverlay drops an overlay and redraws
+func (b *Bridge) handleRemoveCanvasTileMapOverlay(msg Message) Response {
+	t, errResp := b.getTileMap(msg)
+	if errResp != nil {
+		return *errResp
+	}
+
+	overlayID, _ := msg.Payload["overlayId"].(string)
+	t.mu.Lock()
+	if _, exists := t.overlays[overlayID]; exists {
+		delete(t.overlays, overlayID)
+		for i, id := range t.overlayOrder {
+			if id == overlayID {
+				t.overlayOrder = append(t.overlayOrder[:i], t.overlayOrder[i+1:]...)
+				break
+			}
+		}
+	}
+	t.mu.Unlock()
+
+	return Response{
+		ID:      msg.ID,
+		Success: true,
+		Result:  map[string]interface{}{"missing": t.refresh()},
+	}
+}
+
+// handleGetCanvasTileMapInfo reports cache occupancy and the missing tiles
+func (b *Bridge) handleGetCanvasTileMapInfo(msg Message) Response {
+	t, errResp := b.getTileMap(msg)
+	if errResp != nil {
+		return *errResp
+	}
+
+	t.mu.Lock()
+	defer t.mu.Unlock()
+	cachedBytes := 0
+	for _, tile := range t.tiles {
+		cachedBytes += len(tile.pix)
+	}
+	return Response{
+		ID:      msg.ID,
+		Success: true,
+		Result: map[string]interface{}{
+			"tiles":   len(t.tiles),
+			"bytes":   cachedBytes,
+			"missing": append([]string(nil), t.missing...),
+		},
+	}
+}
@@ -0,0 +1,160 @@
+package main
+
+import (
+	"bytes"
+	"image"
+	"image/png"
+	"testing"
+
+	"fyne.io/fyne/v2"
+	"fyne.io/fyne/v2/canvas"
+)
+
+// testTilePNG is a small solid tile; the compositor scales it to tileSize
+func testTilePNG(t *testing.T) []byte {
+	img := image.NewNRGBA(image.Rect(0, 0, 8, 8))
+	for i := 0; i < len(img.Pix); i += 4 {
+		img.Pix[i], img.Pix[i+3] = 200, 255
+	}
+	var buf bytes.Buffer
+	if err := png.Encode(&buf, img); err != nil {
+		t.Fatal(err)
+	}
+	return buf.Bytes()
+}
+
+// newTestTileMap has a raster so refresh can present to it
+func newTestTileMap(width, height, maxTiles int) *TileMap {
+	tm := newTileMap(width, height)
+	tm.maxTiles = maxTiles
+	tm.raster = canvas.NewRaster(tm.frontImage)
+	return tm
+}
+
+func TestTileMapMissing(t *testing.T) {
+	tests := []struct {
+		name     string
+		viewport map[string]interface{}
+		want     []string
+	}{
+		{
+			"one world",
+			map[string]interface{}{"lng": 0.0, "lat": 0.0, "zoom": 1.0},
+			[]string{"1/0/0", "1/1/0", "1/0/1", "1/1/1"},
+		},
+		{
+			"wrapped columns reported once",
+			map[string]interface{}{"lng": 0.0, "lat": 0.0, "zoom": 0.0, "width": 600, "height": 256},
+			[]string{"0/0/0"},
+		},
+		{
+			"wrapped row at zoom 1",
+			map[string]interface{}{"lng": 0.0, "lat": 0.0, "zoom": 1.0, "width": 1200, "height": 500},
+			[]string{"1/0/0", "1/1/0", "1/0/1", "1/1/1"},
+		},
+	}
+	for _, tc := range tests {
+		t.Run(tc.name, func(t *testing.T) {
+			tm := newTestTileMap(500, 500, 128)
+			tm.applyViewport(tc.viewport)
+			tm.composite()
+			if len(tm.missing) != len(tc.want) {
+				t.Fatalf("missing = %v, want %v", tm.missing, tc.want)
+			}
+			for i := range tc.want {
+				if tm.missing[i] != tc.want[i] {
+					t.Fatalf("missing = %v, want %v", tm.missing, tc.want)
+				}
+			}
+		})
+	}
+}
+
+// TestTileMapKeepsVisibleTiles fills a view that needs more tiles than the
+// cache holds without evicting any of them
+func TestTileMapKeepsVisibleTiles(t *testing.T) {
+	tile := testTilePNG(t)
+	tm := newTestTileMap(500, 500, 2)
+	tm.applyViewport(map[string]interface{}{"lng": 0.0, "lat": 0.0, "zoom": 1.0})
+	tm.composite()
+
+	for _, xy := range [][2]int{{0, 0}, {1, 0}, {0, 1}, {1, 1}} {
+		if err := tm.put(1, xy[0], xy[1], tile); err != nil {
+			t.Fatal(err)
+		}
+	}
+	tm.composite()
+	if len(tm.missing) != 0 || len(tm.tiles) != 4 {
+		t.Fatalf("after filling the view: missing %v, %d tiles cached", tm.missing, len(tm.tiles))
+	}
+
+	// A tile nobody is looking at goes first
+	if err := tm.put(5, 3, 3, tile); err != nil {
+		t.Fatal(err)
+	}
+	if _, ok := tm.tiles["5/3/3"]; ok || len(tm.tiles) != 4 {
+		t.Errorf("off-screen tile kept over visible ones: %d tiles cached", len(tm.tiles))
+	}
+
+	// Once the view shrinks to one tile the rest are fair game again
+	tm.applyViewport(map[string]interface{}{"lng": -90.0, "lat": 66.51326, "width": 250, "height": 250})
+	tm.composite()
+	if err := tm.put(5, 3, 3, tile); err != nil {
+		t.Fatal(err)
+	}
+	if len(tm.tiles) != 2 {
+		t.Errorf("%d tiles cached, want 2", len(tm.tiles))
+	}
+	for _, key := range []string{"1/0/0", "5/3/3"} {
+		if _, ok := tm.tiles[key]; !ok {
+			t.Errorf("%s was evicted", key)
+		}
+	}
+}
+
+// TestTileMapCompositeKeepsFront checks that compositing never touches the
+// shown buffer and that a resize only reaches the raster when presented
+func TestTileMapCompositeKeepsFront(t *testing.T) {
+	tm := newTestTileMap(64, 64, 128)
+	front := tm.front
+	shown := append([]byte(nil), front.Pix...)
+
+	tm.applyViewport(map[string]interface{}{"zoom": 1.0, "width": 100, "height": 80})
+	tm.composite()
+	if tm.front != front || !bytes.Equal(front.Pix, shown) {
+		t.Fatal("composite wrote to the front buffer")
+	}
+	if tm.raster.MinSize() != (fyne.Size{}) {
+		t.Fatal("raster resized off the main thread")
+	}
+
+	tm.present()
+	want := fyne.NewSize(100, 80)
+	if tm.front == front || tm.front.Bounds().Dx() != 100 || tm.front.Bounds().Dy() != 80 {
+		t.Errorf("front is %v after present, want the 100x80 composite", tm.front.Bounds())
+	}
+	if tm.raster.MinSize() != want || tm.raster.Size() != want {
+		t.Errorf("raster min %v size %v, want %v", tm.raster.MinSize(), tm.raster.Size(), want)
+	}
+
+	// Presenting again without a new composite keeps the same frame
+	shownNow := tm.front
+	tm.present()
+	if tm.front != shownNow {
+		t.Error("present swapped in a stale buffer")
+	}
+}
+
+func TestRemoveWidgetTreeFreesTileMap(t *testing.T) {
+	tm := newTestTileMap(64, 64, 128)
+	bridge := &Bridge{
+		widgets:    map[string]fyne.CanvasObject{"tilemap_1": tm.raster},
+		widgetMeta: map[string]WidgetMetadata{"tilemap_1": {Type: "canvastilemap"}},
+		tileMaps:   map[string]*TileMap{"tilemap_1": tm},
+	}
+
+	bridge.removeWidgetTree("tilemap_1")
+	if len(bridge.tileMaps) != 0 {
+		t.Error("tile map still registered after removal")
+	}
+}
@@ -431,7 +431,7 @@ func (b *Bridge) handleSetTextGridText(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		tsyneTextGrid.TextGrid.SetText(text)
 		tsyneTextGrid.TextGrid.Refresh()
 	})
@@ -469,7 +469,7 @@ func (b *Bridge) handleSetTextGridCell(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		if hasChar && len(char) > 0 {
 			// Set rune at position
 			tsyneTextGrid.TextGrid.SetRune(row, col, rune(char[0]))
@@ -530,7 +530,7 @@ func (b *Bridge) handleSetTextGridRow(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		tsyneTextGrid.TextGrid.SetRow(row, widget.TextGridRow{Cells: cells})
 		tsyneTextGrid.TextGrid.Refresh()
 	})
@@ -569,7 +569,7 @@ func (b *Bridge) handleSetTextGridStyle(msg Message) Response {
 	}
 
 	style := parseTextGridStyle(styleData)
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		tsyneTextGrid.TextGrid.SetStyle(row, col, style)
 		tsyneTextGrid.TextGrid.Refresh()
 	})
@@ -610,7 +610,7 @@ func (b *Bridge) handleSetTextGridStyleRange(msg Message) Response {
 	}
 
 	style := parseTextGridStyle(styleData)
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		tsyneTextGrid.TextGrid.SetStyleRange(startRow, startCol, endRow, endCol, style)
 		tsyneTextGrid.TextGrid.Refresh()
 	})
@@ -1173,7 +1173,7 @@ func (b *Bridge) handleDesktopMDIAddWindow(msg Message) Response {
 	}
 
 	// Add the window to the container
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		desktop.AddWindow(innerWin)
 
 		// Register drop callback if provided
@@ -1262,7 +1262,7 @@ func (b *Bridge) handleDesktopMDIRemoveWindow(msg Message) Response {
 	}
 
 	// Remove the window from the container
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		desktop.RemoveWindow(innerWin)
 	})
 
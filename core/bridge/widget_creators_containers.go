@@ -146,7 +146,7 @@ func (b *Bridge) handleSetScrollMinHeight(msg Message) Response {
 		}
 	}
 
-	fyne.Do(func() {
+	fyneDo(func() {
 		scroll.SetMinSize(fyne.NewSize(scroll.MinSize().Width, minHeight))
 	})
 
@@ -182,7 +182,7 @@ func (b *Bridge) handleSetScrollMinSize(msg Message) Response {
 		}
 	}
 
-	fyne.Do(func() {
+	fyneDo(func() {
 		scroll.SetMinSize(fyne.NewSize(minWidth, minHeight))
 	})
 
@@ -216,7 +216,7 @@ func (b *Bridge) handleScrollToBottom(msg Message) Response {
 		}
 	}
 
-	fyne.Do(func() {
+	fyneDo(func() {
 		scroll.ScrollToBottom()
 	})
 
@@ -250,7 +250,7 @@ func (b *Bridge) handleScrollToTop(msg Message) Response {
 		}
 	}
 
-	fyne.Do(func() {
+	fyneDo(func() {
 		scroll.ScrollToTop()
 	})
 
@@ -1327,7 +1327,7 @@ func (b *Bridge) handleTabsSelect(msg Message) Response {
 		}
 	}
 
-	fyne.Do(func() {
+	fyneDo(func() {
 		tabs.Select(items[tabIndex])
 	})
 
@@ -1513,7 +1513,7 @@ func (b *Bridge) handleInnerWindowClose(msg Message) Response {
 	}
 	b.mu.RUnlock()
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		innerWindow.Close()
 	})
 
@@ -1561,7 +1561,7 @@ func (b *Bridge) handleSetInnerWindowContent(msg Message) Response {
 	bgRect := canvas.NewRectangle(theme.BackgroundColor())
 	contentWithBg := container.NewStack(bgRect, content)
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		innerWindow.SetContent(contentWithBg)
 	})
 
@@ -2127,7 +2127,7 @@ func (b *Bridge) handleMultipleWindowsAddWindow(msg Message) Response {
 	}
 
 	// Add the window to the container
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		multiWin.Add(innerWin)
 
 		// Position the window if coordinates provided, otherwise center it
@@ -2211,7 +2211,7 @@ func (b *Bridge) handleMultipleWindowsRemoveWindow(msg Message) Response {
 	}
 
 	// Close the inner window (MultipleWindows container handles this automatically)
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		innerWin.Close()
 	})
 	// Suppress unused variable warning
@@ -2283,7 +2283,7 @@ func (b *Bridge) handleMoveWidget(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		widget.Move(fyne.NewPos(float32(x), float32(y)))
 		// If size provided, resize; otherwise use MinSize
 		var size fyne.Size
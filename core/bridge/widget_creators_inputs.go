@@ -812,7 +812,7 @@ func (b *Bridge) handleCreateCompletionEntry(msg Message) Response {
 	var widgetToStore fyne.CanvasObject
 
 	// Create widget on Fyne main thread
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		completionEntry = xWidget.NewCompletionEntry(options)
 		completionEntry.SetPlaceHolder(placeholder)
 
@@ -900,7 +900,7 @@ func (b *Bridge) handleSetCompletionEntryOptions(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		completionEntry.SetOptions(options)
 	})
 
@@ -938,7 +938,7 @@ func (b *Bridge) handleShowCompletion(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		completionEntry.ShowCompletion()
 	})
 
@@ -976,7 +976,7 @@ func (b *Bridge) handleHideCompletion(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		completionEntry.HideCompletion()
 	})
 
@@ -106,7 +106,7 @@ func (b *Bridge) handleSetText(msg Message) Response {
 	}
 
 	// UI updates must happen on the main thread
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		switch w := actualWidget.(type) {
 		case *widget.Label:
 			w.SetText(text)
@@ -232,7 +232,7 @@ func (b *Bridge) handleSetChecked(msg Message) Response {
 	if check, ok := obj.(*widget.Check); ok {
 		// UI updates must happen on the main thread
 		// Temporarily disable OnChanged to prevent infinite loops when setting initial state
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			originalCallback := check.OnChanged
 			check.OnChanged = nil
 			check.SetChecked(checked)
@@ -299,7 +299,7 @@ func (b *Bridge) handleSetValue(msg Message) Response {
 
 	if slider, ok := obj.(*widget.Slider); ok {
 		// UI updates must happen on the main thread
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			slider.SetValue(value)
 		})
 		return Response{
@@ -363,7 +363,7 @@ func (b *Bridge) handleSetProgress(msg Message) Response {
 
 	if pb, ok := obj.(*widget.ProgressBar); ok {
 		// UI updates must happen on the main thread
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			pb.SetValue(value)
 		})
 		return Response{
@@ -427,7 +427,7 @@ func (b *Bridge) handleSetSelected(msg Message) Response {
 
 	if sel, ok := obj.(*widget.Select); ok {
 		// UI updates must happen on the main thread
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			sel.SetSelected(selected)
 		})
 		return Response{
@@ -467,7 +467,7 @@ func (b *Bridge) handleSetSelectOptions(msg Message) Response {
 
 	if sel, ok := obj.(*widget.Select); ok {
 		// UI updates must happen on the main thread
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			sel.Options = options
 			sel.Refresh()
 		})
@@ -508,7 +508,7 @@ func (b *Bridge) handleSetRadioOptions(msg Message) Response {
 
 	if radio, ok := obj.(*widget.RadioGroup); ok {
 		// UI updates must happen on the main thread
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			radio.Options = options
 			radio.Refresh()
 		})
@@ -573,7 +573,7 @@ func (b *Bridge) handleSetRadioSelected(msg Message) Response {
 
 	if radio, ok := obj.(*widget.RadioGroup); ok {
 		// UI updates must happen on the main thread
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			radio.SetSelected(selected)
 		})
 		return Response{
@@ -643,7 +643,7 @@ func (b *Bridge) handleSetCheckGroupSelected(msg Message) Response {
 
 	if checkGroup, ok := obj.(*widget.CheckGroup); ok {
 		// UI updates must happen on the main thread
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			checkGroup.SetSelected(selected)
 		})
 		return Response{
@@ -713,7 +713,7 @@ func (b *Bridge) handleUpdateTableData(msg Message) Response {
 
 	if table, ok := obj.(*widget.Table); ok {
 		// UI updates must happen on the main thread
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			table.Refresh()
 		})
 		return Response{
@@ -778,7 +778,7 @@ func (b *Bridge) handleUpdateListData(msg Message) Response {
 
 	if list, ok := obj.(*widget.List); ok {
 		// UI updates must happen on the main thread
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			list.Refresh()
 		})
 		return Response{
@@ -811,7 +811,7 @@ func (b *Bridge) handleUnselectAllList(msg Message) Response {
 
 	if list, ok := obj.(*widget.List); ok {
 		// UI updates must happen on the main thread
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			list.UnselectAll()
 		})
 		return Response{
@@ -1013,7 +1013,7 @@ func (b *Bridge) handleUpdateImage(msg Message) Response {
 	}
 
 	// UI updates must happen on the main thread
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		imgWidget.Image = decodedImg
 		// Update MinSize based on the new image dimensions
 		// Use a reasonable minimum (200x200) to avoid forcing window to be huge
@@ -1108,7 +1108,7 @@ func (b *Bridge) handleGetContainerObjects(msg Message) Response {
 
 	// Get container objects (child widget IDs)
 	var childIDs []string
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		for _, childObj := range container.Objects {
 			// Find the widget ID for this object (reverse lookup)
 			b.mu.RLock()
@@ -1610,7 +1610,7 @@ func (b *Bridge) handleStartProgressInfinite(msg Message) Response {
 	}
 
 	if pb, ok := obj.(*widget.ProgressBarInfinite); ok {
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			pb.Start()
 		})
 		return Response{
@@ -1642,7 +1642,7 @@ func (b *Bridge) handleStopProgressInfinite(msg Message) Response {
 	}
 
 	if pb, ok := obj.(*widget.ProgressBarInfinite); ok {
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			pb.Stop()
 		})
 		return Response{
@@ -1713,7 +1713,7 @@ func (b *Bridge) handleSetSelectEntryOptions(msg Message) Response {
 
 	if selectEntry, ok := obj.(*widget.SelectEntry); ok {
 		// UI updates must happen on the main thread
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			selectEntry.SetOptions(options)
 		})
 		return Response{
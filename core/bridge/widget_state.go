@@ -20,7 +20,7 @@ func (b *Bridge) handleShowWidget(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		obj.Show()
 	})
 
@@ -45,7 +45,7 @@ func (b *Bridge) handleHideWidget(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		obj.Hide()
 	})
 
@@ -75,7 +75,7 @@ func (b *Bridge) handleEnableWidget(msg Message) Response {
 	// If we have a separate entry reference (from TappableEntry), use that
 	if hasEntry {
 		if entry, ok := entryObj.(*widget.Entry); ok {
-			fyne.DoAndWait(func() {
+			fyneDoAndWait(func() {
 				entry.Enable()
 			})
 			return Response{
@@ -87,7 +87,7 @@ func (b *Bridge) handleEnableWidget(msg Message) Response {
 
 	// Try to enable the widget directly
 	if disableable, ok := obj.(fyne.Disableable); ok {
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			disableable.Enable()
 		})
 		return Response{
@@ -123,7 +123,7 @@ func (b *Bridge) handleDisableWidget(msg Message) Response {
 	// If we have a separate entry reference (from TappableEntry), use that
 	if hasEntry {
 		if entry, ok := entryObj.(*widget.Entry); ok {
-			fyne.DoAndWait(func() {
+			fyneDoAndWait(func() {
 				entry.Disable()
 			})
 			return Response{
@@ -135,7 +135,7 @@ func (b *Bridge) handleDisableWidget(msg Message) Response {
 
 	// Try to disable the widget directly
 	if disableable, ok := obj.(fyne.Disableable); ok {
-		fyne.DoAndWait(func() {
+		fyneDoAndWait(func() {
 			disableable.Disable()
 		})
 		return Response{
@@ -89,7 +89,7 @@ func (b *Bridge) handleCreateWindow(msg Message) Response {
 	var win fyne.Window
 
 	// Window creation must happen on the main thread
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		// Apply theme on first window creation (when event loop is running)
 		b.mu.Lock()
 		if len(b.windows) == 0 && b.scalableTheme != nil {
@@ -200,12 +200,12 @@ func (b *Bridge) handleCreateWindow(msg Message) Response {
 						windowCount := len(b.windows)
 						b.mu.Unlock()
 
-						fyne.DoAndWait(func() {
+						fyneDoAndWait(func() {
 							win.Close()
 						})
 
 						if windowCount == 0 {
-							fyne.Do(func() {
+							fyneDo(func() {
 								b.app.Quit()
 							})
 						}
@@ -223,7 +223,7 @@ func (b *Bridge) handleCreateWindow(msg Message) Response {
 
 				// If no more windows, quit the application
 				if windowCount == 0 {
-					fyne.Do(func() {
+					fyneDo(func() {
 						b.app.Quit()
 					})
 				}
@@ -254,7 +254,7 @@ func (b *Bridge) handleShowWindow(msg Message) Response {
 	}
 
 	// Showing window must happen on the main thread
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		win.Show()
 
 	})
@@ -282,7 +282,7 @@ func (b *Bridge) handleSetWindowTitle(msg Message) Response {
 	}
 
 	// Setting window title must happen on the main thread
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		win.SetTitle(title)
 	})
 
@@ -335,7 +335,7 @@ func (b *Bridge) handleCaptureWindow(msg Message) Response {
 	var img image.Image
 
 	// Canvas capture must happen on main thread
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		img = win.Canvas().Capture()
 	})
 
@@ -438,7 +438,7 @@ func (b *Bridge) handleSetWindowIcon(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		resource := fyne.NewStaticResource(resourceName, iconData)
 		win.SetIcon(resource)
 	})
@@ -514,7 +514,7 @@ func (b *Bridge) handleCloseWindow(msg Message) Response {
 	windowCount := len(b.windows)
 	b.mu.Unlock()
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		win.Close()
 		// If no more windows, quit the application
 		if windowCount == 0 {
@@ -543,7 +543,7 @@ func (b *Bridge) handleRequestFocusWindow(msg Message) Response {
 		}
 	}
 
-	fyne.DoAndWait(func() {
+	fyneDoAndWait(func() {
 		win.RequestFocus()
 	})
 
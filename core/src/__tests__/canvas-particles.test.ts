@@ -0,0 +1,57 @@
+import { CanvasParticles } from '../widgets';
+import { Context } from '../context';
+import { BridgeInterface } from '../fynebridge';
+
+describe('CanvasParticles', () => {
+  let ctx: Context;
+  let mockBridge: Partial<BridgeInterface>;
+
+  beforeEach(() => {
+    mockBridge = {
+      send: jest.fn((action: string) =>
+        Promise.resolve(action === 'getCanvasParticlesInfo' ? { count: 42, running: true } : undefined)
+      ),
+    };
+    ctx = new Context(mockBridge as BridgeInterface);
+  });
+
+  test('creates the widget with emitter parameters', () => {
+    const particles = new CanvasParticles(ctx, {
+      width: 320,
+      height: 240,
+      background: '#000000',
+      emitter: { x: 160, y: 240, rate: 200, gravityY: 98, colors: ['#ffcc00', '#ff000000'] },
+    });
+
+    expect(mockBridge.send).toHaveBeenCalledWith(
+      'createCanvasParticles',
+      expect.objectContaining({
+        id: particles.id,
+        width: 320,
+        height: 240,
+        background: '#000000',
+        emitter: expect.objectContaining({ rate: 200, gravityY: 98 }),
+      })
+    );
+  });
+
+  test('sends only parameter changes after creation', async () => {
+    const particles = new CanvasParticles(ctx, { width: 100, height: 100 });
+    await particles.setEmitter({ x: 10 });
+    await particles.bursts([{ count: 50, x: 20, y: 30 }, { count: 80 }]);
+    await particles.stop();
+
+    expect(mockBridge.send).toHaveBeenCalledWith('updateCanvasParticles', { widgetId: particles.id, emitter: { x: 10 } });
+    expect(mockBridge.send).toHaveBeenCalledWith('updateCanvasParticles', {
+      widgetId: particles.id,
+      bursts: [{ count: 50, x: 20, y: 30 }, { count: 80 }],
+    });
+    expect(mockBridge.send).toHaveBeenCalledWith('updateCanvasParticles', { widgetId: particles.id, running: false });
+    expect(mockBridge.send).toHaveBeenCalledTimes(4);
+  });
+
+  test('reports the bridge particle count', async () => {
+    const particles = new CanvasParticles(ctx, { width: 100, height: 100 });
+    expect(await particles.getParticleCount()).toBe(42);
+  });
+});
@@ -0,0 +1,85 @@
+import { CanvasTileMap } from '../widgets';
+import { Context } from '../context';
+import { BridgeInterface } from '../fynebridge';
+
+describe('CanvasTileMap', () => {
+  let ctx: Context;
+  let mockBridge: Partial<BridgeInterface>;
+
+  beforeEach(() => {
+    mockBridge = {
+      send: jest.fn((action: string) =>
+        Promise.resolve(action === 'getCanvasTileMapInfo'
+          ? { tiles: 4, bytes: 4 * 256 * 256 * 4, missing: [] }
+          : { missing: ['3/4/2'] })
+      ),
+    };
+    ctx = new Context(mockBridge as BridgeInterface);
+  });
+
+  test('creates the widget with its viewport', async () => {
+    const map = new CanvasTileMap(ctx, {
+      width: 400,
+      height: 300,
+      center: { lng: 2.35, lat: 48.85 },
+      zoom: 12,
+      maxTiles: 64,
+    });
+
+    expect(mockBridge.send).toHaveBeenCalledWith('createCanvasTileMap', {
+      id: map.id,
+      width: 400,
+      height: 300,
+      lng: 2.35,
+      lat: 48.85,
+      zoom: 12,
+      maxTiles: 64,
+    });
+    expect(await map.getInitialMissingTiles()).toEqual(['3/4/2']);
+  });
+
+  test('pans with viewport-only messages', async () => {
+    const map = new CanvasTileMap(ctx, { width: 256, height: 256 });
+    const missing = await map.setViewport({ lng: 10, lat: 20 }, 3.5);
+
+    expect(missing).toEqual(['3/4/2']);
+    expect(mockBridge.send).toHaveBeenCalledWith('setCanvasTileMapViewport', {
+      widgetId: map.id,
+      lng: 10,
+      lat: 20,
+      zoom: 3.5,
+    });
+  });
+
+  test('uploads encoded tiles as base64', async () => {
+    const map = new CanvasTileMap(ctx, { width: 256, height: 256 });
+    const bytes = new Uint8Array([0x89, 0x50, 0x4e, 0x47]);
+    await map.putTiles([
+      { z: 3, x: 4, y: 2, data: bytes },
+      { z: 3, x: 5, y: 2, data: bytes.buffer },
+    ]);
+
+    expect(mockBridge.send).toHaveBeenCalledWith('putCanvasTileMapTiles', {
+      widgetId: map.id,
+      tiles: [
+        { z: 3, x: 4, y: 2, data: 'iVBORw==' },
+        { z: 3, x: 5, y: 2, data: 'iVBORw==' },
+      ],
+    });
+    expect((await map.getInfo()).tiles).toBe(4);
+  });
+
+  test('sends overlays as base64 lng/lat doubles', async () => {
+    const map = new CanvasTileMap(ctx, { width: 256, height: 256 });
+    const coordinates = new Float64Array([2.35, 48.85, 2.36, 48.86]);
+    await map.setOverlay('track', { kind: 'line', coordinates, color: '#ff0000', width: 3 });
+
+    const sent = (mockBridge.send as jest.Mock).mock.calls.find(call => call[0] === 'setCanvasTileMapOverlay')![1];
+    expect(sent).toMatchObject({ widgetId: map.id, overlayId: 'track', kind: 'line', color: '#ff0000', width: 3 });
+    const bytes = Buffer.from(sent.coordinates, 'base64');
+    expect(Array.from(new Float64Array(bytes.buffer, bytes.byteOffset, 4))).toEqual([2.35, 48.85, 2.36, 48.86]);
+
+    await map.removeOverlay('track');
+    expect(mockBridge.send).toHaveBeenCalledWith('removeCanvasTileMapOverlay', { widgetId: map.id, overlayId: 'track' });
+  });
+});
@@ -296,11 +296,11 @@ export class Animation {
 
     this.tickerStop = ticker(16, () => {
       if (!this.started) {
-        this.startTime = Date.now();
+        this.startTime = performance.now();
         this.started = true;
       }
 
-      const elapsed = Date.now() - this.startTime;
+      const elapsed = performance.now() - this.startTime;
 
       // Handle delay
       if (elapsed < this.delayMs) {
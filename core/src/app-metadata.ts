@@ -26,7 +26,8 @@
 
 import * as fs from 'fs';
 import * as path from 'path';
-import { executeInSandbox, SandboxRuntimeType } from './sandbox-runtime';
+import { executeInSandbox, getIsolatePool, SandboxRuntimeType } from './sandbox-runtime';
+import type { BridgeInterface } from './fynebridge';
 import { loadAndExecuteFile, getCacheStats } from './transpile-cache';
 
 export interface AppMetadata {
@@ -412,6 +413,15 @@ let sandboxConfig: SandboxConfig = { enabled: false, runtime: 'vm' };
  */
 export function setSandboxConfig(config: SandboxConfig): void {
   sandboxConfig = { runtime: 'vm', ...config };
+
+  // Start warming isolates now, so the first sandboxed app doesn't wait
+  if (sandboxConfig.enabled && sandboxConfig.runtime === 'isolated-vm') {
+    try {
+      getIsolatePool(sandboxConfig.memoryLimitMB || 128);
+    } catch {
+      // isolated-vm missing: loading the app reports it
+    }
+  }
 }
 
 /**
@@ -435,15 +445,18 @@ export function getSandboxConfig(): SandboxConfig {
  *   - Apps cannot access real require, eval, process, etc.
  *   - Each app gets its own unique token - can't call each other's functions
  *   - Choice of 'vm' (fast) or 'isolated-vm' (secure) runtime
+ *   - With a bridge, isolated-vm apps reach it as globalThis.__tsyneBridge;
+ *     their isolate lives until the returned dispose() is called
  */
 export async function loadAppBuilderSandboxed(
   metadata: AppMetadata,
-  _tsyneExports: any  // The tsyne module exports to inject (for future use)
-): Promise<{ builder: ((...args: any[]) => void | Promise<void>) | null; token: string | null }> {
+  _tsyneExports: any,  // The tsyne module exports to inject (for future use)
+  bridge?: BridgeInterface
+): Promise<{ builder: ((...args: any[]) => void | Promise<void>) | null; token: string | null; dispose: () => void }> {
   if (!sandboxConfig.enabled) {
     // Development mode: use normal require
     const builder = await loadAppBuilder(metadata);
-    return { builder, token: null };
+    return { builder, token: null, dispose: () => {} };
   }
 
   try {
@@ -456,6 +469,7 @@ export async function loadAppBuilderSandboxed(
       memoryLimitMB: sandboxConfig.memoryLimitMB,
       timeoutMs: sandboxConfig.timeoutMs || 5000,
       allowedModules: sandboxConfig.allowedModules || [],
+      bridge,
     });
 
     // Extract the builder function
@@ -463,12 +477,13 @@ export async function loadAppBuilderSandboxed(
 
     if (typeof builder !== 'function') {
       console.error(`Builder function '${metadata.builder}' not found in sandboxed module ${metadata.filePath}`);
-      return { builder: null, token: result.token };
+      result.dispose();
+      return { builder: null, token: result.token, dispose: () => {} };
     }
 
-    return { builder, token: result.token };
+    return { builder, token: result.token, dispose: result.dispose };
   } catch (error) {
     console.error(`Error loading sandboxed app from ${metadata.filePath}:`, error);
-    return { builder: null, token: null };
+    return { builder: null, token: null, dispose: () => {} };
   }
 }
@@ -215,6 +215,8 @@ const ${transformedName('global', token)} = Object.freeze({
   Error: Error,
   TypeError: TypeError,
   RangeError: RangeError,
+  // Bridge channel, installed by the isolated-vm runtime when it has a bridge
+  __tsyneBridge: typeof __tsyneBridge !== 'undefined' ? __tsyneBridge : undefined,
   // Explicitly NOT including: process, require, eval, Function, Buffer, etc.
 });
 
@@ -3,6 +3,7 @@ import { GrpcBridgeConnection } from './grpcbridge';
 import { MsgpackBridgeConnection } from './msgpackbridge';
 import { FfiBridgeConnection } from './ffibridge';
 import { WebRendererBridge } from './webrendererbridge';
+import { getTracer, exportChromeTrace } from './tracing';
 import { Context } from './context';
 import { Window, WindowOptions } from './window';
 import { ITsyneWindow, createTsyneWindow, isDesktopMode, isPhoneMode } from './tsyne-window';
@@ -90,6 +91,10 @@ import {
   CanvasGauge,
   CanvasGaugeOptions,
   CanvasLine,
+  CanvasParticles,
+  CanvasParticlesOptions,
+  CanvasTileMap,
+  CanvasTileMapOptions,
   CanvasLinearGradient,
   CanvasPath,
   CanvasPathOptions,
@@ -1071,6 +1076,20 @@ export class App {
     return new CanvasGauge(this.ctx, options);
   }
 
+  /**
+   * Create a particle system that simulates and renders inside the bridge
+   */
+  canvasParticles(options: CanvasParticlesOptions): CanvasParticles {
+    return new CanvasParticles(this.ctx, options);
+  }
+
+  /**
+   * Create a map widget whose tiles are cached and composited inside the bridge
+   */
+  canvasTileMap(options: CanvasTileMapOptions): CanvasTileMap {
+    return new CanvasTileMap(this.ctx, options);
+  }
+
   // Simple canvas primitive aliases for common use cases
   /**
    * Create a colored rectangle - simplified API for backgrounds, dividers, and placeholder boxes
@@ -1222,6 +1241,14 @@ export class App {
   }
 
   quit(): void {
+    // With TSYNE_TRACE set, collect the bridge's spans before it goes away
+    const tracer = getTracer();
+    if (tracer?.outputPath) {
+      exportChromeTrace(this.ctx.bridge, tracer.outputPath, tracer)
+        .catch((err) => console.error('Failed to write trace:', err))
+        .finally(() => this.ctx.bridge.quit());
+      return;
+    }
     this.ctx.bridge.quit();
   }
 
@@ -7,6 +7,7 @@
  *   tsyne run <app.ts>        # Run an app
  *   tsyne dev <app.ts>        # Hot reload, inspector, debugging
  *   tsyne build <app.ts>      # Package for distribution
+ *   tsyne precompile <app.ts> # Bundle and cache an app and its imports
  *   tsyne test                # Run tests
  *   tsyne --version           # Report all component versions
  */
@@ -15,6 +16,7 @@ import { PROTOCOL_VERSION, TSYNE_VERSION } from './version';
 import { checkAppVersion, getVersionRequirement, validateVersion } from './app-version';
 import { processGrabDirectives, parseGrabDirectives, listCachedPackages, clearCache, getGrabCacheDir } from './grab';
 import { showVersionMismatchDialog, openUpdatePage } from './version-dialog';
+import { precompileApp } from './transpile-cache';
 import { spawn, execSync } from 'child_process';
 import * as path from 'path';
 import * as fs from 'fs';
@@ -117,6 +119,7 @@ Commands:
   run <app.ts>      Run a Tsyne application
   dev <app.ts>      Run with hot reload and debugging (coming soon)
   build <app.ts>    Package for distribution (coming soon)
+  precompile <app.ts>  Transpile an app and its local imports into one cached bundle
   test              Run tests (coming soon)
 
 Options:
@@ -339,6 +342,29 @@ async function buildApp(appPath: string): Promise<number> {
   return 0;
 }
 
+/**
+ * Precompile an app: walk its local imports, transpile them in parallel and
+ * write the cached bundle the launchers load on the next start
+ */
+async function precompile(appPath: string): Promise<number> {
+  const absolutePath = path.resolve(appPath);
+  if (!fs.existsSync(absolutePath)) {
+    logError(`File not found: ${appPath}`);
+    return 1;
+  }
+
+  const start = Date.now();
+  try {
+    const result = await precompileApp(absolutePath);
+    const state = result.cached ? 'up to date' : `built in ${Date.now() - start}ms`;
+    logSuccess(`Bundle ${result.bundleKey} (${result.modules.length} modules) ${state}`);
+    return 0;
+  } catch (err) {
+    logError(`Precompile failed: ${err instanceof Error ? err.message : String(err)}`);
+    return 1;
+  }
+}
+
 /**
  * Main CLI entry point
  */
@@ -424,7 +450,8 @@ async function main(): Promise<void> {
   let appPath: string | undefined;
   let appArgs: string[];
 
-  if (firstArg === 'run' || firstArg === 'dev' || firstArg === 'build' || firstArg === 'test') {
+  if (firstArg === 'run' || firstArg === 'dev' || firstArg === 'build' || firstArg === 'test' ||
+      firstArg === 'precompile') {
     command = firstArg;
     appPath = args[1];
     appArgs = args.slice(2);
@@ -465,6 +492,15 @@ async function main(): Promise<void> {
       process.exit(buildCode);
       break;
 
+    case 'precompile':
+      if (!appPath) {
+        logError('No application file specified');
+        printUsage();
+        process.exit(1);
+      }
+      process.exit(await precompile(appPath));
+      break;
+
     case 'test':
       logError('test command coming soon');
       process.exit(1);
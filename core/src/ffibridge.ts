@@ -4,6 +4,25 @@ import { BridgeInterface, Event } from './fynebridge';
 // Import koffi at runtime
 let koffi: any;
 
+/**
+ * Locate libtsyne.so: next to the executable for pkg builds, otherwise in
+ * core/bin (works from both src/ and dist/src/).
+ */
+export function resolveLibTsynePath(): string {
+  const isPkg = typeof (process as unknown as { pkg?: unknown }).pkg !== 'undefined';
+
+  if (isPkg) {
+    const execDir = path.dirname(process.execPath);
+    return path.join(execDir, 'libtsyne.so');
+  }
+
+  const isCompiled = __dirname.includes(path.sep + 'dist' + path.sep);
+  const projectRoot = isCompiled
+    ? path.join(__dirname, '..', '..')
+    : path.join(__dirname, '..');
+  return path.join(projectRoot, 'bin', 'libtsyne.so');
+}
+
 /**
  * FFI Bridge Connection - calls Go library directly via koffi
  *
@@ -32,23 +51,8 @@ export class FfiBridgeConnection implements BridgeInterface {
       throw new Error('koffi not installed. Run: npm install koffi');
     }
 
-    // Find library path
-    const isPkg = typeof (process as unknown as { pkg?: unknown }).pkg !== 'undefined';
-    let libPath: string;
-
-    if (isPkg) {
-      const execDir = path.dirname(process.execPath);
-      libPath = path.join(execDir, 'libtsyne.so');
-    } else {
-      const isCompiled = __dirname.includes(path.sep + 'dist' + path.sep);
-      const projectRoot = isCompiled
-        ? path.join(__dirname, '..', '..')
-        : path.join(__dirname, '..');
-      libPath = path.join(projectRoot, 'bin', 'libtsyne.so');
-    }
-
     // Load the shared library
-    this.lib = koffi.load(libPath);
+    this.lib = koffi.load(resolveLibTsynePath());
 
     // Define function signatures
     const TsyneInit = this.lib.func('TsyneInit', 'int', ['int']);
@@ -188,6 +192,10 @@ export class FfiBridgeConnection implements BridgeInterface {
     this.eventHandlers.delete(eventType);
   }
 
+  getEventHandler(eventType: string): ((data: unknown) => void) | undefined {
+    return this.eventHandlers.get(eventType);
+  }
+
   /**
    * Register a callback to be called when the bridge exits
    * Note: In FFI mode, the bridge runs in the same process, so this is called on shutdown
@@ -2,6 +2,7 @@ import { ChildProcess, spawn } from 'child_process';
 import * as path from 'path';
 import crc32 from 'buffer-crc32';
 import { PROTOCOL_VERSION, TSYNE_VERSION, BridgeHandshake, isCompatibleHandshake } from './version';
+import { getTracer, TRACE_LANE_CALLS, TRACE_LANE_TRANSPORT, TRACE_LANE_RESPONSES } from './tracing';
 
 export interface Message {
   id: string;
@@ -33,6 +34,8 @@ export interface BridgeInterface {
   registerEventHandler(callbackId: string, handler: (data: unknown) => void): void;
   on(eventType: string, handler: (data: unknown) => void): void;
   off(eventType: string, handler?: (data: unknown) => void): void;
+  /** The handler a later on(eventType) would replace, if any */
+  getEventHandler(eventType: string): ((data: unknown) => void) | undefined;
   registerCustomId(widgetId: string, customId: string): Promise<unknown>;
   getParent(widgetId: string): Promise<string>;
   clickToolbarAction(toolbarId: string, actionLabel: string): Promise<unknown>;
@@ -50,6 +53,8 @@ export class BridgeConnection implements BridgeInterface {
     resolve: (result: unknown) => void;
     reject: (error: Error) => void;
     callerStack: string;
+    type: string;
+    traceStart: number; // Microseconds when send() was called, 0 when not tracing
   }>();
   private eventHandlers = new Map<string, (data: unknown) => void>();
   private readyPromise: Promise<void>;
@@ -229,6 +234,8 @@ export class BridgeConnection implements BridgeInterface {
 
     const pending = this.pendingRequests.get(response.id);
     if (pending) {
+      const tracer = getTracer();
+      const resolveStart = tracer ? tracer.now() : 0;
       this.pendingRequests.delete(response.id);
       if (response.success) {
         pending.resolve(response.result || {});
@@ -241,6 +248,10 @@ export class BridgeConnection implements BridgeInterface {
         }
         pending.reject(error);
       }
+      if (tracer) {
+        tracer.span('resolve', 'ipc', response.id, TRACE_LANE_RESPONSES, resolveStart);
+        tracer.span(pending.type, 'bridge', response.id, TRACE_LANE_CALLS, pending.traceStart, true);
+      }
     }
   }
 
@@ -284,6 +295,9 @@ export class BridgeConnection implements BridgeInterface {
   }
 
   async send(type: string, payload: Record<string, unknown>, callerFn?: Function): Promise<unknown> {
+    const tracer = getTracer();
+    const traceStart = tracer ? tracer.now() : 0;
+
     // Wait for bridge to be ready before sending commands
     await this.readyPromise;
 
@@ -304,7 +318,8 @@ export class BridgeConnection implements BridgeInterface {
     const callerStack = stackCapture.stack || '';
 
     return new Promise((resolve, reject) => {
-      this.pendingRequests.set(id, { resolve, reject, callerStack });
+      this.pendingRequests.set(id, { resolve, reject, callerStack, type, traceStart });
+      const writeStart = tracer ? tracer.now() : 0;
 
       // IPC Safeguard: Write framed message with length-prefix and CRC32 validation
       // Frame format: [uint32 length][uint32 crc32][json bytes]
@@ -325,6 +340,7 @@ export class BridgeConnection implements BridgeInterface {
       }
 
       this.process.stdin!.write(frame);
+      tracer?.span('write', 'ipc', id, TRACE_LANE_TRANSPORT, writeStart);
     });
   }
 
@@ -354,6 +370,10 @@ export class BridgeConnection implements BridgeInterface {
     this.eventHandlers.delete(eventType);
   }
 
+  getEventHandler(eventType: string): ((data: unknown) => void) | undefined {
+    return this.eventHandlers.get(eventType);
+  }
+
   /**
    * Register a callback to be called when the bridge process exits
    */
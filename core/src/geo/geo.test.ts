@@ -15,7 +15,18 @@ import {
   lngLatToTile,
   tileToLngLat,
   earthRadius,
-  earthCircumference
+  earthCircumference,
+  createPixelTransform,
+  lngLatArrayToMercator,
+  mercatorArrayToLngLat,
+  mercatorArrayToPixels,
+  lngLatArrayToPixels,
+  clipPolyline,
+  clipPolygon,
+  cullPoints,
+  createClipOutput,
+  clipPolylineInto,
+  clipPolygonInto
 } from './geo';
 
 describe('Constants', () => {
@@ -405,3 +416,119 @@ describe('Tile coordinates', () => {
     });
   });
 });
+
+describe('Batch projection', () => {
+  const track = new Float64Array([2.35, 48.85, -73.5, 40.7, 139.7, 35.7, 0, 89]);
+
+  it('matches the per-point Mercator functions', () => {
+    const xy = lngLatArrayToMercator(track);
+    expect(xy[0]).toBeCloseTo(mercatorXfromLng(2.35), 12);
+    expect(xy[1]).toBeCloseTo(mercatorYfromLat(48.85), 12);
+    expect(xy[4]).toBeCloseTo(mercatorXfromLng(139.7), 12);
+    expect(xy[5]).toBeCloseTo(mercatorYfromLat(35.7), 12);
+    // Clamped to the Mercator limit
+    expect(xy[7]).toBeCloseTo(0, 6);
+  });
+
+  it('round-trips through Mercator', () => {
+    const back = mercatorArrayToLngLat(lngLatArrayToMercator(track));
+    for (let i = 0; i < 6; i++) {
+      expect(back[i]).toBeCloseTo(track[i], 9);
+    }
+  });
+
+  it('reuses the output buffer', () => {
+    const out = new Float64Array(8);
+    expect(lngLatArrayToMercator(track, out)).toBe(out);
+    const pixels = new Float32Array(8);
+    expect(lngLatArrayToPixels(track, createPixelTransform({ lng: 0, lat: 0 }, 0, 512, 512), pixels)).toBe(pixels);
+  });
+
+  it('puts the center in the middle of the viewport', () => {
+    const view = createPixelTransform({ lng: 2.35, lat: 48.85 }, 12, 800, 600);
+    const pixels = lngLatArrayToPixels(new Float64Array([2.35, 48.85]), view);
+    expect(pixels[0]).toBeCloseTo(400, 2);
+    expect(pixels[1]).toBeCloseTo(300, 2);
+  });
+
+  it('fused projection matches Mercator then pixels', () => {
+    const view = createPixelTransform({ lng: 10, lat: 20 }, 3.5, 640, 480);
+    const fused = lngLatArrayToPixels(track, view);
+    const twoStep = mercatorArrayToPixels(lngLatArrayToMercator(track), view);
+    for (let i = 0; i < fused.length; i++) {
+      expect(fused[i]).toBeCloseTo(twoStep[i], 3);
+    }
+  });
+
+  it('projects 100k vertices without per-point objects', () => {
+    const n = 100000;
+    const big = new Float64Array(n * 2);
+    for (let i = 0; i < n; i++) {
+      big[i * 2] = -180 + 360 * i / n;
+      big[i * 2 + 1] = Math.sin(i / 1000) * 60;
+    }
+    const view = createPixelTransform({ lng: 0, lat: 0 }, 2, 1024, 768);
+    const out = lngLatArrayToPixels(big, view);
+    expect(out.length).toBe(n * 2);
+    expect(out[n]).toBeCloseTo(512, 0);
+  });
+});
+
+describe('Clipping', () => {
+  const rect = { minX: 0, minY: 0, maxX: 10, maxY: 10 };
+
+  it('splits a polyline into visible runs', () => {
+    const line = new Float32Array([-10, 5, 5, 5, 15, 5, 15, -5, 5, -5, 5, 5]);
+    const runs = clipPolyline(line, rect);
+    expect(runs.map(r => Array.from(r))).toEqual([
+      [0, 5, 5, 5, 10, 5],
+      [5, 0, 5, 5],
+    ]);
+  });
+
+  it('drops a polyline entirely outside', () => {
+    expect(clipPolyline(new Float32Array([20, 20, 30, 30]), rect)).toEqual([]);
+  });
+
+  it('clips a polygon to the rectangle', () => {
+    const ring = clipPolygon(new Float32Array([-5, -5, 15, -5, 5, 15]), rect);
+    expect(Array.from(ring)).toEqual([2.5, 10, 0, 5, 0, 0, 10, 0, 10, 5, 7.5, 10]);
+    expect(clipPolygon(new Float32Array([20, 20, 30, 20, 25, 30]), rect).length).toBe(0);
+  });
+
+  it('clips into a reused output without reallocating', () => {
+    const out = createClipOutput(16);
+    const points = out.points;
+    const starts = out.starts;
+    const line = new Float32Array([-10, 5, 5, 5, 15, 5, 15, -5, 5, -5, 5, 5]);
+
+    for (let frame = 0; frame < 3; frame++) {
+      const runs = clipPolylineInto(line, rect, out);
+      expect(runs).toBe(2);
+      expect(Array.from(out.points.subarray(out.starts[0] * 2, out.starts[1] * 2))).toEqual([0, 5, 5, 5, 10, 5]);
+      expect(Array.from(out.points.subarray(out.starts[1] * 2, out.starts[2] * 2))).toEqual([5, 0, 5, 5]);
+
+      const n = clipPolygonInto(new Float32Array([-5, -5, 15, -5, 5, 15]), rect, out);
+      expect(Array.from(out.points.subarray(0, n * 2))).toEqual([2.5, 10, 0, 5, 0, 0, 10, 0, 10, 5, 7.5, 10]);
+    }
+    expect(out.points).toBe(points);
+    expect(out.starts).toBe(starts);
+    expect(clipPolygonInto(new Float32Array([20, 20, 30, 20, 25, 30]), rect, out)).toBe(0);
+  });
+
+  it('grows a clip output that is too small', () => {
+    const out = createClipOutput(1);
+    const zigzag = new Float32Array(200);
+    for (let i = 0; i < 100; i++) {
+      zigzag[i * 2] = i / 10;
+      zigzag[i * 2 + 1] = i % 2 === 0 ? -5 : 5;
+    }
+    expect(clipPolylineInto(zigzag, rect, out)).toBe(clipPolyline(zigzag, rect).length);
+    expect(clipPolygonInto(zigzag, rect, out)).toBe(clipPolygon(zigzag, rect).length / 2);
+  });
+
+  it('culls points outside the rectangle', () => {
+    const points = new Float32Array([1, 1, 20, 1, 5, 5, -1, 3]);
+    expect(Array.from(cullPoints(points, rect))).toEqual([0, 2]);
+  });
+});
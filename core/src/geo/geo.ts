@@ -454,6 +454,304 @@ export function tileToLngLat(z: number, x: number, y: number): { lng: number; la
     return { lng, lat };
 }
 
+// ============================================================================
+// Batch Projection
+// ============================================================================
+
+/**
+ * Where Mercator coordinates land in a viewport of pixels.
+ */
+export interface PixelTransform {
+    /** Viewport center in Mercator units (0-1) */
+    centerX: number;
+    centerY: number;
+    /** Width of the whole world in pixels at the current zoom */
+    worldSize: number;
+    /** Viewport size in pixels */
+    width: number;
+    height: number;
+}
+
+/**
+ * Build the pixel transform for a viewport. tileSize is the world width at
+ * zoom 0 (512 for vector-style maps, 256 for raster tiles).
+ */
+export function createPixelTransform(
+    center: { lng: number; lat: number },
+    zoom: number,
+    width: number,
+    height: number,
+    tileSize = 512
+): PixelTransform {
+    return {
+        centerX: mercatorXfromLng(center.lng),
+        centerY: mercatorYfromLat(clamp(center.lat, -MAX_MERCATOR_LATITUDE, MAX_MERCATOR_LATITUDE)),
+        worldSize: tileSize * Math.pow(2, zoom),
+        width,
+        height
+    };
+}
+
+/**
+ * Project interleaved lng, lat pairs to interleaved Mercator x, y (0-1).
+ * Latitudes are clamped to the Mercator limit. Pass out to reuse a buffer.
+ */
+export function lngLatArrayToMercator(lngLat: Float64Array, out?: Float64Array): Float64Array {
+    const result = out && out.length >= lngLat.length ? out : new Float64Array(lngLat.length);
+    const k = 180 / Math.PI;
+    for (let i = 0; i < lngLat.length; i += 2) {
+        const lat = Math.min(MAX_MERCATOR_LATITUDE, Math.max(-MAX_MERCATOR_LATITUDE, lngLat[i + 1]));
+        result[i] = (180 + lngLat[i]) / 360;
+        result[i + 1] = (180 - k * Math.log(Math.tan(Math.PI / 4 + lat * Math.PI / 360))) / 360;
+    }
+    return result;
+}
+
+/**
+ * Convert interleaved Mercator x, y back to interleaved lng, lat.
+ */
+export function mercatorArrayToLngLat(xy: Float64Array, out?: Float64Array): Float64Array {
+    const result = out && out.length >= xy.length ? out : new Float64Array(xy.length);
+    for (let i = 0; i < xy.length; i += 2) {
+        result[i] = xy[i] * 360 - 180;
+        result[i + 1] = 360 / Math.PI * Math.atan(Math.exp((180 - xy[i + 1] * 360) * Math.PI / 180)) - 90;
+    }
+    return result;
+}
+
+/**
+ * Place interleaved Mercator x, y in the viewport as interleaved pixels.
+ */
+export function mercatorArrayToPixels(xy: Float64Array, transform: PixelTransform, out?: Float32Array): Float32Array {
+    const result = out && out.length >= xy.length ? out : new Float32Array(xy.length);
+    const size = transform.worldSize;
+    const offsetX = transform.width / 2 - transform.centerX * size;
+    const offsetY = transform.height / 2 - transform.centerY * size;
+    for (let i = 0; i < xy.length; i += 2) {
+        result[i] = xy[i] * size + offsetX;
+        result[i + 1] = xy[i + 1] * size + offsetY;
+    }
+    return result;
+}
+
+/**
+ * Project interleaved lng, lat pairs straight to viewport pixels in one pass.
+ */
+export function lngLatArrayToPixels(lngLat: Float64Array, transform: PixelTransform, out?: Float32Array): Float32Array {
+    const result = out && out.length >= lngLat.length ? out : new Float32Array(lngLat.length);
+    const size = transform.worldSize;
+    const offsetX = transform.width / 2 - transform.centerX * size;
+    const offsetY = transform.height / 2 - transform.centerY * size;
+    const k = 180 / Math.PI;
+    for (let i = 0; i < lngLat.length; i += 2) {
+        const lat = Math.min(MAX_MERCATOR_LATITUDE, Math.max(-MAX_MERCATOR_LATITUDE, lngLat[i + 1]));
+        const x = (180 + lngLat[i]) / 360;
+        const y = (180 - k * Math.log(Math.tan(Math.PI / 4 + lat * Math.PI / 360))) / 360;
+        result[i] = x * size + offsetX;
+        result[i + 1] = y * size + offsetY;
+    }
+    return result;
+}
+
+/**
+ * Axis-aligned clip rectangle in pixels.
+ */
+export interface ClipRect {
+    minX: number;
+    minY: number;
+    maxX: number;
+    maxY: number;
+}
+
+/**
+ * Reusable clipping output, laid out like the native kernels: run i of a
+ * polyline is points[starts[i] * 2] up to points[starts[i + 1] * 2]. The
+ * arrays grow when a call needs more room and are kept for the next call.
+ */
+export interface ClipOutput {
+    points: Float32Array;
+    starts: Int32Array;
+    /** Intermediate ring for polygon clipping */
+    scratch: Float32Array;
+}
+
+/**
+ * Create a ClipOutput with room for capacity points.
+ */
+export function createClipOutput(capacity = 256): ClipOutput {
+    return {
+        points: new Float32Array(capacity * 2),
+        starts: new Int32Array(Math.max(2, capacity >> 1)),
+        scratch: new Float32Array(capacity * 2)
+    };
+}
+
+/**
+ * Clip an interleaved polyline to a rectangle into out, without allocating
+ * once out has grown to fit. A line that leaves and re-enters the rectangle
+ * splits into several runs. Returns the number of runs.
+ */
+export function clipPolylineInto(xy: Float32Array | Float64Array, rect: ClipRect, out: ClipOutput): number {
+    const count = xy.length >> 1;
+    // Worst case every segment is its own two-point run
+    if (out.points.length < (count - 1) * 4) out.points = new Float32Array((count - 1) * 4);
+    if (out.starts.length < count + 1) out.starts = new Int32Array(count + 1);
+    const points = out.points;
+    const starts = out.starts;
+    let n = 0;
+    let runs = 0;
+    let open = false;
+
+    for (let i = 0; i + 1 < count; i++) {
+        const x0 = xy[i * 2], y0 = xy[i * 2 + 1];
+        const x1 = xy[i * 2 + 2], y1 = xy[i * 2 + 3];
+        if (!clipSegment(x0, y0, x1, y1, rect)) {
+            open = false;
+            continue;
+        }
+        const t0 = segmentT[0], t1 = segmentT[1];
+        if (!open || t0 > 0) {
+            starts[runs++] = n;
+            points[n * 2] = x0 + (x1 - x0) * t0;
+            points[n * 2 + 1] = y0 + (y1 - y0) * t0;
+            n++;
+            open = true;
+        }
+        points[n * 2] = x0 + (x1 - x0) * t1;
+        points[n * 2 + 1] = y0 + (y1 - y0) * t1;
+        n++;
+        if (t1 < 1) open = false;
+    }
+    starts[runs] = n;
+    return runs;
+}
+
+/**
+ * Clip an interleaved polyline to a rectangle. Returns the visible runs, each
+ * as its own interleaved array. Allocates the result; per-frame code should
+ * use clipPolylineInto.
+ */
+export function clipPolyline(xy: Float32Array | Float64Array, rect: ClipRect): Float32Array[] {
+    const out = createClipOutput(0);
+    const runs = clipPolylineInto(xy, rect, out);
+    const parts: Float32Array[] = [];
+    for (let i = 0; i < runs; i++) {
+        parts.push(out.points.slice(out.starts[i] * 2, out.starts[i + 1] * 2));
+    }
+    return parts;
+}
+
+/**
+ * Clip an interleaved polygon ring to a rectangle (Sutherland-Hodgman) into
+ * out.points, without allocating once out has grown to fit. Returns the
+ * number of points in the clipped ring, 0 when nothing is left.
+ */
+export function clipPolygonInto(xy: Float32Array | Float64Array, rect: ClipRect, out: ClipOutput): number {
+    let n = xy.length >> 1;
+    n = clipRingEdge(xy, n, 0, rect.minX, -1, out, false);
+    n = clipRingEdge(out.scratch, n, 0, rect.maxX, 1, out, true);
+    n = clipRingEdge(out.points, n, 1, rect.minY, -1, out, false);
+    n = clipRingEdge(out.scratch, n, 1, rect.maxY, 1, out, true);
+    return n >= 3 ? n : 0;
+}
+
+/**
+ * Clip an interleaved polygon ring to a rectangle (Sutherland-Hodgman).
+ * Returns an empty array when nothing is left. Allocates the result;
+ * per-frame code should use clipPolygonInto.
+ */
+export function clipPolygon(xy: Float32Array | Float64Array, rect: ClipRect): Float32Array {
+    const out = createClipOutput(0);
+    const n = clipPolygonInto(xy, rect, out);
+    return out.points.slice(0, n * 2);
+}
+
+/**
+ * Indices of the interleaved points inside a rectangle (markers, point clouds).
+ */
+export function cullPoints(xy: Float32Array | Float64Array, rect: ClipRect, out?: Uint32Array): Uint32Array {
+    const count = xy.length >> 1;
+    const result = out && out.length >= count ? out : new Uint32Array(count);
+    let n = 0;
+    for (let i = 0; i < count; i++) {
+        const x = xy[i * 2], y = xy[i * 2 + 1];
+        if (x >= rect.minX && x <= rect.maxX && y >= rect.minY && y <= rect.maxY) {
+            result[n++] = i;
+        }
+    }
+    return result.subarray(0, n);
+}
+
+// [t0, t1] of the last segment clipSegment accepted
+const segmentT = new Float64Array(2);
+
+// Liang-Barsky: whether any of a segment is inside rect; the inside part is
+// [segmentT[0], segmentT[1]]
+function clipSegment(x0: number, y0: number, x1: number, y1: number, rect: ClipRect): boolean {
+    const dx = x1 - x0;
+    const dy = y1 - y0;
+    segmentT[0] = 0;
+    segmentT[1] = 1;
+    return clipSegmentEdge(-dx, x0 - rect.minX) && clipSegmentEdge(dx, rect.maxX - x0) &&
+        clipSegmentEdge(-dy, y0 - rect.minY) && clipSegmentEdge(dy, rect.maxY - y0);
+}
+
+// Narrow segmentT to one edge's inside; false when nothing is left
+function clipSegmentEdge(p: number, q: number): boolean {
+    if (p === 0) return q >= 0;
+    const t = q / p;
+    if (p < 0) {
+        if (t > segmentT[1]) return false;
+        if (t > segmentT[0]) segmentT[0] = t;
+    } else {
+        if (t < segmentT[0]) return false;
+        if (t < segmentT[1]) segmentT[1] = t;
+    }
+    return true;
+}
+
+// One Sutherland-Hodgman pass against sign * coordinate <= sign * edge, from
+// the n points of ring into out.points (toPoints) or out.scratch. Returns the
+// number of points written.
+function clipRingEdge(
+    ring: Float32Array | Float64Array,
+    n: number,
+    axis: 0 | 1,
+    edge: number,
+    sign: number,
+    out: ClipOutput,
+    toPoints: boolean
+): number {
+    // Each point adds at most an intersection and itself
+    let dst = toPoints ? out.points : out.scratch;
+    if (dst.length < n * 4) {
+        dst = new Float32Array(n * 4);
+        if (toPoints) out.points = dst; else out.scratch = dst;
+    }
+    let m = 0;
+    for (let i = 0; i < n; i++) {
+        const j = (i + n - 1) % n;
+        const cx = ring[i * 2], cy = ring[i * 2 + 1];
+        const px = ring[j * 2], py = ring[j * 2 + 1];
+        const c = axis === 0 ? cx : cy;
+        const prev = axis === 0 ? px : py;
+        const curIn = sign * c <= sign * edge;
+        const prevIn = sign * prev <= sign * edge;
+        if (curIn !== prevIn) {
+            const t = (edge - prev) / (c - prev);
+            dst[m * 2] = px + (cx - px) * t;
+            dst[m * 2 + 1] = py + (cy - py) * t;
+            m++;
+        }
+        if (curIn) {
+            dst[m * 2] = cx;
+            dst[m * 2 + 1] = cy;
+            m++;
+        }
+    }
+    return m;
+}
+
 // ============================================================================
 // Default Export
 // ============================================================================
@@ -489,5 +787,18 @@ export default {
 
     // Tile coordinates
     lngLatToTile,
-    tileToLngLat
+    tileToLngLat,
+
+    // Batch projection
+    createPixelTransform,
+    lngLatArrayToMercator,
+    mercatorArrayToLngLat,
+    mercatorArrayToPixels,
+    lngLatArrayToPixels,
+    createClipOutput,
+    clipPolylineInto,
+    clipPolygonInto,
+    clipPolyline,
+    clipPolygon,
+    cullPoints
 };
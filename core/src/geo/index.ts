@@ -5,3 +5,4 @@
  */
 
 export * from './geo';
+export * from './native-geo';
@@ -0,0 +1,72 @@
+/**
+ * Native geometry kernel tests: results must match the geo.ts batch functions.
+ *
+ * Requires core/bin/libtsyne.so (built with `go build -buildmode=c-shared`)
+ * and koffi; the suite is skipped when either is missing.
+ */
+
+import { loadNativeGeo, NativeGeo } from './native-geo';
+import {
+  createPixelTransform,
+  lngLatArrayToMercator,
+  lngLatArrayToPixels,
+  clipPolyline,
+  clipPolygon,
+  cullPoints,
+  createClipOutput
+} from './geo';
+
+const native = loadNativeGeo();
+const describeNative = native ? describe : describe.skip;
+
+function randomTrack(n: number): Float64Array {
+  const lngLat = new Float64Array(n * 2);
+  for (let i = 0; i < n; i++) {
+    lngLat[i * 2] = 2 + Math.sin(i / 50) * 0.5;
+    lngLat[i * 2 + 1] = 48.5 + Math.cos(i / 70) * 0.5;
+  }
+  return lngLat;
+}
+
+describeNative('native geometry kernels', () => {
+  const ng = native as NativeGeo;
+  const view = createPixelTransform({ lng: 2.2, lat: 48.7 }, 9, 800, 600);
+  const rect = { minX: 0, minY: 0, maxX: 800, maxY: 600 };
+
+  it('projects like geo.ts', () => {
+    const track = randomTrack(1000);
+    const js = lngLatArrayToMercator(track);
+    const nat = ng.lngLatArrayToMercator(track);
+    for (let i = 0; i < js.length; i++) {
+      expect(nat[i]).toBeCloseTo(js[i], 12);
+    }
+
+    const jsPx = lngLatArrayToPixels(track, view);
+    const natPx = ng.lngLatArrayToPixels(track, view);
+    for (let i = 0; i < jsPx.length; i++) {
+      expect(Math.abs(natPx[i] - jsPx[i])).toBeLessThan(0.01);
+    }
+  });
+
+  it('clips like geo.ts', () => {
+    const pixels = lngLatArrayToPixels(randomTrack(2000), view);
+    const jsRuns = clipPolyline(pixels, rect);
+    const natRuns = ng.clipPolyline(pixels, rect);
+    expect(natRuns.length).toBe(jsRuns.length);
+    expect(natRuns.map(r => r.length)).toEqual(jsRuns.map(r => r.length));
+
+    const ring = new Float32Array([-50, -50, 900, 100, 400, 700]);
+    expect(Array.from(ng.clipPolygon(ring, rect)).length).toBe(clipPolygon(ring, rect).length);
+    expect(Array.from(ng.cullPoints(pixels, rect))).toEqual(Array.from(cullPoints(pixels, rect)));
+  });
+
+  it('clips into a reused output', () => {
+    const pixels = lngLatArrayToPixels(randomTrack(2000), view);
+    const out = createClipOutput();
+    const runs = ng.clipPolylineInto(pixels, rect, out);
+    const points = out.points;
+    expect(ng.clipPolylineInto(pixels, rect, out)).toBe(runs);
+    expect(out.points).toBe(points);
+    expect(runs).toBe(clipPolyline(pixels, rect).length);
+  });
+});
@@ -0,0 +1,144 @@
+/**
+ * Tsyne Native Geometry Kernels
+ *
+ * FFI bindings (via koffi) for the C++ batch projection kernels compiled
+ * into libtsyne.so (core/bridge/geo_kernels.cpp). Same results as the batch
+ * functions in geo.ts, for overlays with enough vertices that projecting
+ * them every frame shows up in profiles.
+ *
+ * The native library is optional: loadNativeGeo() returns null when koffi
+ * or libtsyne.so is unavailable, and callers keep using geo.ts.
+ */
+
+import { resolveLibTsynePath } from '../ffibridge';
+import type { PixelTransform, ClipRect, ClipOutput } from './geo';
+import { createClipOutput } from './geo';
+
+/** ABI version this binding was written against (TSYNE_GEO_ABI_VERSION) */
+export const NATIVE_GEO_ABI_VERSION = 1;
+
+/**
+ * Native geometry kernel API, mirroring the geo.ts batch functions
+ */
+export interface NativeGeo {
+    lngLatArrayToMercator(lngLat: Float64Array, out?: Float64Array): Float64Array;
+    lngLatArrayToPixels(lngLat: Float64Array, transform: PixelTransform, out?: Float32Array): Float32Array;
+    clipPolylineInto(xy: Float32Array, rect: ClipRect, out: ClipOutput): number;
+    clipPolygonInto(xy: Float32Array, rect: ClipRect, out: ClipOutput): number;
+    clipPolyline(xy: Float32Array, rect: ClipRect): Float32Array[];
+    clipPolygon(xy: Float32Array, rect: ClipRect): Float32Array;
+    cullPoints(xy: Float32Array, rect: ClipRect, out?: Uint32Array): Uint32Array;
+}
+
+type KoffiFn = (...args: unknown[]) => unknown;
+
+// undefined = not attempted yet, null = unavailable
+let cached: NativeGeo | null | undefined;
+
+/**
+ * Load the native geometry kernels. Returns null if koffi or the library is
+ * missing, or if the library's kernel ABI does not match this binding.
+ * The result is cached per process.
+ */
+export function loadNativeGeo(libPath?: string): NativeGeo | null {
+    if (cached !== undefined && libPath === undefined) {
+        return cached;
+    }
+
+    let result: NativeGeo | null = null;
+    try {
+        // eslint-disable-next-line @typescript-eslint/no-var-requires
+        const koffi = require('koffi');
+        const lib = koffi.load(libPath ?? resolveLibTsynePath());
+        result = bindNativeGeo(lib);
+    } catch {
+        result = null;
+    }
+
+    if (libPath === undefined) {
+        cached = result;
+    }
+    return result;
+}
+
+function bindNativeGeo(lib: { func: (name: string, ret: string, args: string[]) => KoffiFn }): NativeGeo | null {
+    const version = lib.func('TsyneGeoVersion', 'int', []);
+    if (version() !== NATIVE_GEO_ABI_VERSION) {
+        return null;
+    }
+
+    const rectArgs = ['float', 'float', 'float', 'float'];
+    // TypedArrays passed to pointer parameters are handed to C without copying
+    const toMercator = lib.func('TsyneGeoLngLatToMercator', 'void', ['double *', 'int', 'double *']);
+    const toPixels = lib.func('TsyneGeoLngLatToPixels', 'void',
+        ['double *', 'int', 'double', 'double', 'double', 'double', 'double', 'float *']);
+    const clipLine = lib.func('TsyneGeoClipPolyline', 'int',
+        ['float *', 'int', ...rectArgs, 'float *', 'int *']);
+    const clipRing = lib.func('TsyneGeoClipPolygon', 'int',
+        ['float *', 'int', ...rectArgs, 'float *', 'int']);
+    const cull = lib.func('TsyneGeoCullPoints', 'int',
+        ['float *', 'int', ...rectArgs, 'uint32_t *']);
+
+    const api: NativeGeo = {
+        lngLatArrayToMercator(lngLat, out) {
+            const result = out && out.length >= lngLat.length ? out : new Float64Array(lngLat.length);
+            toMercator(lngLat, lngLat.length >> 1, result);
+            return result;
+        },
+
+        lngLatArrayToPixels(lngLat, transform, out) {
+            const result = out && out.length >= lngLat.length ? out : new Float32Array(lngLat.length);
+            toPixels(lngLat, lngLat.length >> 1,
+                transform.centerX, transform.centerY, transform.worldSize,
+                transform.width, transform.height, result);
+            return result;
+        },
+
+        clipPolylineInto(xy, rect, out) {
+            const count = xy.length >> 1;
+            if (count < 2) {
+                out.starts[0] = 0;
+                return 0;
+            }
+            if (out.points.length < (count - 1) * 4) out.points = new Float32Array((count - 1) * 4);
+            if (out.starts.length < count + 1) out.starts = new Int32Array(count + 1);
+            return clipLine(xy, count, rect.minX, rect.minY, rect.maxX, rect.maxY, out.points, out.starts) as number;
+        },
+
+        clipPolygonInto(xy, rect, out) {
+            const count = xy.length >> 1;
+            if (out.points.length < count * 2 + 16) out.points = new Float32Array(count * 2 + 16);
+            let n = clipRing(xy, count, rect.minX, rect.minY, rect.maxX, rect.maxY, out.points, out.points.length >> 1) as number;
+            if (n * 2 > out.points.length) {
+                // Too small: the kernel reports the size it needs
+                out.points = new Float32Array(n * 2);
+                n = clipRing(xy, count, rect.minX, rect.minY, rect.maxX, rect.maxY, out.points, n) as number;
+            }
+            return n;
+        },
+
+        clipPolyline(xy, rect) {
+            const out = createClipOutput(0);
+            const runs = api.clipPolylineInto(xy, rect, out);
+            const parts: Float32Array[] = [];
+            for (let i = 0; i < runs; i++) {
+                parts.push(out.points.subarray(out.starts[i] * 2, out.starts[i + 1] * 2));
+            }
+            return parts;
+        },
+
+        clipPolygon(xy, rect) {
+            const out = createClipOutput(0);
+            const n = api.clipPolygonInto(xy, rect, out);
+            return out.points.subarray(0, n * 2);
+        },
+
+        cullPoints(xy, rect, out) {
+            const count = xy.length >> 1;
+            const result = out && out.length >= count ? out : new Uint32Array(count);
+            const n = cull(xy, count, rect.minX, rect.minY, rect.maxX, rect.maxY, result) as number;
+            return result.subarray(0, n);
+        },
+    };
+    return api;
+}
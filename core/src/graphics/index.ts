@@ -14,5 +14,8 @@ export * from './platform';
 // Rasterizer - Drawing primitives (lines, circles, heatmaps, etc.)
 export * from './rasterizer';
 
+// Native raster kernels - Optional C++ fast path via libtsyne.so
+export * from './native-raster';
+
 // DOM stubs - For running browser code in Node.js
 export * from './dom';
@@ -0,0 +1,130 @@
+/**
+ * Native raster kernel tests and JS-vs-native benchmarks.
+ *
+ * Requires core/bin/libtsyne.so (built with `go build -buildmode=c-shared`)
+ * and koffi; the suite is skipped when either is missing.
+ */
+
+import { loadNativeRaster, NativeRaster } from './native-raster';
+import { createRenderTarget, clearRenderTarget, RenderTarget } from './platform';
+import { drawCircle, fillPolygon, fillRect, drawImage, rgba } from './rasterizer';
+
+const native = loadNativeRaster();
+const describeNative = native ? describe : describe.skip;
+
+function makeTarget(w = 64, h = 64): RenderTarget {
+  const t = createRenderTarget(w, h);
+  clearRenderTarget(t, 10, 20, 30, 255);
+  return t;
+}
+
+function maxChannelDiff(a: Uint8Array, b: Uint8Array): number {
+  let max = 0;
+  for (let i = 0; i < a.length; i++) {
+    max = Math.max(max, Math.abs(a[i] - b[i]));
+  }
+  return max;
+}
+
+function bench(label: string, iterations: number, fn: () => void): number {
+  for (let i = 0; i < 5; i++) fn();
+  const start = performance.now();
+  for (let i = 0; i < iterations; i++) fn();
+  const ms = (performance.now() - start) / iterations;
+  console.log(`${label}: ${ms.toFixed(4)}ms/op`);
+  return ms;
+}
+
+describeNative('native raster kernels', () => {
+  const nr = native as NativeRaster;
+
+  it('reports a backend', () => {
+    expect(typeof nr.backend).toBe('string');
+  });
+
+  it('clear fills every pixel', () => {
+    const t = makeTarget(8, 8);
+    nr.clear(t, rgba(1, 2, 3, 4));
+    for (let i = 0; i < t.pixels.length; i += 4) {
+      expect([t.pixels[i], t.pixels[i + 1], t.pixels[i + 2], t.pixels[i + 3]]).toEqual([1, 2, 3, 4]);
+    }
+  });
+
+  it('fillCircle matches drawCircle', () => {
+    const js = makeTarget();
+    const nat = makeTarget();
+    const color = rgba(200, 100, 50, 180);
+    drawCircle(js, 31.5, 30.25, 17.3, color, true);
+    nr.fillCircle(nat, 31.5, 30.25, 17.3, color);
+    expect(maxChannelDiff(js.pixels, nat.pixels)).toBeLessThanOrEqual(1);
+  });
+
+  it('fillPolygon matches fillPolygon', () => {
+    const js = makeTarget();
+    const nat = makeTarget();
+    const color = rgba(0, 255, 0, 128);
+    const verts = [{ x: 5, y: 3 }, { x: 60, y: 12 }, { x: 40, y: 58 }, { x: -4, y: 40 }];
+    fillPolygon(js, verts, color);
+    nr.fillPolygon(nat, verts, color);
+    expect(maxChannelDiff(js.pixels, nat.pixels)).toBeLessThanOrEqual(1);
+  });
+
+  it('fillRect matches fillRect', () => {
+    const js = makeTarget();
+    const nat = makeTarget();
+    const color = rgba(255, 255, 255, 77);
+    fillRect(js, 3.5, -2, 40.2, 30, color);
+    nr.fillRect(nat, 3.5, -2, 40.2, 30, color);
+    expect(maxChannelDiff(js.pixels, nat.pixels)).toBeLessThanOrEqual(1);
+  });
+
+  it('blit matches drawImage', () => {
+    const image = { width: 16, height: 16, data: new Uint8Array(16 * 16 * 4) };
+    for (let i = 0; i < image.data.length; i++) image.data[i] = (i * 37) & 0xff;
+    const js = makeTarget();
+    const nat = makeTarget();
+    drawImage(js, image, 10, 12, 32, 24);
+    nr.blit(nat, image, 10, 12, 32, 24);
+    expect(maxChannelDiff(js.pixels, nat.pixels)).toBeLessThanOrEqual(1);
+  });
+
+  it('texturedColumn samples, shades and fogs', () => {
+    const t = makeTarget(4, 4);
+    const tex = { width: 1, height: 2, data: new Uint8Array([200, 100, 50, 255, 0, 0, 0, 255]) };
+    nr.texturedColumn(t, 1, 0, 3, tex, 0, 0, 0.25, [0, 0, 0], 0.5, 0, [0, 0, 0]);
+    // Rows 0-1 sample the first texel at half shade
+    expect(Array.from(t.pixels.slice((0 * 4 + 1) * 4, (0 * 4 + 1) * 4 + 4))).toEqual([100, 50, 25, 255]);
+    // Rows 2-3 sample the second texel
+    expect(Array.from(t.pixels.slice((3 * 4 + 1) * 4, (3 * 4 + 1) * 4 + 4))).toEqual([0, 0, 0, 255]);
+  });
+
+  describe('benchmarks vs JS rasterizer', () => {
+    const W = 640;
+    const H = 480;
+
+    it('circles', () => {
+      const t = createRenderTarget(W, H);
+      const color = rgba(255, 128, 0, 200);
+      const jsMs = bench('JS drawCircle r=100', 50, () => drawCircle(t, 320, 240, 100, color, true));
+      const nMs = bench('native fillCircle r=100', 50, () => nr.fillCircle(t, 320, 240, 100, color));
+      console.log(`circle speedup: ${(jsMs / nMs).toFixed(1)}x`);
+    });
+
+    it('polygons', () => {
+      const t = createRenderTarget(W, H);
+      const color = rgba(0, 128, 255, 255);
+      const verts = [{ x: 20, y: 20 }, { x: 600, y: 60 }, { x: 500, y: 460 }, { x: 40, y: 400 }];
+      const jsMs = bench('JS fillPolygon quad', 50, () => fillPolygon(t, verts, color));
+      const nMs = bench('native fillPolygon quad', 50, () => nr.fillPolygon(t, verts, color));
+      console.log(`polygon speedup: ${(jsMs / nMs).toFixed(1)}x`);
+    });
+
+    it('blits', () => {
+      const t = createRenderTarget(W, H);
+      const tile = { width: 256, height: 256, data: new Uint8Array(256 * 256 * 4).fill(255) };
+      const jsMs = bench('JS drawImage 256px', 20, () => drawImage(t, tile, 100, 100));
+      const nMs = bench('native blit 256px', 20, () => nr.blit(t, tile, 100, 100));
+      console.log(`blit speedup: ${(jsMs / nMs).toFixed(1)}x`);
+    });
+  });
+});
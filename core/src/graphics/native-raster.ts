@@ -0,0 +1,208 @@
+/**
+ * Tsyne Native Raster Kernels
+ *
+ * FFI bindings (via koffi) for the C++ raster kernels compiled into
+ * libtsyne.so (core/bridge/raster_kernels.cpp). The kernels draw directly
+ * into a RenderTarget's pixel buffer, so the same Uint8Array can then be
+ * shipped to a raster widget without copying.
+ *
+ * The native library is optional: loadNativeRaster() returns null when koffi
+ * or libtsyne.so is unavailable, and callers keep using rasterizer.ts.
+ */
+
+import { resolveLibTsynePath } from '../ffibridge';
+import type { RenderTarget } from './platform';
+import type { Color } from './rasterizer';
+import type { Vertex } from './geometry';
+
+/** ABI version this binding was written against (TSYNE_RASTER_ABI_VERSION) */
+export const NATIVE_RASTER_ABI_VERSION = 1;
+
+/**
+ * RGBA image accepted by blit() and texturedColumn()
+ */
+export interface NativeRasterImage {
+    width: number;
+    height: number;
+    data: Uint8Array | Uint8ClampedArray;
+}
+
+/**
+ * Native raster kernel API. All methods draw in place into target.pixels.
+ */
+export interface NativeRaster {
+    /** Active code path reported by the library ("scalar", "sse2", "neon") */
+    readonly backend: string;
+
+    /** Overwrite the whole target with a color (no blending) */
+    clear(target: RenderTarget, color: Color): void;
+
+    /** Blend a horizontal span [x0, x1] on row y */
+    fillSpan(target: RenderTarget, y: number, x0: number, x1: number, color: Color): void;
+
+    /** Blend a rectangle (same rounding as rasterizer.fillRect) */
+    fillRect(target: RenderTarget, x: number, y: number, width: number, height: number, color: Color): void;
+
+    /** Blend an anti-aliased filled circle (same output as rasterizer.drawCircle filled) */
+    fillCircle(target: RenderTarget, cx: number, cy: number, radius: number, color: Color): void;
+
+    /**
+     * Blend a filled polygon (same output as rasterizer.fillPolygon).
+     * Accepts either vertex objects or interleaved x,y pairs.
+     */
+    fillPolygon(target: RenderTarget, vertices: Vertex[] | Float32Array, color: Color): void;
+
+    /**
+     * Draw an opaque textured (or solid, when texture is null) wall column,
+     * applying shade and fog the way Raycaster.drawWallStripe does.
+     */
+    texturedColumn(
+        target: RenderTarget,
+        x: number, yStart: number, yEnd: number,
+        texture: NativeRasterImage | null,
+        u: number, vStart: number, vStep: number,
+        baseColor: [number, number, number],
+        shade: number,
+        fogFactor: number,
+        fogColor: [number, number, number]
+    ): void;
+
+    /** Blend an image scaled to dw x dh (same output as rasterizer.drawImage) */
+    blit(target: RenderTarget, image: NativeRasterImage, dx: number, dy: number, dw?: number, dh?: number): void;
+}
+
+type KoffiFn = (...args: unknown[]) => unknown;
+
+// undefined = not attempted yet, null = unavailable
+let cached: NativeRaster | null | undefined;
+
+/**
+ * Load the native raster kernels. Returns null if koffi or the library is
+ * missing, or if the library's kernel ABI does not match this binding.
+ * The result is cached per process.
+ */
+export function loadNativeRaster(libPath?: string): NativeRaster | null {
+    if (cached !== undefined && libPath === undefined) {
+        return cached;
+    }
+
+    let result: NativeRaster | null = null;
+    try {
+        // eslint-disable-next-line @typescript-eslint/no-var-requires
+        const koffi = require('koffi');
+        const lib = koffi.load(libPath ?? resolveLibTsynePath());
+        result = bindNativeRaster(lib);
+    } catch {
+        result = null;
+    }
+
+    if (libPath === undefined) {
+        cached = result;
+    }
+    return result;
+}
+
+/**
+ * Check whether native raster kernels can be used in this process
+ */
+export function isNativeRasterAvailable(): boolean {
+    return loadNativeRaster() !== null;
+}
+
+function bindNativeRaster(lib: { func: (name: string, ret: string, args: string[]) => KoffiFn }): NativeRaster | null {
+    const version = lib.func('TsyneRasterVersion', 'int', []);
+    if (version() !== NATIVE_RASTER_ABI_VERSION) {
+        return null;
+    }
+
+    const backend = lib.func('TsyneRasterBackend', 'const char *', [])() as string;
+    const rgbaArgs = ['int', 'int', 'int', 'int'];
+
+    // TypedArrays passed to pointer parameters are handed to C without copying
+    const clear = lib.func('TsyneRasterClear', 'void', ['uint8_t *', 'int', 'int', ...rgbaArgs]);
+    const fillSpan = lib.func('TsyneRasterFillSpan', 'void',
+        ['uint8_t *', 'int', 'int', 'int', 'int', 'int', ...rgbaArgs]);
+    const fillRect = lib.func('TsyneRasterFillRect', 'void',
+        ['uint8_t *', 'int', 'int', 'float', 'float', 'float', 'float', ...rgbaArgs]);
+    const fillCircle = lib.func('TsyneRasterFillCircle', 'void',
+        ['uint8_t *', 'int', 'int', 'float', 'float', 'float', ...rgbaArgs]);
+    const fillPolygon = lib.func('TsyneRasterFillPolygon', 'void',
+        ['uint8_t *', 'int', 'int', 'float *', 'int', ...rgbaArgs]);
+    const texturedColumn = lib.func('TsyneRasterTexturedColumn', 'void', [
+        'uint8_t *', 'int', 'int',
+        'int', 'int', 'int',
+        'uint8_t *', 'int', 'int',
+        'float', 'float', 'float',
+        'int', 'int', 'int',
+        'float', 'float',
+        'int', 'int', 'int'
+    ]);
+    const blit = lib.func('TsyneRasterBlit', 'void',
+        ['uint8_t *', 'int', 'int', 'uint8_t *', 'int', 'int', 'float', 'float', 'float', 'float']);
+
+    // Reused across fillPolygon calls so Vertex[] input does not allocate per call
+    let polygonScratch = new Float32Array(64);
+
+    return {
+        backend,
+
+        clear(target, color) {
+            clear(target.pixels, target.width, target.height, color.r, color.g, color.b, color.a);
+        },
+
+        fillSpan(target, y, x0, x1, color) {
+            fillSpan(target.pixels, target.width, target.height, y, x0, x1,
+                color.r, color.g, color.b, color.a);
+        },
+
+        fillRect(target, x, y, width, height, color) {
+            fillRect(target.pixels, target.width, target.height, x, y, width, height,
+                color.r, color.g, color.b, color.a);
+        },
+
+        fillCircle(target, cx, cy, radius, color) {
+            fillCircle(target.pixels, target.width, target.height, cx, cy, radius,
+                color.r, color.g, color.b, color.a);
+        },
+
+        fillPolygon(target, vertices, color) {
+            let xy: Float32Array;
+            let count: number;
+            if (vertices instanceof Float32Array) {
+                xy = vertices;
+                count = vertices.length >> 1;
+            } else {
+                count = vertices.length;
+                if (polygonScratch.length < count * 2) {
+                    polygonScratch = new Float32Array(count * 4);
+                }
+                for (let i = 0; i < count; i++) {
+                    polygonScratch[i * 2] = vertices[i].x;
+                    polygonScratch[i * 2 + 1] = vertices[i].y;
+                }
+                xy = polygonScratch;
+            }
+            if (count < 3) return;
+            fillPolygon(target.pixels, target.width, target.height, xy, count,
+                color.r, color.g, color.b, color.a);
+        },
+
+        texturedColumn(target, x, yStart, yEnd, texture, u, vStart, vStep, baseColor, shade, fogFactor, fogColor) {
+            texturedColumn(
+                target.pixels, target.width, target.height,
+                x, yStart, yEnd,
+                texture ? texture.data : null, texture ? texture.width : 0, texture ? texture.height : 0,
+                u, vStart, vStep,
+                baseColor[0], baseColor[1], baseColor[2],
+                shade, fogFactor,
+                fogColor[0], fogColor[1], fogColor[2]
+            );
+        },
+
+        blit(target, image, dx, dy, dw, dh) {
+            blit(target.pixels, target.width, target.height,
+                image.data, image.width, image.height,
+                dx, dy, dw ?? image.width, dh ?? image.height);
+        },
+    };
+}
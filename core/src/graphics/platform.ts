@@ -132,6 +132,8 @@ export interface RenderTarget {
     width: number;
     height: number;
     pixels: Uint8Array;
+    /** Optional per-pixel depth (NDC z, smaller is nearer) for z-buffered rendering */
+    depth?: Float32Array;
 }
 
 /**
@@ -160,6 +162,24 @@ export function clearRenderTarget(
     }
 }
 
+/**
+ * Get the target's depth buffer, allocating it on first use or after a resize
+ */
+export function ensureDepthBuffer(target: RenderTarget): Float32Array {
+    const size = target.width * target.height;
+    if (!target.depth || target.depth.length !== size) {
+        target.depth = new Float32Array(size);
+    }
+    return target.depth;
+}
+
+/**
+ * Reset every depth value (default: 1, the far plane in NDC)
+ */
+export function clearDepthBuffer(target: RenderTarget, value: number = 1): void {
+    ensureDepthBuffer(target).fill(value);
+}
+
 /**
  * Set a single pixel (no blending)
  */
@@ -1250,6 +1250,10 @@ export class GrpcBridgeConnection implements BridgeInterface {
     this.eventHandlers.delete(eventType);
   }
 
+  getEventHandler(eventType: string): ((data: unknown) => void) | undefined {
+    return this.eventHandlers.get(eventType) as ((data: unknown) => void) | undefined;
+  }
+
   /**
    * Register a callback to be called when the bridge process exits
    */
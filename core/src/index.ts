@@ -1008,8 +1008,25 @@ export {
   loadAndExecuteFile,
   clearCache,
   generateCacheKey,
+  precompileApp,
 } from './transpile-cache';
 
+// Export cross-process tracing (TSYNE_TRACE=<file.json>)
+export { TraceRecorder, getTracer, setTracer, exportChromeTrace } from './tracing';
+export type { ChromeTrace, ChromeTraceEvent } from './tracing';
+
+// Export bridge perf stats (histograms, queue depths, GC, heap) and pprof capture
+export { getPerfStats, subscribePerfStats, captureProfile } from './perf-stats';
+export type {
+  BridgePerfStats,
+  BridgeOpStats,
+  BridgeMainThreadStats,
+  PerfStatsOptions,
+  PerfStatsSubscribeOptions,
+  CaptureProfileOptions,
+  CapturedProfile,
+} from './perf-stats';
+
 // Export TsyneWindow abstraction (for apps that work in both standalone and desktop modes)
 export {
   createTsyneWindow,
@@ -1054,6 +1071,8 @@ export {
   RenderTarget,
   createRenderTarget,
   clearRenderTarget,
+  ensureDepthBuffer,
+  clearDepthBuffer,
   setPixel,
   blendPixel,
   copyToCanvas,
@@ -1094,6 +1113,14 @@ export {
   renderHeatmap,
 } from './graphics/rasterizer';
 
+export {
+  // Native raster kernels (libtsyne.so) - optional fast path
+  NativeRaster,
+  NativeRasterImage,
+  loadNativeRaster,
+  isNativeRasterAvailable,
+} from './graphics/native-raster';
+
 export {
   // Geometry
   Point,
@@ -0,0 +1,245 @@
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { PNG } from 'pngjs';
+import { TileDecodePool } from './decodePool';
+import { TileDecodeError } from './imageDecode';
+import { TilePack } from './tilePack';
+import { TileMapRenderer, decodePNG } from './tileRenderer';
+import { TILE_SOURCES } from './tiles';
+
+function makePNG(size: number, seed: number): ArrayBuffer {
+  const png = new PNG({ width: size, height: size });
+  for (let i = 0; i < png.data.length; i++) {
+    png.data[i] = (i * 31 + seed * 17) & 255;
+  }
+  const bytes = PNG.sync.write(png);
+  return bytes.buffer.slice(bytes.byteOffset, bytes.byteOffset + bytes.byteLength) as ArrayBuffer;
+}
+
+describe('TileDecodePool', () => {
+  let pool: TileDecodePool;
+
+  beforeAll(() => {
+    pool = TileDecodePool.create({ threads: 1, maxQueue: 3 })!;
+  });
+
+  afterAll(() => {
+    pool.destroy();
+  });
+
+  it('decodes on a worker and leaves the caller its buffer', async () => {
+    const encoded = makePNG(16, 1);
+    const image = await pool.decode(encoded);
+    const expected = await decodePNG(encoded);
+
+    expect(encoded.byteLength).toBeGreaterThan(0);
+    expect(image.width).toBe(16);
+    expect(image.height).toBe(16);
+    expect(Buffer.from(image.data).equals(Buffer.from(expected.data))).toBe(true);
+    expect(pool.getStats().decoded).toBeGreaterThanOrEqual(1);
+  });
+
+  it('rejects data that is not an image', async () => {
+    await expect(pool.decode(new Uint8Array([1, 2, 3, 4]).buffer)).rejects.toThrow('Unsupported');
+  });
+
+  it('marks corrupt bytes with TileDecodeError and dropped decodes without', async () => {
+    const corrupt = makePNG(16, 1).slice(0, 60);
+    const results = await Promise.allSettled([
+      pool.decode(corrupt),
+      pool.decode(makePNG(32, 13), 'prefetch'),
+      pool.decode(makePNG(32, 14), 'visible'),
+      pool.decode(makePNG(32, 15), 'visible'),
+      pool.decode(makePNG(32, 16), 'visible'),
+    ]);
+
+    const corruptErr = (results[0] as PromiseRejectedResult).reason;
+    const droppedErr = (results[1] as PromiseRejectedResult).reason;
+    expect(corruptErr instanceof TileDecodeError).toBe(true);
+    expect(droppedErr.message).toBe('Decode queue full');
+    expect(droppedErr instanceof TileDecodeError).toBe(false);
+  });
+
+  it('promotes a queued prefetch ahead of the other prefetches', async () => {
+    const order: string[] = [];
+    const track = (name: string, promise: Promise<unknown>) => promise.then(() => order.push(name));
+
+    const running = pool.decode(makePNG(64, 17), 'prefetch');
+    const first = pool.decode(makePNG(64, 18), 'prefetch');
+    const second = pool.decode(makePNG(64, 19), 'prefetch');
+    pool.promote(second);
+    await Promise.all([track('running', running), track('first', first), track('second', second)]);
+
+    expect(order).toEqual(['running', 'second', 'first']);
+  });
+
+  it('decodes visible tiles before queued prefetches', async () => {
+    const order: string[] = [];
+    const track = (name: string, promise: Promise<unknown>) => promise.then(() => order.push(name));
+
+    const jobs = [
+      track('prefetch-0', pool.decode(makePNG(64, 2), 'prefetch')),
+      track('prefetch-1', pool.decode(makePNG(64, 3), 'prefetch')),
+      track('prefetch-2', pool.decode(makePNG(64, 4), 'prefetch')),
+      track('visible', pool.decode(makePNG(64, 5), 'visible')),
+    ];
+    await Promise.all(jobs);
+
+    // prefetch-0 was already on the worker when the visible tile arrived
+    expect(order).toEqual(['prefetch-0', 'visible', 'prefetch-1', 'prefetch-2']);
+  });
+
+  it('drops the oldest prefetch when the queue is full', async () => {
+    const dropped = pool.getStats().dropped;
+    const results = await Promise.allSettled([
+      pool.decode(makePNG(32, 6), 'prefetch'),  // Goes straight to the worker
+      pool.decode(makePNG(32, 7), 'prefetch'),
+      pool.decode(makePNG(32, 8), 'visible'),
+      pool.decode(makePNG(32, 9), 'visible'),
+      pool.decode(makePNG(32, 10), 'visible'),
+    ]);
+
+    expect(results.map(r => r.status)).toEqual(['fulfilled', 'rejected', 'fulfilled', 'fulfilled', 'fulfilled']);
+    expect((results[1] as PromiseRejectedResult).reason.message).toBe('Decode queue full');
+    expect(pool.getStats().dropped).toBe(dropped + 1);
+  });
+
+  it('cancels queued decodes', async () => {
+    const controller = new AbortController();
+    const running = pool.decode(makePNG(64, 11));
+    const queued = pool.decode(makePNG(64, 12), 'prefetch', controller.signal);
+    controller.abort();
+
+    await expect(queued).rejects.toThrow('Decode cancelled');
+    await expect(running).resolves.toBeDefined();
+  });
+});
+
+/**
+ * A stand-in pool whose decodes settle when the test says so
+ */
+function manualPool() {
+  const calls: Array<{ priority: string; promise: Promise<any>; resolve: (v: any) => void; reject: (e: Error) => void }> = [];
+  const promoted: Promise<any>[] = [];
+  const pool = {
+    decode(_buffer: ArrayBuffer, priority = 'visible') {
+      let resolve!: (v: any) => void;
+      let reject!: (e: Error) => void;
+      const promise = new Promise((res, rej) => { resolve = res; reject = rej; });
+      calls.push({ priority, promise, resolve, reject });
+      return promise;
+    },
+    promote(decoding: Promise<any>) {
+      promoted.push(decoding);
+    },
+  };
+  return { pool: pool as unknown as TileDecodePool, calls, promoted };
+}
+
+const settleIO = () => new Promise(resolve => setImmediate(resolve));
+
+describe('TileMapRenderer decode failures and priority', () => {
+  let cacheDir: string;
+  const coord = { z: 3, x: 1, y: 2 };
+
+  beforeEach(() => {
+    cacheDir = fs.mkdtempSync(path.join(os.tmpdir(), 'tsyne-decode-'));
+    const pack = new TilePack(path.join(cacheDir, 'osm.tiles'));
+    pack.put(coord, makePNG(16, 1));
+    pack.close();
+  });
+
+  afterEach(() => {
+    fs.rmSync(cacheDir, { recursive: true, force: true });
+  });
+
+  it('keeps the bytes when a decode is dropped, not when they are corrupt', async () => {
+    const { pool, calls } = manualPool();
+    const renderer = new TileMapRenderer(TILE_SOURCES.osmRaster(), { fsCachePath: cacheDir, decodePool: pool });
+
+    const dropped = renderer.getTile(coord);
+    await settleIO();
+    calls[0].reject(new Error('Decode queue full'));
+    expect(await dropped).toBeNull();
+    expect(renderer.hasTile(coord)).toBe(true);
+
+    const corrupt = renderer.getTile(coord);
+    await settleIO();
+    calls[1].reject(new TileDecodeError('bad CRC'));
+    const errorSpy = jest.spyOn(console, 'error').mockImplementation(() => {});
+    expect(await corrupt).toBeNull();
+    errorSpy.mockRestore();
+    expect(renderer.hasTile(coord)).toBe(false);
+    renderer.close();
+  });
+
+  it('promotes a pending prefetch decode when a visible request joins it', async () => {
+    const { pool, calls, promoted } = manualPool();
+    const renderer = new TileMapRenderer(TILE_SOURCES.osmRaster(), { fsCachePath: cacheDir, decodePool: pool });
+
+    const prefetch = renderer.getTile(coord, 'prefetch');
+    await settleIO();
+    expect(calls.map(c => c.priority)).toEqual(['prefetch']);
+
+    const visible = renderer.getTile(coord);
+    expect(calls.length).toBe(1);
+    expect(promoted).toEqual([calls[0].promise]);
+
+    calls[0].resolve({ width: 16, height: 16, data: new Uint8Array(16 * 16 * 4) });
+    expect((await visible)?.image.width).toBe(16);
+    expect(await prefetch).toEqual(await visible);
+    renderer.close();
+  });
+
+  it('decodes at visible priority when a visible request joins before the bytes arrive', async () => {
+    const { pool, calls, promoted } = manualPool();
+    const renderer = new TileMapRenderer(TILE_SOURCES.osmRaster(), { fsCachePath: cacheDir, decodePool: pool });
+
+    const prefetch = renderer.getTile(coord, 'prefetch');
+    renderer.getTile(coord);
+    await settleIO();
+    expect(calls.map(c => c.priority)).toEqual(['visible']);
+    expect(promoted).toEqual([]);
+
+    calls[0].resolve({ width: 16, height: 16, data: new Uint8Array(16 * 16 * 4) });
+    await prefetch;
+    renderer.close();
+  });
+});
+
+describe('TileMapRenderer with decode threads', () => {
+  let cacheDir: string;
+
+  beforeEach(() => {
+    cacheDir = fs.mkdtempSync(path.join(os.tmpdir(), 'tsyne-decode-'));
+  });
+
+  afterEach(() => {
+    fs.rmSync(cacheDir, { recursive: true, force: true });
+  });
+
+  it('decodes cached tiles off the main thread', async () => {
+    const pack = new TilePack(path.join(cacheDir, 'osm.tiles'));
+    const tiles = Array.from({ length: 12 }, (_, i) => ({ z: 4, x: i, y: 5 }));
+    tiles.forEach((coord, i) => pack.put(coord, makePNG(256, i)));
+    pack.close();
+
+    const renderer = new TileMapRenderer(TILE_SOURCES.osmRaster(), { fsCachePath: cacheDir, decodeThreads: 2 });
+    // Longest gap between event loop turns while the tiles decode
+    let maxGap = 0;
+    let last = performance.now();
+    const timer = setInterval(() => {
+      const now = performance.now();
+      maxGap = Math.max(maxGap, now - last);
+      last = now;
+    }, 1);
+
+    const images = await Promise.all(tiles.map(coord => renderer.getTile(coord)));
+    clearInterval(timer);
+    renderer.close();
+
+    expect(images.every(image => image?.image.width === 256)).toBe(true);
+    console.log(`12 tiles decoded on 2 workers: longest event loop stall ${maxGap.toFixed(1)}ms`);
+  });
+});
@@ -0,0 +1,309 @@
+/**
+ * Tile Decode Pool
+ *
+ * Decodes PNG/JPEG tiles on worker threads so a viewport's worth of tiles
+ * doesn't block the event loop. Each worker takes one tile at a time from a
+ * bounded two-level queue: visible tiles always go before prefetched ones,
+ * and when the queue is full the oldest prefetch (then the oldest visible
+ * tile) is dropped. Encoded bytes are copied to the worker; the decoded RGBA
+ * buffer is transferred back without a copy.
+ *
+ * When worker threads are unavailable, or every worker has died, tiles are
+ * decoded on the calling thread instead.
+ */
+
+import type { Worker } from 'worker_threads';
+import * as os from 'os';
+import { decodeImageSync, DecodedImage, TileDecodeError } from './imageDecode';
+
+export type DecodePriority = 'visible' | 'prefetch';
+
+/** Message to a decode worker */
+export interface DecodeRequest {
+    id: number;
+    buffer: ArrayBuffer;
+}
+
+/** Reply from a decode worker: pixels, or an error message */
+export interface DecodeResult {
+    id: number;
+    width?: number;
+    height?: number;
+    data?: ArrayBuffer;
+    error?: string;
+    /** The error came from the bytes themselves (see TileDecodeError) */
+    corrupt?: boolean;
+}
+
+export interface TileDecodePoolOptions {
+    /** Worker threads. Default: CPU count - 1, between 1 and 4 */
+    threads?: number;
+    /** Most tiles waiting for a worker. Default 256 */
+    maxQueue?: number;
+}
+
+export interface TileDecodePoolStats {
+    threads: number;
+    busy: number;
+    queuedVisible: number;
+    queuedPrefetch: number;
+    decoded: number;
+    dropped: number;
+}
+
+interface DecodeJob {
+    id: number;
+    buffer: ArrayBuffer;
+    resolve: (image: DecodedImage) => void;
+    reject: (err: Error) => void;
+    signal?: AbortSignal;
+    onAbort?: () => void;
+}
+
+interface PoolWorker {
+    worker: Worker;
+    job: DecodeJob | null;
+}
+
+export class TileDecodePool {
+    private workers: PoolWorker[] = [];
+    private visible: DecodeJob[] = [];
+    private prefetch: DecodeJob[] = [];
+    private maxQueue: number;
+    private nextId = 1;
+    private decoded = 0;
+    private dropped = 0;
+    private jobs = new WeakMap<Promise<DecodedImage>, DecodeJob>();
+
+    /**
+     * Start the pool, or return null when worker threads are unavailable
+     */
+    static create(options?: TileDecodePoolOptions): TileDecodePool | null {
+        const script = resolveWorkerScript();
+        if (!script) {
+            return null;
+        }
+        try {
+            return new TileDecodePool(script, options);
+        } catch {
+            return null;
+        }
+    }
+
+    private constructor(script: WorkerScript, options?: TileDecodePoolOptions) {
+        const { Worker } = require('worker_threads') as typeof import('worker_threads');
+        const threads = Math.max(1, options?.threads ?? Math.min(4, Math.max(1, os.cpus().length - 1)));
+        this.maxQueue = Math.max(1, options?.maxQueue ?? 256);
+
+        for (let i = 0; i < threads; i++) {
+            const entry: PoolWorker = {
+                worker: new Worker(script.filename, { execArgv: script.execArgv }),
+                job: null
+            };
+            entry.worker.on('message', (result: DecodeResult) => this.finish(entry, result));
+            entry.worker.on('error', err => this.fail(entry, err));
+            entry.worker.on('exit', () => this.fail(entry, new Error('Decode worker exited')));
+            entry.worker.unref();
+            this.workers.push(entry);
+        }
+    }
+
+    /**
+     * Decode an encoded tile. The buffer is copied, so the caller keeps it.
+     * Rejects with a TileDecodeError when the bytes are not an image.
+     */
+    decode(buffer: ArrayBuffer, priority: DecodePriority = 'visible', signal?: AbortSignal): Promise<DecodedImage> {
+        if (signal?.aborted) {
+            return Promise.reject(new Error('Decode cancelled'));
+        }
+        if (this.workers.length === 0) {
+            // No workers left: decode here
+            try {
+                return Promise.resolve(decodeImageSync(buffer));
+            } catch (err: any) {
+                return Promise.reject(err);
+            }
+        }
+
+        let job!: DecodeJob;
+        const decoding = new Promise<DecodedImage>((resolve, reject) => {
+            job = { id: this.nextId++, buffer: buffer.slice(0), resolve, reject, signal };
+            if (signal) {
+                job.onAbort = () => {
+                    if (this.removeQueued(job)) {
+                        reject(new Error('Decode cancelled'));
+                    }
+                };
+                signal.addEventListener('abort', job.onAbort, { once: true });
+            }
+
+            (priority === 'visible' ? this.visible : this.prefetch).push(job);
+            this.enforceLimit();
+            this.dispatch();
+        });
+        this.jobs.set(decoding, job);
+        return decoding;
+    }
+
+    /**
+     * Move a queued prefetch decode into the visible queue, behind the
+     * visible tiles already waiting. No-op once the decode has started.
+     */
+    promote(decoding: Promise<DecodedImage>): void {
+        const job = this.jobs.get(decoding);
+        const index = job ? this.prefetch.indexOf(job) : -1;
+        if (index !== -1) {
+            this.prefetch.splice(index, 1);
+            this.visible.push(job!);
+        }
+    }
+
+    getStats(): TileDecodePoolStats {
+        return {
+            threads: this.workers.length,
+            busy: this.workers.filter(w => w.job !== null).length,
+            queuedVisible: this.visible.length,
+            queuedPrefetch: this.prefetch.length,
+            decoded: this.decoded,
+            dropped: this.dropped
+        };
+    }
+
+    /**
+     * Stop the workers; queued and running decodes are rejected
+     */
+    destroy(): void {
+        const workers = this.workers;
+        this.workers = [];
+        for (const entry of workers) {
+            if (entry.job) this.settle(entry.job, new Error('Decode pool destroyed'));
+            entry.job = null;
+            entry.worker.removeAllListeners();
+            entry.worker.terminate();
+        }
+        for (const job of [...this.visible, ...this.prefetch]) {
+            this.settle(job, new Error('Decode pool destroyed'));
+        }
+        this.visible = [];
+        this.prefetch = [];
+    }
+
+    private removeQueued(job: DecodeJob): boolean {
+        for (const queue of [this.visible, this.prefetch]) {
+            const index = queue.indexOf(job);
+            if (index !== -1) {
+                queue.splice(index, 1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    private enforceLimit(): void {
+        while (this.visible.length + this.prefetch.length > this.maxQueue) {
+            const oldest = this.prefetch.length > 0 ? this.prefetch.shift()! : this.visible.shift()!;
+            this.dropped++;
+            this.settle(oldest, new Error('Decode queue full'));
+        }
+    }
+
+    private dispatch(): void {
+        for (const entry of this.workers) {
+            if (entry.job) continue;
+            const job = this.visible.shift() ?? this.prefetch.shift();
+            if (!job) return;
+
+            entry.job = job;
+            // Busy workers keep the process alive until their tile is back
+            entry.worker.ref();
+            const request: DecodeRequest = { id: job.id, buffer: job.buffer };
+            entry.worker.postMessage(request, [job.buffer]);
+        }
+    }
+
+    private finish(entry: PoolWorker, result: DecodeResult): void {
+        const job = entry.job;
+        entry.job = null;
+        entry.worker.unref();
+        if (job && job.id === result.id) {
+            if (result.error !== undefined || !result.data) {
+                const message = result.error ?? 'Decode failed';
+                this.settle(job, result.corrupt ? new TileDecodeError(message) : new Error(message));
+            } else {
+                this.decoded++;
+                this.settle(job, null, {
+                    width: result.width!,
+                    height: result.height!,
+                    data: new Uint8Array(result.data)
+                });
+            }
+        }
+        this.dispatch();
+    }
+
+    private fail(entry: PoolWorker, err: Error): void {
+        const index = this.workers.indexOf(entry);
+        if (index === -1) return;
+        this.workers.splice(index, 1);
+        if (entry.job) {
+            this.settle(entry.job, err);
+            entry.job = null;
+        }
+
+        if (this.workers.length === 0) {
+            // Last worker gone: finish the queue on this thread
+            for (const job of this.visible.splice(0).concat(this.prefetch.splice(0))) {
+                try {
+                    this.settle(job, null, decodeImageSync(job.buffer));
+                } catch (decodeErr: any) {
+                    this.settle(job, decodeErr);
+                }
+            }
+        } else {
+            this.dispatch();
+        }
+    }
+
+    private settle(job: DecodeJob, err: Error | null, image?: DecodedImage): void {
+        if (job.signal && job.onAbort) {
+            job.signal.removeEventListener('abort', job.onAbort);
+        }
+        if (err) {
+            job.reject(err);
+        } else {
+            job.resolve(image!);
+        }
+    }
+}
+
+interface WorkerScript {
+    filename: string;
+    execArgv?: string[];
+}
+
+/**
+ * Find the worker entry point next to this module: compiled JavaScript in
+ * a build, or the TypeScript source when running under ts-jest/tsx
+ */
+function resolveWorkerScript(): WorkerScript | null {
+    try {
+        const fs = require('fs') as typeof import('fs');
+        const path = require('path') as typeof import('path');
+        const js = path.join(__dirname, 'decodeWorker.js');
+        if (fs.existsSync(js)) {
+            return { filename: js };
+        }
+        const ts = path.join(__dirname, 'decodeWorker.ts');
+        if (!fs.existsSync(ts)) {
+            return null;
+        }
+        try {
+            require.resolve('tsx/cjs');
+            return { filename: ts, execArgv: [...process.execArgv, '--require', 'tsx/cjs'] };
+        } catch {
+            return { filename: ts };
+        }
+    } catch {
+        return null;
+    }
+}
@@ -0,0 +1,28 @@
+/**
+ * Tile decode worker thread entry point (see decodePool.ts)
+ *
+ * Decodes one encoded tile per message and transfers the RGBA pixels back.
+ */
+
+import { parentPort } from 'worker_threads';
+import { decodeImageSync, TileDecodeError } from './imageDecode';
+import type { DecodeRequest, DecodeResult } from './decodePool';
+
+parentPort!.on('message', (request: DecodeRequest) => {
+    let result: DecodeResult;
+    let transfer: ArrayBuffer[] = [];
+    try {
+        const image = decodeImageSync(request.buffer);
+        // Hand over the pixel buffer itself, not a copy
+        let pixels = image.data;
+        if (pixels.byteOffset !== 0 || pixels.byteLength !== pixels.buffer.byteLength ||
+            !(pixels.buffer instanceof ArrayBuffer)) {
+            pixels = pixels.slice();
+        }
+        result = { id: request.id, width: image.width, height: image.height, data: pixels.buffer as ArrayBuffer };
+        transfer = [result.data!];
+    } catch (err: any) {
+        result = { id: request.id, error: err?.message ?? String(err), corrupt: err instanceof TileDecodeError };
+    }
+    parentPort!.postMessage(result, transfer);
+});
@@ -0,0 +1,72 @@
+/**
+ * Synchronous tile image decoding, shared by the main thread and the decode
+ * workers (see decodePool.ts)
+ */
+
+import { PNG } from 'pngjs';
+
+export interface DecodedImage {
+    width: number;
+    height: number;
+    data: Uint8Array;
+}
+
+/**
+ * The bytes are not a decodable tile: corrupt, truncated or an unknown
+ * format. Anything else (a full queue, a cancelled or interrupted decode)
+ * says nothing about the bytes and uses a plain Error.
+ */
+export class TileDecodeError extends Error {
+    constructor(message: string) {
+        super(message);
+        this.name = 'TileDecodeError';
+    }
+}
+
+function isPNG(bytes: Uint8Array): boolean {
+    return bytes.length >= 8 && bytes[0] === 0x89 && bytes[1] === 0x50 && bytes[2] === 0x4e && bytes[3] === 0x47;
+}
+
+function isJPEG(bytes: Uint8Array): boolean {
+    return bytes.length >= 3 && bytes[0] === 0xff && bytes[1] === 0xd8 && bytes[2] === 0xff;
+}
+
+/**
+ * Decode PNG or JPEG bytes to RGBA pixels. JPEG needs the optional jpeg-js
+ * package.
+ */
+export function decodeImageSync(buffer: ArrayBuffer | Uint8Array): DecodedImage {
+    const bytes = buffer instanceof Uint8Array ? buffer : new Uint8Array(buffer);
+    const data = Buffer.from(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+
+    if (isJPEG(bytes)) {
+        let jpeg: { decode(data: Buffer, options: object): { width: number; height: number; data: Uint8Array } };
+        try {
+            jpeg = require('jpeg-js');
+        } catch {
+            throw new Error('JPEG tiles need the jpeg-js package');
+        }
+        let image: { width: number; height: number; data: Uint8Array };
+        try {
+            image = jpeg.decode(data, { useTArray: true, formatAsRGBA: true });
+        } catch (err: any) {
+            throw new TileDecodeError(err?.message ?? String(err));
+        }
+        return { width: image.width, height: image.height, data: image.data };
+    }
+
+    if (!isPNG(bytes)) {
+        throw new TileDecodeError('Unsupported tile image format');
+    }
+    let png: PNG;
+    try {
+        png = PNG.sync.read(data);
+    } catch (err: any) {
+        throw new TileDecodeError(err?.message ?? String(err));
+    }
+    return {
+        width: png.width,
+        height: png.height,
+        data: new Uint8Array(png.data.buffer, png.data.byteOffset, png.data.byteLength)
+    };
+}
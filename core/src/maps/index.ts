@@ -58,7 +58,30 @@ export {
     getTilePosition,
     TileMapRenderer,
     TileMapRendererOptions,
+    TileCompositor,
+    CompositorTile,
     ImageData,
     TileImage,
     MapViewport
 } from './tileRenderer';
+
+export { ByteBudgetCache, ByteBudgetCacheOptions } from './tileCache';
+export { TilePack, TilePackOptions } from './tilePack';
+export {
+    TileDecodePool,
+    TileDecodePoolOptions,
+    TileDecodePoolStats,
+    DecodePriority
+} from './decodePool';
+export { decodeImageSync, DecodedImage, TileDecodeError } from './imageDecode';
+
+// ============================================================================
+// Tile Prefetching
+// ============================================================================
+
+export {
+    TilePrefetcher,
+    TilePrefetcherOptions,
+    TilePrefetchTarget,
+    TilePrefetchStats
+} from './prefetch';
@@ -34,6 +34,9 @@ import {
     latFromMercatorY
 } from '../geo';
 
+import { MapViewport } from './tileRenderer';
+import { TilePrefetcher } from './prefetch';
+
 // ============================================================================
 // Types
 // ============================================================================
@@ -48,6 +51,8 @@ export interface TsyneMapOptions {
     pitch?: number;
     accessToken?: string;
     style?: string;
+    /** Fed every viewport change so it can load tiles ahead of panning and zooming */
+    prefetcher?: TilePrefetcher;
 }
 
 export interface TsyneMapState {
@@ -72,6 +77,7 @@ export class TsyneMap {
     private accessToken: string;
     private styleUrl: string;
     private dirty: boolean = true;
+    private prefetcher?: TilePrefetcher;
 
     // Event handlers
     private onMoveListeners: Array<() => void> = [];
@@ -97,6 +103,7 @@ export class TsyneMap {
 
         this.accessToken = options.accessToken || '';
         this.styleUrl = options.style || '';
+        this.prefetcher = options.prefetcher;
     }
 
     // ========================================================================
@@ -178,6 +185,26 @@ export class TsyneMap {
         return earthCircumference * Math.cos(lat * Math.PI / 180) / (512 * scale);
     }
 
+    /**
+     * The viewport in 256px tile terms, for getTilesForViewport and
+     * TileMapRenderer. This map's world is 512px at zoom 0, so tile zoom is
+     * one level higher.
+     */
+    getViewport(): MapViewport {
+        return {
+            center: { lng: this.state.center.lng, lat: this.state.center.lat },
+            zoom: this.state.zoom + 1,
+            width: this.target.width,
+            height: this.target.height
+        };
+    }
+
+    setPrefetcher(prefetcher: TilePrefetcher | undefined): this {
+        this.prefetcher?.cancel();
+        this.prefetcher = prefetcher;
+        return this;
+    }
+
     // ========================================================================
     // Coordinate Projection
     // ========================================================================
@@ -425,6 +452,7 @@ export class TsyneMap {
     }
 
     private notifyMove(): void {
+        this.prefetcher?.update(this.getViewport());
         for (const listener of this.onMoveListeners) {
             listener();
         }
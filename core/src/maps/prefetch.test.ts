@@ -0,0 +1,175 @@
+import * as http from 'http';
+import { TilePrefetcher, TilePrefetchTarget } from './prefetch';
+import { TileMapRenderer, MapViewport, getTilesForViewport } from './tileRenderer';
+import { TileCoord } from './tiles';
+
+// Longitude span of one 256px tile at zoom z
+const tileLng = (z: number) => 360 / Math.pow(2, z);
+
+function fakeTarget() {
+  const requested: TileCoord[] = [];
+  const aborted: string[] = [];
+  const target: TilePrefetchTarget = {
+    prefetchTile: (coord, signal) => {
+      requested.push(coord);
+      return new Promise<boolean>(resolve => {
+        signal?.addEventListener('abort', () => {
+          aborted.push(`${coord.z}/${coord.x}/${coord.y}`);
+          resolve(false);
+        });
+      });
+    }
+  };
+  return { target, requested, aborted };
+}
+
+const flush = () => new Promise(resolve => setTimeout(resolve, 5));
+
+describe('TilePrefetcher', () => {
+  let time: number;
+  const now = () => time;
+  const viewport = (lng: number, zoom: number = 10): MapViewport =>
+    ({ center: { lng, lat: 0.1 }, zoom, width: 512, height: 512 });
+
+  beforeEach(() => {
+    time = 1000;
+  });
+
+  it('prefetches nothing while the map is still', () => {
+    const { target } = fakeTarget();
+    const prefetcher = new TilePrefetcher(target, { now });
+    prefetcher.update(viewport(0));
+    time += 16;
+    prefetcher.update(viewport(0));
+
+    expect(prefetcher.getQueue()).toEqual([]);
+  });
+
+  it('queues tiles ahead of a pan only', () => {
+    const { target } = fakeTarget();
+    const prefetcher = new TilePrefetcher(target, { now, lookaheadMs: 300 });
+    for (let i = 0; i < 4; i++) {
+      prefetcher.update(viewport(i * tileLng(10) / 8));
+      time += 16;
+    }
+
+    const current = viewport(3 * tileLng(10) / 8);
+    const visibleX = getTilesForViewport(current).map(t => t.x);
+    const queue = prefetcher.getQueue();
+    expect(queue.length).toBeGreaterThan(0);
+    for (const tile of queue) {
+      expect(tile.z).toBe(10);
+      expect(tile.x).toBeGreaterThan(Math.max(...visibleX));
+    }
+  });
+
+  it('queues the next zoom level while zooming in', () => {
+    const { target } = fakeTarget();
+    const prefetcher = new TilePrefetcher(target, { now });
+    prefetcher.update(viewport(0, 10));
+    time += 16;
+    prefetcher.update(viewport(0, 10.2));
+
+    const queue = prefetcher.getQueue();
+    expect(queue.length).toBeGreaterThan(0);
+    expect(queue.every(t => t.z === 11)).toBe(true);
+  });
+
+  it('skips tiles the target already has', () => {
+    const { target } = fakeTarget();
+    target.hasTile = () => true;
+    const prefetcher = new TilePrefetcher(target, { now });
+    prefetcher.update(viewport(0, 10));
+    time += 16;
+    prefetcher.update(viewport(0, 10.2));
+
+    expect(prefetcher.getQueue()).toEqual([]);
+  });
+
+  it('runs a few loads at a time and cancels ones the viewport turned away from', async () => {
+    const { target, requested, aborted } = fakeTarget();
+    const prefetcher = new TilePrefetcher(target, { now, concurrency: 2 });
+    for (let i = 0; i < 4; i++) {
+      prefetcher.update(viewport(i * tileLng(10) / 8));
+      time += 16;
+    }
+    await flush();
+    expect(requested).toHaveLength(2);
+    expect(prefetcher.getStats().inFlight).toBe(2);
+
+    // Reverse the pan
+    for (let i = 3; i >= -6; i--) {
+      prefetcher.update(viewport(i * tileLng(10) / 8));
+      time += 16;
+    }
+    await flush();
+    expect(aborted.length).toBeGreaterThanOrEqual(2);
+    expect(prefetcher.getStats().cancelled).toBeGreaterThanOrEqual(2);
+    expect(requested.slice(2).every(t => t.x < requested[0].x)).toBe(true);
+
+    prefetcher.cancel();
+    expect(prefetcher.getStats().inFlight).toBe(0);
+  });
+});
+
+describe('Prefetch blank-tile benchmark', () => {
+  let server: http.Server;
+  let baseUrl: string;
+  const latencyMs = 60;
+
+  // Local stand-in for a tile server with fixed latency
+  beforeAll(async () => {
+    server = http.createServer((req, res) => {
+      setTimeout(() => {
+        res.writeHead(200, { 'Content-Type': 'image/png' });
+        res.end(Buffer.from(`tile ${req.url}`));
+      }, latencyMs);
+    });
+    await new Promise<void>(resolve => server.listen(0, '127.0.0.1', resolve));
+    baseUrl = `http://127.0.0.1:${(server.address() as { port: number }).port}`;
+  });
+
+  afterAll(async () => {
+    await new Promise(resolve => server.close(resolve));
+  });
+
+  async function blankRate(prefetch: boolean): Promise<number> {
+    const renderer = new TileMapRenderer({ url: `${baseUrl}/{z}/{x}/{y}.png`, type: 'raster', tileSize: 256 });
+    const prefetcher = prefetch ? new TilePrefetcher(renderer, { concurrency: 4 }) : null;
+    const zoom = 14;
+    const pxPerFrame = 24;
+    let lng = 2.35;
+    let blank = 0;
+    let shown = 0;
+
+    // Warm up the first viewport so both runs start from a full screen
+    const start: MapViewport = { center: { lng, lat: 48.85 }, zoom, width: 512, height: 384 };
+    await Promise.all(getTilesForViewport(start).map(t => renderer.getTileBytes(t)));
+
+    for (let frame = 0; frame < 40; frame++) {
+      lng += pxPerFrame * tileLng(zoom) / 256;
+      const view: MapViewport = { ...start, center: { lng, lat: 48.85 } };
+      for (const coord of getTilesForViewport(view)) {
+        shown++;
+        if (!renderer.hasTile(coord)) {
+          blank++;
+          renderer.getTileBytes(coord);
+        }
+      }
+      prefetcher?.update(view);
+      await new Promise(resolve => setTimeout(resolve, 16));
+    }
+    prefetcher?.cancel();
+    return blank / shown;
+  }
+
+  it('shows fewer blank tiles while panning with prefetch', async () => {
+    const without = await blankRate(false);
+    const withPrefetch = await blankRate(true);
+    console.log(`blank tiles while panning: ${(without * 100).toFixed(1)}% without prefetch, ` +
+      `${(withPrefetch * 100).toFixed(1)}% with`);
+
+    expect(without).toBeGreaterThan(0);
+    expect(withPrefetch).toBeLessThan(without);
+  });
+});
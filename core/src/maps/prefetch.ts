@@ -0,0 +1,278 @@
+/**
+ * Tile Prefetching
+ *
+ * Tracks how the viewport moves and speculatively loads the tiles it is
+ * about to reveal: the ring beyond the leading edge of a pan (extrapolated
+ * from recent pan velocity) and the next zoom level in the direction the
+ * zoom is changing. Loads run a few at a time, start after the current
+ * task so visible tiles are requested first, and are cancelled when a later
+ * viewport no longer wants them.
+ */
+
+import { TileCoord } from './tiles';
+import { MapViewport, getTilesForViewport } from './tileRenderer';
+
+/**
+ * What the prefetcher loads tiles through (implemented by TileMapRenderer)
+ */
+export interface TilePrefetchTarget {
+    prefetchTile(coord: TileCoord, signal?: AbortSignal, decode?: boolean): Promise<boolean>;
+    hasTile?(coord: TileCoord): boolean;
+}
+
+export interface TilePrefetcherOptions {
+    /** How far ahead (ms) to extrapolate pan motion. Default 400 */
+    lookaheadMs?: number;
+    /** Extra tiles beyond the leading edge of a pan. Default 1 */
+    ring?: number;
+    /** Also load the next zoom level while zooming. Default true */
+    adjacentZoom?: boolean;
+    /** Prefetch loads in flight at once. Default 2 */
+    concurrency?: number;
+    /** Most tiles wanted at once. Default 32 */
+    maxQueue?: number;
+    /** Decode prefetched tiles too, not just fetch them. Default false */
+    decode?: boolean;
+    /** Tile size in pixels. Default 256 */
+    tileSize?: number;
+    /** Clock, for tests (default performance.now) */
+    now?: () => number;
+}
+
+export interface TilePrefetchStats {
+    queued: number;
+    inFlight: number;
+    completed: number;
+    cancelled: number;
+}
+
+// Motion older than this is treated as stopped
+const MOTION_TIMEOUT_MS = 250;
+// Smoothing for velocity estimates (weight of the newest sample)
+const VELOCITY_SMOOTHING = 0.5;
+
+function mercatorX(lng: number): number {
+    return (lng + 180) / 360;
+}
+
+function mercatorY(lat: number): number {
+    const latRad = lat * Math.PI / 180;
+    return (1 - Math.log(Math.tan(latRad) + 1 / Math.cos(latRad)) / Math.PI) / 2;
+}
+
+function lngFromMercator(x: number): number {
+    return x * 360 - 180;
+}
+
+function latFromMercator(y: number): number {
+    return Math.atan(Math.sinh(Math.PI * (1 - 2 * y))) * 180 / Math.PI;
+}
+
+function tileKey(coord: TileCoord): string {
+    return `${coord.z}/${coord.x}/${coord.y}`;
+}
+
+export class TilePrefetcher {
+    private target: TilePrefetchTarget;
+    private lookaheadMs: number;
+    private ring: number;
+    private adjacentZoom: boolean;
+    private concurrency: number;
+    private maxQueue: number;
+    private decode: boolean;
+    private tileSize: number;
+    private now: () => number;
+
+    // Last viewport, in mercator units (0-1), and smoothed motion
+    private last: { x: number; y: number; zoom: number; time: number } | null = null;
+    private velocityX = 0;  // mercator units per ms
+    private velocityY = 0;
+    private zoomVelocity = 0;  // zoom levels per ms
+
+    private queue: TileCoord[] = [];
+    private inFlight: Map<string, AbortController> = new Map();
+    private pumpScheduled = false;
+    private completed = 0;
+    private cancelled = 0;
+
+    constructor(target: TilePrefetchTarget, options?: TilePrefetcherOptions) {
+        this.target = target;
+        this.lookaheadMs = options?.lookaheadMs ?? 400;
+        this.ring = options?.ring ?? 1;
+        this.adjacentZoom = options?.adjacentZoom ?? true;
+        this.concurrency = Math.max(1, options?.concurrency ?? 2);
+        this.maxQueue = options?.maxQueue ?? 32;
+        this.decode = options?.decode ?? false;
+        this.tileSize = options?.tileSize ?? 256;
+        this.now = options?.now ?? (() => performance.now());
+    }
+
+    /**
+     * Report the viewport now on screen; replaces the prefetch queue
+     */
+    update(viewport: MapViewport): void {
+        this.track(viewport);
+        this.queue = this.predict(viewport);
+
+        // Cancel in-flight loads the new viewport doesn't want
+        const wanted = new Set(this.queue.map(tileKey));
+        for (const [key, controller] of this.inFlight) {
+            if (!wanted.has(key)) {
+                controller.abort();
+                this.inFlight.delete(key);
+                this.cancelled++;
+            }
+        }
+        this.queue = this.queue.filter(coord => !this.inFlight.has(tileKey(coord)));
+        this.schedulePump();
+    }
+
+    /**
+     * Drop the queue and abort everything in flight
+     */
+    cancel(): void {
+        this.cancelled += this.inFlight.size;
+        for (const controller of this.inFlight.values()) {
+            controller.abort();
+        }
+        this.inFlight.clear();
+        this.queue = [];
+    }
+
+    /**
+     * Tiles the last update() decided to prefetch, most wanted first
+     */
+    getQueue(): TileCoord[] {
+        return this.queue.slice();
+    }
+
+    getStats(): TilePrefetchStats {
+        return {
+            queued: this.queue.length,
+            inFlight: this.inFlight.size,
+            completed: this.completed,
+            cancelled: this.cancelled
+        };
+    }
+
+    private track(viewport: MapViewport): void {
+        const time = this.now();
+        const x = mercatorX(viewport.center.lng);
+        const y = mercatorY(viewport.center.lat);
+
+        const last = this.last;
+        this.last = { x, y, zoom: viewport.zoom, time };
+        if (!last) return;
+
+        const dt = time - last.time;
+        if (dt > MOTION_TIMEOUT_MS) {
+            // Started moving again after a pause: no usable history
+            this.velocityX = this.velocityY = this.zoomVelocity = 0;
+            return;
+        }
+        if (dt <= 0) return;
+
+        // Shortest way around the antimeridian
+        let dx = x - last.x;
+        if (dx > 0.5) dx -= 1;
+        if (dx < -0.5) dx += 1;
+
+        const blend = (previous: number, sample: number) =>
+            previous + (sample - previous) * VELOCITY_SMOOTHING;
+        this.velocityX = blend(this.velocityX, dx / dt);
+        this.velocityY = blend(this.velocityY, (y - last.y) / dt);
+        this.zoomVelocity = blend(this.zoomVelocity, (viewport.zoom - last.zoom) / dt);
+    }
+
+    private predict(viewport: MapViewport): TileCoord[] {
+        const visible = new Set(getTilesForViewport(viewport).map(tileKey));
+        const z = Math.round(viewport.zoom);
+        const worldSize = this.tileSize * Math.pow(2, z);
+        const cx = mercatorX(viewport.center.lng);
+        const cy = mercatorY(viewport.center.lat);
+        const candidates: TileCoord[] = [];
+        const seen = new Set<string>();
+        const add = (coord: TileCoord) => {
+            const key = tileKey(coord);
+            if (visible.has(key) || seen.has(key)) return;
+            if (this.target.hasTile?.(coord)) return;
+            seen.add(key);
+            candidates.push(coord);
+        };
+
+        // Pan: the viewport where motion is heading, widened by the ring on
+        // the moving axes, keeping only tiles ahead of the current center
+        const vx = this.velocityX * worldSize;  // px/ms
+        const vy = this.velocityY * worldSize;
+        const speed = Math.hypot(vx, vy);
+        if (this.last && this.now() - this.last.time <= MOTION_TIMEOUT_MS && speed > 0.01) {
+            const aheadX = cx + this.velocityX * this.lookaheadMs;
+            const aheadY = Math.min(1, Math.max(0, cy + this.velocityY * this.lookaheadMs));
+            const ringPx = this.ring * this.tileSize * 2;
+            const predicted: MapViewport = {
+                center: { lng: lngFromMercator(((aheadX % 1) + 1) % 1), lat: latFromMercator(aheadY) },
+                zoom: viewport.zoom,
+                width: viewport.width + (Math.abs(vx) / speed > 0.2 ? ringPx : 0),
+                height: viewport.height + (Math.abs(vy) / speed > 0.2 ? ringPx : 0)
+            };
+
+            const ahead = getTilesForViewport(predicted)
+                .map(coord => {
+                    // Tile center relative to the current center, in px, wrapped
+                    let dx = ((coord.x + 0.5) * this.tileSize) - cx * worldSize;
+                    if (dx > worldSize / 2) dx -= worldSize;
+                    if (dx < -worldSize / 2) dx += worldSize;
+                    const dy = ((coord.y + 0.5) * this.tileSize) - cy * worldSize;
+                    return { coord, along: (dx * vx + dy * vy) / speed, distance: Math.hypot(dx, dy) };
+                })
+                .filter(tile => tile.along > 0)
+                .sort((a, b) => a.distance - b.distance);
+            for (const tile of ahead) {
+                add(tile.coord);
+            }
+        }
+
+        // Zoom: the same viewport one level further in the zoom direction
+        if (this.adjacentZoom && Math.abs(this.zoomVelocity) > 1e-4) {
+            const nextZoom = z + Math.sign(this.zoomVelocity);
+            if (nextZoom >= 0 && nextZoom <= 22) {
+                for (const coord of getTilesForViewport({ ...viewport, zoom: nextZoom })) {
+                    add(coord);
+                }
+            }
+        }
+
+        return candidates.slice(0, this.maxQueue);
+    }
+
+    /**
+     * Start queued loads after the current task, so tiles for the visible
+     * viewport (requested synchronously by the caller) go first
+     */
+    private schedulePump(): void {
+        if (this.pumpScheduled) return;
+        this.pumpScheduled = true;
+        setTimeout(() => {
+            this.pumpScheduled = false;
+            this.pump();
+        }, 0);
+    }
+
+    private pump(): void {
+        while (this.inFlight.size < this.concurrency && this.queue.length > 0) {
+            const coord = this.queue.shift()!;
+            const key = tileKey(coord);
+            const controller = new AbortController();
+            this.inFlight.set(key, controller);
+
+            this.target.prefetchTile(coord, controller.signal, this.decode)
+                .catch(() => false)
+                .then(loaded => {
+                    if (this.inFlight.get(key) !== controller) return;  // Cancelled
+                    this.inFlight.delete(key);
+                    if (loaded) this.completed++;
+                    this.pump();
+                });
+        }
+    }
+}
@@ -0,0 +1,52 @@
+import { ByteBudgetCache } from './tileCache';
+
+describe('ByteBudgetCache', () => {
+  const sized = (maxBytes: number, extra: { maxEntries?: number; maxAge?: number } = {}) =>
+    new ByteBudgetCache<Uint8Array>({ maxBytes, sizeOf: v => v.byteLength, ...extra });
+
+  it('evicts least recently used entries once over the byte budget', () => {
+    const cache = sized(100);
+    cache.set('a', new Uint8Array(40));
+    cache.set('b', new Uint8Array(40));
+    cache.get('a');
+    cache.set('c', new Uint8Array(40));
+
+    expect(cache.get('a')).toBeDefined();
+    expect(cache.get('b')).toBeUndefined();
+    expect(cache.get('c')).toBeDefined();
+    expect(cache.bytes).toBe(80);
+  });
+
+  it('accounts for replaced and deleted entries', () => {
+    const cache = sized(100);
+    cache.set('a', new Uint8Array(30));
+    cache.set('a', new Uint8Array(50));
+    expect(cache.bytes).toBe(50);
+    expect(cache.delete('a')).toBe(true);
+    expect(cache.bytes).toBe(0);
+    expect(cache.size).toBe(0);
+  });
+
+  it('skips values larger than the whole budget', () => {
+    const cache = sized(100);
+    cache.set('small', new Uint8Array(10));
+    cache.set('huge', new Uint8Array(200));
+
+    expect(cache.get('huge')).toBeUndefined();
+    expect(cache.get('small')).toBeDefined();
+  });
+
+  it('honours an entry cap and a max age', () => {
+    const capped = sized(1000, { maxEntries: 2 });
+    capped.set('a', new Uint8Array(1));
+    capped.set('b', new Uint8Array(1));
+    capped.set('c', new Uint8Array(1));
+    expect(capped.size).toBe(2);
+    expect(capped.get('a')).toBeUndefined();
+
+    const expiring = sized(1000, { maxAge: -1 });
+    expiring.set('a', new Uint8Array(1));
+    expect(expiring.get('a')).toBeUndefined();
+    expect(expiring.bytes).toBe(0);
+  });
+});
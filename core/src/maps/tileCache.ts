@@ -0,0 +1,105 @@
+/**
+ * Byte-Budgeted Tile Cache
+ *
+ * LRU cache bounded by the memory its values hold rather than by entry
+ * count, so a cache of decoded 256px tiles (256 KB each) and one of encoded
+ * tiles (~20 KB each) can share a budget expressed in bytes.
+ */
+
+export interface ByteBudgetCacheOptions<V> {
+    /** Total size of the cached values before least recently used ones are evicted */
+    maxBytes: number;
+    /** Size of one value in bytes */
+    sizeOf: (value: V) => number;
+    /** Optional cap on the number of entries as well */
+    maxEntries?: number;
+    /** Entries older than this (ms) read as missing. Default: never */
+    maxAge?: number;
+}
+
+interface BudgetEntry<V> {
+    value: V;
+    bytes: number;
+    timestamp: number;
+}
+
+export class ByteBudgetCache<V> {
+    private entries: Map<string, BudgetEntry<V>> = new Map();
+    private maxBytes: number;
+    private maxEntries: number;
+    private maxAge: number;
+    private sizeOf: (value: V) => number;
+    private totalBytes = 0;
+
+    constructor(options: ByteBudgetCacheOptions<V>) {
+        this.maxBytes = options.maxBytes;
+        this.maxEntries = options.maxEntries ?? Infinity;
+        this.maxAge = options.maxAge ?? Infinity;
+        this.sizeOf = options.sizeOf;
+    }
+
+    get(key: string): V | undefined {
+        const entry = this.entries.get(key);
+        if (!entry) return undefined;
+
+        if (Date.now() - entry.timestamp > this.maxAge) {
+            this.delete(key);
+            return undefined;
+        }
+
+        // Move to end (most recently used)
+        this.entries.delete(key);
+        this.entries.set(key, entry);
+        return entry.value;
+    }
+
+    /**
+     * Whether key is cached and unexpired, without marking it as used
+     */
+    has(key: string): boolean {
+        const entry = this.entries.get(key);
+        return entry !== undefined && Date.now() - entry.timestamp <= this.maxAge;
+    }
+
+    set(key: string, value: V): void {
+        this.delete(key);
+
+        const bytes = this.sizeOf(value);
+        // A value bigger than the whole budget is not worth evicting everything for
+        if (bytes > this.maxBytes) return;
+
+        this.entries.set(key, { value, bytes, timestamp: Date.now() });
+        this.totalBytes += bytes;
+
+        // Evict from the least recently used end
+        for (const [oldestKey, oldest] of this.entries) {
+            if (this.totalBytes <= this.maxBytes && this.entries.size <= this.maxEntries) break;
+            this.entries.delete(oldestKey);
+            this.totalBytes -= oldest.bytes;
+        }
+    }
+
+    delete(key: string): boolean {
+        const entry = this.entries.get(key);
+        if (!entry) return false;
+        this.entries.delete(key);
+        this.totalBytes -= entry.bytes;
+        return true;
+    }
+
+    clear(): void {
+        this.entries.clear();
+        this.totalBytes = 0;
+    }
+
+    get size(): number {
+        return this.entries.size;
+    }
+
+    /**
+     * Bytes currently held
+     */
+    get bytes(): number {
+        return this.totalBytes;
+    }
+}
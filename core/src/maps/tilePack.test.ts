@@ -0,0 +1,106 @@
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { TilePack } from './tilePack';
+
+describe('TilePack', () => {
+  let dir: string;
+  let packPath: string;
+
+  beforeEach(() => {
+    dir = fs.mkdtempSync(path.join(os.tmpdir(), 'tsyne-pack-'));
+    packPath = path.join(dir, 'osm.tiles');
+  });
+
+  afterEach(() => {
+    fs.rmSync(dir, { recursive: true, force: true });
+  });
+
+  function text(buffer: ArrayBuffer | null): string | null {
+    return buffer ? Buffer.from(buffer).toString() : null;
+  }
+
+  it('stores tiles in one pack file plus an index', () => {
+    const pack = new TilePack(packPath);
+    pack.put({ z: 1, x: 0, y: 1 }, Buffer.from('tile-a'));
+    pack.put({ z: 2, x: 3, y: 1 }, Buffer.from('tile-bb'));
+
+    expect(text(pack.get({ z: 1, x: 0, y: 1 }))).toBe('tile-a');
+    expect(text(pack.get({ z: 2, x: 3, y: 1 }))).toBe('tile-bb');
+    expect(pack.get({ z: 2, x: 0, y: 0 })).toBeNull();
+    expect(fs.readdirSync(dir).sort()).toEqual(['osm.tiles', 'osm.tiles.idx']);
+    expect(fs.statSync(packPath).size).toBe(13);
+    pack.close();
+  });
+
+  it('reloads the index after reopening', () => {
+    const pack = new TilePack(packPath);
+    pack.put({ z: 5, x: 17, y: 9 }, Buffer.from('old'));
+    pack.put({ z: 5, x: 17, y: 9 }, Buffer.from('new'));
+    pack.put({ z: 5, x: 18, y: 9 }, Buffer.from('gone'));
+    pack.delete({ z: 5, x: 18, y: 9 });
+    pack.close();
+
+    const reopened = new TilePack(packPath, { compactRatio: 1 });
+    expect(reopened.size).toBe(1);
+    expect(text(reopened.get({ z: 5, x: 17, y: 9 }))).toBe('new');
+    expect(reopened.has({ z: 5, x: 18, y: 9 })).toBe(false);
+    expect(reopened.getStats().deadBytes).toBe(7);
+    reopened.close();
+  });
+
+  it('ignores index records past the end of a truncated pack', () => {
+    const pack = new TilePack(packPath);
+    pack.put({ z: 0, x: 0, y: 0 }, Buffer.from('world'));
+    pack.put({ z: 1, x: 1, y: 1 }, Buffer.from('cut short'));
+    pack.close();
+    fs.truncateSync(packPath, 7);
+
+    const reopened = new TilePack(packPath);
+    expect(text(reopened.get({ z: 0, x: 0, y: 0 }))).toBe('world');
+    expect(reopened.get({ z: 1, x: 1, y: 1 })).toBeNull();
+    reopened.close();
+  });
+
+  it('treats expired tiles as missing and compacts them away', () => {
+    const pack = new TilePack(packPath, { maxAge: 1000 });
+    pack.put({ z: 3, x: 1, y: 2 }, Buffer.from('stale'), Date.now() - 5000);
+    pack.put({ z: 3, x: 2, y: 2 }, Buffer.from('fresh'));
+
+    expect(pack.get({ z: 3, x: 1, y: 2 })).toBeNull();
+    pack.compact();
+    expect(pack.getStats()).toEqual({ tiles: 1, bytes: 5, deadBytes: 0 });
+    expect(text(pack.get({ z: 3, x: 2, y: 2 }))).toBe('fresh');
+
+    pack.put({ z: 3, x: 3, y: 2 }, Buffer.from('after'));
+    pack.close();
+    const reopened = new TilePack(packPath);
+    expect(text(reopened.get({ z: 3, x: 3, y: 2 }))).toBe('after');
+    reopened.close();
+  });
+
+  it('compacts on open once most of the pack is dead', () => {
+    const pack = new TilePack(packPath);
+    for (let i = 0; i < 4; i++) {
+      pack.put({ z: 4, x: 0, y: 0 }, Buffer.from(`version-${i}`));
+    }
+    pack.close();
+
+    const reopened = new TilePack(packPath);
+    expect(reopened.getStats()).toEqual({ tiles: 1, bytes: 9, deadBytes: 0 });
+    expect(text(reopened.get({ z: 4, x: 0, y: 0 }))).toBe('version-3');
+    reopened.close();
+  });
+
+  it('imports a z/x/y.png directory tree', () => {
+    const legacy = path.join(dir, 'legacy');
+    fs.mkdirSync(path.join(legacy, '2', '1'), { recursive: true });
+    fs.writeFileSync(path.join(legacy, '2', '1', '3.png'), 'png-bytes');
+    fs.writeFileSync(path.join(legacy, '2', '1', 'notes.txt'), 'ignored');
+
+    const pack = new TilePack(packPath);
+    expect(pack.importDirectory(legacy)).toBe(1);
+    expect(text(pack.get({ z: 2, x: 1, y: 3 }))).toBe('png-bytes');
+    pack.close();
+  });
+});
@@ -0,0 +1,290 @@
+/**
+ * Tile Pack
+ *
+ * Single-file disk store for encoded map tiles (in the spirit of MBTiles,
+ * without the SQLite dependency). Tile bytes are appended to one pack file
+ * and an append-only index file records where each tile lives:
+ *
+ *   <name>      concatenated tile bytes
+ *   <name>.idx  32-byte records: z, x, y, length (uint32), offset, time (float64)
+ *
+ * The index is read in one go when the pack is first used, so lookups never
+ * stat or open per-tile files and 100k tiles cost two inodes. The latest
+ * record for a tile wins; a zero-length record deletes it. Records pointing
+ * past the end of the pack (a write cut short) are ignored. Space left
+ * behind by replaced, deleted or expired tiles is reclaimed by compact().
+ */
+
+import * as fs from 'fs';
+import * as path from 'path';
+import { TileCoord } from './tiles';
+
+const INDEX_RECORD_SIZE = 32;
+
+interface PackEntry {
+    z: number;
+    x: number;
+    y: number;
+    offset: number;
+    length: number;
+    time: number;
+}
+
+function encodeIndexRecord(entry: PackEntry): Buffer {
+    const record = Buffer.alloc(INDEX_RECORD_SIZE);
+    record.writeUInt32LE(entry.z, 0);
+    record.writeUInt32LE(entry.x, 4);
+    record.writeUInt32LE(entry.y, 8);
+    record.writeUInt32LE(entry.length, 12);
+    record.writeDoubleLE(entry.offset, 16);
+    record.writeDoubleLE(entry.time, 24);
+    return record;
+}
+
+export interface TilePackOptions {
+    /** Tiles older than this (ms) read as missing and are dropped on compact. Default: never */
+    maxAge?: number;
+    /** Compact on open when dead bytes exceed this fraction of the pack (default 0.5) */
+    compactRatio?: number;
+}
+
+export class TilePack {
+    readonly packPath: string;
+    readonly indexPath: string;
+    private maxAge: number;
+    private compactRatio: number;
+    private entries: Map<string, PackEntry> = new Map();
+    private packFd: number | null = null;
+    private indexFd: number | null = null;
+    private packSize = 0;
+    private deadBytes = 0;
+
+    constructor(packPath: string, options?: TilePackOptions) {
+        this.packPath = packPath;
+        this.indexPath = packPath + '.idx';
+        this.maxAge = options?.maxAge ?? Infinity;
+        this.compactRatio = options?.compactRatio ?? 0.5;
+    }
+
+    /**
+     * Whether the pack exists on disk
+     */
+    exists(): boolean {
+        return this.packFd !== null || fs.existsSync(this.packPath);
+    }
+
+    /**
+     * Open the files and load the index (done on first use)
+     */
+    open(): void {
+        if (this.packFd !== null) return;
+
+        fs.mkdirSync(path.dirname(this.packPath), { recursive: true });
+        this.packFd = fs.openSync(this.packPath, 'a+');
+        this.indexFd = fs.openSync(this.indexPath, 'a+');
+        this.packSize = fs.fstatSync(this.packFd).size;
+        this.loadIndex();
+
+        if (this.deadBytes > 0 && this.deadBytes >= this.packSize * this.compactRatio) {
+            this.compact();
+        }
+    }
+
+    close(): void {
+        if (this.packFd !== null) fs.closeSync(this.packFd);
+        if (this.indexFd !== null) fs.closeSync(this.indexFd);
+        this.packFd = null;
+        this.indexFd = null;
+        this.entries.clear();
+        this.packSize = 0;
+        this.deadBytes = 0;
+    }
+
+    private key(coord: TileCoord): string {
+        return `${coord.z}/${coord.x}/${coord.y}`;
+    }
+
+    private loadIndex(): void {
+        this.entries.clear();
+        this.deadBytes = 0;
+        const index = fs.readFileSync(this.indexPath);
+        const count = Math.floor(index.length / INDEX_RECORD_SIZE);
+
+        for (let i = 0; i < count; i++) {
+            const at = i * INDEX_RECORD_SIZE;
+            const entry: PackEntry = {
+                z: index.readUInt32LE(at),
+                x: index.readUInt32LE(at + 4),
+                y: index.readUInt32LE(at + 8),
+                length: index.readUInt32LE(at + 12),
+                offset: index.readDoubleLE(at + 16),
+                time: index.readDoubleLE(at + 24)
+            };
+            if (entry.offset + entry.length > this.packSize) continue;
+
+            const k = this.key(entry);
+            const previous = this.entries.get(k);
+            if (previous) this.deadBytes += previous.length;
+            if (entry.length === 0) {
+                this.entries.delete(k);
+            } else {
+                this.entries.set(k, entry);
+            }
+        }
+    }
+
+    private appendIndex(entry: PackEntry): void {
+        fs.writeSync(this.indexFd!, encodeIndexRecord(entry));
+    }
+
+    private isExpired(entry: PackEntry): boolean {
+        return Date.now() - entry.time > this.maxAge;
+    }
+
+    /**
+     * Read a tile's bytes, or null if absent or expired
+     */
+    get(coord: TileCoord): ArrayBuffer | null {
+        this.open();
+        const entry = this.entries.get(this.key(coord));
+        if (!entry || this.isExpired(entry)) return null;
+
+        const buffer = new Uint8Array(entry.length);
+        const read = fs.readSync(this.packFd!, buffer, 0, entry.length, entry.offset);
+        if (read !== entry.length) return null;
+        return buffer.buffer;
+    }
+
+    has(coord: TileCoord): boolean {
+        this.open();
+        const entry = this.entries.get(this.key(coord));
+        return entry !== undefined && !this.isExpired(entry);
+    }
+
+    /**
+     * Store a tile's bytes, replacing any previous version
+     */
+    put(coord: TileCoord, data: ArrayBuffer | Uint8Array, time: number = Date.now()): void {
+        this.open();
+        const bytes = data instanceof Uint8Array ? data : new Uint8Array(data);
+        if (bytes.length === 0) return;
+
+        // Tile bytes first: an index record never points at unwritten data
+        fs.writeSync(this.packFd!, bytes);
+        const entry: PackEntry = {
+            z: coord.z, x: coord.x, y: coord.y,
+            offset: this.packSize,
+            length: bytes.length,
+            time
+        };
+        this.packSize += bytes.length;
+        this.appendIndex(entry);
+
+        const k = this.key(coord);
+        const previous = this.entries.get(k);
+        if (previous) this.deadBytes += previous.length;
+        this.entries.set(k, entry);
+    }
+
+    delete(coord: TileCoord): void {
+        this.open();
+        const k = this.key(coord);
+        const previous = this.entries.get(k);
+        if (!previous) return;
+
+        this.appendIndex({ z: coord.z, x: coord.x, y: coord.y, offset: 0, length: 0, time: Date.now() });
+        this.deadBytes += previous.length;
+        this.entries.delete(k);
+    }
+
+    /**
+     * Number of tiles in the index (including expired ones not yet compacted)
+     */
+    get size(): number {
+        this.open();
+        return this.entries.size;
+    }
+
+    /**
+     * Pack file size in bytes and how much of it is no longer referenced
+     */
+    getStats(): { tiles: number; bytes: number; deadBytes: number } {
+        this.open();
+        return { tiles: this.entries.size, bytes: this.packSize, deadBytes: this.deadBytes };
+    }
+
+    /**
+     * Rewrite the pack with only live, unexpired tiles
+     */
+    compact(): void {
+        this.open();
+        const packTmp = this.packPath + '.tmp';
+        const indexTmp = this.indexPath + '.tmp';
+        const packOut = fs.openSync(packTmp, 'w');
+        const indexOut = fs.openSync(indexTmp, 'w');
+        const live: Map<string, PackEntry> = new Map();
+        let offset = 0;
+
+        try {
+            for (const [k, entry] of this.entries) {
+                if (this.isExpired(entry)) continue;
+                const bytes = Buffer.allocUnsafe(entry.length);
+                if (fs.readSync(this.packFd!, bytes, 0, entry.length, entry.offset) !== entry.length) continue;
+
+                fs.writeSync(packOut, bytes);
+                const moved = { ...entry, offset };
+                fs.writeSync(indexOut, encodeIndexRecord(moved));
+                live.set(k, moved);
+                offset += entry.length;
+            }
+        } finally {
+            fs.closeSync(packOut);
+            fs.closeSync(indexOut);
+        }
+
+        fs.closeSync(this.packFd!);
+        fs.closeSync(this.indexFd!);
+        fs.renameSync(packTmp, this.packPath);
+        fs.renameSync(indexTmp, this.indexPath);
+        this.packFd = fs.openSync(this.packPath, 'a+');
+        this.indexFd = fs.openSync(this.indexPath, 'a+');
+        this.entries = live;
+        this.packSize = offset;
+        this.deadBytes = 0;
+    }
+
+    /**
+     * Import a z/x/y.png directory tree (the old one-file-per-tile cache),
+     * keeping each file's mtime as the tile's time. Returns the tile count.
+     */
+    importDirectory(dir: string): number {
+        let imported = 0;
+        const numericDirs = (parent: string) => {
+            try {
+                return fs.readdirSync(parent).filter(name => /^\d+$/.test(name));
+            } catch {
+                return [];
+            }
+        };
+
+        for (const z of numericDirs(dir)) {
+            for (const x of numericDirs(path.join(dir, z))) {
+                const xDir = path.join(dir, z, x);
+                for (const file of fs.readdirSync(xDir)) {
+                    const match = /^(\d+)\.png$/.exec(file);
+                    if (!match) continue;
+                    const filePath = path.join(xDir, file);
+                    try {
+                        const stat = fs.statSync(filePath);
+                        this.put({ z: Number(z), x: Number(x), y: Number(match[1]) },
+                            fs.readFileSync(filePath), stat.mtimeMs);
+                        imported++;
+                    } catch {
+                        // Unreadable file - skip it
+                    }
+                }
+            }
+        }
+        return imported;
+    }
+}
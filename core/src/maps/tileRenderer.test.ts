@@ -1,8 +1,13 @@
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
 import {
   getTilesForViewport,
   getTilePosition,
   MapViewport,
-  TileMapRenderer
+  TileMapRenderer,
+  TileCompositor,
+  CompositorTile
 } from './tileRenderer';
 import { TILE_SOURCES } from './tiles';
 
@@ -252,12 +257,76 @@ describe('TileMapRenderer', () => {
     expect(renderer).toBeDefined();
   });
 
+  it('creates renderer with memory budgets', () => {
+    const renderer = new TileMapRenderer(TILE_SOURCES.osmRaster(), {
+      memoryBudget: 8 * 1024 * 1024,
+      encodedMemoryBudget: 1024 * 1024
+    });
+
+    expect(renderer.getCacheStats()).toEqual({
+      decoded: { tiles: 0, bytes: 0 },
+      encoded: { tiles: 0, bytes: 0 },
+      disk: null
+    });
+  });
+
   it('clearCache does not throw', () => {
     const source = TILE_SOURCES.osmRaster();
     const renderer = new TileMapRenderer(source);
 
     expect(() => renderer.clearCache()).not.toThrow();
   });
+
+  describe('renderNative', () => {
+    let cacheDir: string;
+
+    beforeEach(() => {
+      cacheDir = fs.mkdtempSync(path.join(os.tmpdir(), 'tsyne-tiles-'));
+    });
+
+    afterEach(() => {
+      fs.rmSync(cacheDir, { recursive: true, force: true });
+    });
+
+    function fakeCompositor(missing: string[]) {
+      const uploads: CompositorTile[][] = [];
+      const compositor: TileCompositor = {
+        setViewport: jest.fn(async () => missing),
+        putTiles: jest.fn(async (tiles: CompositorTile[]) => {
+          uploads.push(tiles);
+          return [];
+        }),
+      };
+      return { compositor, uploads };
+    }
+
+    it('uploads only the tiles the compositor reports missing, undecoded', async () => {
+      // One-file-per-tile cache from earlier versions, imported into the pack
+      const tileDir = path.join(cacheDir, 'osm', '3', '4');
+      fs.mkdirSync(tileDir, { recursive: true });
+      fs.writeFileSync(path.join(tileDir, '2.png'), Buffer.from('not really a png'));
+      const renderer = new TileMapRenderer(TILE_SOURCES.osmRaster(), { fsCachePath: cacheDir });
+
+      const { compositor, uploads } = fakeCompositor(['3/4/2']);
+      const viewport: MapViewport = { center: { lng: 10, lat: 20 }, zoom: 3, width: 300, height: 200 };
+      await renderer.renderNative(compositor, viewport);
+
+      expect(compositor.setViewport).toHaveBeenCalledWith({ lng: 10, lat: 20 }, 3, { width: 300, height: 200 });
+      expect(uploads).toHaveLength(1);
+      expect(uploads[0].map(t => [t.z, t.x, t.y])).toEqual([[3, 4, 2]]);
+      expect(Buffer.from(uploads[0][0].data).toString()).toBe('not really a png');
+      expect(renderer.getCacheStats().disk?.tiles).toBe(1);
+      renderer.close();
+    });
+
+    it('sends nothing when the compositor has every tile', async () => {
+      const renderer = new TileMapRenderer(TILE_SOURCES.osmRaster());
+      const { compositor } = fakeCompositor([]);
+      await renderer.renderNative(compositor, { center: { lng: 0, lat: 0 }, zoom: 2, width: 256, height: 256 });
+
+      expect(compositor.putTiles).not.toHaveBeenCalled();
+    });
+  });
 });
 
 describe('Viewport and tile consistency', () => {
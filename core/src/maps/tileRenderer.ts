@@ -3,7 +3,7 @@
  *
  * Utilities for fetching, decoding, and rendering map tiles.
  * Uses pngjs for PNG decoding in Node.js environment.
- * Supports filesystem caching for offline use (OSM requires 7-day min TTL).
+ * Supports disk caching for offline use (OSM requires 7-day min TTL).
  */
 
 import { PNG } from 'pngjs';
@@ -11,6 +11,10 @@ import * as fs from 'fs';
 import * as path from 'path';
 import { RenderTarget, fetchResource, drawImage } from '../graphics';
 import { TileSource, TileCoord, buildTileUrl } from './tiles';
+import { ByteBudgetCache } from './tileCache';
+import { TilePack } from './tilePack';
+import { TileDecodePool, DecodePriority } from './decodePool';
+import { TileDecodeError } from './imageDecode';
 
 // ============================================================================
 // PNG Decoding
@@ -23,7 +27,8 @@ export interface ImageData {
 }
 
 /**
- * Decode a PNG from ArrayBuffer to RGBA pixels
+ * Decode a PNG from ArrayBuffer to RGBA pixels. Rejects with a
+ * TileDecodeError when the bytes are not a valid PNG.
  */
 export async function decodePNG(buffer: ArrayBuffer): Promise<ImageData> {
     return new Promise((resolve, reject) => {
@@ -37,7 +42,7 @@ export async function decodePNG(buffer: ArrayBuffer): Promise<ImageData> {
             });
         });
 
-        png.on('error', reject);
+        png.on('error', (err: Error) => reject(new TileDecodeError(err.message)));
 
         png.parse(Buffer.from(buffer));
     });
@@ -162,48 +167,102 @@ export function getTilePosition(
 // Tile Map Renderer
 // ============================================================================
 
-interface CachedTile {
-    coord: TileCoord;
-    image: ImageData;
-    timestamp: number;
-}
-
 export interface TileMapRendererOptions {
+    /** Decoded (RGBA) tiles kept in memory, in bytes. Default 64 MB (~256 tiles) */
+    memoryBudget?: number;
+    /** Encoded (PNG) tiles kept in memory, in bytes. Default 16 MB */
+    encodedMemoryBudget?: number;
+    /** Optional cap on decoded tiles by count, on top of memoryBudget */
     maxCacheSize?: number;
     cacheMaxAge?: number;
     /** Filesystem cache directory. If provided, tiles are cached to disk with 7-day TTL (per OSM policy) */
     fsCachePath?: string;
     /** Filesystem cache TTL in ms. Defaults to 7 days (OSM requirement) */
     fsCacheMaxAge?: number;
+    /** Decode tiles on this many worker threads instead of the main thread */
+    decodeThreads?: number;
+    /** Decode tiles on a shared pool (takes precedence over decodeThreads) */
+    decodePool?: TileDecodePool;
+}
+
+/**
+ * A getTile() decode in flight: its current priority, and the pool's
+ * promise once decoding has started
+ */
+interface PendingDecode {
+    priority: DecodePriority;
+    decoding?: Promise<ImageData>;
+}
+
+/**
+ * An encoded tile as uploaded to a TileCompositor
+ */
+export interface CompositorTile {
+    z: number;
+    x: number;
+    y: number;
+    data: ArrayBuffer;
+}
+
+/**
+ * A bridge-side tile cache and compositor (implemented by CanvasTileMap).
+ * Both calls resolve to the visible tiles ("z/x/y") it still lacks.
+ */
+export interface TileCompositor {
+    setViewport(
+        center: { lng: number; lat: number },
+        zoom: number,
+        size?: { width: number; height: number }
+    ): Promise<string[]>;
+    putTiles(tiles: CompositorTile[]): Promise<string[]>;
 }
 
 /**
- * Manages tile loading and rendering for a map viewport
+ * Manages tile loading and rendering for a map viewport.
+ *
+ * Tiles are looked up in three tiers: decoded tiles (byte-budgeted LRU),
+ * encoded tiles (a second, cheaper LRU that skips the disk read but not the
+ * decode), then a single-file TilePack on disk, before the network.
  */
 export class TileMapRenderer {
     private source: TileSource;
-    private cache: Map<string, CachedTile> = new Map();
+    private decoded: ByteBudgetCache<ImageData>;
+    private encoded: ByteBudgetCache<ArrayBuffer>;
     private pending: Map<string, Promise<TileImage | null>> = new Map();
-    private maxCacheSize: number;
-    private cacheMaxAge: number;
-    private fsCachePath?: string;
-    private fsCacheMaxAge: number;
+    private pendingDecodes: Map<string, PendingDecode> = new Map();
+    private pendingBytes: Map<string, Promise<ArrayBuffer | null>> = new Map();
+    private prefetchControllers: Map<string, AbortController> = new Map();
+    private pack: TilePack | null = null;
+    private decodePool: TileDecodePool | null = null;
+    private ownsDecodePool = false;
 
     constructor(source: TileSource, options?: TileMapRendererOptions) {
         this.source = source;
-        this.maxCacheSize = options?.maxCacheSize ?? 50;
-        this.cacheMaxAge = options?.cacheMaxAge ?? 5 * 60 * 1000; // 5 minutes in-memory
-        this.fsCachePath = options?.fsCachePath;
-        this.fsCacheMaxAge = options?.fsCacheMaxAge ?? 7 * 24 * 60 * 60 * 1000; // 7 days (OSM policy)
+        const cacheMaxAge = options?.cacheMaxAge ?? 5 * 60 * 1000; // 5 minutes in-memory
+        this.decoded = new ByteBudgetCache<ImageData>({
+            maxBytes: options?.memoryBudget ?? 64 * 1024 * 1024,
+            maxEntries: options?.maxCacheSize,
+            maxAge: cacheMaxAge,
+            sizeOf: image => image.data.byteLength
+        });
+        this.encoded = new ByteBudgetCache<ArrayBuffer>({
+            maxBytes: options?.encodedMemoryBudget ?? 16 * 1024 * 1024,
+            maxAge: cacheMaxAge,
+            sizeOf: buffer => buffer.byteLength
+        });
 
-        // Ensure cache directory exists
-        if (this.fsCachePath) {
-            try {
-                fs.mkdirSync(this.fsCachePath, { recursive: true });
-            } catch (err) {
-                console.error('Failed to create tile cache directory:', err);
-                this.fsCachePath = undefined;
-            }
+        if (options?.decodePool) {
+            this.decodePool = options.decodePool;
+        } else if (options?.decodeThreads && options.decodeThreads > 0) {
+            this.decodePool = TileDecodePool.create({ threads: options.decodeThreads });
+            this.ownsDecodePool = this.decodePool !== null;
+        }
+
+        if (options?.fsCachePath) {
+            this.pack = this.openPack(
+                options.fsCachePath,
+                options.fsCacheMaxAge ?? 7 * 24 * 60 * 60 * 1000 // 7 days (OSM policy)
+            );
         }
     }
 
@@ -223,139 +282,231 @@ export class TileMapRenderer {
     }
 
     /**
-     * Get filesystem cache path for a tile
-     */
-    private getFsCachePath(coord: TileCoord): string | null {
-        if (!this.fsCachePath) return null;
-        const sourceDir = path.join(this.fsCachePath, this.getSourceId());
-        return path.join(sourceDir, `${coord.z}`, `${coord.x}`, `${coord.y}.png`);
-    }
-
-    /**
-     * Try to load tile from filesystem cache
+     * Open the source's tile pack (<fsCachePath>/<source>.tiles). A z/x/y.png
+     * directory left by earlier versions is imported the first time.
      */
-    private async loadFromFsCache(coord: TileCoord): Promise<ImageData | null> {
-        const cachePath = this.getFsCachePath(coord);
-        if (!cachePath) return null;
-
+    private openPack(fsCachePath: string, maxAge: number): TilePack | null {
         try {
-            const stat = fs.statSync(cachePath);
-            const age = Date.now() - stat.mtimeMs;
-
-            // Check if cache is still valid
-            if (age > this.fsCacheMaxAge) {
-                // Cache expired, delete it
-                fs.unlinkSync(cachePath);
-                return null;
+            const pack = new TilePack(path.join(fsCachePath, `${this.getSourceId()}.tiles`), { maxAge });
+            const legacyDir = path.join(fsCachePath, this.getSourceId());
+            const migrate = !pack.exists() && fs.existsSync(legacyDir);
+            pack.open();
+            if (migrate) {
+                pack.importDirectory(legacyDir);
             }
-
-            // Read and decode the cached PNG
-            const buffer = fs.readFileSync(cachePath);
-            return await decodePNG(buffer.buffer.slice(buffer.byteOffset, buffer.byteOffset + buffer.byteLength));
-        } catch {
-            // File doesn't exist or read error
+            return pack;
+        } catch (err) {
+            console.error('Failed to open tile cache:', err);
             return null;
         }
     }
 
     /**
-     * Save tile to filesystem cache
+     * Save tile to the disk cache
      */
-    private saveToFsCache(coord: TileCoord, pngBuffer: ArrayBuffer): void {
-        const cachePath = this.getFsCachePath(coord);
-        if (!cachePath) return;
+    private saveToPack(coord: TileCoord, buffer: ArrayBuffer): void {
+        if (!this.pack) return;
 
         try {
-            // Ensure directory exists
-            const dir = path.dirname(cachePath);
-            fs.mkdirSync(dir, { recursive: true });
-
-            // Write the PNG file
-            fs.writeFileSync(cachePath, Buffer.from(pngBuffer));
+            this.pack.put(coord, buffer);
         } catch (err) {
             // Silently fail - caching is best-effort
             console.error('Failed to cache tile:', err);
         }
     }
 
+    private loadFromPack(coord: TileCoord): ArrayBuffer | null {
+        if (!this.pack) return null;
+
+        try {
+            return this.pack.get(coord);
+        } catch {
+            return null;
+        }
+    }
+
     private key(coord: TileCoord): string {
         return `${coord.z}/${coord.x}/${coord.y}`;
     }
 
     /**
-     * Get a tile (from memory cache, filesystem cache, or network)
+     * Get a tile (from memory, disk cache, or network)
      */
-    async getTile(coord: TileCoord): Promise<TileImage | null> {
+    async getTile(coord: TileCoord, priority: DecodePriority = 'visible'): Promise<TileImage | null> {
         const k = this.key(coord);
 
-        // 1. Check in-memory cache (fastest)
-        const cached = this.cache.get(k);
-        if (cached && Date.now() - cached.timestamp < this.cacheMaxAge) {
-            return { coord: cached.coord, image: cached.image };
+        // 1. Decoded tiles (fastest)
+        const cached = this.decoded.get(k);
+        if (cached) {
+            return { coord, image: cached };
         }
 
         // Check pending
         const pending = this.pending.get(k);
         if (pending) {
+            if (priority === 'visible') {
+                this.promote(k);
+            }
             return pending;
         }
 
-        // 2. Check filesystem cache
+        // 2. Encoded bytes from memory, disk or network
+        const request: PendingDecode = { priority };
         const promise = (async (): Promise<TileImage | null> => {
-            // Try filesystem cache first
-            const fsImage = await this.loadFromFsCache(coord);
-            if (fsImage) {
-                // Add to in-memory cache
-                this.addToMemoryCache(k, coord, fsImage);
-                return { coord, image: fsImage };
-            }
+            const buffer = await this.getTileBytes(coord);
+            if (!buffer) return null;
 
-            // 3. Fetch from network
             try {
-                const url = buildTileUrl(this.source, coord);
-                const response = await fetchResource(url);
-                if (!response.ok) {
-                    throw new Error(`HTTP ${response.status}`);
+                let image: ImageData;
+                if (this.decodePool) {
+                    // Read the priority now: a visible request may have joined
+                    request.decoding = this.decodePool.decode(buffer, request.priority);
+                    image = await request.decoding;
+                } else {
+                    image = await decodePNG(buffer);
                 }
-
-                const buffer = await response.arrayBuffer();
-
-                // Save to filesystem cache (raw PNG bytes)
-                this.saveToFsCache(coord, buffer);
-
-                // Decode PNG
-                const image = await decodePNG(buffer);
-
-                // Add to in-memory cache
-                this.addToMemoryCache(k, coord, image);
-
+                this.decoded.set(k, image);
                 return { coord, image };
             } catch (err: any) {
-                console.error(`Failed to load tile ${k}:`, err.message);
+                if (err instanceof TileDecodeError) {
+                    // Corrupt bytes: forget them so the next request refetches
+                    console.error(`Failed to decode tile ${k}:`, err.message);
+                    this.encoded.delete(k);
+                    this.pack?.delete(coord);
+                }
+                // Otherwise the decode was dropped or interrupted and the
+                // bytes are fine: the next request decodes them again
                 return null;
             }
         })();
 
         this.pending.set(k, promise);
-        promise.finally(() => this.pending.delete(k));
+        this.pendingDecodes.set(k, request);
+        promise.finally(() => {
+            // clearCache() may have let a newer request take the key
+            if (this.pending.get(k) === promise) {
+                this.pending.delete(k);
+                this.pendingDecodes.delete(k);
+            }
+        });
         return promise;
     }
 
     /**
-     * Add a tile to the in-memory cache with LRU eviction
+     * A visible request joined a pending prefetch: decode it ahead of the
+     * other prefetches
      */
-    private addToMemoryCache(key: string, coord: TileCoord, image: ImageData): void {
-        // Evict old entries if at capacity
-        while (this.cache.size >= this.maxCacheSize) {
-            const oldestKey = this.cache.keys().next().value;
-            if (oldestKey) this.cache.delete(oldestKey);
+    private promote(k: string): void {
+        const request = this.pendingDecodes.get(k);
+        if (!request || request.priority === 'visible') return;
+        request.priority = 'visible';
+        if (request.decoding) {
+            this.decodePool?.promote(request.decoding);
         }
+    }
 
-        this.cache.set(key, {
-            coord,
-            image,
-            timestamp: Date.now()
+    /**
+     * Fetch a tile's encoded bytes from the network and save them to the
+     * disk cache
+     */
+    private async fetchTileBytes(coord: TileCoord, signal?: AbortSignal): Promise<ArrayBuffer> {
+        const url = buildTileUrl(this.source, coord);
+        const response = await fetchResource(url, { signal });
+        if (!response.ok) {
+            throw new Error(`HTTP ${response.status}`);
+        }
+
+        const buffer = await response.arrayBuffer();
+
+        // Save to disk cache (raw PNG bytes)
+        this.saveToPack(coord, buffer);
+        return buffer;
+    }
+
+    /**
+     * Get a tile's encoded bytes (from memory, disk cache or network) without
+     * decoding them
+     */
+    async getTileBytes(coord: TileCoord): Promise<ArrayBuffer | null> {
+        const k = this.key(coord);
+
+        const cached = this.encoded.get(k);
+        if (cached) {
+            return cached;
+        }
+
+        const pending = this.pendingBytes.get(k);
+        if (pending) {
+            // Needed now: a prefetch already loading it can no longer be cancelled
+            this.prefetchControllers.delete(k);
+            return pending;
+        }
+
+        return this.loadTileBytes(coord);
+    }
+
+    private loadTileBytes(coord: TileCoord, signal?: AbortSignal): Promise<ArrayBuffer | null> {
+        const k = this.key(coord);
+
+        const promise = (async (): Promise<ArrayBuffer | null> => {
+            let buffer = this.loadFromPack(coord);
+            if (!buffer) {
+                try {
+                    buffer = await this.fetchTileBytes(coord, signal);
+                } catch (err: any) {
+                    if (!signal?.aborted) {
+                        console.error(`Failed to load tile ${k}:`, err.message);
+                    }
+                    return null;
+                }
+            }
+            this.encoded.set(k, buffer);
+            return buffer;
+        })();
+
+        this.pendingBytes.set(k, promise);
+        promise.finally(() => {
+            this.pendingBytes.delete(k);
+            this.prefetchControllers.delete(k);
         });
+        return promise;
+    }
+
+    /**
+     * Whether a tile can be drawn without waiting for disk or network
+     */
+    hasTile(coord: TileCoord): boolean {
+        const k = this.key(coord);
+        return this.decoded.has(k) || this.encoded.has(k);
+    }
+
+    /**
+     * Load a tile ahead of need (see TilePrefetcher). Aborting the signal
+     * cancels the download, unless a regular request has asked for the same
+     * tile in the meantime. Resolves to whether the tile ended up cached.
+     */
+    async prefetchTile(coord: TileCoord, signal?: AbortSignal, decode: boolean = false): Promise<boolean> {
+        const k = this.key(coord);
+        if (this.decoded.has(k) || (!decode && this.encoded.has(k))) return true;
+        if (signal?.aborted) return false;
+
+        let pending = this.pendingBytes.get(k);
+        if (!pending) {
+            const controller = new AbortController();
+            this.prefetchControllers.set(k, controller);
+            signal?.addEventListener('abort', () => {
+                if (this.prefetchControllers.get(k) === controller) {
+                    controller.abort();
+                }
+            }, { once: true });
+            pending = this.loadTileBytes(coord, controller.signal);
+        }
+
+        if (!await pending) return false;
+        if (decode && !signal?.aborted) {
+            return (await this.getTile(coord, 'prefetch')) !== null;
+        }
+        return true;
     }
 
     /**
@@ -390,11 +541,68 @@ export class TileMapRenderer {
         }
     }
 
+    /**
+     * Show a viewport on a bridge-side compositor (see CanvasTileMap).
+     * Tiles are neither decoded nor composited here: the compositor reports
+     * which tiles it lacks and only those are uploaded, as encoded bytes.
+     */
+    async renderNative(compositor: TileCompositor, viewport: MapViewport): Promise<void> {
+        const missing = await compositor.setViewport(viewport.center, viewport.zoom, {
+            width: viewport.width,
+            height: viewport.height
+        });
+        if (missing.length === 0) return;
+
+        const tiles = await Promise.all(missing.map(async key => {
+            const [z, x, y] = key.split('/').map(Number);
+            const data = await this.getTileBytes({ z, x, y });
+            return data ? { z, x, y, data } : null;
+        }));
+
+        const loaded = tiles.filter((tile): tile is CompositorTile => tile !== null);
+        if (loaded.length > 0) {
+            await compositor.putTiles(loaded);
+        }
+    }
+
     /**
      * Clear the tile cache
      */
     clearCache(): void {
-        this.cache.clear();
+        this.decoded.clear();
+        this.encoded.clear();
         this.pending.clear();
+        this.pendingDecodes.clear();
+        this.pendingBytes.clear();
+        for (const controller of this.prefetchControllers.values()) {
+            controller.abort();
+        }
+        this.prefetchControllers.clear();
+    }
+
+    /**
+     * Memory and disk cache occupancy
+     */
+    getCacheStats(): {
+        decoded: { tiles: number; bytes: number };
+        encoded: { tiles: number; bytes: number };
+        disk: { tiles: number; bytes: number; deadBytes: number } | null;
+    } {
+        return {
+            decoded: { tiles: this.decoded.size, bytes: this.decoded.bytes },
+            encoded: { tiles: this.encoded.size, bytes: this.encoded.bytes },
+            disk: this.pack ? this.pack.getStats() : null
+        };
+    }
+
+    /**
+     * Close the disk cache files and stop the decode workers this renderer started
+     */
+    close(): void {
+        this.pack?.close();
+        if (this.ownsDecodePool) {
+            this.decodePool?.destroy();
+            this.decodePool = null;
+        }
     }
 }
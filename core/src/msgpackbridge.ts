@@ -4,6 +4,7 @@ import * as net from 'net';
 import { encode, decode } from '@msgpack/msgpack';
 import { BridgeInterface } from './fynebridge';
 import { PROTOCOL_VERSION, TSYNE_VERSION, isCompatibleHandshake } from './version';
+import { getTracer, TRACE_LANE_CALLS, TRACE_LANE_TRANSPORT, TRACE_LANE_RESPONSES } from './tracing';
 
 export interface MsgpackConnectionInfo {
   socketPath: string;
@@ -90,6 +91,8 @@ export class MsgpackBridgeConnection implements BridgeInterface {
   private pendingRequests = new Map<string, {
     resolve: (result: unknown) => void;
     reject: (error: Error) => void;
+    type: string;
+    traceStart: number; // Microseconds when send() was called, 0 when not tracing
   }>();
   private receiveBuffer = Buffer.allocUnsafe(65536); // Pre-allocated 64KB buffer
   private receiveLength = 0; // Track how much data is in the buffer
@@ -284,12 +287,18 @@ export class MsgpackBridgeConnection implements BridgeInterface {
           const response = data as MsgpackResponse;
           const pending = this.pendingRequests.get(response.id);
           if (pending) {
+            const tracer = getTracer();
+            const resolveStart = tracer ? tracer.now() : 0;
             this.pendingRequests.delete(response.id);
             if (response.success) {
               pending.resolve(response.result || {});
             } else {
               pending.reject(new Error(response.error || 'Unknown error'));
             }
+            if (tracer) {
+              tracer.span('resolve', 'ipc', response.id, TRACE_LANE_RESPONSES, resolveStart);
+              tracer.span(pending.type, 'bridge', response.id, TRACE_LANE_CALLS, pending.traceStart, true);
+            }
           }
         } else if ('type' in data) {
           // It's an event
@@ -358,7 +367,9 @@ export class MsgpackBridgeConnection implements BridgeInterface {
     }
 
     // Queue this message to ensure sequential processing
-    const messagePromise = this.messageQueue.then(() => this.sendMsgpackMessage(type, payload));
+    const tracer = getTracer();
+    const traceStart = tracer ? tracer.now() : 0;
+    const messagePromise = this.messageQueue.then(() => this.sendMsgpackMessage(type, payload, traceStart));
     // Update queue to wait for this message (but catch errors to prevent queue breakage)
     this.messageQueue = messagePromise.catch(() => {});
     return messagePromise;
@@ -376,6 +387,8 @@ export class MsgpackBridgeConnection implements BridgeInterface {
     }
 
     // Send directly without waiting for readyPromise (assume ready if socket exists)
+    const tracer = getTracer();
+    const writeStart = tracer ? tracer.now() : 0;
     const id = `ff_${this.messageId++}`;
     const message: MsgpackMessage = { id, type, payload };
 
@@ -395,6 +408,7 @@ export class MsgpackBridgeConnection implements BridgeInterface {
       // Return buffer to pool after write completes
       this.bufferPool.release(frame);
     });
+    tracer?.span('write', 'ipc', id, TRACE_LANE_TRANSPORT, writeStart);
 
     // Don't wait for response - just discard it when it arrives
   }
@@ -402,12 +416,14 @@ export class MsgpackBridgeConnection implements BridgeInterface {
   /**
    * Internal method to send the actual MessagePack message
    */
-  private sendMsgpackMessage(type: string, payload: Record<string, unknown>): Promise<unknown> {
+  private sendMsgpackMessage(type: string, payload: Record<string, unknown>, traceStart: number = 0): Promise<unknown> {
     const id = `msg_${this.messageId++}`;
     const message: MsgpackMessage = { id, type, payload };
+    const tracer = getTracer();
 
     return new Promise((resolve, reject) => {
-      this.pendingRequests.set(id, { resolve, reject });
+      this.pendingRequests.set(id, { resolve, reject, type, traceStart });
+      const writeStart = tracer ? tracer.now() : 0;
 
       // Encode to MessagePack
       const msgBuf = Buffer.from(encode(message));
@@ -425,6 +441,7 @@ export class MsgpackBridgeConnection implements BridgeInterface {
         // Return buffer to pool after write completes
         this.bufferPool.release(frame);
       });
+      tracer?.span('write', 'ipc', id, TRACE_LANE_TRANSPORT, writeStart);
     });
   }
 
@@ -440,6 +457,10 @@ export class MsgpackBridgeConnection implements BridgeInterface {
     this.eventHandlers.delete(eventType);
   }
 
+  getEventHandler(eventType: string): ((data: unknown) => void) | undefined {
+    return this.eventHandlers.get(eventType) as ((data: unknown) => void) | undefined;
+  }
+
   /**
    * Register a callback to be called when the bridge process exits
    */
@@ -0,0 +1,122 @@
+/**
+ * Tests for the bridge perf stats API
+ */
+
+import { getPerfStats, subscribePerfStats, captureProfile, BridgePerfStats } from './perf-stats';
+
+function mockBridge() {
+  const handlers = new Map<string, (data: unknown) => void>();
+  return {
+    handlers,
+    send: jest.fn(async (type: string) => (type === 'getPerfStats' ? { enabled: true } : {})),
+    on: jest.fn((type: string, handler: (data: unknown) => void) => handlers.set(type, handler)),
+    off: jest.fn((type: string) => handlers.delete(type)),
+    getEventHandler: (type: string) => handlers.get(type),
+  };
+}
+
+describe('getPerfStats', () => {
+  it('sends getPerfStats with the options', async () => {
+    const bridge = mockBridge();
+    const stats = await getPerfStats(bridge as any, { histograms: true });
+
+    expect(bridge.send).toHaveBeenCalledWith('getPerfStats', { histograms: true });
+    expect(stats.enabled).toBe(true);
+  });
+});
+
+describe('subscribePerfStats', () => {
+  it('delivers perfStats events until unsubscribed', async () => {
+    const bridge = mockBridge();
+    const received: BridgePerfStats[] = [];
+
+    const unsubscribe = await subscribePerfStats(bridge as any, (s) => received.push(s), { intervalMs: 500 });
+    expect(bridge.send).toHaveBeenCalledWith('subscribePerfStats', { intervalMs: 500 });
+
+    bridge.handlers.get('perfStats')!({ enabled: true, timestamp_ms: 1 });
+    expect(received.map((s) => s.timestamp_ms)).toEqual([1]);
+
+    await unsubscribe();
+    expect(bridge.handlers.has('perfStats')).toBe(false);
+    expect(bridge.send).toHaveBeenCalledWith('unsubscribePerfStats', {});
+  });
+
+  it('removes the handler when the bridge rejects the subscription', async () => {
+    const bridge = mockBridge();
+    bridge.send = jest.fn(async () => {
+      throw new Error('Unknown message type');
+    });
+
+    await expect(subscribePerfStats(bridge as any, () => {})).rejects.toThrow('Unknown message type');
+    expect(bridge.handlers.has('perfStats')).toBe(false);
+  });
+});
+
+describe('captureProfile', () => {
+  it('resolves when the profileWritten event arrives', async () => {
+    const bridge = mockBridge();
+    bridge.send = jest.fn(async () => ({ kind: 'cpu', path: '/tmp/cpu.pprof', seconds: 5 }));
+
+    const capture = captureProfile(bridge as any, { kind: 'cpu', seconds: 5 });
+    await new Promise((r) => setTimeout(r, 0));
+    expect(bridge.send).toHaveBeenCalledWith('captureProfile', { kind: 'cpu', seconds: 5 });
+
+    bridge.handlers.get('profileWritten')!({ kind: 'cpu', path: '/tmp/cpu.pprof', bytes: 1234 });
+    await expect(capture).resolves.toEqual({ kind: 'cpu', path: '/tmp/cpu.pprof', bytes: 1234 });
+    expect(bridge.handlers.has('profileWritten')).toBe(false);
+  });
+
+  it('handles an event that beats the response and rejects on profile errors', async () => {
+    const bridge = mockBridge();
+    bridge.send = jest.fn(async () => {
+      bridge.handlers.get('profileWritten')!({ kind: 'heap', path: '/tmp/heap.pprof', error: 'disk full' });
+      return { kind: 'heap', path: '/tmp/heap.pprof', seconds: 0 };
+    });
+
+    await expect(captureProfile(bridge as any, { kind: 'heap' })).rejects.toThrow('disk full');
+    expect(bridge.handlers.has('profileWritten')).toBe(false);
+  });
+
+  it('keeps each bridge separate and restores the app handler', async () => {
+    const first = mockBridge();
+    const second = mockBridge();
+    first.send = jest.fn(async () => ({ kind: 'cpu', path: '/tmp/a.pprof', seconds: 1 }));
+    second.send = jest.fn(async () => ({ kind: 'cpu', path: '/tmp/b.pprof', seconds: 1 }));
+    const appHandler = jest.fn();
+    second.handlers.set('profileWritten', appHandler);
+
+    const a = captureProfile(first as any, { seconds: 1 });
+    const b = captureProfile(second as any, { seconds: 1 });
+    await new Promise((r) => setTimeout(r, 0));
+
+    // An event the capture does not own still reaches the app
+    second.handlers.get('profileWritten')!({ kind: 'heap', path: '/tmp/app.pprof', bytes: 1 });
+    expect(appHandler).toHaveBeenCalledTimes(1);
+
+    second.handlers.get('profileWritten')!({ kind: 'cpu', path: '/tmp/b.pprof', bytes: 2 });
+    first.handlers.get('profileWritten')!({ kind: 'cpu', path: '/tmp/a.pprof', bytes: 1 });
+    await expect(a).resolves.toEqual({ kind: 'cpu', path: '/tmp/a.pprof', bytes: 1 });
+    await expect(b).resolves.toEqual({ kind: 'cpu', path: '/tmp/b.pprof', bytes: 2 });
+
+    expect(first.handlers.has('profileWritten')).toBe(false);
+    expect(second.handlers.get('profileWritten')).toBe(appHandler);
+  });
+
+  it('rejects when the profile is not written in time', async () => {
+    const bridge = mockBridge();
+    bridge.send = jest.fn(async () => ({ kind: 'cpu', path: '/tmp/lost.pprof', seconds: 0 }));
+    const realSetTimeout = global.setTimeout;
+    const delays: number[] = [];
+    (global as any).setTimeout = (fn: () => void, ms: number) => {
+      delays.push(ms);
+      return realSetTimeout(fn, 0);
+    };
+    try {
+      await expect(captureProfile(bridge as any, { kind: 'heap' })).rejects.toThrow('/tmp/lost.pprof was not written');
+    } finally {
+      global.setTimeout = realSetTimeout;
+    }
+    expect(delays).toEqual([30000]);
+    expect(bridge.handlers.has('profileWritten')).toBe(false);
+  });
+});
@@ -0,0 +1,246 @@
+/**
+ * Bridge performance stats at runtime
+ *
+ * getPerfStats() asks the Go bridge for a snapshot of its per-operation
+ * latency histograms, main-thread stalls, queue depths and Go runtime stats
+ * (goroutines, heap, GC pauses). subscribePerfStats() has the bridge push the
+ * same snapshot as a "perfStats" event every intervalMs. Both work on the
+ * stdio, msgpack-uds and FFI transports; the gRPC transport does not route
+ * them.
+ *
+ * Op latencies are only sampled when the bridge runs with TSYNE_PERF_SAMPLE,
+ * or after a request with `enable: true`; the runtime and queue sections are
+ * always filled in.
+ *
+ * captureProfile() has the bridge write a CPU, heap or mutex pprof profile of
+ * itself to a file.
+ */
+
+import type { BridgeInterface } from './fynebridge';
+
+/**
+ * Latency summary for one bridge operation (all times in milliseconds)
+ */
+export interface BridgeOpStats {
+  name: string;
+  count: number;
+  min_ms: number;
+  max_ms: number;
+  avg_ms: number;
+  median_ms: number;
+  p90_ms: number;
+  p99_ms: number;
+  p999_ms: number;
+  stddev_ms: number;
+  total_ms: number;
+  /** Average since the previous stderr report */
+  recent_dur_ms: number;
+  /** [bucket upper bound in microseconds, count] pairs, with `histograms: true` */
+  buckets_us?: Array<[number, number]>;
+}
+
+/**
+ * fyne.Do / fyne.DoAndWait timing for one call site
+ */
+export interface BridgeMainThreadStats {
+  site: string;
+  count: number;
+  stalls: number;
+  wait_p50_ms: number;
+  wait_p99_ms: number;
+  wait_max_ms: number;
+  run_p50_ms: number;
+  run_p99_ms: number;
+  run_max_ms: number;
+  run_total_ms: number;
+}
+
+/**
+ * A perf snapshot from getPerfStats or a perfStats event
+ */
+export interface BridgePerfStats {
+  enabled: boolean;
+  timestamp_ms: number;
+  uptime_sec?: number;
+  /** Busiest (by total time) first */
+  operations?: BridgeOpStats[];
+  main_thread?: BridgeMainThreadStats[] | null;
+  stalls_by_op?: Record<string, number> | null;
+  /** Items waiting in each bridge queue; only the active transport's appear */
+  queues: {
+    main_thread_pending?: number;
+    msgpack_batch?: number;
+    ffi_events?: number;
+  };
+  runtime: {
+    goroutines: number;
+    heap_alloc_bytes: number;
+    heap_sys_bytes: number;
+    heap_objects: number;
+    gc_count: number;
+    gc_pause_total_ms: number;
+    /** Newest first */
+    gc_recent_pauses_ms: number[];
+  };
+}
+
+export interface PerfStatsOptions {
+  /** Turn on op sampling if the bridge started without TSYNE_PERF_SAMPLE */
+  enable?: boolean;
+  /** Include the non-empty histogram buckets of each operation */
+  histograms?: boolean;
+}
+
+export interface PerfStatsSubscribeOptions extends PerfStatsOptions {
+  /** Push interval; the bridge clamps it to at least 100ms (default 1000) */
+  intervalMs?: number;
+}
+
+/**
+ * Fetch one perf snapshot from the bridge
+ */
+export async function getPerfStats(
+  bridge: BridgeInterface,
+  options: PerfStatsOptions = {}
+): Promise<BridgePerfStats> {
+  return await bridge.send('getPerfStats', { ...options }) as BridgePerfStats;
+}
+
+/**
+ * Receive a perf snapshot every intervalMs until the returned function is
+ * called. The bridge keeps one stream, so subscribing again replaces it.
+ */
+export async function subscribePerfStats(
+  bridge: BridgeInterface,
+  handler: (stats: BridgePerfStats) => void,
+  options: PerfStatsSubscribeOptions = {}
+): Promise<() => Promise<void>> {
+  const listener = (data: unknown) => handler(data as BridgePerfStats);
+  bridge.on('perfStats', listener);
+  try {
+    await bridge.send('subscribePerfStats', { ...options });
+  } catch (err) {
+    bridge.off('perfStats', listener);
+    throw err;
+  }
+
+  return async () => {
+    bridge.off('perfStats', listener);
+    await bridge.send('unsubscribePerfStats', {});
+  };
+}
+
+export interface CaptureProfileOptions {
+  /** cpu (default), heap or mutex */
+  kind?: 'cpu' | 'heap' | 'mutex';
+  /** Profile window; default 10 for cpu/mutex, heap defaults to a snapshot */
+  seconds?: number;
+  /**
+   * Output file name (no directories), written in the bridge's socket
+   * directory; defaults to tsyne-<pid>-<kind>-<time>.pprof
+   */
+  path?: string;
+}
+
+export interface CapturedProfile {
+  kind: string;
+  path: string;
+  bytes: number;
+}
+
+type ProfileWrittenEvent = { kind: string; path: string; bytes?: number; error?: string };
+
+// How long past the profile window to wait for its profileWritten event
+const PROFILE_WRITE_MARGIN_MS = 30000;
+
+/**
+ * captureProfile's profileWritten listener on one bridge, installed while
+ * captures are running. Events are matched by output path; one can arrive
+ * before the captureProfile response it belongs to.
+ */
+interface ProfileListener {
+  waiters: Map<string, (event: ProfileWrittenEvent) => void>;
+  unclaimed: Map<string, ProfileWrittenEvent>;
+  captures: number;
+  handler: (data: unknown) => void;
+  /** The app's own profileWritten handler, restored when the last capture ends */
+  previous?: (data: unknown) => void;
+}
+
+const profileListeners = new WeakMap<BridgeInterface, ProfileListener>();
+
+function listenForProfiles(bridge: BridgeInterface): ProfileListener {
+  let listener = profileListeners.get(bridge);
+  if (!listener) {
+    const created: ProfileListener = {
+      waiters: new Map(),
+      unclaimed: new Map(),
+      captures: 0,
+      previous: bridge.getEventHandler('profileWritten'),
+      handler: (data: unknown) => {
+        const event = data as ProfileWrittenEvent;
+        const waiter = created.waiters.get(event.path);
+        if (waiter) {
+          waiter(event);
+          return;
+        }
+        created.unclaimed.set(event.path, event);
+        created.previous?.(data);
+      },
+    };
+    bridge.on('profileWritten', created.handler);
+    profileListeners.set(bridge, created);
+    listener = created;
+  }
+  listener.captures++;
+  return listener;
+}
+
+function stopListeningForProfiles(bridge: BridgeInterface, listener: ProfileListener): void {
+  if (--listener.captures > 0) {
+    return;
+  }
+  profileListeners.delete(bridge);
+  bridge.off('profileWritten', listener.handler);
+  if (listener.previous) {
+    bridge.on('profileWritten', listener.previous);
+  }
+}
+
+/**
+ * Have the bridge record a Go pprof profile to a file, resolving once the
+ * file is written. Open it with `go tool pprof <path>`. Rejects if the file
+ * is not reported within the profile window plus 30 seconds.
+ */
+export async function captureProfile(
+  bridge: BridgeInterface,
+  options: CaptureProfileOptions = {}
+): Promise<CapturedProfile> {
+  const listener = listenForProfiles(bridge);
+  let path: string | undefined;
+  let timer: ReturnType<typeof setTimeout> | undefined;
+
+  try {
+    const started = await bridge.send('captureProfile', { ...options }) as { path: string; seconds?: number };
+    path = started.path;
+    const event = listener.unclaimed.get(started.path) ?? await new Promise<ProfileWrittenEvent>((resolve, reject) => {
+      listener.waiters.set(started.path, resolve);
+      const timeoutMs = (started.seconds ?? options.seconds ?? 0) * 1000 + PROFILE_WRITE_MARGIN_MS;
+      timer = setTimeout(() => {
+        reject(new Error(`Profile ${started.path} was not written within ${timeoutMs}ms`));
+      }, timeoutMs);
+    });
+
+    if (event.error) {
+      throw new Error(event.error);
+    }
+    return { kind: event.kind, path: event.path, bytes: event.bytes ?? 0 };
+  } finally {
+    clearTimeout(timer);
+    if (path !== undefined) {
+      listener.waiters.delete(path);
+      listener.unclaimed.delete(path);
+    }
+    stopListeningForProfiles(bridge, listener);
+  }
+}
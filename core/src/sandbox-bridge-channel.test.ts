@@ -0,0 +1,236 @@
+/**
+ * Tests for the batched sandbox -> bridge command channel
+ *
+ * The isolate side runs in a plain vm context with a fake isolated-vm:
+ * ExternalCopy hands the buffer over as-is and References call straight through.
+ */
+
+import * as vm from 'vm';
+import { SandboxBridgeChannel } from './sandbox-bridge-channel';
+
+function createFakeIvm() {
+  class ExternalCopy {
+    constructor(private value: ArrayBuffer) {}
+    copyInto() {
+      return this.value;
+    }
+  }
+  class Reference {
+    constructor(private fn: (...args: any[]) => any) {}
+    applyIgnored(_this: unknown, args: any[]) {
+      this.fn(...args);
+    }
+    apply(_this: unknown, args: any[]) {
+      return Promise.resolve(this.fn(...args));
+    }
+    release() {}
+  }
+  return { ExternalCopy, Reference };
+}
+
+function createFakeContext() {
+  const sandbox = vm.createContext({});
+  const context = {
+    global: {
+      set: async (name: string, value: any) => { sandbox[name] = value; },
+      get: async (name: string) => new (createFakeIvm().Reference)(sandbox[name]),
+    },
+    eval: async (code: string) => vm.runInContext(code, sandbox),
+  };
+  return { sandbox, context };
+}
+
+function createMockBridge() {
+  const handlers = new Map<string, (data: unknown) => void>();
+  return {
+    handlers,
+    sendFireAndForget: jest.fn(),
+    send: jest.fn(async (type: string, payload: any) => ({ echo: type, id: payload.widgetId })),
+    registerEventHandler: jest.fn((id: string, handler: (data: unknown) => void) => { handlers.set(id, handler); }),
+    getEventHandler: (id: string) => handlers.get(id),
+    off: jest.fn((id: string) => { handlers.delete(id); }),
+  };
+}
+
+async function settle() {
+  for (let i = 0; i < 5; i++) {
+    await new Promise((resolve) => setImmediate(resolve));
+  }
+}
+
+describe('SandboxBridgeChannel', () => {
+  it('flushes all commands from one turn as a single batch, in order', async () => {
+    const bridge = createMockBridge();
+    const channel = new SandboxBridgeChannel(bridge as any, 'app_');
+    const { context } = createFakeContext();
+    await channel.install(context, createFakeIvm());
+
+    await context.eval(`
+      for (var i = 0; i < 100; i++) {
+        __tsyneBridge.post('setText', { widgetId: 'app_label' + i, text: 'héllo ' + i });
+      }
+    `);
+    await settle();
+
+    expect(channel.getStats()).toMatchObject({ batches: 1, commands: 100, errors: 0 });
+    expect(bridge.sendFireAndForget).toHaveBeenCalledTimes(100);
+    expect(bridge.sendFireAndForget.mock.calls[0]).toEqual(['setText', { widgetId: 'app_label0', text: 'héllo 0' }]);
+    expect(bridge.sendFireAndForget.mock.calls[99][1].widgetId).toBe('app_label99');
+  });
+
+  it('resolves send() with the bridge result', async () => {
+    const bridge = createMockBridge();
+    const channel = new SandboxBridgeChannel(bridge as any, 'app_');
+    const { sandbox, context } = createFakeContext();
+    await channel.install(context, createFakeIvm());
+
+    await context.eval(`
+      globalThis.results = [];
+      __tsyneBridge.send('getText', { widgetId: 'app_a' }).then(function (r) { results.push(r); });
+      __tsyneBridge.send('getText', { widgetId: 'app_b' }).then(function (r) { results.push(r); });
+    `);
+    await settle();
+
+    expect(channel.getStats().batches).toBe(1);
+    expect(JSON.parse(JSON.stringify(sandbox.results))).toEqual([
+      { echo: 'getText', id: 'app_a' },
+      { echo: 'getText', id: 'app_b' },
+    ]);
+  });
+
+  it('rejects send() when the bridge call fails', async () => {
+    const bridge = createMockBridge();
+    (bridge as any).send = jest.fn(async () => { throw new Error('Widget not found: x'); });
+    const channel = new SandboxBridgeChannel(bridge as any, 'app_');
+    const { sandbox, context } = createFakeContext();
+    await channel.install(context, createFakeIvm());
+
+    await context.eval(`
+      __tsyneBridge.send('getText', { widgetId: 'app_x' }).catch(function (e) { globalThis.failure = e.message; });
+    `);
+    await settle();
+
+    expect(sandbox.failure).toBe('Widget not found: x');
+    expect(channel.getStats().errors).toBe(1);
+  });
+
+  it('delivers bridge events to on() handlers, subscribing once per callbackId', async () => {
+    const bridge = createMockBridge();
+    const handlers = bridge.handlers;
+    const channel = new SandboxBridgeChannel(bridge as any, 'app_');
+    const { sandbox, context } = createFakeContext();
+    await channel.install(context, createFakeIvm());
+
+    await context.eval(`
+      globalThis.seen = [];
+      __tsyneBridge.on('app_cb1', function () { seen.push('first'); });
+      __tsyneBridge.on('app_cb1', function (data) { seen.push(data.value); });
+    `);
+    await settle();
+    expect(bridge.registerEventHandler).toHaveBeenCalledTimes(1);
+
+    const handler = handlers.get('app_cb1')!;
+    handler({ value: 42 });
+    expect(JSON.parse(JSON.stringify(sandbox.seen))).toEqual([42]);
+
+    // dispose() unregisters the handler, and a stale one delivers nothing
+    channel.dispose();
+    expect(handlers.has('app_cb1')).toBe(false);
+    handler({ value: 43 });
+    expect(sandbox.seen.length).toBe(1);
+  });
+
+  it('refuses message types outside the allowlist', async () => {
+    const bridge = createMockBridge();
+    const channel = new SandboxBridgeChannel(bridge as any, 'app_');
+    const { sandbox, context } = createFakeContext();
+    await channel.install(context, createFakeIvm());
+
+    await context.eval(`
+      __tsyneBridge.post('quit', {});
+      __tsyneBridge.send('captureProfile', { path: '/home/user/.bashrc' })
+        .catch(function (e) { globalThis.failure = e.message; });
+      __tsyneBridge.post('setText', { widgetId: 'app_ok', text: 'fine' });
+    `);
+    await settle();
+
+    expect(bridge.send).not.toHaveBeenCalled();
+    expect(bridge.sendFireAndForget.mock.calls).toEqual([['setText', { widgetId: 'app_ok', text: 'fine' }]]);
+    expect(sandbox.failure).toMatch(/captureProfile is not available/);
+    expect(channel.getStats().rejected).toBe(2);
+  });
+
+  it("refuses IDs outside the app's prefix", async () => {
+    const bridge = createMockBridge();
+    const channel = new SandboxBridgeChannel(bridge as any, 'app_');
+    const { context } = createFakeContext();
+    await channel.install(context, createFakeIvm());
+
+    await context.eval(`
+      __tsyneBridge.post('setText', { widgetId: 'host_title', text: 'pwned' });
+      __tsyneBridge.post('createButton', { id: 'app_b', text: 'Go', callbackId: 'host_cb' });
+      __tsyneBridge.post('createVBox', { id: 'app_box', children: ['app_b', 'other_label'] });
+      __tsyneBridge.post('setText', { widgetId: 'app_', text: 'prefix alone' });
+      __tsyneBridge.post('createVBox', { id: 'app_box', children: ['app_b'] });
+    `);
+    await settle();
+
+    expect(bridge.sendFireAndForget.mock.calls).toEqual([['createVBox', { id: 'app_box', children: ['app_b'] }]]);
+    expect(channel.getStats().rejected).toBe(4);
+  });
+
+  it('never replaces a handler someone else registered', async () => {
+    const bridge = createMockBridge();
+    const hostHandler = jest.fn();
+    bridge.handlers.set('app_taken', hostHandler);
+    bridge.handlers.set('host_click', hostHandler);
+    const channel = new SandboxBridgeChannel(bridge as any, 'app_');
+    const { context } = createFakeContext();
+    await channel.install(context, createFakeIvm());
+
+    await context.eval(`
+      __tsyneBridge.on('host_click', function () {});
+      __tsyneBridge.on('app_taken', function () {});
+    `);
+    await settle();
+
+    expect(bridge.registerEventHandler).not.toHaveBeenCalled();
+    expect(bridge.handlers.get('app_taken')).toBe(hostHandler);
+    expect(channel.getStats().rejected).toBe(2);
+
+    // Nor does dispose() remove them
+    channel.dispose();
+    expect(bridge.off).not.toHaveBeenCalled();
+  });
+
+  it('flushes early when a batch reaches maxBatchChars', async () => {
+    const bridge = createMockBridge();
+    const channel = new SandboxBridgeChannel(bridge as any, 'app_', { maxBatchChars: 200 });
+    const { context } = createFakeContext();
+    await channel.install(context, createFakeIvm());
+
+    await context.eval(`
+      for (var i = 0; i < 20; i++) {
+        __tsyneBridge.post('setText', { widgetId: 'app_w' + i, text: 'xxxxxxxxxxxxxxxxxxxx' });
+      }
+    `);
+    await settle();
+
+    const stats = channel.getStats();
+    expect(stats.commands).toBe(20);
+    expect(stats.batches).toBeGreaterThan(1);
+    expect(bridge.sendFireAndForget.mock.calls.map((c: any[]) => c[1].widgetId))
+      .toEqual(Array.from({ length: 20 }, (_, i) => 'app_w' + i));
+  });
+
+  it('hides the host references from app code', async () => {
+    const channel = new SandboxBridgeChannel(createMockBridge() as any, 'app_');
+    const { sandbox, context } = createFakeContext();
+    await channel.install(context, createFakeIvm());
+
+    expect(sandbox.__tsyneFlush).toBeUndefined();
+    expect(sandbox._ivm).toBeUndefined();
+    expect(Object.isFrozen(sandbox.__tsyneBridge)).toBe(true);
+    expect(sandbox.__tsyneBridge.idPrefix).toBe('app_');
+  });
+});
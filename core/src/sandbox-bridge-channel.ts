@@ -0,0 +1,331 @@
+/**
+ * Sandbox Bridge Channel - Batched bridge calls out of an isolated-vm isolate
+ *
+ * Passing widget calls across the isolate boundary one at a time means a
+ * proxied call per command, each deep-copying its payload. The channel instead
+ * queues commands inside the isolate and flushes them once per microtask turn
+ * as a single ArrayBuffer, transferred (not copied) to the host through
+ * ExternalCopy. The host replays the batch on the bridge connection in order
+ * and answers every command that expects a result with one reply string.
+ * Bridge events the app subscribed to (button clicks, ...) go the other way,
+ * one host call per event.
+ *
+ * Inside the isolate the app talks to globalThis.__tsyneBridge:
+ *   post(type, payload)   fire-and-forget (setText, hideWidget, ...)
+ *   send(type, payload)   returns a promise for the bridge result
+ *   on(callbackId, fn)    calls fn(data) each time the bridge fires callbackId
+ *   flush()               push the queue now instead of at the end of the turn
+ *   idPrefix              prefix every widget and callback ID must start with
+ *
+ * The app shares the bridge with the host and other apps, so the host only
+ * replays widget-level message types (SANDBOX_CHANNEL_MESSAGE_TYPES) and only
+ * for IDs under the app's own prefix. Anything else is refused without
+ * reaching the bridge: no quit, no captureProfile, no touching other apps'
+ * widgets, and no taking over their event handlers.
+ */
+
+import type { BridgeInterface } from './fynebridge';
+
+/**
+ * Options for a SandboxBridgeChannel
+ */
+export interface SandboxBridgeChannelOptions {
+  /** Flush early once the queued batch reaches this many UTF-16 code units (default 64K) */
+  maxBatchChars?: number;
+}
+
+/**
+ * Channel counters, for checking how well commands batch
+ */
+export interface SandboxBridgeChannelStats {
+  /** Buffers received from the isolate */
+  batches: number;
+  /** Commands replayed on the bridge */
+  commands: number;
+  /** Bytes transferred into the host */
+  bytes: number;
+  /** Commands whose bridge call failed */
+  errors: number;
+  /** Commands refused by the message type allowlist or the ID checks */
+  rejected: number;
+}
+
+/**
+ * Message types a sandboxed app may send: creating its own widgets, reading
+ * and changing them, and binding their callbacks. Window, dialog, resource
+ * and bridge-level messages (quit, captureProfile, ...) stay with the host.
+ */
+export const SANDBOX_CHANNEL_MESSAGE_TYPES: ReadonlySet<string> = new Set([
+  'createButton', 'createLabel', 'createEntry', 'createMultiLineEntry', 'createPasswordEntry',
+  'createCheckbox', 'createSelect', 'createSlider', 'createProgressBar', 'createSeparator',
+  'createSpacer', 'createVBox', 'createHBox', 'createScroll', 'createCenter', 'createPadded',
+  'createMax',
+  'setText', 'getText', 'setValue', 'getValue', 'setChecked', 'getChecked',
+  'setProgress', 'getProgress', 'setSelected', 'getSelected', 'setSelectOptions',
+  'setWidgetCallback', 'enableWidget', 'disableWidget', 'showWidget', 'hideWidget',
+]);
+
+/**
+ * Isolate side of the channel. Expects the host to have set __tsyneFlush
+ * (a Reference to the host receiver) and _ivm (the isolated-vm module, for
+ * ExternalCopy). Commands are JSON-encoded into one string per batch and
+ * written as UTF-16 code units, since isolates have no TextEncoder.
+ */
+export const SANDBOX_CHANNEL_PRELUDE = `
+(function () {
+  var flushRef = globalThis.__tsyneFlush;
+  var ivm = globalThis._ivm;
+  delete globalThis.__tsyneFlush;
+  delete globalThis._ivm;
+
+  var queue = [];
+  var queuedChars = 0;
+  var scheduled = false;
+  var nextId = 1;
+  var pending = {};
+  var handlers = {};
+  var maxBatchChars = %MAX_BATCH_CHARS%;
+  var idPrefix = %ID_PREFIX%;
+
+  function flush() {
+    scheduled = false;
+    if (queue.length === 0) return;
+    var text = '[' + queue.join(',') + ']';
+    queue = [];
+    queuedChars = 0;
+
+    var buffer = new ArrayBuffer(text.length * 2);
+    var units = new Uint16Array(buffer);
+    for (var i = 0; i < text.length; i++) units[i] = text.charCodeAt(i);
+
+    var copy = new ivm.ExternalCopy(buffer, { transferOut: true });
+    flushRef.applyIgnored(undefined, [copy.copyInto({ release: true, transferIn: true })]);
+  }
+
+  function enqueue(id, type, payload) {
+    var entry = JSON.stringify([id, type, payload === undefined ? {} : payload]);
+    queue.push(entry);
+    queuedChars += entry.length + 1;
+    if (queuedChars >= maxBatchChars) {
+      flush();
+    } else if (!scheduled) {
+      scheduled = true;
+      Promise.resolve().then(flush);
+    }
+  }
+
+  globalThis.__tsyneBridge = Object.freeze({
+    post: function (type, payload) {
+      enqueue(0, type, payload);
+    },
+    send: function (type, payload) {
+      var id = nextId++;
+      return new Promise(function (resolve, reject) {
+        pending[id] = { resolve: resolve, reject: reject };
+        enqueue(id, type, payload);
+      });
+    },
+    on: function (callbackId, fn) {
+      var known = callbackId in handlers;
+      handlers[callbackId] = fn;
+      if (!known) enqueue(-1, 'on', { callbackId: callbackId });
+    },
+    flush: flush,
+    idPrefix: idPrefix,
+  });
+
+  // Host -> isolate: one JSON array of [id, ok, resultOrMessage] per batch
+  globalThis.__tsyneReplies = function (json) {
+    var replies = JSON.parse(json);
+    for (var i = 0; i < replies.length; i++) {
+      var reply = replies[i];
+      var waiter = pending[reply[0]];
+      if (!waiter) continue;
+      delete pending[reply[0]];
+      if (reply[1]) waiter.resolve(reply[2]);
+      else waiter.reject(new Error(reply[2]));
+    }
+  };
+
+  // Host -> isolate: one bridge event for a subscribed callbackId
+  globalThis.__tsyneEvent = function (callbackId, json) {
+    var handler = handlers[callbackId];
+    if (handler) handler(JSON.parse(json));
+  };
+})();
+`;
+
+type ChannelCommand = [number, string, Record<string, unknown>];
+type ChannelReply = [number, boolean, unknown];
+
+// Command id for an on() subscription; 0 is fire-and-forget, > 0 awaits a reply
+const SUBSCRIBE_ID = -1;
+
+/**
+ * Host side of the channel for one sandboxed app
+ */
+export class SandboxBridgeChannel {
+  private bridge: BridgeInterface;
+  private idPrefix: string;
+  private maxBatchChars: number;
+  private replyRef: any = null;
+  private eventRef: any = null;
+  // Bridge event handlers this channel registered, by callbackId
+  private subscribed = new Map<string, (data: unknown) => void>();
+  // Batches are replayed strictly one after another so commands keep app order
+  private tail: Promise<void> = Promise.resolve();
+  private stats: SandboxBridgeChannelStats = { batches: 0, commands: 0, bytes: 0, errors: 0, rejected: 0 };
+
+  /**
+   * @param idPrefix Prefix of every widget and callback ID the app may use,
+   *   unique to the app (executeInSandbox derives it from the app's token)
+   */
+  constructor(bridge: BridgeInterface, idPrefix: string, options: SandboxBridgeChannelOptions = {}) {
+    if (!idPrefix) {
+      throw new Error('SandboxBridgeChannel needs a non-empty idPrefix');
+    }
+    this.bridge = bridge;
+    this.idPrefix = idPrefix;
+    this.maxBatchChars = Math.max(1, options.maxBatchChars ?? 64 * 1024);
+  }
+
+  /**
+   * Install __tsyneBridge in an isolated-vm context. Must run before the app code.
+   */
+  async install(context: any, ivm: any): Promise<void> {
+    const jail = context.global;
+    await jail.set('__tsyneFlush', new ivm.Reference((buffer: ArrayBuffer) => this.receive(buffer)));
+    await jail.set('_ivm', ivm);
+    await context.eval(SANDBOX_CHANNEL_PRELUDE
+      .replace('%MAX_BATCH_CHARS%', String(this.maxBatchChars))
+      .replace('%ID_PREFIX%', () => JSON.stringify(this.idPrefix)));
+    this.replyRef = await jail.get('__tsyneReplies', { reference: true });
+    this.eventRef = await jail.get('__tsyneEvent', { reference: true });
+  }
+
+  /**
+   * Handle one transferred batch. Returns when its commands have been replayed
+   * and replies delivered.
+   */
+  receive(buffer: ArrayBuffer): Promise<void> {
+    const run = this.tail.then(() => this.replay(buffer));
+    this.tail = run.catch(() => undefined);
+    return run;
+  }
+
+  getStats(): SandboxBridgeChannelStats {
+    return { ...this.stats };
+  }
+
+  /**
+   * Unregister the app's bridge event handlers and drop the isolate
+   * references. Later batches are still replayed but get no replies.
+   */
+  dispose(): void {
+    for (const [callbackId, handler] of this.subscribed) {
+      // Leave it alone if something else has registered the ID since
+      if (this.bridge.getEventHandler(callbackId) === handler) {
+        this.bridge.off(callbackId, handler);
+      }
+    }
+    this.subscribed.clear();
+    if (this.replyRef) {
+      this.replyRef.release?.();
+      this.replyRef = null;
+    }
+    if (this.eventRef) {
+      this.eventRef.release?.();
+      this.eventRef = null;
+    }
+  }
+
+  private async replay(buffer: ArrayBuffer): Promise<void> {
+    this.stats.batches++;
+    this.stats.bytes += buffer.byteLength;
+    const commands = JSON.parse(Buffer.from(buffer).toString('utf16le')) as ChannelCommand[];
+
+    const replies: ChannelReply[] = [];
+    const waits: Promise<void>[] = [];
+    for (const [id, type, payload] of commands) {
+      this.stats.commands++;
+      const refusal = id === SUBSCRIBE_ID
+        ? this.subscribe(String(payload.callbackId))
+        : this.check(type, payload);
+      if (refusal) {
+        this.stats.rejected++;
+        if (id > 0) replies.push([id, false, refusal]);
+        continue;
+      }
+      if (id === SUBSCRIBE_ID) {
+        continue;
+      }
+      if (id === 0) {
+        this.bridge.sendFireAndForget(type, payload);
+        continue;
+      }
+      // Issue in order without waiting; the bridge answers each by message id
+      waits.push(this.bridge.send(type, payload).then(
+        (result) => { replies.push([id, true, result ?? null]); },
+        (err) => {
+          this.stats.errors++;
+          replies.push([id, false, err instanceof Error ? err.message : String(err)]);
+        }
+      ));
+    }
+    if (waits.length === 0 && replies.length === 0) return;
+
+    await Promise.all(waits);
+    if (this.replyRef) {
+      await this.replyRef.apply(undefined, [JSON.stringify(replies)]);
+    }
+  }
+
+  /**
+   * Why a command may not be replayed, or undefined if it may. Every ID in
+   * the payload (id, widgetId, callbackId, childId, ... and the children and
+   * childIds lists) must carry the app's prefix.
+   */
+  private check(type: string, payload: Record<string, unknown>): string | undefined {
+    if (!SANDBOX_CHANNEL_MESSAGE_TYPES.has(type)) {
+      return `Message type ${type} is not available to sandboxed apps`;
+    }
+    if (typeof payload !== 'object' || payload === null || Array.isArray(payload)) {
+      return `Invalid payload for ${type}`;
+    }
+    for (const [key, value] of Object.entries(payload)) {
+      if (key === 'id' || key.endsWith('Id')) {
+        if (!this.ownsId(value)) return `${type}: ${key} must start with ${this.idPrefix}`;
+      } else if (key === 'children' || key.endsWith('Ids')) {
+        if (!Array.isArray(value) || !value.every((v) => this.ownsId(v))) {
+          return `${type}: every entry of ${key} must start with ${this.idPrefix}`;
+        }
+      }
+    }
+    return undefined;
+  }
+
+  private ownsId(value: unknown): boolean {
+    return typeof value === 'string' && value.length > this.idPrefix.length && value.startsWith(this.idPrefix);
+  }
+
+  /**
+   * Forward the bridge's events for callbackId into the isolate. Returns why
+   * the subscription was refused, if it was.
+   */
+  private subscribe(callbackId: string): string | undefined {
+    if (this.subscribed.has(callbackId)) return undefined;
+    if (!this.ownsId(callbackId)) {
+      return `on: callbackId must start with ${this.idPrefix}`;
+    }
+    // Never replace a handler the host or another app registered
+    if (this.bridge.getEventHandler(callbackId) !== undefined) {
+      return `on: ${callbackId} already has a handler`;
+    }
+    const handler = (data: unknown) => {
+      this.eventRef?.applyIgnored(undefined, [callbackId, JSON.stringify(data ?? null)]);
+    };
+    this.subscribed.set(callbackId, handler);
+    this.bridge.registerEventHandler(callbackId, handler);
+    return undefined;
+  }
+}
@@ -3,9 +3,12 @@ import {
   executeInSandbox,
   isIsolatedVmAvailable,
   getRecommendedRuntime,
-  SandboxRuntimeType
+  SandboxRuntimeType,
+  IsolatePool,
+  disposeIsolatePools
 } from './sandbox-runtime';
 import { transformApp } from './app-transformer';
+import * as vm from 'vm';
 
 describe('Sandbox Runtime', () => {
   describe('vm runtime', () => {
@@ -181,3 +184,234 @@ describe('Sandbox Runtime with isolated-vm (if available)', () => {
     })).rejects.toThrow();
   });
 });
+
+/**
+ * Stand-in for the isolated-vm module: records what the pool does with it
+ */
+function createFakeIvm(options: { snapshots?: boolean } = {}) {
+  const isolates: any[] = [];
+  class FakeIsolate {
+    isDisposed = false;
+    contexts = 0;
+    heapUsed = 1024 * 1024;
+    options: any;
+    constructor(opts: any) {
+      this.options = opts;
+      isolates.push(this);
+    }
+    async createContext() {
+      this.contexts++;
+      const evals: string[] = [];
+      return { evals, eval: async (code: string) => { evals.push(code); }, release: jest.fn() };
+    }
+    getHeapStatisticsSync() {
+      return { used_heap_size: this.heapUsed, heap_size_limit: this.options.memoryLimit * 1024 * 1024 };
+    }
+    dispose() {
+      this.isDisposed = true;
+    }
+  }
+  if (options.snapshots !== false) {
+    (FakeIsolate as any).createSnapshot = jest.fn(() => ({ snapshot: true }));
+  }
+  return { Isolate: FakeIsolate, isolates };
+}
+
+describe('IsolatePool', () => {
+  afterAll(() => disposeIsolatePools());
+
+  it('pre-warms isolates from a prelude snapshot', async () => {
+    const ivm = createFakeIvm();
+    const pool = new IsolatePool({ size: 2, memoryLimitMB: 32 }, ivm);
+    await pool.ready();
+
+    expect(pool.getStats()).toMatchObject({ idle: 2, created: 2, snapshot: true });
+    expect(ivm.isolates[0].options).toEqual({ memoryLimit: 32, snapshot: { snapshot: true } });
+
+    // The snapshot already holds the prelude, so a lease's context is untouched
+    const lease = await pool.acquire();
+    expect(lease.context.evals).toEqual([]);
+    lease.release();
+    pool.dispose();
+  });
+
+  it('evaluates the prelude when snapshots are unsupported', async () => {
+    const pool = new IsolatePool({ size: 1 }, createFakeIvm({ snapshots: false }));
+    const lease = await pool.acquire();
+    expect(lease.context.evals[0]).toContain('global.module = { exports: {} }');
+    expect(pool.getStats().snapshot).toBe(false);
+    pool.dispose();
+  });
+
+  it('resets released isolates with a fresh context and reuses them', async () => {
+    const ivm = createFakeIvm();
+    const pool = new IsolatePool({ size: 1 }, ivm);
+    await pool.ready();
+
+    const first = await pool.acquire();
+    const firstContext = first.context;
+    first.release();
+    await pool.ready();
+    await new Promise(resolve => setImmediate(resolve));
+
+    const second = await pool.acquire();
+    expect(second.isolate).toBe(first.isolate);
+    expect(second.context).not.toBe(firstContext);
+    expect(firstContext.release).toHaveBeenCalled();
+    expect(pool.getStats().reused).toBe(1);
+    second.release();
+    pool.dispose();
+  });
+
+  it('retires isolates after maxUses or near the memory cap', async () => {
+    const ivm = createFakeIvm();
+    const pool = new IsolatePool({ size: 1, maxUses: 1, memoryLimitMB: 16 }, ivm);
+
+    const worn = await pool.acquire();
+    worn.release();
+    expect(worn.isolate.isDisposed).toBe(true);
+
+    const heavy = new IsolatePool({ size: 1, memoryLimitMB: 16 }, ivm);
+    const lease = await heavy.acquire();
+    lease.isolate.heapUsed = 15 * 1024 * 1024;
+    lease.release();
+    expect(lease.isolate.isDisposed).toBe(true);
+    expect(heavy.getStats().recycled).toBe(1);
+
+    pool.dispose();
+    heavy.dispose();
+  });
+});
+
+/**
+ * isolated-vm stand-in that runs each context in a plain vm context, so app
+ * code and the bridge channel really execute. References call straight through.
+ */
+function createVmBackedIvm() {
+  class Reference {
+    constructor(private fn: (...args: any[]) => any) {}
+    applyIgnored(_this: unknown, args: any[]) {
+      this.fn(...args);
+    }
+    apply(_this: unknown, args: any[]) {
+      return Promise.resolve(this.fn(...args));
+    }
+    release() {
+      this.fn = () => undefined;
+    }
+  }
+  class ExternalCopy {
+    constructor(private value: ArrayBuffer) {}
+    copyInto() {
+      return this.value;
+    }
+  }
+  class Isolate {
+    isDisposed = false;
+    async createContext() {
+      const sandbox = vm.createContext({});
+      return {
+        global: {
+          set: async (name: string, value: any) => { sandbox[name] = value; },
+          get: async (name: string) => new Reference(sandbox[name]),
+        },
+        eval: async (code: string, opts: any = {}) => {
+          const value = vm.runInContext(code, sandbox);
+          return opts.copy ? JSON.parse(JSON.stringify(value)) : value;
+        },
+        release: () => {},
+      };
+    }
+    getHeapStatisticsSync() {
+      return { used_heap_size: 0, heap_size_limit: 1 };
+    }
+    dispose() {
+      this.isDisposed = true;
+    }
+  }
+  return { Isolate, Reference, ExternalCopy };
+}
+
+describe('executeInSandbox with a bridge', () => {
+  async function settle() {
+    for (let i = 0; i < 5; i++) {
+      await new Promise((resolve) => setImmediate(resolve));
+    }
+  }
+
+  function createMockBridge() {
+    const handlers = new Map<string, (data: unknown) => void>();
+    return {
+      handlers,
+      sendFireAndForget: jest.fn(),
+      send: jest.fn(async () => ({ ok: true })),
+      registerEventHandler: jest.fn((id: string, handler: (data: unknown) => void) => { handlers.set(id, handler); }),
+      getEventHandler: (id: string) => handlers.get(id),
+      off: (id: string) => { handlers.delete(id); },
+    };
+  }
+
+  it('keeps the channel alive to deliver callbacks after launch', async () => {
+    const pool = new IsolatePool({ size: 1 }, createVmBackedIvm());
+    const bridge = createMockBridge();
+    const source = `
+      const tsyne = globalThis.__tsyneBridge;
+      const button = tsyne.idPrefix + 'b1';
+      const clicked = tsyne.idPrefix + 'cb1';
+      let clicks = 0;
+      tsyne.send('createButton', { id: button, text: 'Go', callbackId: clicked }).then(() => {
+        tsyne.on(clicked, (data) => {
+          clicks++;
+          tsyne.post('setText', { widgetId: button, text: data.label + ' ' + clicks });
+        });
+      });
+      module.exports = { name: 'clicker' };
+    `;
+
+    const result = await executeInSandbox(source, 'clicker', {
+      runtime: 'isolated-vm',
+      allowedModules: [],
+      bridge: bridge as any,
+      pool,
+    });
+    expect(result.exports).toEqual({ name: 'clicker' });
+
+    // The reply to createButton arrives after the top level has returned
+    await settle();
+    expect(bridge.registerEventHandler).toHaveBeenCalledTimes(1);
+    expect(pool.getStats().inUse).toBe(1);
+
+    // The app's IDs carry its own prefix
+    const button = `sandbox_${result.token}_b1`;
+    const handler = bridge.handlers.get(`sandbox_${result.token}_cb1`)!;
+    expect(handler).toBeDefined();
+    handler({ label: 'Clicked' });
+    handler({ label: 'Clicked' });
+    await settle();
+    expect(bridge.sendFireAndForget.mock.calls).toEqual([
+      ['setText', { widgetId: button, text: 'Clicked 1' }],
+      ['setText', { widgetId: button, text: 'Clicked 2' }],
+    ]);
+
+    // Once the app closes its handler is unregistered, a stale reference
+    // delivers nothing, and the isolate goes back
+    result.dispose();
+    expect(bridge.handlers.size).toBe(0);
+    handler({ label: 'Clicked' });
+    await settle();
+    expect(bridge.sendFireAndForget).toHaveBeenCalledTimes(2);
+    expect(pool.getStats().inUse).toBe(0);
+    pool.dispose();
+  });
+
+  it('releases the isolate right away without a bridge', async () => {
+    const pool = new IsolatePool({ size: 1 }, createVmBackedIvm());
+    await executeInSandbox('module.exports = { x: 1 };', 'plain', {
+      runtime: 'isolated-vm',
+      allowedModules: [],
+      pool,
+    });
+    expect(pool.getStats().inUse).toBe(0);
+    pool.dispose();
+  });
+});
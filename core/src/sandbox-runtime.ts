@@ -10,6 +10,8 @@
  */
 
 import { transformApp } from './app-transformer';
+import type { BridgeInterface } from './fynebridge';
+import { SandboxBridgeChannel } from './sandbox-bridge-channel';
 
 /**
  * Sandbox runtime type
@@ -28,6 +30,16 @@ export interface SandboxExecutionConfig {
   timeoutMs?: number;
   /** Modules the app is allowed to require */
   allowedModules?: string[];
+  /** Take the isolate from the shared pre-warmed pool (isolated-vm only, default true) */
+  pooled?: boolean;
+  /**
+   * Bridge exposed to the app as globalThis.__tsyneBridge through a batched
+   * channel (isolated-vm only). The app gets widget-level messages only, for
+   * IDs starting with __tsyneBridge.idPrefix (sandbox_<token>_).
+   */
+  bridge?: BridgeInterface;
+  /** Pool to lease from instead of the shared one for memoryLimitMB (isolated-vm only) */
+  pool?: IsolatePool;
 }
 
 /**
@@ -40,6 +52,11 @@ export interface SandboxExecutionResult {
   token: string;
   /** Which runtime was used */
   runtime: SandboxRuntimeType;
+  /**
+   * Release the runtime. With a bridge the isolate and its channel stay alive
+   * so the app keeps handling events; call this when the app closes.
+   */
+  dispose(): void;
 }
 
 /**
@@ -120,61 +137,375 @@ class VmRuntime implements ISandboxRuntime {
   }
 }
 
+/**
+ * Module system shim and safe globals every isolated-vm context starts with.
+ * Baked into the pool's startup snapshot when isolated-vm supports it.
+ *
+ * The tsyne API is deliberately not part of the prelude: it is host objects
+ * bound to one bridge connection, which a snapshot cannot hold and pooled
+ * isolates must not share. Each app gets it after its lease instead, as
+ * __tsyneBridge from sandbox-bridge-channel.ts.
+ */
+const ISOLATE_PRELUDE = `
+  var global = globalThis;
+  global.module = { exports: {} };
+  global.exports = global.module.exports;
+
+  // Safe globals
+  global.console = {
+    log: (...args) => {},
+    error: (...args) => {},
+    warn: (...args) => {},
+  };
+  global.setTimeout = (fn, ms) => { /* stub */ };
+  global.clearTimeout = (id) => {};
+  global.setInterval = (fn, ms) => { /* stub */ };
+  global.clearInterval = (id) => {};
+
+  // Make module/exports available at top level
+  var module = global.module;
+  var exports = global.exports;
+`;
+
+function loadIsolatedVm(): any {
+  try {
+    // Use require() to avoid TypeScript compile-time errors for optional dependency
+    // eslint-disable-next-line @typescript-eslint/no-var-requires
+    return require('isolated-vm');
+  } catch (e) {
+    throw new Error(
+      'isolated-vm is not installed. Install it with: npm install isolated-vm\n' +
+      'Or use runtime: "vm" for the built-in (less secure) sandbox.'
+    );
+  }
+}
+
+/**
+ * Options for an IsolatePool
+ */
+export interface IsolatePoolOptions {
+  /** Isolates kept alive, idle or leased (default 2) */
+  size?: number;
+  /** Memory cap per isolate in MB (default 128) */
+  memoryLimitMB?: number;
+  /** Apps an isolate runs before it is replaced (default 50) */
+  maxUses?: number;
+  /** Replace an isolate once its heap passes this fraction of the cap (default 0.75) */
+  maxHeapRatio?: number;
+}
+
+/**
+ * Pool counters, for tuning size and reuse limits
+ */
+export interface IsolatePoolStats {
+  idle: number;
+  inUse: number;
+  /** Isolates created since the pool started */
+  created: number;
+  /** Leases handed out */
+  acquired: number;
+  /** Leases served by an isolate that had run an app before */
+  reused: number;
+  /** Isolates retired for use count, heap size or a crash */
+  recycled: number;
+  /** Whether isolates start from a prelude snapshot */
+  snapshot: boolean;
+}
+
+/**
+ * An isolate and a fresh context from the pool. Release it when the app is done.
+ */
+export interface IsolateLease {
+  /** The isolated-vm module the isolate belongs to */
+  ivm: any;
+  isolate: any;
+  context: any;
+  release(): void;
+}
+
+interface PooledIsolate {
+  isolate: any;
+  context: any;
+  uses: number;
+}
+
+/**
+ * Pool of pre-warmed isolated-vm isolates.
+ *
+ * Each idle isolate already has a context with the prelude loaded: from a
+ * startup snapshot when isolated-vm supports Isolate.createSnapshot, by
+ * evaluating the prelude otherwise. A released isolate gets a brand new
+ * context (nothing from the previous app survives) and goes back to the
+ * pool, unless it has run maxUses apps or its heap is near the cap.
+ */
+export class IsolatePool {
+  private ivm: any;
+  private size: number;
+  private memoryLimitMB: number;
+  private maxUses: number;
+  private maxHeapRatio: number;
+  private snapshot: any = null;
+  private idle: PooledIsolate[] = [];
+  private warming: Promise<void> | null = null;
+  private inUse = 0;
+  private disposed = false;
+  private created = 0;
+  private acquired = 0;
+  private reused = 0;
+  private recycled = 0;
+
+  /**
+   * @param ivm - The isolated-vm module (loaded on demand when omitted)
+   */
+  constructor(options: IsolatePoolOptions = {}, ivm?: any) {
+    this.ivm = ivm ?? loadIsolatedVm();
+    this.size = Math.max(0, options.size ?? 2);
+    this.memoryLimitMB = options.memoryLimitMB ?? 128;
+    this.maxUses = Math.max(1, options.maxUses ?? 50);
+    this.maxHeapRatio = options.maxHeapRatio ?? 0.75;
+
+    if (typeof this.ivm.Isolate.createSnapshot === 'function') {
+      try {
+        this.snapshot = this.ivm.Isolate.createSnapshot([{ code: ISOLATE_PRELUDE, filename: 'tsyne-prelude.js' }]);
+      } catch {
+        this.snapshot = null;
+      }
+    }
+    this.warm();
+  }
+
+  /**
+   * Take a warm isolate, or create one when the pool is empty
+   */
+  async acquire(): Promise<IsolateLease> {
+    if (this.disposed) {
+      throw new Error('Isolate pool disposed');
+    }
+    let entry = this.idle.pop();
+    if (!entry) {
+      entry = await this.createEntry(await this.createIsolate());
+    }
+
+    this.acquired++;
+    if (entry.uses > 0) {
+      this.reused++;
+    }
+    entry.uses++;
+    this.inUse++;
+    this.warm();
+
+    let released = false;
+    const lease = entry;
+    return {
+      ivm: this.ivm,
+      isolate: lease.isolate,
+      context: lease.context,
+      release: () => {
+        if (released) return;
+        released = true;
+        this.inUse--;
+        this.giveBack(lease);
+      },
+    };
+  }
+
+  getStats(): IsolatePoolStats {
+    return {
+      idle: this.idle.length,
+      inUse: this.inUse,
+      created: this.created,
+      acquired: this.acquired,
+      reused: this.reused,
+      recycled: this.recycled,
+      snapshot: this.snapshot !== null,
+    };
+  }
+
+  /**
+   * Resolves once background warming has finished
+   */
+  async ready(): Promise<void> {
+    while (this.warming) {
+      await this.warming;
+    }
+  }
+
+  dispose(): void {
+    this.disposed = true;
+    for (const entry of this.idle) {
+      this.disposeIsolate(entry.isolate);
+    }
+    this.idle = [];
+  }
+
+  private async createIsolate(): Promise<any> {
+    const options: Record<string, any> = { memoryLimit: this.memoryLimitMB };
+    if (this.snapshot) {
+      options.snapshot = this.snapshot;
+    }
+    this.created++;
+    return new this.ivm.Isolate(options);
+  }
+
+  /**
+   * A fresh context on isolate, with the prelude in place
+   */
+  private async createEntry(isolate: any, uses = 0): Promise<PooledIsolate> {
+    const context = await isolate.createContext();
+    if (!this.snapshot) {
+      await context.eval(ISOLATE_PRELUDE);
+    }
+    return { isolate, context, uses };
+  }
+
+  /**
+   * Reset a released isolate with a new context, or retire it
+   */
+  private giveBack(entry: PooledIsolate): void {
+    try {
+      entry.context.release();
+    } catch {
+      // Context already gone with its isolate
+    }
+
+    if (this.disposed || entry.isolate.isDisposed || !this.isReusable(entry)) {
+      this.recycled++;
+      this.disposeIsolate(entry.isolate);
+      this.warm();
+      return;
+    }
+
+    this.createEntry(entry.isolate, entry.uses)
+      .then(fresh => {
+        if (this.disposed || this.idle.length + this.inUse >= this.size) {
+          this.disposeIsolate(fresh.isolate);
+        } else {
+          this.idle.push(fresh);
+        }
+      })
+      .catch(() => {
+        this.recycled++;
+        this.disposeIsolate(entry.isolate);
+        this.warm();
+      });
+  }
+
+  private isReusable(entry: PooledIsolate): boolean {
+    if (entry.uses >= this.maxUses) {
+      return false;
+    }
+    try {
+      const heap = entry.isolate.getHeapStatisticsSync();
+      const limit = heap.heap_size_limit || this.memoryLimitMB * 1024 * 1024;
+      return heap.used_heap_size / limit < this.maxHeapRatio;
+    } catch {
+      return false;
+    }
+  }
+
+  private disposeIsolate(isolate: any): void {
+    try {
+      if (!isolate.isDisposed) {
+        isolate.dispose();
+      }
+    } catch {
+      // Already disposed
+    }
+  }
+
+  /**
+   * Top the pool up to its size in the background
+   */
+  private warm(): void {
+    if (this.warming || this.disposed || this.idle.length + this.inUse >= this.size) {
+      return;
+    }
+    const warming = (async () => {
+      try {
+        while (!this.disposed && this.idle.length + this.inUse < this.size) {
+          const entry = await this.createEntry(await this.createIsolate());
+          if (this.disposed) {
+            this.disposeIsolate(entry.isolate);
+          } else {
+            this.idle.push(entry);
+          }
+        }
+      } catch {
+        // Leave the pool short; acquire() creates isolates on demand
+      }
+    })();
+    this.warming = warming;
+    warming.then(() => {
+      if (this.warming === warming) {
+        this.warming = null;
+      }
+    });
+  }
+}
+
+// Shared pools, one per memory cap
+const isolatePools = new Map<number, IsolatePool>();
+
+/**
+ * The shared isolate pool for a memory cap, created on first use
+ */
+export function getIsolatePool(memoryLimitMB: number = 128): IsolatePool {
+  let pool = isolatePools.get(memoryLimitMB);
+  if (!pool) {
+    pool = new IsolatePool({ memoryLimitMB });
+    isolatePools.set(memoryLimitMB, pool);
+  }
+  return pool;
+}
+
+/**
+ * Dispose every shared isolate pool
+ */
+export function disposeIsolatePools(): void {
+  for (const pool of isolatePools.values()) {
+    pool.dispose();
+  }
+  isolatePools.clear();
+}
+
 /**
  * isolated-vm based runtime (secure, true V8 isolate)
  */
 class IsolatedVmRuntime implements ISandboxRuntime {
   private isolate: any = null;
+  private lease: IsolateLease | null = null;
+  private channel: SandboxBridgeChannel | null = null;
 
   async execute(
     transformedCode: string,
     token: string,
     config: SandboxExecutionConfig
   ): Promise<Record<string, any>> {
-    // Lazy import - will fail if isolated-vm not installed
-    // Use require() to avoid TypeScript compile-time errors for optional dependency
+    let context: any;
     let ivm: any;
-    try {
-      // eslint-disable-next-line @typescript-eslint/no-var-requires
-      ivm = require('isolated-vm');
-    } catch (e) {
-      throw new Error(
-        'isolated-vm is not installed. Install it with: npm install isolated-vm\n' +
-        'Or use runtime: "vm" for the built-in (less secure) sandbox.'
-      );
+    if (config.pooled !== false) {
+      const pool = config.pool ?? getIsolatePool(config.memoryLimitMB || 128);
+      this.lease = await pool.acquire();
+      context = this.lease.context;
+      ivm = this.lease.ivm;
+    } else {
+      ivm = loadIsolatedVm();
+
+      // Create isolate with memory limit
+      this.isolate = new ivm.Isolate({
+        memoryLimit: config.memoryLimitMB || 128
+      });
+
+      context = await this.isolate.createContext();
+
+      // Set up globals and module system
+      await context.eval(ISOLATE_PRELUDE);
     }
 
-    // Create isolate with memory limit
-    this.isolate = new ivm.Isolate({
-      memoryLimit: config.memoryLimitMB || 128
-    });
-
-    const context = await this.isolate.createContext();
-
-    // Set up globals and module system
-    const jail = context.global;
-    await jail.set('global', jail.derefInto());
-
-    // Set up module/exports on global so they persist across evals
-    await context.eval(`
-      global.module = { exports: {} };
-      global.exports = global.module.exports;
-
-      // Safe globals
-      global.console = {
-        log: (...args) => {},
-        error: (...args) => {},
-        warn: (...args) => {},
-      };
-      global.setTimeout = (fn, ms) => { /* stub */ };
-      global.clearTimeout = (id) => {};
-      global.setInterval = (fn, ms) => { /* stub */ };
-      global.clearInterval = (id) => {};
-
-      // Make module/exports available at top level
-      var module = global.module;
-      var exports = global.exports;
-    `);
+    if (config.bridge) {
+      this.channel = new SandboxBridgeChannel(config.bridge, `sandbox_${token}_`);
+      await this.channel.install(context, ivm);
+    }
 
     // Run the transformed code
     await context.eval(transformedCode, {
@@ -188,6 +519,14 @@ class IsolatedVmRuntime implements ISandboxRuntime {
   }
 
   dispose(): void {
+    if (this.channel) {
+      this.channel.dispose();
+      this.channel = null;
+    }
+    if (this.lease) {
+      this.lease.release();
+      this.lease = null;
+    }
     if (this.isolate) {
       this.isolate.dispose();
       this.isolate = null;
@@ -229,17 +568,25 @@ export async function executeInSandbox(
   // Create runtime and execute
   const runtime = createSandboxRuntime(config.runtime);
 
+  let exports: Record<string, any>;
   try {
-    const exports = await runtime.execute(code, token, config);
+    exports = await runtime.execute(code, token, config);
+  } catch (error) {
+    runtime.dispose();
+    throw error;
+  }
 
-    return {
-      exports,
-      token,
-      runtime: config.runtime
-    };
-  } finally {
+  // Without a bridge nothing reaches the app after its top level has run
+  if (!config.bridge) {
     runtime.dispose();
   }
+
+  return {
+    exports,
+    token,
+    runtime: config.runtime,
+    dispose: () => runtime.dispose()
+  };
 }
 
 /**
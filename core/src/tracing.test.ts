@@ -0,0 +1,77 @@
+/**
+ * Tests for cross-process tracing
+ */
+
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import {
+  TraceRecorder,
+  exportChromeTrace,
+  TRACE_LANE_CALLS,
+  TRACE_LANE_TRANSPORT,
+  TRACE_LANE_RESPONSES,
+} from './tracing';
+
+describe('TraceRecorder', () => {
+  it('uses wall-clock microseconds', () => {
+    const tracer = new TraceRecorder(8);
+    expect(Math.abs(tracer.now() / 1000 - Date.now())).toBeLessThan(1000);
+  });
+
+  it('keeps the newest spans when the ring wraps', () => {
+    const tracer = new TraceRecorder(3);
+    for (let i = 0; i < 5; i++) {
+      tracer.span('write', 'ipc', `msg_${i}`, TRACE_LANE_TRANSPORT, tracer.now());
+    }
+
+    const spans = tracer.chromeEvents().filter((e) => e.ph === 'X');
+    expect(spans.map((e) => e.args!.msgId)).toEqual(['msg_2', 'msg_3', 'msg_4']);
+    expect(tracer.dropped).toBe(2);
+  });
+
+  it('exports sends as async events and links write/resolve to the bridge flows', () => {
+    const tracer = new TraceRecorder(16);
+    const start = tracer.now();
+    tracer.span('write', 'ipc', 'msg_1', TRACE_LANE_TRANSPORT, start);
+    tracer.span('resolve', 'ipc', 'msg_1', TRACE_LANE_RESPONSES, start);
+    tracer.span('setText', 'bridge', 'msg_1', TRACE_LANE_CALLS, start, true);
+
+    const events = tracer.chromeEvents();
+    expect(events.find((e) => e.ph === 's')).toMatchObject({ id: 'req:msg_1', name: 'request' });
+    expect(events.find((e) => e.ph === 'f')).toMatchObject({ id: 'resp:msg_1', name: 'response', bp: 'e' });
+    expect(events.filter((e) => e.name === 'setText').map((e) => e.ph)).toEqual(['b', 'e']);
+    expect(events.filter((e) => e.ph === 'M').length).toBeGreaterThan(0);
+  });
+});
+
+describe('exportChromeTrace', () => {
+  it('merges bridge events and writes the trace file', async () => {
+    const tracer = new TraceRecorder(16);
+    tracer.span('write', 'ipc', 'msg_1', TRACE_LANE_TRANSPORT, tracer.now());
+    const bridge = {
+      send: jest.fn(async () => ({
+        events: [{ name: 'decode', ph: 'X', ts: 1, dur: 2, pid: 99, tid: 1 }],
+        dropped: 3,
+      })),
+    };
+    const file = path.join(fs.mkdtempSync(path.join(os.tmpdir(), 'tsyne-trace-')), 'trace.json');
+
+    const trace = await exportChromeTrace(bridge as any, file, tracer);
+
+    expect(bridge.send).toHaveBeenCalledWith('getTraceEvents', {});
+    expect(trace.traceEvents.some((e) => e.pid === 99 && e.name === 'decode')).toBe(true);
+    expect(trace.otherData).toEqual({ droppedNode: 0, droppedBridge: 3 });
+    expect(JSON.parse(fs.readFileSync(file, 'utf8')).traceEvents.length).toBe(trace.traceEvents.length);
+  });
+
+  it('falls back to the Node side when the bridge is not tracing', async () => {
+    const tracer = new TraceRecorder(16);
+    tracer.span('write', 'ipc', 'msg_1', TRACE_LANE_TRANSPORT, tracer.now());
+    const bridge = { send: jest.fn(async () => { throw new Error('Tracing is not enabled'); }) };
+
+    const trace = await exportChromeTrace(bridge as any, undefined, tracer);
+
+    expect(trace.traceEvents.some((e) => e.name === 'write')).toBe(true);
+  });
+});
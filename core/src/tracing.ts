@@ -0,0 +1,197 @@
+/**
+ * Cross-process latency tracing
+ *
+ * Set TSYNE_TRACE=<file.json> to record spans for every bridge message on
+ * both sides of the IPC boundary:
+ *
+ *   Node:  send (call to resolve), transport write, resolve
+ *   Go:    decode, handler, fyne.Do wait / run on the main thread, respond
+ *
+ * Spans carry the message ID and live in fixed-size ring buffers. The bridge
+ * inherits TSYNE_TRACE and keeps its own ring; exportChromeTrace() fetches it
+ * with getTraceEvents and writes one Chrome trace JSON file, with flow arrows
+ * from each send to its Go decode and from each Go respond back to the
+ * resolve. Open it in https://ui.perfetto.dev or chrome://tracing.
+ *
+ * Timestamps are wall-clock microseconds since the Unix epoch on both sides,
+ * so the two processes line up on one timeline.
+ */
+
+import * as fs from 'fs';
+import type { BridgeInterface } from './fynebridge';
+
+/**
+ * One event in the Chrome trace event format
+ */
+export interface ChromeTraceEvent {
+  name: string;
+  ph: string;
+  pid: number;
+  tid?: number;
+  ts?: number;
+  dur?: number;
+  cat?: string;
+  id?: string;
+  bp?: string;
+  args?: Record<string, unknown>;
+}
+
+/**
+ * A Chrome/Perfetto trace file
+ */
+export interface ChromeTrace {
+  traceEvents: ChromeTraceEvent[];
+  displayTimeUnit: 'ms';
+  /** Spans lost to ring buffer wrap-around, per side */
+  otherData: { droppedNode: number; droppedBridge: number };
+}
+
+/** Trace lanes (Chrome "tid") on the Node side */
+export const TRACE_LANE_CALLS = 1;
+export const TRACE_LANE_TRANSPORT = 2;
+export const TRACE_LANE_RESPONSES = 3;
+
+interface TraceSpan {
+  name: string;
+  cat: string;
+  msgId: string;
+  lane: number;
+  async: boolean;
+  startUs: number;
+  durUs: number;
+}
+
+/**
+ * Ring buffer of spans recorded in this process
+ */
+export class TraceRecorder {
+  private ring: (TraceSpan | undefined)[];
+  private next = 0;
+  private total = 0;
+
+  /**
+   * @param capacity - Spans kept; older ones are overwritten
+   * @param outputPath - Where App.quit() writes the trace (TSYNE_TRACE)
+   */
+  constructor(capacity: number = 65536, readonly outputPath?: string) {
+    this.ring = new Array(Math.max(1, capacity));
+  }
+
+  /** Wall-clock microseconds since the Unix epoch */
+  now(): number {
+    return Math.round((performance.timeOrigin + performance.now()) * 1000);
+  }
+
+  /**
+   * Record a span from startUs until now. Async spans may overlap others on
+   * the same lane (e.g. concurrent sends awaiting their responses).
+   */
+  span(name: string, cat: string, msgId: string, lane: number, startUs: number, async: boolean = false): void {
+    this.ring[this.next] = { name, cat, msgId, lane, async, startUs, durUs: this.now() - startUs };
+    this.next = (this.next + 1) % this.ring.length;
+    this.total++;
+  }
+
+  /** Spans lost because the ring wrapped */
+  get dropped(): number {
+    return Math.max(0, this.total - this.ring.length);
+  }
+
+  clear(): void {
+    this.ring = new Array(this.ring.length);
+    this.next = 0;
+    this.total = 0;
+  }
+
+  /**
+   * Buffered spans as Chrome trace events, oldest first. Write spans start
+   * the "request" flow and resolve spans end the "response" flow.
+   */
+  chromeEvents(): ChromeTraceEvent[] {
+    const pid = process.pid;
+    const events: ChromeTraceEvent[] = [
+      { name: 'process_name', ph: 'M', pid, args: { name: 'tsyne (Node)' } },
+      { name: 'thread_name', ph: 'M', pid, tid: TRACE_LANE_CALLS, args: { name: 'Bridge calls' } },
+      { name: 'thread_name', ph: 'M', pid, tid: TRACE_LANE_TRANSPORT, args: { name: 'Transport' } },
+      { name: 'thread_name', ph: 'M', pid, tid: TRACE_LANE_RESPONSES, args: { name: 'Responses' } },
+    ];
+
+    const ordered = this.total > this.ring.length
+      ? [...this.ring.slice(this.next), ...this.ring.slice(0, this.next)]
+      : this.ring.slice(0, this.next);
+
+    for (const span of ordered) {
+      if (!span) continue;
+      const { name, cat, msgId, lane: tid, startUs: ts, durUs: dur } = span;
+      const args = { msgId };
+      if (span.async) {
+        events.push({ name, cat, ph: 'b', id: msgId, ts, pid, tid, args });
+        events.push({ name, cat, ph: 'e', id: msgId, ts: ts + dur, pid, tid });
+        continue;
+      }
+      events.push({ name, cat, ph: 'X', ts, dur, pid, tid, args });
+      if (name === 'write') {
+        events.push({ name: 'request', cat: 'ipc', ph: 's', id: `req:${msgId}`, ts, pid, tid });
+      } else if (name === 'resolve') {
+        events.push({ name: 'response', cat: 'ipc', ph: 'f', bp: 'e', id: `resp:${msgId}`, ts, pid, tid });
+      }
+    }
+    return events;
+  }
+}
+
+// undefined = TSYNE_TRACE not checked yet, null = tracing off
+let activeTracer: TraceRecorder | null | undefined;
+
+/**
+ * The process-wide recorder, or null when TSYNE_TRACE is not set.
+ * TSYNE_TRACE_SPANS overrides the ring size.
+ */
+export function getTracer(): TraceRecorder | null {
+  if (activeTracer === undefined) {
+    const outputPath = process.env.TSYNE_TRACE;
+    const capacity = parseInt(process.env.TSYNE_TRACE_SPANS || '', 10);
+    activeTracer = outputPath
+      ? new TraceRecorder(capacity > 0 ? capacity : undefined, outputPath)
+      : null;
+  }
+  return activeTracer;
+}
+
+/**
+ * Replace the process-wide recorder (null turns tracing off)
+ */
+export function setTracer(tracer: TraceRecorder | null): void {
+  activeTracer = tracer;
+}
+
+/**
+ * Merge this process's spans with the bridge's into one Chrome trace and
+ * optionally write it to filePath. When the bridge was started without
+ * tracing, the trace holds only the Node side.
+ */
+export async function exportChromeTrace(
+  bridge: BridgeInterface,
+  filePath?: string,
+  tracer: TraceRecorder | null = getTracer()
+): Promise<ChromeTrace> {
+  const traceEvents = tracer ? tracer.chromeEvents() : [];
+  let droppedBridge = 0;
+  try {
+    const result = await bridge.send('getTraceEvents', {}) as { events?: ChromeTraceEvent[]; dropped?: number };
+    traceEvents.push(...(result.events || []));
+    droppedBridge = result.dropped || 0;
+  } catch {
+    // Bridge not tracing (or already gone) - export the Node side only
+  }
+
+  const trace: ChromeTrace = {
+    traceEvents,
+    displayTimeUnit: 'ms',
+    otherData: { droppedNode: tracer ? tracer.dropped : 0, droppedBridge },
+  };
+  if (filePath) {
+    await fs.promises.writeFile(filePath, JSON.stringify(trace));
+  }
+  return trace;
+}
@@ -13,6 +13,12 @@ import {
   loadWithCache,
   clearCache,
   getCacheStats,
+  executeCompiledCode,
+  lookupFileCache,
+  loadFileWithCache,
+  precompileApp,
+  executeBundle,
+  loadAndExecuteFile,
 } from './transpile-cache';
 
 describe('transpile-cache', () => {
@@ -132,6 +138,224 @@ describe('transpile-cache', () => {
     });
   });
 
+  describe('V8 code cache', () => {
+    it('writes a code cache on first execution and reuses it', async () => {
+      const source = `export const answer = 6 * 7; export const stamp = "code-cache-${Date.now()}";`;
+      const { code, cacheKey } = await loadWithCache(source, 'test.ts');
+      const codeCachePath = path.join(getCacheStats().cacheDir, `${cacheKey}.cache`);
+      expect(fs.existsSync(codeCachePath)).toBe(false);
+
+      const first = executeCompiledCode(code, 'test.ts', {}, cacheKey);
+      expect(first.answer).toBe(42);
+      expect(fs.existsSync(codeCachePath)).toBe(true);
+      const written = fs.statSync(codeCachePath).mtimeMs;
+
+      // Accepted cache data is not rewritten
+      const second = executeCompiledCode(code, 'test.ts', {}, cacheKey);
+      expect(second.answer).toBe(42);
+      expect(fs.statSync(codeCachePath).mtimeMs).toBe(written);
+    });
+
+    it('replaces rejected code cache data', async () => {
+      const source = `export const greeting = "rejected-${Date.now()}";`;
+      const { code, cacheKey } = await loadWithCache(source, 'test.ts');
+      const codeCachePath = path.join(getCacheStats().cacheDir, `${cacheKey}.cache`);
+      fs.writeFileSync(codeCachePath, Buffer.from('not a code cache'));
+
+      const result = executeCompiledCode(code, 'test.ts', { extra: 1 }, cacheKey);
+      expect(result.greeting).toContain('rejected-');
+      expect(fs.readFileSync(codeCachePath).toString()).not.toBe('not a code cache');
+    });
+
+    it('passes context overrides to the app', async () => {
+      const { code } = await loadWithCache(`declare const host: string; export const seen = host;`, 'test.ts');
+      expect(executeCompiledCode(code, 'test.ts', { host: 'phonetop' }).seen).toBe('phonetop');
+    });
+  });
+
+  describe('file fingerprints', () => {
+    let dir: string;
+
+    beforeEach(() => {
+      dir = fs.mkdtempSync(path.join(os.tmpdir(), 'tsyne-fingerprint-'));
+    });
+
+    afterEach(() => {
+      fs.rmSync(dir, { recursive: true, force: true });
+    });
+
+    it('skips hashing an unchanged file', async () => {
+      const file = path.join(dir, 'app.ts');
+      fs.writeFileSync(file, `export const v = "fp-${Date.now()}";`);
+
+      const first = await loadFileWithCache(file);
+      expect(first.cached).toBe(false);
+
+      const lookup = lookupFileCache(file);
+      expect(lookup.hit).toBe(true);
+      expect(lookup.validatedBy).toBe('fingerprint');
+      expect(lookup.code).toBe(first.code);
+      expect((await loadFileWithCache(file)).cached).toBe(true);
+    });
+
+    it('rehashes when the fingerprint changes', async () => {
+      const file = path.join(dir, 'app.ts');
+      const source = `export const v = "touch-${Date.now()}";`;
+      fs.writeFileSync(file, source);
+      await loadFileWithCache(file);
+
+      // Same contents, new mtime: still a hit, found by hash
+      const later = new Date(Date.now() + 5000);
+      fs.utimesSync(file, later, later);
+      const touched = lookupFileCache(file);
+      expect(touched.hit).toBe(true);
+      expect(touched.validatedBy).toBe('hash');
+      expect(lookupFileCache(file).validatedBy).toBe('fingerprint');
+
+      // New contents: a miss
+      fs.writeFileSync(file, source + ' export const w = 1;');
+      const changed = lookupFileCache(file);
+      expect(changed.hit).toBe(false);
+      expect((await loadFileWithCache(file)).code).toContain('w');
+    });
+
+    it('keeps all metadata in one index file', async () => {
+      const file = path.join(dir, 'app.ts');
+      fs.writeFileSync(file, `export const v = "index-${Date.now()}";`);
+      const { cacheKey } = await loadFileWithCache(file);
+
+      const cacheDir = getCacheStats().cacheDir;
+      expect(fs.existsSync(path.join(cacheDir, `${cacheKey}.meta.json`))).toBe(false);
+      const index = JSON.parse(fs.readFileSync(path.join(cacheDir, 'index.json'), 'utf-8'));
+      expect(index.entries[cacheKey].sourcePath).toBe(file);
+      expect(index.files[path.resolve(file)].cacheKey).toBe(cacheKey);
+    });
+  });
+
+  describe('index writes', () => {
+    const indexPath = () => path.join(getCacheStats().cacheDir, 'index.json');
+    const readIndex = () => JSON.parse(fs.readFileSync(indexPath(), 'utf-8'));
+
+    it('keeps entries another process wrote since the index was loaded', () => {
+      const mine = storeInCache(`export const a = "mine-${Date.now()}";`, 'exports.a = 1;', 'mine.ts');
+
+      // Another launch adds its own entry behind this process's back
+      const index = readIndex();
+      index.entries['0123456789abcdef'] = { sourceHash: 'x', sourcePath: 'theirs.ts', compiledAt: Date.now() };
+      fs.writeFileSync(indexPath(), JSON.stringify(index));
+
+      const next = storeInCache(`export const b = "next-${Date.now()}";`, 'exports.b = 1;', 'next.ts');
+      const merged = readIndex();
+      expect(merged.entries[mine].sourcePath).toBe('mine.ts');
+      expect(merged.entries[next].sourcePath).toBe('next.ts');
+      expect(merged.entries['0123456789abcdef'].sourcePath).toBe('theirs.ts');
+    });
+
+    it('writes the index once per precompiled app', async () => {
+      const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'tsyne-batch-'));
+      const stamp = Date.now();
+      fs.writeFileSync(path.join(dir, 'app.ts'), `import { a } from './a';\nimport { b } from './b';\nexport const v = a + b + ${stamp};`);
+      fs.writeFileSync(path.join(dir, 'a.ts'), `export const a = ${stamp};`);
+      fs.writeFileSync(path.join(dir, 'b.ts'), `export const b = ${stamp + 1};`);
+
+      const writes = getCacheStats().indexWrites;
+      try {
+        const result = await precompileApp(path.join(dir, 'app.ts'));
+        expect(result.modules.length).toBe(3);
+        expect(getCacheStats().indexWrites).toBe(writes + 1);
+        expect(Object.keys(readIndex().files)).toEqual(expect.arrayContaining(result.modules));
+        expect(readIndex().bundles[path.join(dir, 'app.ts')]).toBeDefined();
+      } finally {
+        fs.rmSync(dir, { recursive: true, force: true });
+      }
+    });
+  });
+
+  describe('whole-app bundles', () => {
+    let dir: string;
+    let entry: string;
+
+    beforeEach(() => {
+      dir = fs.mkdtempSync(path.join(os.tmpdir(), 'tsyne-bundle-'));
+      fs.mkdirSync(path.join(dir, 'lib'));
+      entry = path.join(dir, 'app.ts');
+      const stamp = Date.now();
+      fs.writeFileSync(entry, `import { double } from './math';\nimport { label } from './lib';\n` +
+        `export const result = label(double(21)); export const stamp = ${stamp};`);
+      fs.writeFileSync(path.join(dir, 'math.ts'), `export function double(n: number): number { return n * 2; }`);
+      fs.writeFileSync(path.join(dir, 'lib', 'index.ts'),
+        `import { double } from '../math';\nexport function label(n: number): string { return 'answer=' + n + '/' + double(1); }`);
+    });
+
+    afterEach(() => {
+      fs.rmSync(dir, { recursive: true, force: true });
+    });
+
+    it('walks the import graph into one bundle', async () => {
+      const first = await precompileApp(entry);
+      expect(first.cached).toBe(false);
+      expect(first.modules).toEqual([entry, path.join(dir, 'math.ts'), path.join(dir, 'lib', 'index.ts')]);
+
+      const cacheDir = getCacheStats().cacheDir;
+      expect(fs.existsSync(path.join(cacheDir, `bundle-${first.bundleKey}.js`))).toBe(true);
+      expect(executeBundle(first.bundleKey, entry).result).toBe('answer=42/2');
+      expect(fs.existsSync(path.join(cacheDir, `bundle-${first.bundleKey}.cache`))).toBe(true);
+    });
+
+    it('reuses the bundle until a module changes', async () => {
+      const first = await precompileApp(entry);
+      const warm = await precompileApp(entry);
+      expect(warm.cached).toBe(true);
+      expect(warm.bundleKey).toBe(first.bundleKey);
+
+      fs.writeFileSync(path.join(dir, 'math.ts'), `export function double(n: number): number { return n + n + 0; }`);
+      const rebuilt = await precompileApp(entry);
+      expect(rebuilt.cached).toBe(false);
+      expect(rebuilt.bundleKey).not.toBe(first.bundleKey);
+    });
+
+    it('leaves modules outside the app directory to Node require', async () => {
+      const appDir = path.join(dir, 'phone');
+      fs.mkdirSync(appDir);
+      const main = path.join(appDir, 'main.ts');
+      fs.writeFileSync(path.join(dir, 'services.js'), `exports.registry = { apps: 0 };`);
+      fs.writeFileSync(main, `import { registry } from '../services';\nimport { three } from './local';\n` +
+        `registry.apps += three;\nexport const shared = registry;\nexport const stamp = ${Date.now()};`);
+      fs.writeFileSync(path.join(appDir, 'local.ts'), `export const three = 3;`);
+
+      const built = await precompileApp(main);
+      expect(built.modules).toEqual([main, path.join(appDir, 'local.ts')]);
+
+      // The host's instance, not a bundled copy
+      const host = require(path.join(dir, 'services.js'));
+      const { shared } = executeBundle(built.bundleKey, main);
+      expect(shared).toBe(host.registry);
+      expect(host.registry.apps).toBe(3);
+    });
+
+    it('takes bundled modules the host already loaded from require.cache', async () => {
+      const counter = path.join(dir, 'counter.js');
+      fs.writeFileSync(counter, `exports.state = { n: 0 };`);
+      fs.appendFileSync(entry, `\nimport { state } from './counter';\nexport const counterState = state;`);
+      const built = await precompileApp(entry);
+      expect(built.modules).toContain(counter);
+
+      const host = require(counter);
+      try {
+        expect(executeBundle(built.bundleKey, entry).counterState).toBe(host.state);
+      } finally {
+        delete require.cache[counter];
+      }
+    });
+
+    it('loadAndExecuteFile runs the bundle with context variables', async () => {
+      fs.appendFileSync(entry, `\ndeclare const host: string;\nexport const seen = host;`);
+      const { exports } = await loadAndExecuteFile(entry, { host: 'browser' });
+      expect(exports.result).toBe('answer=42/2');
+      expect(exports.seen).toBe('browser');
+    });
+  });
+
   describe('clearCache', () => {
     it('should clear cached files', async () => {
       const source = `export const clear = "clear-test-${Date.now()}";`;
@@ -8,12 +8,24 @@
  * - Single-file apps with explicit imports only
  * - Content hash (not mtime) - works for URLs too
  * - Cache invalidation = source hash change OR core version change
+ *
+ * For files, a (size, mtime, inode) fingerprint recorded at the last hash
+ * is checked first; only a changed fingerprint reads and rehashes the
+ * source. Entry metadata and fingerprints live in one index.json. Writes
+ * re-read it and merge this process's changes, so concurrent launches
+ * don't drop each other's entries.
+ *
+ * Each entry may also carry a V8 code cache (`<key>.cache`, from
+ * vm.Script#createCachedData), so warm launches skip parsing and compiling
+ * the app too. V8 rejects code cache data from another V8 version or with
+ * different flags; it is then regenerated.
  */
 
 import * as fs from 'fs';
 import * as path from 'path';
 import * as os from 'os';
 import * as crypto from 'crypto';
+import * as vm from 'vm';
 
 // Get Tsyne core version for cache invalidation
 const packageJsonPath = path.resolve(__dirname, '..', __dirname.includes('dist') ? '..' : '', 'package.json');
@@ -29,15 +41,52 @@ const CACHE_DIR = process.env.TSYNE_CACHE_DIR ||
   path.join(os.homedir(), '.cache', 'tsyne', 'compiled');
 
 /**
- * Cache metadata stored alongside compiled JS
+ * What the index records about each cache entry
  */
 interface CacheMetadata {
   sourceHash: string;
-  coreVersion: string;
   sourcePath: string;
   compiledAt: number;
 }
 
+/**
+ * All cache metadata, in one file loaded once per process. files maps an
+ * absolute source path to the stat fingerprint it had when it was last
+ * hashed, so an unchanged file resolves to its entry without being read.
+ */
+interface CacheIndex {
+  coreVersion: string;
+  entries: Record<string, CacheMetadata>;
+  files: Record<string, { fingerprint: string; cacheKey: string }>;
+  /** Per app entry file: its current bundle and the module fingerprints it was built from */
+  bundles: Record<string, BundleManifest>;
+}
+
+interface BundleManifest {
+  bundleKey: string;
+  contextNames: string[];
+  modules: Record<string, string>;
+}
+
+const INDEX_PATH = path.join(CACHE_DIR, 'index.json');
+
+// Loaded on first use
+let cacheIndex: CacheIndex | null = null;
+
+type IndexSection = 'entries' | 'files' | 'bundles';
+
+/**
+ * What this process changed in the index since it was last written (null
+ * deletes), replayed onto the file on disk by saveIndex()
+ */
+type IndexChanges = { [S in IndexSection]: Map<string, CacheIndex[S][string] | null> };
+
+let indexChanges: IndexChanges = emptyChanges();
+
+// Nesting depth of batchIndexWrites(); the index is written when it returns to 0
+let indexBatchDepth = 0;
+let indexWrites = 0;
+
 /**
  * Result of cache lookup
  */
@@ -45,6 +94,9 @@ export interface CacheResult {
   hit: boolean;
   code?: string;
   sourcePath?: string;
+  cacheKey?: string;
+  /** How a file lookup was validated: stat fingerprint, or hashing the source */
+  validatedBy?: 'fingerprint' | 'hash';
 }
 
 /**
@@ -52,7 +104,14 @@ export interface CacheResult {
  * Cache key = sha256(source) + core version to invalidate on upgrades
  */
 export function generateCacheKey(source: string): string {
-  const sourceHash = crypto.createHash('sha256').update(source).digest('hex');
+  return cacheKeyFromHash(hashSource(source));
+}
+
+function hashSource(source: string): string {
+  return crypto.createHash('sha256').update(source).digest('hex');
+}
+
+function cacheKeyFromHash(sourceHash: string): string {
   // Include version in hash to auto-invalidate on upgrades
   const combined = `${sourceHash}:${TSYNE_CORE_VERSION}`;
   return crypto.createHash('sha256').update(combined).digest('hex').slice(0, 16);
@@ -61,10 +120,10 @@ export function generateCacheKey(source: string): string {
 /**
  * Get cache file paths for a given cache key
  */
-function getCachePaths(cacheKey: string): { js: string; meta: string } {
+function getCachePaths(cacheKey: string): { js: string; codeCache: string } {
   return {
     js: path.join(CACHE_DIR, `${cacheKey}.js`),
-    meta: path.join(CACHE_DIR, `${cacheKey}.meta.json`),
+    codeCache: path.join(CACHE_DIR, `${cacheKey}.cache`),
   };
 }
 
@@ -77,29 +136,175 @@ function ensureCacheDir(): void {
   }
 }
 
+function emptyIndex(): CacheIndex {
+  return { coreVersion: TSYNE_CORE_VERSION, entries: {}, files: {}, bundles: {} };
+}
+
+function emptyChanges(): IndexChanges {
+  return { entries: new Map(), files: new Map(), bundles: new Map() };
+}
+
 /**
- * Look up cached transpiled code
- * Returns hit=true with code if found, hit=false otherwise
+ * Read index.json. An index written by another core version is ignored
+ * (its keys can't match anyway).
  */
-export function lookupCache(source: string): CacheResult {
-  const cacheKey = generateCacheKey(source);
-  const { js, meta } = getCachePaths(cacheKey);
-
+function readIndexFile(): CacheIndex {
   try {
-    if (fs.existsSync(js) && fs.existsSync(meta)) {
-      const metadata: CacheMetadata = JSON.parse(fs.readFileSync(meta, 'utf-8'));
+    const parsed = JSON.parse(fs.readFileSync(INDEX_PATH, 'utf-8')) as CacheIndex;
+    return parsed.coreVersion === TSYNE_CORE_VERSION && parsed.entries && parsed.files
+      ? { ...parsed, bundles: parsed.bundles ?? {} }
+      : emptyIndex();
+  } catch {
+    return emptyIndex();
+  }
+}
 
-      // Verify version matches (double-check since it's in the hash)
-      if (metadata.coreVersion === TSYNE_CORE_VERSION) {
-        const code = fs.readFileSync(js, 'utf-8');
-        return { hit: true, code, sourcePath: metadata.sourcePath };
+/**
+ * The cache index, read from disk the first time it is needed
+ */
+function getIndex(): CacheIndex {
+  if (!cacheIndex) {
+    cacheIndex = readIndexFile();
+  }
+  return cacheIndex;
+}
+
+/**
+ * Set (or with null, delete) one index record, here and in the next write
+ */
+function updateIndex<S extends IndexSection>(section: S, key: string, value: CacheIndex[S][string] | null): void {
+  const records = getIndex()[section] as Record<string, CacheIndex[S][string]>;
+  if (value === null) {
+    delete records[key];
+  } else {
+    records[key] = value;
+  }
+  (indexChanges[section] as Map<string, CacheIndex[S][string] | null>).set(key, value);
+}
+
+/**
+ * Write this process's index changes. Another launch may have written the
+ * file since it was loaded, so the changes are replayed onto a fresh read
+ * and the result renamed into place atomically; a concurrent launch never
+ * reads half of it. Inside batchIndexWrites() this waits for the batch.
+ */
+function saveIndex(): void {
+  if (indexBatchDepth > 0) {
+    return;
+  }
+  const changes = indexChanges;
+  if (changes.entries.size + changes.files.size + changes.bundles.size === 0) {
+    return;
+  }
+  try {
+    ensureCacheDir();
+    const merged = readIndexFile();
+    for (const section of ['entries', 'files', 'bundles'] as const) {
+      const records = merged[section] as Record<string, unknown>;
+      for (const [key, value] of changes[section] as Map<string, unknown>) {
+        if (value === null) {
+          delete records[key];
+        } else {
+          records[key] = value;
+        }
       }
     }
+    const tmp = `${INDEX_PATH}.${process.pid}.tmp`;
+    fs.writeFileSync(tmp, JSON.stringify(merged));
+    fs.renameSync(tmp, INDEX_PATH);
+    indexWrites++;
+    cacheIndex = merged;
+    indexChanges = emptyChanges();
+  } catch {
+    // The index is an optimization; the next launch rehashes
+  }
+}
+
+/**
+ * Run fn with index writes held back, then write them once
+ */
+async function batchIndexWrites<T>(fn: () => Promise<T>): Promise<T> {
+  indexBatchDepth++;
+  try {
+    return await fn();
+  } finally {
+    indexBatchDepth--;
+    saveIndex();
+  }
+}
+
+/**
+ * (size, mtime, inode) of a file, or null if it can't be stat'ed
+ */
+function statFingerprint(filePath: string): string | null {
+  try {
+    const stat = fs.statSync(filePath, { bigint: true });
+    return `${stat.size}:${stat.mtimeNs}:${stat.ino}`;
+  } catch {
+    return null;
+  }
+}
+
+/**
+ * Read the compiled code for a cache key, dropping the entry if its file is gone
+ */
+function readEntry(cacheKey: string): CacheResult {
+  const index = getIndex();
+  const entry = index.entries[cacheKey];
+  if (!entry) {
+    return { hit: false };
+  }
+  try {
+    const code = fs.readFileSync(getCachePaths(cacheKey).js, 'utf-8');
+    return { hit: true, code, sourcePath: entry.sourcePath, cacheKey };
   } catch {
-    // Cache miss on any error
+    updateIndex('entries', cacheKey, null);
+    return { hit: false };
   }
+}
 
-  return { hit: false };
+/**
+ * Look up cached transpiled code
+ * Returns hit=true with code if found, hit=false otherwise
+ */
+export function lookupCache(source: string): CacheResult {
+  return readEntry(generateCacheKey(source));
+}
+
+/**
+ * File lookup, also returning what a miss needs to store the result
+ */
+function lookupFile(filePath: string): CacheResult & { source?: string; fingerprint: string | null } {
+  const absPath = path.resolve(filePath);
+  const fingerprint = statFingerprint(absPath);
+  const index = getIndex();
+
+  // Fast path: the file hasn't changed since it was last hashed
+  const known = index.files[absPath];
+  if (fingerprint && known && known.fingerprint === fingerprint) {
+    const result = readEntry(known.cacheKey);
+    if (result.hit) {
+      return { ...result, validatedBy: 'fingerprint', fingerprint };
+    }
+  }
+
+  // Slow path: hash the contents; a hit re-validates the fingerprint
+  const source = fs.readFileSync(absPath, 'utf-8');
+  const result = lookupCache(source);
+  if (result.hit && fingerprint) {
+    updateIndex('files', absPath, { fingerprint, cacheKey: result.cacheKey! });
+    saveIndex();
+  }
+  return { ...result, validatedBy: 'hash', source, fingerprint };
+}
+
+/**
+ * Look up cached transpiled code for a file. When the file's size, mtime
+ * and inode match the last launch, the source is not read or hashed.
+ */
+export function lookupFileCache(filePath: string): CacheResult {
+  const { hit, code, sourcePath, cacheKey, validatedBy } = lookupFile(filePath);
+  return { hit, code, sourcePath, cacheKey, validatedBy };
 }
 
 /**
@@ -112,18 +317,18 @@ export function storeInCache(
 ): string {
   ensureCacheDir();
 
-  const cacheKey = generateCacheKey(source);
-  const { js, meta } = getCachePaths(cacheKey);
-
-  const metadata: CacheMetadata = {
-    sourceHash: crypto.createHash('sha256').update(source).digest('hex'),
-    coreVersion: TSYNE_CORE_VERSION,
-    sourcePath,
-    compiledAt: Date.now(),
-  };
+  const sourceHash = hashSource(source);
+  const cacheKey = cacheKeyFromHash(sourceHash);
+  const { js, codeCache } = getCachePaths(cacheKey);
 
   fs.writeFileSync(js, compiledCode);
-  fs.writeFileSync(meta, JSON.stringify(metadata, null, 2));
+  // A code cache from earlier compiled code no longer matches
+  if (fs.existsSync(codeCache)) {
+    fs.unlinkSync(codeCache);
+  }
+
+  updateIndex('entries', cacheKey, { sourceHash, sourcePath, compiledAt: Date.now() });
+  saveIndex();
 
   return cacheKey;
 }
@@ -169,20 +374,20 @@ export async function transpileTypeScript(
 export async function loadWithCache(
   source: string,
   sourcePath: string = 'app.ts'
-): Promise<{ code: string; cached: boolean }> {
+): Promise<{ code: string; cached: boolean; cacheKey: string }> {
   // Check cache first
   const cacheResult = lookupCache(source);
   if (cacheResult.hit && cacheResult.code) {
-    return { code: cacheResult.code, cached: true };
+    return { code: cacheResult.code, cached: true, cacheKey: cacheResult.cacheKey! };
   }
 
   // Cache miss - transpile
   const code = await transpileTypeScript(source, sourcePath);
 
   // Store in cache for next time
-  storeInCache(source, code, sourcePath);
+  const cacheKey = storeInCache(source, code, sourcePath);
 
-  return { code, cached: false };
+  return { code, cached: false, cacheKey };
 }
 
 /**
@@ -190,9 +395,93 @@ export async function loadWithCache(
  */
 export async function loadFileWithCache(
   filePath: string
-): Promise<{ code: string; cached: boolean }> {
-  const source = fs.readFileSync(filePath, 'utf-8');
-  return loadWithCache(source, filePath);
+): Promise<{ code: string; cached: boolean; cacheKey: string }> {
+  return batchIndexWrites(async () => {
+    const lookup = lookupFile(filePath);
+    if (lookup.hit && lookup.code) {
+      return { code: lookup.code, cached: true, cacheKey: lookup.cacheKey! };
+    }
+
+    const source = lookup.source!;
+    const code = await transpileTypeScript(source, filePath);
+    const cacheKey = storeInCache(source, code, filePath);
+    if (lookup.fingerprint) {
+      // Stat'ed before the read: if the file changed in between, the next
+      // launch sees a different fingerprint and rehashes
+      updateIndex('files', path.resolve(filePath), { fingerprint: lookup.fingerprint, cacheKey });
+    }
+    return { code, cached: false, cacheKey };
+  });
+}
+
+// Parameters of the function each module's code runs in
+const MODULE_PARAMS = ['exports', 'require', 'module', '__filename', '__dirname'];
+
+/**
+ * Imports of tsyne core by relative path (apps in examples/ or ported-apps/*)
+ */
+function isCoreImport(id: string): boolean {
+  return id.startsWith('../core/src') || id.startsWith('../../core/src');
+}
+
+/**
+ * Build the require function an app module sees: tsyne core, then
+ * relative paths from the module's directory, then Node's require
+ */
+function createAppRequire(appDir: string): (id: string) => any {
+  return (id: string): any => {
+    // Handle tsyne core imports
+    if (id === 'tsyne') {
+      return require(path.resolve(__dirname, 'index'));
+    }
+    if (isCoreImport(id)) {
+      // Resolve relative to tsyne core
+      const resolved = path.resolve(__dirname, '..', id.replace(/\.\.\/core\/src/g, 'src').replace('../', ''));
+      return require(resolved);
+    }
+    // Handle relative imports - resolve relative to the app's directory
+    if (id.startsWith('./') || id.startsWith('../')) {
+      const resolved = path.resolve(appDir, id);
+      return require(resolved);
+    }
+    // Allow node built-ins and installed packages
+    return require(id);
+  };
+}
+
+/**
+ * Compile source with V8 code cache data from codeCachePath when present.
+ * Call saveCodeCache() after running the script: it writes fresh data when
+ * there was none or V8 rejected it (another V8 version or different flags).
+ */
+function compileWithCodeCache(
+  source: string,
+  filename: string,
+  codeCachePath?: string
+): { script: vm.Script; saveCodeCache: () => void } {
+  let cachedData: Buffer | undefined;
+  if (codeCachePath) {
+    try {
+      cachedData = fs.readFileSync(codeCachePath);
+    } catch {
+      // No code cache yet
+    }
+  }
+
+  const script = new vm.Script(source, { filename, cachedData });
+  return {
+    script,
+    saveCodeCache: () => {
+      if (codeCachePath && (!cachedData || script.cachedDataRejected)) {
+        try {
+          ensureCacheDir();
+          fs.writeFileSync(codeCachePath, script.createCachedData());
+        } catch {
+          // The code cache is an optimization only
+        }
+      }
+    },
+  };
 }
 
 /**
@@ -202,11 +491,13 @@ export async function loadFileWithCache(
  * @param code - The transpiled JavaScript code to execute
  * @param sourcePath - Path to the original source file (for __dirname resolution)
  * @param contextOverrides - Additional context variables to inject
+ * @param cacheKey - Cache entry the code came from; enables the V8 code cache
  */
 export function executeCompiledCode(
   code: string,
   sourcePath: string = 'app.ts',
-  contextOverrides: Record<string, any> = {}
+  contextOverrides: Record<string, any> = {},
+  cacheKey?: string
 ): Record<string, any> {
   // Create module context
   const moduleExports: Record<string, any> = {};
@@ -216,50 +507,230 @@ export function executeCompiledCode(
   const appDir = path.dirname(path.resolve(sourcePath));
   const appFilename = path.resolve(sourcePath);
 
-  // Build require function that delegates to Node's require
-  // Apps can only require allowed modules
-  const requireFn = (id: string): any => {
-    // Handle tsyne core imports
-    if (id === 'tsyne') {
-      return require(path.resolve(__dirname, 'index'));
-    }
-    if (id.startsWith('../core/src') || id.startsWith('../../core/src')) {
-      // Resolve relative to tsyne core (for apps in examples/ or ported-apps/*)
-      const resolved = path.resolve(__dirname, '..', id.replace(/\.\.\/core\/src/g, 'src').replace('../', ''));
-      return require(resolved);
-    }
-    // Handle relative imports - resolve relative to the app's directory
-    if (id.startsWith('./') || id.startsWith('../')) {
-      const resolved = path.resolve(appDir, id);
-      return require(resolved);
-    }
-    // Allow node built-ins and installed packages
-    return require(id);
-  };
+  // Execute in function context, the same way Node wraps CommonJS modules
+  const params = [...MODULE_PARAMS, ...Object.keys(contextOverrides)];
+  const wrapper = `(function (${params.join(', ')}) {\n${code}\n})`;
 
-  // Execute in function context
-  const fn = new Function(
-    'exports',
-    'require',
-    'module',
-    '__filename',
-    '__dirname',
-    ...Object.keys(contextOverrides),
-    code
-  );
+  const codeCachePath = cacheKey ? getCachePaths(cacheKey).codeCache : undefined;
+  const compiled = compileWithCodeCache(wrapper, appFilename, codeCachePath);
+  const fn = compiled.script.runInThisContext() as (...args: any[]) => void;
 
   fn(
     moduleExports,
-    requireFn,
+    createAppRequire(appDir),
     moduleObj,
     appFilename,
     appDir,
     ...Object.values(contextOverrides)
   );
 
+  // Create the code cache after the top-level run, so functions compiled
+  // during startup are in it too
+  compiled.saveCodeCache();
+
   return moduleObj.exports;
 }
 
+// ============================================================================
+// Whole-app bundles
+// ============================================================================
+//
+// A multi-file app would otherwise resolve and transpile each relative import
+// on first use, one after another. precompileApp() walks the import graph up
+// front (one graph level at a time, each level transpiled in parallel) and
+// writes every module into one bundle file with one V8 code cache. The index
+// records the modules' stat fingerprints, so a warm launch stats the files
+// and loads the bundle without reading any module.
+//
+// Only modules under the entry's own directory are bundled. Anything a
+// relative import reaches outside it (phone-apps/services.ts, ported-apps,
+// a built core) is shared with the host, so it is left to Node's require and
+// the app gets the same instance the host has. For the same reason a bundled
+// module the host has already loaded is taken from require.cache.
+
+/** Module files the graph walker transpiles; anything else is required at runtime */
+const BUNDLE_EXTENSIONS = ['.ts', '.tsx', '.js'];
+
+/**
+ * Result of precompileApp
+ */
+export interface PrecompileResult {
+  bundleKey: string;
+  /** Absolute paths of the modules in the bundle, entry first */
+  modules: string[];
+  /** Whether the bundle was reused without walking the graph */
+  cached: boolean;
+}
+
+/**
+ * Resolve a relative import the way Node would for app sources, or null when
+ * it isn't a module the bundle can hold
+ */
+function resolveModuleFile(target: string): string | null {
+  const candidates = [target, ...BUNDLE_EXTENSIONS.map(ext => target + ext),
+    ...BUNDLE_EXTENSIONS.map(ext => path.join(target, 'index' + ext))];
+  for (const candidate of candidates) {
+    if (!BUNDLE_EXTENSIONS.includes(path.extname(candidate))) continue;
+    try {
+      if (fs.statSync(candidate).isFile()) return candidate;
+    } catch {
+      // Try the next candidate
+    }
+  }
+  return null;
+}
+
+/**
+ * Whether file is under the app directory root and so belongs in its bundle
+ */
+function isAppModule(root: string, file: string): boolean {
+  const relative = path.relative(root, file);
+  return relative !== '' && !relative.startsWith('..') && !path.isAbsolute(relative);
+}
+
+/**
+ * Relative module ids required by transpiled (CommonJS) code
+ */
+function relativeRequires(code: string): string[] {
+  const ids: string[] = [];
+  const pattern = /\brequire\(\s*["']([^"']+)["']\s*\)/g;
+  let match: RegExpExecArray | null;
+  while ((match = pattern.exec(code)) !== null) {
+    const id = match[1];
+    if ((id.startsWith('./') || id.startsWith('../')) && !isCoreImport(id)) {
+      ids.push(id);
+    }
+  }
+  return ids;
+}
+
+function getBundlePaths(bundleKey: string): { js: string; codeCache: string } {
+  return {
+    js: path.join(CACHE_DIR, `bundle-${bundleKey}.js`),
+    codeCache: path.join(CACHE_DIR, `bundle-${bundleKey}.cache`),
+  };
+}
+
+/**
+ * Transpile an app and everything it imports by relative path from its own
+ * directory into one cached bundle. contextNames are the context variables
+ * the app will be executed with (they become parameters of every module
+ * function).
+ */
+export async function precompileApp(
+  entryPath: string,
+  contextNames: string[] = []
+): Promise<PrecompileResult> {
+  // One index write for the whole graph instead of one or two per module
+  return batchIndexWrites(() => buildApp(entryPath, contextNames));
+}
+
+async function buildApp(entryPath: string, contextNames: string[]): Promise<PrecompileResult> {
+  const entry = path.resolve(entryPath);
+  const root = path.dirname(entry);
+  const index = getIndex();
+
+  // Warm path: every module is unchanged since the bundle was built
+  const manifest = index.bundles[entry];
+  if (manifest && manifest.contextNames.join(',') === contextNames.join(',') &&
+      Object.entries(manifest.modules).every(([file, fingerprint]) => statFingerprint(file) === fingerprint) &&
+      fs.existsSync(getBundlePaths(manifest.bundleKey).js)) {
+    return { bundleKey: manifest.bundleKey, modules: Object.keys(manifest.modules), cached: true };
+  }
+
+  // Walk the graph breadth-first, transpiling each level in parallel
+  const modules = new Map<string, { code: string; cacheKey: string }>();
+  let level = [entry];
+  const queued = new Set(level);
+  while (level.length > 0) {
+    const loaded = await Promise.all(level.map(file => loadFileWithCache(file)));
+    const next: string[] = [];
+    level.forEach((file, i) => {
+      modules.set(file, { code: loaded[i].code, cacheKey: loaded[i].cacheKey });
+      for (const id of relativeRequires(loaded[i].code)) {
+        const resolved = resolveModuleFile(path.resolve(path.dirname(file), id));
+        if (resolved && isAppModule(root, resolved) && !queued.has(resolved)) {
+          queued.add(resolved);
+          next.push(resolved);
+        }
+      }
+    });
+    level = next;
+  }
+
+  // The bundle key covers every module's content, so it changes with the app version
+  const files = [...modules.keys()];
+  const keySource = [TSYNE_CORE_VERSION, contextNames.join(','),
+    ...files.map(file => `${file}:${modules.get(file)!.cacheKey}`).sort()].join('\n');
+  const bundleKey = crypto.createHash('sha256').update(keySource).digest('hex').slice(0, 16);
+
+  const { js } = getBundlePaths(bundleKey);
+  if (!fs.existsSync(js)) {
+    const params = [...MODULE_PARAMS, ...contextNames].join(', ');
+    const parts = files.map(file =>
+      `${JSON.stringify(file)}: function (${params}) {\n${modules.get(file)!.code}\n}`);
+    ensureCacheDir();
+    fs.writeFileSync(js, `({\n${parts.join(',\n')}\n})`);
+  }
+
+  const fingerprints: Record<string, string> = {};
+  for (const file of files) {
+    const fingerprint = getIndex().files[file]?.fingerprint;
+    if (fingerprint) fingerprints[file] = fingerprint;
+  }
+  if (Object.keys(fingerprints).length === files.length) {
+    updateIndex('bundles', entry, { bundleKey, contextNames, modules: fingerprints });
+  }
+
+  return { bundleKey, modules: files, cached: false };
+}
+
+/**
+ * Run a bundle written by precompileApp and return the entry's exports.
+ * Relative imports between bundled modules never touch the filesystem.
+ */
+export function executeBundle(
+  bundleKey: string,
+  entryPath: string,
+  contextOverrides: Record<string, any> = {}
+): Record<string, any> {
+  const { js, codeCache } = getBundlePaths(bundleKey);
+  const compiled = compileWithCodeCache(fs.readFileSync(js, 'utf-8'), js, codeCache);
+  const factories = compiled.script.runInThisContext() as Record<string, (...args: any[]) => void>;
+  const contextValues = Object.values(contextOverrides);
+  const instances = new Map<string, { exports: any }>();
+  const root = path.dirname(path.resolve(entryPath));
+
+  const load = (file: string): any => {
+    const existing = instances.get(file);
+    if (existing) {
+      // Cycles see the partially initialized exports, as in Node
+      return existing.exports;
+    }
+    const moduleObj = { exports: {} as any };
+    instances.set(file, moduleObj);
+
+    const dir = path.dirname(file);
+    const fallback = createAppRequire(dir);
+    const requireFn = (id: string): any => {
+      if ((id.startsWith('./') || id.startsWith('../')) && !isCoreImport(id)) {
+        const resolved = resolveModuleFile(path.resolve(dir, id));
+        if (resolved && factories[resolved] && isAppModule(root, resolved) && !require.cache[resolved]) {
+          return load(resolved);
+        }
+      }
+      return fallback(id);
+    };
+
+    factories[file](moduleObj.exports, requireFn, moduleObj, file, dir, ...contextValues);
+    return moduleObj.exports;
+  };
+
+  const exports = load(path.resolve(entryPath));
+  compiled.saveCodeCache();
+  return exports;
+}
+
 /**
  * High-level: Load and execute a TypeScript app with caching
  *
@@ -271,20 +742,22 @@ export async function loadAndExecuteApp(
   sourcePath: string = 'app.ts',
   contextOverrides: Record<string, any> = {}
 ): Promise<{ exports: Record<string, any>; cached: boolean }> {
-  const { code, cached } = await loadWithCache(source, sourcePath);
-  const exports = executeCompiledCode(code, sourcePath, contextOverrides);
+  const { code, cached, cacheKey } = await loadWithCache(source, sourcePath);
+  const exports = executeCompiledCode(code, sourcePath, contextOverrides, cacheKey);
   return { exports, cached };
 }
 
 /**
- * Load and execute a TypeScript file with caching
+ * Load and execute a TypeScript file with caching, bundled with the modules
+ * it imports by relative path from its own directory (see precompileApp)
  */
 export async function loadAndExecuteFile(
   filePath: string,
   contextOverrides: Record<string, any> = {}
 ): Promise<{ exports: Record<string, any>; cached: boolean }> {
-  const source = fs.readFileSync(filePath, 'utf-8');
-  return loadAndExecuteApp(source, filePath, contextOverrides);
+  const { bundleKey, cached } = await precompileApp(filePath, Object.keys(contextOverrides));
+  const exports = executeBundle(bundleKey, filePath, contextOverrides);
+  return { exports, cached };
 }
 
 /**
@@ -299,11 +772,18 @@ export function clearCache(): number {
   let count = 0;
 
   for (const file of files) {
-    if (file.endsWith('.js') || file.endsWith('.meta.json')) {
+    // .meta.json: per-entry metadata from before the index
+    // bundle-*.js and bundle-*.cache: whole-app bundles
+    if (file.endsWith('.js') || file.endsWith('.meta.json') || file.endsWith('.cache')) {
       fs.unlinkSync(path.join(CACHE_DIR, file));
       count++;
     }
   }
+  if (fs.existsSync(INDEX_PATH)) {
+    fs.unlinkSync(INDEX_PATH);
+  }
+  cacheIndex = emptyIndex();
+  indexChanges = emptyChanges();
 
   return count;
 }
@@ -315,10 +795,16 @@ export function getCacheStats(): {
   cacheDir: string;
   fileCount: number;
   totalSize: number;
+  codeCacheCount: number;
+  codeCacheSize: number;
+  /** Times this process has written index.json */
+  indexWrites: number;
   coreVersion: string;
 } {
   let fileCount = 0;
   let totalSize = 0;
+  let codeCacheCount = 0;
+  let codeCacheSize = 0;
 
   if (fs.existsSync(CACHE_DIR)) {
     const files = fs.readdirSync(CACHE_DIR);
@@ -326,6 +812,9 @@ export function getCacheStats(): {
       if (file.endsWith('.js')) {
         fileCount++;
         totalSize += fs.statSync(path.join(CACHE_DIR, file)).size;
+      } else if (file.endsWith('.cache')) {
+        codeCacheCount++;
+        codeCacheSize += fs.statSync(path.join(CACHE_DIR, file)).size;
       }
     }
   }
@@ -334,6 +823,9 @@ export function getCacheStats(): {
     cacheDir: CACHE_DIR,
     fileCount,
     totalSize,
+    codeCacheCount,
+    codeCacheSize,
+    indexWrites,
     coreVersion: TSYNE_CORE_VERSION,
   };
 }
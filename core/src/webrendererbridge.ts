@@ -168,6 +168,11 @@ export class WebRendererBridge implements BridgeInterface {
     }
   }
 
+  getEventHandler(_eventType: string): ((data: unknown) => void) | undefined {
+    // on() adds to a set rather than replacing, so nothing needs restoring
+    return undefined;
+  }
+
   async registerCustomId(widgetId: string, customId: string): Promise<unknown> {
     return this.send('registerCustomId', { widgetId, customId });
   }
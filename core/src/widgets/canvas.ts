@@ -2622,3 +2622,255 @@ export class CanvasGauge {
     return this._value;
   }
 }
+
+/**
+ * Emitter parameters for CanvasParticles. Every field is optional on update.
+ */
+export interface ParticleEmitterOptions {
+  x?: number;            // Emitter position in canvas pixels
+  y?: number;
+  rate?: number;         // Particles per second (0 = bursts only)
+  angle?: number;        // Emission direction in radians (default: up)
+  spread?: number;       // Width of the emission cone in radians
+  speedMin?: number;     // px/s
+  speedMax?: number;     // px/s
+  lifeMin?: number;      // ms
+  lifeMax?: number;      // ms
+  radius?: number;       // Sets radiusStart and radiusEnd
+  radiusStart?: number;
+  radiusEnd?: number;
+  gravityX?: number;     // px/s^2
+  gravityY?: number;     // px/s^2
+  friction?: number;     // Velocity multiplier per 1/60 s (1 = none)
+  colors?: string[];     // Color ramp over each particle's life (#RRGGBB or #RRGGBBAA)
+}
+
+export interface CanvasParticlesOptions {
+  width: number;
+  height: number;
+  background?: string;   // Default: opaque black
+  fps?: number;          // Simulation rate (default: 60)
+  maxParticles?: number; // Default: 20000
+  running?: boolean;     // Start simulating immediately (default: true)
+  emitter?: ParticleEmitterOptions;
+}
+
+/**
+ * Canvas Particles - a particle system simulated and rendered in the bridge
+ * Particles never cross IPC: only emitter changes and bursts are sent, so
+ * effects such as fireworks cost no per-frame traffic.
+ */
+export class CanvasParticles {
+  private ctx: Context;
+  public id: string;
+
+  constructor(ctx: Context, options: CanvasParticlesOptions) {
+    this.ctx = ctx;
+    this.id = ctx.generateId('canvasparticles');
+
+    const payload: any = {
+      id: this.id,
+      width: options.width,
+      height: options.height,
+    };
+
+    if (options.background) payload.background = options.background;
+    if (options.fps !== undefined) payload.fps = options.fps;
+    if (options.maxParticles !== undefined) payload.maxParticles = options.maxParticles;
+    if (options.running !== undefined) payload.running = options.running;
+    if (options.emitter) payload.emitter = options.emitter;
+
+    ctx.bridge.send('createCanvasParticles', payload);
+    ctx.addToCurrentContainer(this.id);
+  }
+
+  /**
+   * Change emitter parameters; fields left out keep their current values
+   */
+  async setEmitter(emitter: ParticleEmitterOptions): Promise<void> {
+    await this.ctx.bridge.send('updateCanvasParticles', {
+      widgetId: this.id,
+      emitter,
+    });
+  }
+
+  /**
+   * Spawn particles at once, at the emitter or at the given position
+   */
+  async burst(count: number, x?: number, y?: number): Promise<void> {
+    await this.bursts([{ count, x, y }]);
+  }
+
+  /**
+   * Spawn several bursts in one message
+   */
+  async bursts(bursts: Array<{ count: number; x?: number; y?: number }>): Promise<void> {
+    await this.ctx.bridge.send('updateCanvasParticles', {
+      widgetId: this.id,
+      bursts,
+    });
+  }
+
+  async start(): Promise<void> {
+    await this.ctx.bridge.send('updateCanvasParticles', { widgetId: this.id, running: true });
+  }
+
+  /**
+   * Pause the simulation; the last frame stays on screen
+   */
+  async stop(): Promise<void> {
+    await this.ctx.bridge.send('updateCanvasParticles', { widgetId: this.id, running: false });
+  }
+
+  async clear(): Promise<void> {
+    await this.ctx.bridge.send('updateCanvasParticles', { widgetId: this.id, clear: true });
+  }
+
+  async getParticleCount(): Promise<number> {
+    const result = await this.ctx.bridge.send('getCanvasParticlesInfo', { widgetId: this.id }) as { count: number };
+    return result.count;
+  }
+}
+
+export interface CanvasTileMapOptions {
+  width: number;
+  height: number;
+  center?: { lng: number; lat: number };
+  zoom?: number;
+  tileSize?: number;     // Source tile size in pixels (default: 256)
+  maxTiles?: number;     // Decoded tiles kept in the bridge, never fewer than the view needs (default: 128)
+  background?: string;   // Shown where no tile is available
+}
+
+/**
+ * An encoded tile for CanvasTileMap
+ */
+export interface CanvasTileMapTile {
+  z: number;
+  x: number;
+  y: number;
+  data: Uint8Array | ArrayBuffer;  // PNG or JPEG bytes
+}
+
+/**
+ * Geometry drawn over a CanvasTileMap, projected and clipped in the bridge
+ */
+export interface CanvasTileMapOverlay {
+  kind: 'line' | 'polygon' | 'points';
+  coordinates: Float64Array;  // Interleaved lng, lat pairs
+  color?: string;             // Hex color, with optional alpha
+  width?: number;             // Line width in pixels (line, polygon)
+  radius?: number;            // Point radius in pixels (points)
+}
+
+/**
+ * Canvas Tile Map - map tiles decoded, cached and composited in the bridge
+ * Each tile is sent once as encoded bytes keyed by z/x/y; panning and zooming
+ * only send the new viewport. Calls that change the view resolve to the
+ * visible tiles ("z/x/y") the bridge doesn't have yet.
+ */
+export class CanvasTileMap {
+  private ctx: Context;
+  public id: string;
+  private created: Promise<string[]>;
+
+  constructor(ctx: Context, options: CanvasTileMapOptions) {
+    this.ctx = ctx;
+    this.id = ctx.generateId('canvastilemap');
+
+    const payload: any = {
+      id: this.id,
+      width: options.width,
+      height: options.height,
+      lng: options.center?.lng ?? 0,
+      lat: options.center?.lat ?? 0,
+      zoom: options.zoom ?? 0,
+    };
+
+    if (options.tileSize !== undefined) payload.tileSize = options.tileSize;
+    if (options.maxTiles !== undefined) payload.maxTiles = options.maxTiles;
+    if (options.background) payload.background = options.background;
+
+    this.created = Promise.resolve(ctx.bridge.send('createCanvasTileMap', payload))
+      .then((result: any) => result?.missing ?? []);
+    ctx.addToCurrentContainer(this.id);
+  }
+
+  /**
+   * Tiles missing for the initial viewport
+   */
+  async getInitialMissingTiles(): Promise<string[]> {
+    return this.created;
+  }
+
+  /**
+   * Move the map; the bridge recomposites from its tile cache
+   */
+  async setViewport(
+    center: { lng: number; lat: number },
+    zoom: number,
+    size?: { width: number; height: number }
+  ): Promise<string[]> {
+    const result = await this.ctx.bridge.send('setCanvasTileMapViewport', {
+      widgetId: this.id,
+      lng: center.lng,
+      lat: center.lat,
+      zoom,
+      ...size,
+    }) as { missing?: string[] };
+    return result?.missing ?? [];
+  }
+
+  /**
+   * Upload encoded tiles in one message
+   */
+  async putTiles(tiles: CanvasTileMapTile[]): Promise<string[]> {
+    const result = await this.ctx.bridge.send('putCanvasTileMapTiles', {
+      widgetId: this.id,
+      tiles: tiles.map(tile => ({
+        z: tile.z,
+        x: tile.x,
+        y: tile.y,
+        data: Buffer.from(tile.data instanceof ArrayBuffer ? new Uint8Array(tile.data) : tile.data)
+          .toString('base64'),
+      })),
+    }) as { missing?: string[] };
+    return result?.missing ?? [];
+  }
+
+  /**
+   * Drop every cached tile in the bridge
+   */
+  async clearTiles(): Promise<void> {
+    await this.ctx.bridge.send('putCanvasTileMapTiles', { widgetId: this.id, clear: true });
+  }
+
+  /**
+   * Add or replace a geometry overlay. The coordinates are sent once; the
+   * bridge re-projects them natively on every pan and zoom.
+   */
+  async setOverlay(overlayId: string, overlay: CanvasTileMapOverlay): Promise<void> {
+    const coords = overlay.coordinates;
+    const payload: any = {
+      widgetId: this.id,
+      overlayId,
+      kind: overlay.kind,
+      // Float64Array bytes are little-endian on every supported platform
+      coordinates: Buffer.from(coords.buffer, coords.byteOffset, coords.byteLength).toString('base64'),
+    };
+    if (overlay.color) payload.color = overlay.color;
+    if (overlay.width !== undefined) payload.width = overlay.width;
+    if (overlay.radius !== undefined) payload.radius = overlay.radius;
+    await this.ctx.bridge.send('setCanvasTileMapOverlay', payload);
+  }
+
+  async removeOverlay(overlayId: string): Promise<void> {
+    await this.ctx.bridge.send('removeCanvasTileMapOverlay', { widgetId: this.id, overlayId });
+  }
+
+  async getInfo(): Promise<{ tiles: number; bytes: number; missing: string[] }> {
+    return await this.ctx.bridge.send('getCanvasTileMapInfo', { widgetId: this.id }) as {
+      tiles: number; bytes: number; missing: string[];
+    };
+  }
+}
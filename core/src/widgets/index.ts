@@ -121,6 +121,13 @@ export {
   CanvasEllipseOptions,
   CanvasGauge,
   CanvasGaugeOptions,
+  CanvasParticles,
+  CanvasParticlesOptions,
+  ParticleEmitterOptions,
+  CanvasTileMap,
+  CanvasTileMapOptions,
+  CanvasTileMapTile,
+  CanvasTileMapOverlay,
   TappableCanvasRaster,
   TappableCanvasRasterOptions
 } from './canvas';
@@ -1,15 +1,13 @@
 /**
- * Animation manager using requestAnimationFrame
+ * Animation manager driven by the shared frame scheduler
  *
- * Coordinates all active animations and triggers refresh on each frame.
- * Instantiate per-context rather than using as a singleton.
+ * Coordinates all active animations and requests a refresh after each frame.
+ * Instantiate per-context rather than using as a singleton; the frame
+ * scheduler underneath is shared so all managers tick together.
  */
 
 import { Animation, AnimationControl } from './animation';
-
-// Browser globals (not available in Node.js)
-declare const requestAnimationFrame: ((callback: () => void) => number) | undefined;
-declare const cancelAnimationFrame: ((id: number) => void) | undefined;
+import { FrameScheduler, getFrameScheduler } from './frame-scheduler';
 
 /**
  * Tracks an animation with its target object and property
@@ -26,13 +24,17 @@ interface AnimationTracker {
  */
 export class AnimationManager {
   private animations: Set<AnimationTracker> = new Set();
-  private rafId: number | null = null;
-  private lastFrameTime: number = 0;
+  private scheduler: FrameScheduler;
+  private unsubscribe: (() => void) | null = null;
   private refreshCallback?: () => void;
   private isRunning: boolean = false;
 
+  constructor(scheduler?: FrameScheduler) {
+    this.scheduler = scheduler ?? getFrameScheduler();
+  }
+
   /**
-   * Register refresh callback (called after each animation frame)
+   * Register refresh callback (flushed once at the end of each frame tick)
    */
   setRefreshCallback(callback: () => void): void {
     this.refreshCallback = callback;
@@ -89,80 +91,51 @@ export class AnimationManager {
     if (this.isRunning) return;
 
     this.isRunning = true;
-    this.lastFrameTime = Date.now();
-    this.scheduleFrame();
+    this.unsubscribe = this.scheduler.subscribe(this.frame);
   }
 
   /**
    * Stop animation loop
    */
   private stop(): void {
-    if (this.rafId !== null) {
-      // Use cancelAnimationFrame if available (browser), clearTimeout otherwise (Node.js)
-      if (typeof cancelAnimationFrame !== 'undefined') {
-        cancelAnimationFrame(this.rafId);
-      } else {
-        clearTimeout(this.rafId);
-      }
-      this.rafId = null;
+    if (this.unsubscribe) {
+      this.unsubscribe();
+      this.unsubscribe = null;
     }
     this.isRunning = false;
   }
 
   /**
-   * Schedule next animation frame
+   * Advance every animation by one frame
    */
-  private scheduleFrame(): void {
-    // Use requestAnimationFrame if available (browser), setTimeout otherwise (Node.js)
-    const scheduleCallback = (callback: () => void): number => {
-      if (typeof requestAnimationFrame !== 'undefined') {
-        return requestAnimationFrame(callback);
-      } else {
-        // ~60fps fallback for Node.js
-        const timer = setTimeout(callback, 16);
-        // Don't keep process alive for animation timers
-        if (typeof timer === 'object' && timer !== null && 'unref' in timer) {
-          (timer as NodeJS.Timeout).unref();
-        }
-        return timer as unknown as number;
-      }
-    };
-
-    this.rafId = scheduleCallback(() => {
-      const now = Date.now();
-      const deltaMs = now - this.lastFrameTime;
-      this.lastFrameTime = now;
-
-      // Update all animations
-      const completedAnimations: AnimationTracker[] = [];
+  private frame = (deltaMs: number): void => {
+    // Update all animations
+    const completedAnimations: AnimationTracker[] = [];
 
-      for (const tracker of this.animations) {
-        const { value, complete } = tracker.animation.update(deltaMs);
-        tracker.target[tracker.property] = value;
+    for (const tracker of this.animations) {
+      const { value, complete } = tracker.animation.update(deltaMs);
+      tracker.target[tracker.property] = value;
 
-        if (complete) {
-          completedAnimations.push(tracker);
-        }
+      if (complete) {
+        completedAnimations.push(tracker);
       }
+    }
 
-      // Remove completed animations
-      for (const tracker of completedAnimations) {
-        this.animations.delete(tracker);
-      }
+    // Remove completed animations
+    for (const tracker of completedAnimations) {
+      this.animations.delete(tracker);
+    }
 
-      // Trigger refresh callback
-      if (this.refreshCallback) {
-        this.refreshCallback();
-      }
+    // Refresh once per tick, however many systems ask for it
+    if (this.refreshCallback) {
+      this.scheduler.requestFlush(this.refreshCallback);
+    }
 
-      // Continue loop if there are active animations
-      if (this.animations.size > 0) {
-        this.scheduleFrame();
-      } else {
-        this.stop();
-      }
-    });
-  }
+    // Stop ticking once nothing is left to animate
+    if (this.animations.size === 0) {
+      this.stop();
+    }
+  };
 
   /**
    * Get number of active animations
@@ -25,6 +25,7 @@ import { CirclesCollection, RectsCollection, LinesCollection } from './collectio
 import { TransformStack, TransformOptions } from './transforms';
 import { ForeignObject, ForeignObjectCollection } from './foreign';
 import { AnimationManager } from './animation-manager';
+import { getFrameScheduler } from './frame-scheduler';
 import { MarkerConfig, isCustomMarker, BuiltInMarkerType, CustomMarker } from './markers';
 
 /**
@@ -1118,31 +1119,20 @@ export function registerCosyneContext(context: CosyneContext): void {
  * Note: This only updates existing primitives. Use rebuildAllCosyneContexts()
  * if you need to create different primitives based on new state.
  */
-let refreshPending = false;
-let lastRefreshTime = 0;
-
 export function refreshAllCosyneContexts(): void {
-  // Throttle: skip if refresh is pending or was done very recently
-  const now = performance.now();
-  if (refreshPending || (now - lastRefreshTime) < 16) { // ~60fps max
-    return;
-  }
-
-  refreshPending = true;
-  lastRefreshTime = now;
+  // Coalesced into one flush at the end of the current (or next) frame tick
+  getFrameScheduler().requestFlush(flushCosyneContexts);
+}
 
-  // Use requestAnimationFrame-style scheduling via setImmediate/setTimeout
-  setTimeout(() => {
-    const start = performance.now();
-    for (const context of contextRegistry) {
-      context.refreshBindings();
-    }
-    const elapsed = performance.now() - start;
-    if (elapsed > 10) {
-      console.log(`[refreshAllCosyneContexts] took ${elapsed.toFixed(1)}ms`);
-    }
-    refreshPending = false;
-  }, 0);
+function flushCosyneContexts(): void {
+  const start = performance.now();
+  for (const context of contextRegistry) {
+    context.refreshBindings();
+  }
+  const elapsed = performance.now() - start;
+  if (elapsed > 10) {
+    console.log(`[refreshAllCosyneContexts] took ${elapsed.toFixed(1)}ms`);
+  }
 }
 
 /**
@@ -24,6 +24,7 @@ import { Light, LightOptions, createLight, LightManager } from './light';
 import { Vector3, Ray, Quaternion } from './math3d';
 import { MaterialProperties } from './material';
 import { renderer3d, Renderer3D } from './renderer3d';
+import { SceneBVH, CullingStats } from './scene-bvh';
 
 /**
  * Options for creating a Cosyne3dContext
@@ -37,6 +38,8 @@ export interface Cosyne3dContextOptions {
   backgroundColor?: string;
   /** Enable antialiasing (for renderer) */
   antialias?: boolean;
+  /** Drop primitives hidden behind large opaque ones (default: false) */
+  occlusionCulling?: boolean;
 }
 
 /**
@@ -83,6 +86,12 @@ export class Cosyne3dContext {
   private allPrimitives: Primitive3D[] = [];
   private primitivesById: Map<string, Primitive3D> = new Map();
   private bindingRegistry: BindingRegistry = new BindingRegistry();
+
+  // Culling: BVH over world bounds, rebuilt when primitivesVersion changes
+  private primitivesVersion: number = 0;
+  private sceneBvh: SceneBVH = new SceneBVH();
+  private occlusionCulling: boolean = false;
+  private renderablePrimitives: Primitive3D[] = [];
   private lightManager: LightManager = new LightManager();
   private camera: Camera;
 
@@ -110,6 +119,7 @@ export class Cosyne3dContext {
       if (options.height) this.height = options.height;
       if (options.backgroundColor) this.backgroundColor = options.backgroundColor;
       if (options.antialias !== undefined) this.antialias = options.antialias;
+      if (options.occlusionCulling !== undefined) this.occlusionCulling = options.occlusionCulling;
     }
 
     // Create default camera
@@ -164,6 +174,7 @@ export class Cosyne3dContext {
 
     // Clear existing primitives
     this.allPrimitives = [];
+    this.primitivesVersion++;
     this.primitivesById.clear();
     this.bindingRegistry.clear();
 
@@ -381,6 +392,7 @@ export class Cosyne3dContext {
   private trackPrimitive(primitive: Primitive3D): void {
     primitive.setSceneId(this.sceneId);
     this.allPrimitives.push(primitive);
+    this.primitivesVersion++;
 
     const id = primitive.getId();
     if (id) {
@@ -392,6 +404,7 @@ export class Cosyne3dContext {
     const index = this.allPrimitives.indexOf(primitive);
     if (index !== -1) {
       this.allPrimitives.splice(index, 1);
+      this.primitivesVersion++;
     }
 
     const id = primitive.getId();
@@ -423,6 +436,33 @@ export class Cosyne3dContext {
     return this.allPrimitives.filter(p => p.visible);
   }
 
+  /**
+   * Get the primitives a renderer needs to draw this frame: visible ones
+   * whose world bounds intersect the camera frustum (and, with occlusion
+   * culling on, are not hidden behind large opaque primitives).
+   * The returned array is reused by the next call.
+   */
+  getRenderablePrimitives(): readonly Primitive3D[] {
+    this.sceneBvh.sync(this.allPrimitives, this.primitivesVersion);
+    this.sceneBvh.cull(this.camera, this.renderablePrimitives, this.occlusionCulling);
+    return this.renderablePrimitives;
+  }
+
+  /**
+   * Enable or disable coarse occlusion culling
+   */
+  setOcclusionCulling(enabled: boolean): this {
+    this.occlusionCulling = enabled;
+    return this;
+  }
+
+  /**
+   * Culling counters from the last getRenderablePrimitives() call
+   */
+  getCullingStats(): CullingStats {
+    return this.sceneBvh.getStats();
+  }
+
   /**
    * Get scene statistics
    */
@@ -561,6 +601,22 @@ export class Cosyne3dContext {
     renderer3d.render(this, app);
   }
 
+  /**
+   * Update the widgets from the last render() in place; only primitives that
+   * changed (or everything, after a camera or light change) send bridge
+   * updates. Returns false if the scene must be rendered again from scratch.
+   *
+   * @example
+   * ```typescript
+   * if (!scene.update()) {
+   *   rebuildCanvas(); // clears the canvasStack and calls scene.render(a)
+   * }
+   * ```
+   */
+  update(): boolean {
+    return renderer3d.update(this);
+  }
+
   /**
    * Get the renderer instance (for advanced usage)
    */
@@ -578,6 +634,8 @@ export class Cosyne3dContext {
       primitive.dispose();
     }
     this.allPrimitives = [];
+    this.primitivesVersion++;
+    this.renderablePrimitives.length = 0;
     this.primitivesById.clear();
     this.bindingRegistry.clear();
     this.lightManager.clear();
@@ -0,0 +1,228 @@
+/**
+ * Central frame scheduler
+ *
+ * One timer drives every subscribed system (particle systems, animation
+ * managers, anything else that ticks) so they advance in the same wakeup
+ * instead of each running its own setTimeout loop. Time comes from
+ * performance.now(), wakeups are scheduled against absolute deadlines so the
+ * frame rate doesn't drift, and fixed-step subscribers get their elapsed time
+ * in whole steps through an accumulator. Flush callbacks (bridge refreshes)
+ * requested during a tick run once, after every subscriber has run.
+ */
+
+// Browser globals (not available in Node.js)
+declare const requestAnimationFrame: ((callback: () => void) => number) | undefined;
+declare const cancelAnimationFrame: ((id: number) => void) | undefined;
+
+export type FrameCallback = (deltaMs: number, now: number) => void;
+
+export interface FrameSubscribeOptions {
+  /**
+   * Fixed step in ms. The callback runs once per whole step elapsed, always
+   * with deltaMs = stepMs. Leave unset to run once per tick with the real
+   * elapsed time.
+   */
+  stepMs?: number;
+}
+
+export interface FrameSchedulerOptions {
+  /** Tick period in ms when no fixed-step subscriber asks for less (default 1000/60) */
+  frameMs?: number;
+  /** Most fixed steps one subscriber may catch up in a tick; extra time is dropped (default 5) */
+  maxStepsPerTick?: number;
+  /** Don't run a timer; the owner calls tick(), e.g. from bridge vsync events */
+  manual?: boolean;
+  /** Clock, for tests (default performance.now) */
+  now?: () => number;
+}
+
+interface Subscriber {
+  callback: FrameCallback;
+  stepMs: number; // 0 = variable step
+  accumulator: number;
+  last: number;
+}
+
+export class FrameScheduler {
+  private subscribers: Subscriber[] = [];
+  private flushes: Set<() => void> = new Set();
+  private frameMs: number;
+  private maxStepsPerTick: number;
+  private manual: boolean;
+  private now: () => number;
+  private timerId: ReturnType<typeof setTimeout> | number | null = null;
+  private usingRaf = false;
+  private nextDeadline = 0;
+  private ticking = false;
+  private tickCount = 0;
+
+  constructor(options?: FrameSchedulerOptions) {
+    this.frameMs = options?.frameMs ?? 1000 / 60;
+    this.maxStepsPerTick = options?.maxStepsPerTick ?? 5;
+    this.manual = options?.manual ?? false;
+    this.now = options?.now ?? (() => performance.now());
+  }
+
+  /**
+   * Run callback on every tick. Returns an unsubscribe function.
+   */
+  subscribe(callback: FrameCallback, options?: FrameSubscribeOptions): () => void {
+    const subscriber: Subscriber = {
+      callback,
+      stepMs: Math.max(0, options?.stepMs ?? 0),
+      accumulator: 0,
+      last: this.now(),
+    };
+    this.subscribers.push(subscriber);
+    this.schedule();
+
+    return () => {
+      const index = this.subscribers.indexOf(subscriber);
+      if (index !== -1) {
+        this.subscribers.splice(index, 1);
+      }
+      if (this.subscribers.length === 0) {
+        this.cancel();
+      }
+    };
+  }
+
+  /**
+   * Ask for fn to run once at the end of the current tick (or the next one,
+   * outside a tick). Repeated requests for the same fn collapse into one call.
+   */
+  requestFlush(fn: () => void): void {
+    this.flushes.add(fn);
+    if (!this.ticking) {
+      this.schedule();
+    }
+  }
+
+  /**
+   * Ticker in the shape core's Animation.start()/makeAnimatable() expect
+   */
+  readonly ticker = (_ms: number, callback: () => void): (() => void) =>
+    this.subscribe(() => callback());
+
+  /**
+   * Advance all subscribers to now and run the pending flushes
+   */
+  tick(now: number = this.now()): void {
+    if (this.ticking) return;
+    this.ticking = true;
+    this.tickCount++;
+    try {
+      // Snapshot: subscribers may unsubscribe (or subscribe others) while running
+      for (const subscriber of this.subscribers.slice()) {
+        const elapsed = Math.max(0, now - subscriber.last);
+        subscriber.last = now;
+
+        if (subscriber.stepMs === 0) {
+          subscriber.callback(elapsed, now);
+          continue;
+        }
+
+        subscriber.accumulator += elapsed;
+        let steps = 0;
+        while (subscriber.accumulator >= subscriber.stepMs && steps < this.maxStepsPerTick) {
+          subscriber.accumulator -= subscriber.stepMs;
+          subscriber.callback(subscriber.stepMs, now);
+          steps++;
+        }
+        if (steps === this.maxStepsPerTick) {
+          // Fell too far behind: drop the backlog rather than spiral
+          subscriber.accumulator %= subscriber.stepMs;
+        }
+      }
+
+      const flushes = Array.from(this.flushes);
+      this.flushes.clear();
+      for (const flush of flushes) {
+        flush();
+      }
+    } finally {
+      this.ticking = false;
+    }
+  }
+
+  /**
+   * Number of ticks run so far
+   */
+  getTickCount(): number {
+    return this.tickCount;
+  }
+
+  getSubscriberCount(): number {
+    return this.subscribers.length;
+  }
+
+  isRunning(): boolean {
+    return this.timerId !== null;
+  }
+
+  /**
+   * Tick period: the finest fixed step, capped at frameMs
+   */
+  private getPeriod(): number {
+    let period = this.frameMs;
+    for (const subscriber of this.subscribers) {
+      if (subscriber.stepMs > 0 && subscriber.stepMs < period) {
+        period = subscriber.stepMs;
+      }
+    }
+    return period;
+  }
+
+  private schedule(): void {
+    if (this.manual || this.timerId !== null) return;
+    if (this.subscribers.length === 0 && this.flushes.size === 0) return;
+
+    const now = this.now();
+    const period = this.getPeriod();
+    // Next deadline on the absolute grid; resync after a long stall
+    this.nextDeadline += period;
+    if (this.nextDeadline < now || this.nextDeadline > now + period) {
+      this.nextDeadline = now + period;
+    }
+
+    if (typeof requestAnimationFrame !== 'undefined') {
+      this.usingRaf = true;
+      this.timerId = requestAnimationFrame(this.wake);
+      return;
+    }
+    const timer = setTimeout(this.wake, this.nextDeadline - now);
+    // Don't keep process alive for frame timers
+    if (typeof timer === 'object' && timer !== null && 'unref' in timer) {
+      (timer as NodeJS.Timeout).unref();
+    }
+    this.timerId = timer;
+  }
+
+  private cancel(): void {
+    if (this.timerId === null) return;
+    if (this.usingRaf && typeof cancelAnimationFrame !== 'undefined') {
+      cancelAnimationFrame(this.timerId as number);
+    } else {
+      clearTimeout(this.timerId as ReturnType<typeof setTimeout>);
+    }
+    this.timerId = null;
+  }
+
+  private wake = (): void => {
+    this.timerId = null;
+    this.tick();
+    this.schedule();
+  };
+}
+
+let sharedScheduler: FrameScheduler | null = null;
+
+/**
+ * The process-wide scheduler used by systems that aren't given their own
+ */
+export function getFrameScheduler(): FrameScheduler {
+  if (!sharedScheduler) {
+    sharedScheduler = new FrameScheduler();
+  }
+  return sharedScheduler;
+}
@@ -58,6 +58,13 @@ export {
   type Keyframe,
 } from './animation';
 export { AnimationManager } from './animation-manager';
+export {
+  FrameScheduler,
+  getFrameScheduler,
+  type FrameCallback,
+  type FrameSubscribeOptions,
+  type FrameSchedulerOptions,
+} from './frame-scheduler';
 export {
   LinearScale,
   LogScale,
@@ -94,6 +101,7 @@ export {
   type ParticleOptions,
   type EmitterOptions,
 } from './particle-system';
+export { ParticleStore, packRGBA } from './particle-store';
 export {
   MarkerRenderer,
   MarkerAnchor,
@@ -71,6 +71,12 @@ export {
   getAllCosyne3dContexts,
 } from './context3d';
 
+// Culling
+export {
+  SceneBVH,
+  CullingStats,
+} from './scene-bvh';
+
 // 3D Primitives
 export {
   // Base class
@@ -151,6 +157,8 @@ export {
   Quaternion,
   Ray,
   Box3,
+  Frustum,
+  FrustumTest,
   degToRad,
   radToDeg,
   clamp,
@@ -182,6 +190,9 @@ export {
 export {
   Renderer3D,
   renderer3d,
+  FrameArena,
+  CanvasSceneRenderer,
+  CanvasSceneStats,
 } from './renderer3d';
 
 // Note: RenderTarget, createRenderTarget, clearRenderTarget are exported from tsyne's graphics/platform
@@ -155,6 +155,18 @@ export abstract class Light {
     normal: Vector3
   ): number;
 
+  /**
+   * Allocation-free variant of calculateIntensityAt taking scalar components
+   * (normal must be unit length). Built-in lights override this; custom
+   * subclasses fall back to calculateIntensityAt.
+   */
+  calculateIntensityAtXYZ(
+    px: number, py: number, pz: number,
+    nx: number, ny: number, nz: number
+  ): number {
+    return this.calculateIntensityAt(new Vector3(px, py, pz), new Vector3(nx, ny, nz));
+  }
+
   /**
    * Get the light direction at a point (for specular calculations)
    * Returns normalized vector pointing FROM the point TO the light
@@ -192,12 +204,19 @@ export class DirectionalLight extends Light {
     return this;
   }
 
-  calculateIntensityAt(_point: Vector3, normal: Vector3): number {
+  calculateIntensityAt(point: Vector3, normal: Vector3): number {
+    return this.calculateIntensityAtXYZ(point.x, point.y, point.z, normal.x, normal.y, normal.z);
+  }
+
+  calculateIntensityAtXYZ(
+    _px: number, _py: number, _pz: number,
+    nx: number, ny: number, nz: number
+  ): number {
     if (!this._enabled) return 0;
 
     // Light direction is inverted (direction points at surface, we need towards light)
-    const lightDir = this._direction.negate();
-    const dot = Math.max(0, normal.dot(lightDir));
+    const d = this._direction;
+    const dot = Math.max(0, -(nx * d.x + ny * d.y + nz * d.z));
     return dot * this._intensity;
   }
 
@@ -261,10 +280,19 @@ export class PointLight extends Light {
   }
 
   calculateIntensityAt(point: Vector3, normal: Vector3): number {
+    return this.calculateIntensityAtXYZ(point.x, point.y, point.z, normal.x, normal.y, normal.z);
+  }
+
+  calculateIntensityAtXYZ(
+    px: number, py: number, pz: number,
+    nx: number, ny: number, nz: number
+  ): number {
     if (!this._enabled) return 0;
 
-    const lightDir = this._position.sub(point);
-    const distance = lightDir.length();
+    let lx = this._position.x - px;
+    let ly = this._position.y - py;
+    let lz = this._position.z - pz;
+    const distance = Math.sqrt(lx * lx + ly * ly + lz * lz);
 
     // Check range
     if (this._range > 0 && distance > this._range) {
@@ -272,10 +300,18 @@ export class PointLight extends Light {
     }
 
     // Normalize light direction
-    const normalizedDir = distance > 0 ? lightDir.divideScalar(distance) : Vector3.up();
+    if (distance > 0) {
+      lx /= distance;
+      ly /= distance;
+      lz /= distance;
+    } else {
+      lx = 0;
+      ly = 1;
+      lz = 0;
+    }
 
     // Calculate diffuse
-    const dot = Math.max(0, normal.dot(normalizedDir));
+    const dot = Math.max(0, nx * lx + ny * ly + nz * lz);
 
     // Calculate attenuation
     let attenuation = 1;
@@ -313,6 +349,11 @@ export class AmbientLight extends Light {
     return this._intensity;
   }
 
+  calculateIntensityAtXYZ(): number {
+    if (!this._enabled) return 0;
+    return this._intensity;
+  }
+
   getLightDirectionAt(_point: Vector3): Vector3 {
     // Ambient has no direction - return up as placeholder
     return Vector3.up();
@@ -397,10 +438,20 @@ export class SpotLight extends Light {
   }
 
   calculateIntensityAt(point: Vector3, normal: Vector3): number {
+    return this.calculateIntensityAtXYZ(point.x, point.y, point.z, normal.x, normal.y, normal.z);
+  }
+
+  calculateIntensityAtXYZ(
+    px: number, py: number, pz: number,
+    nx: number, ny: number, nz: number
+  ): number {
     if (!this._enabled) return 0;
 
-    const lightToPoint = point.sub(this._position);
-    const distance = lightToPoint.length();
+    const d = this._direction;
+    let tx = px - this._position.x;
+    let ty = py - this._position.y;
+    let tz = pz - this._position.z;
+    const distance = Math.sqrt(tx * tx + ty * ty + tz * tz);
 
     // Check range
     if (this._range > 0 && distance > this._range) {
@@ -408,8 +459,16 @@ export class SpotLight extends Light {
     }
 
     // Check angle
-    const normalizedLightToPoint = distance > 0 ? lightToPoint.divideScalar(distance) : this._direction;
-    const spotAngle = Math.acos(Math.max(-1, Math.min(1, normalizedLightToPoint.dot(this._direction))));
+    if (distance > 0) {
+      tx /= distance;
+      ty /= distance;
+      tz /= distance;
+    } else {
+      tx = d.x;
+      ty = d.y;
+      tz = d.z;
+    }
+    const spotAngle = Math.acos(Math.max(-1, Math.min(1, tx * d.x + ty * d.y + tz * d.z)));
 
     if (spotAngle > this._outerAngle) {
       return 0;
@@ -422,11 +481,8 @@ export class SpotLight extends Light {
       spotFalloff = 1 - t;
     }
 
-    // Light direction towards the point
-    const lightDir = this._position.sub(point).normalize();
-
-    // Calculate diffuse
-    const dot = Math.max(0, normal.dot(lightDir));
+    // Light direction towards the point is the reverse of light-to-point
+    const dot = distance > 0 ? Math.max(0, -(nx * tx + ny * ty + nz * tz)) : 0;
 
     // Calculate distance attenuation
     let attenuation = 1;
@@ -547,6 +603,44 @@ export class LightManager {
     return { diffuse, specular, ambient };
   }
 
+  /**
+   * Total ambient intensity (independent of position, so callers shading
+   * many vertices can compute it once per frame)
+   */
+  calculateAmbient(): number {
+    let ambient = 0;
+    let hasAmbient = false;
+    for (let i = 0; i < this.lights.length; i++) {
+      const light = this.lights[i];
+      if (light.type !== 'ambient') continue;
+      hasAmbient = true;
+      if (light.enabled) {
+        ambient += light.calculateIntensityAtXYZ(0, 0, 0, 0, 1, 0);
+      }
+    }
+    if (!hasAmbient) {
+      ambient = this.defaultAmbient.calculateIntensityAtXYZ();
+    }
+    return ambient;
+  }
+
+  /**
+   * Total diffuse intensity at a point from all non-ambient lights.
+   * Allocation-free; normal must be unit length.
+   */
+  calculateDiffuseAt(
+    px: number, py: number, pz: number,
+    nx: number, ny: number, nz: number
+  ): number {
+    let diffuse = 0;
+    for (let i = 0; i < this.lights.length; i++) {
+      const light = this.lights[i];
+      if (!light.enabled || light.type === 'ambient') continue;
+      diffuse += light.calculateIntensityAtXYZ(px, py, pz, nx, ny, nz);
+    }
+    return diffuse;
+  }
+
   /**
    * Set default ambient intensity
    */
@@ -225,6 +225,9 @@ export class Material {
   private _parsedColor: ColorRGBA | null = null;
   private _parsedEmissive: ColorRGBA | null = null;
 
+  // Bumped by every property change so renderers can tell when to redraw
+  private _version: number = 0;
+
   constructor(props?: MaterialProperties) {
     if (props) {
       // Use setters for proper validation of range-constrained properties
@@ -260,13 +263,22 @@ export class Material {
     });
   }
 
+  /**
+   * Counter that changes whenever any material property is set
+   */
+  get version(): number {
+    return this._version;
+  }
+
   get color(): string {
     return this._color;
   }
 
   set color(value: string) {
+    this._version++;
     this._color = value;
-    this._parsedColor = null;
+    // Parsed here rather than on first use so the render loop never parses
+    this._parsedColor = parseColor(value);
   }
 
   get shininess(): number {
@@ -274,6 +286,7 @@ export class Material {
   }
 
   set shininess(value: number) {
+    this._version++;
     this._shininess = Math.max(0, Math.min(1, value));
   }
 
@@ -282,6 +295,7 @@ export class Material {
   }
 
   set opacity(value: number) {
+    this._version++;
     this._opacity = Math.max(0, Math.min(1, value));
   }
 
@@ -290,6 +304,7 @@ export class Material {
   }
 
   set transparent(value: boolean) {
+    this._version++;
     this._transparent = value;
   }
 
@@ -298,8 +313,9 @@ export class Material {
   }
 
   set emissive(value: string) {
+    this._version++;
     this._emissive = value;
-    this._parsedEmissive = null;
+    this._parsedEmissive = parseColor(value);
   }
 
   get emissiveIntensity(): number {
@@ -307,6 +323,7 @@ export class Material {
   }
 
   set emissiveIntensity(value: number) {
+    this._version++;
     this._emissiveIntensity = Math.max(0, Math.min(1, value));
   }
 
@@ -315,6 +332,7 @@ export class Material {
   }
 
   set unlit(value: boolean) {
+    this._version++;
     this._unlit = value;
   }
 
@@ -323,6 +341,7 @@ export class Material {
   }
 
   set wireframe(value: boolean) {
+    this._version++;
     this._wireframe = value;
   }
 
@@ -331,6 +350,7 @@ export class Material {
   }
 
   set doubleSided(value: boolean) {
+    this._version++;
     this._doubleSided = value;
   }
 
@@ -339,6 +359,7 @@ export class Material {
   }
 
   set flatShading(value: boolean) {
+    this._version++;
     this._flatShading = value;
   }
 
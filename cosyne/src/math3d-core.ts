@@ -256,10 +256,17 @@ export class Matrix4 {
   }
 
   static multiply(a: Matrix4, b: Matrix4): Matrix4 {
+    return new Matrix4().multiplyMatrices(a, b);
+  }
+
+  /**
+   * Set this matrix to a * b in place (no allocation).
+   * Safe when this is a or b.
+   */
+  multiplyMatrices(a: Matrix4, b: Matrix4): this {
     const ae = a.elements;
     const be = b.elements;
-    const result = new Matrix4();
-    const re = result.elements;
+    const re = this.elements;
 
     const a11 = ae[0], a21 = ae[1], a31 = ae[2], a41 = ae[3];
     const a12 = ae[4], a22 = ae[5], a32 = ae[6], a42 = ae[7];
@@ -291,7 +298,7 @@ export class Matrix4 {
     re[11] = a41 * b13 + a42 * b23 + a43 * b33 + a44 * b43;
     re[15] = a41 * b14 + a42 * b24 + a43 * b34 + a44 * b44;
 
-    return result;
+    return this;
   }
 
   premultiply(m: Matrix4): Matrix4 {
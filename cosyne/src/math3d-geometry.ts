@@ -1,5 +1,5 @@
 /**
- * 3D Geometry classes: Ray, Box3, and intersection utilities
+ * 3D Geometry classes: Ray, Box3, Frustum, and intersection utilities
  */
 
 import { Vector3, Matrix4 } from './math3d-core';
@@ -234,6 +234,88 @@ export class Box3 {
   }
 }
 
+/**
+ * Result of a frustum / box test
+ */
+export enum FrustumTest {
+  Outside = 0,
+  Intersects = 1,
+  Inside = 2,
+}
+
+/**
+ * View frustum as six planes (a, b, c, d with a*x + b*y + c*z + d >= 0 inside),
+ * extracted from a view-projection matrix. Tests are allocation-free.
+ */
+export class Frustum {
+  readonly planes = new Float64Array(24);
+
+  /**
+   * Extract planes from a (column-major) view-projection matrix
+   * (Gribb/Hartmann; OpenGL clip volume -w <= x, y, z <= w)
+   */
+  setFromMatrix(m: Matrix4): this {
+    const e = m.elements;
+    const r0x = e[0], r0y = e[4], r0z = e[8], r0w = e[12];
+    const r1x = e[1], r1y = e[5], r1z = e[9], r1w = e[13];
+    const r2x = e[2], r2y = e[6], r2z = e[10], r2w = e[14];
+    const r3x = e[3], r3y = e[7], r3z = e[11], r3w = e[15];
+
+    this.setPlane(0, r3x + r0x, r3y + r0y, r3z + r0z, r3w + r0w); // left
+    this.setPlane(1, r3x - r0x, r3y - r0y, r3z - r0z, r3w - r0w); // right
+    this.setPlane(2, r3x + r1x, r3y + r1y, r3z + r1z, r3w + r1w); // bottom
+    this.setPlane(3, r3x - r1x, r3y - r1y, r3z - r1z, r3w - r1w); // top
+    this.setPlane(4, r3x + r2x, r3y + r2y, r3z + r2z, r3w + r2w); // near
+    this.setPlane(5, r3x - r2x, r3y - r2y, r3z - r2z, r3w - r2w); // far
+    return this;
+  }
+
+  /**
+   * Classify an axis-aligned box against the frustum
+   */
+  testBox(
+    minX: number, minY: number, minZ: number,
+    maxX: number, maxY: number, maxZ: number
+  ): FrustumTest {
+    const p = this.planes;
+    let inside = true;
+    for (let i = 0; i < 24; i += 4) {
+      const a = p[i], b = p[i + 1], c = p[i + 2], d = p[i + 3];
+      // Corner furthest along the plane normal (positive vertex)
+      const px = a >= 0 ? maxX : minX;
+      const py = b >= 0 ? maxY : minY;
+      const pz = c >= 0 ? maxZ : minZ;
+      if (a * px + b * py + c * pz + d < 0) {
+        return FrustumTest.Outside;
+      }
+      // Opposite corner (negative vertex) decides full containment
+      const nx = a >= 0 ? minX : maxX;
+      const ny = b >= 0 ? minY : maxY;
+      const nz = c >= 0 ? minZ : maxZ;
+      if (a * nx + b * ny + c * nz + d < 0) {
+        inside = false;
+      }
+    }
+    return inside ? FrustumTest.Inside : FrustumTest.Intersects;
+  }
+
+  intersectsBox(box: Box3): boolean {
+    return this.testBox(
+      box.min.x, box.min.y, box.min.z,
+      box.max.x, box.max.y, box.max.z
+    ) !== FrustumTest.Outside;
+  }
+
+  private setPlane(index: number, a: number, b: number, c: number, d: number): void {
+    const len = Math.sqrt(a * a + b * b + c * c) || 1;
+    const o = index * 4;
+    this.planes[o] = a / len;
+    this.planes[o + 1] = b / len;
+    this.planes[o + 2] = c / len;
+    this.planes[o + 3] = d / len;
+  }
+}
+
 /**
  * Ray-line segment intersection in 2D
  * Crucial for 2.5D raycasting (DOOM/Wolfenstein style)
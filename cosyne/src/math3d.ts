@@ -3,7 +3,7 @@
  *
  * This module re-exports from split files:
  * - math3d-core.ts: Vector3, Matrix4, Quaternion
- * - math3d-geometry.ts: Ray, Box3, ray intersections
+ * - math3d-geometry.ts: Ray, Box3, Frustum, ray intersections
  * - math3d-utils.ts: angles, rotations, random, region testing
  */
 
@@ -18,6 +18,8 @@ export {
 export {
   Ray,
   Box3,
+  Frustum,
+  FrustumTest,
   rayLineIntersect2D,
   rayLineIntersect2DV,
 } from './math3d-geometry';
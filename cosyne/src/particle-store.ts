@@ -0,0 +1,237 @@
+/**
+ * Structure-of-arrays particle storage
+ *
+ * Emitter used to keep one Particle object per particle (with nested {x, y}
+ * vectors and a CSS color string), which meant pointer chasing in the update
+ * loop and a steady stream of garbage at high emission rates. ParticleStore
+ * keeps every attribute in its own typed array instead: dead particles are
+ * swap-removed so live ones stay packed at [0, count), the update runs as
+ * flat loops over those arrays, and render() blends straight into a raster
+ * buffer without creating any objects.
+ */
+
+import { RenderTarget } from '../../core/dist/src/graphics/platform';
+
+/**
+ * Pack 0-255 color components into one RGBA word (r in the low byte)
+ */
+export function packRGBA(r: number, g: number, b: number, a: number): number {
+  return ((a & 255) << 24 | (b & 255) << 16 | (g & 255) << 8 | (r & 255)) >>> 0;
+}
+
+/**
+ * Fraction (0-1) of a particle's base alpha left after it has used up part
+ * of its life. Shared by Particle, ParticleStore and ParticleSystem so the
+ * fade is defined once.
+ */
+export function lifeFade(life: number, maxLife: number): number {
+  return Math.max(0, life / maxLife);
+}
+
+export class ParticleStore {
+  /** Number of live particles (stored at indices [0, count)) */
+  count = 0;
+
+  posX: Float32Array;
+  posY: Float32Array;
+  velX: Float32Array;
+  velY: Float32Array;
+  /** Remaining life in ms */
+  life: Float32Array;
+  /** Life at spawn in ms */
+  maxLife: Float32Array;
+  radius: Float32Array;
+  /** Packed RGBA (see packRGBA); alpha is the particle's base alpha */
+  color: Uint32Array;
+
+  constructor(capacity = 256) {
+    capacity = Math.max(1, capacity);
+    this.posX = new Float32Array(capacity);
+    this.posY = new Float32Array(capacity);
+    this.velX = new Float32Array(capacity);
+    this.velY = new Float32Array(capacity);
+    this.life = new Float32Array(capacity);
+    this.maxLife = new Float32Array(capacity);
+    this.radius = new Float32Array(capacity);
+    this.color = new Uint32Array(capacity);
+  }
+
+  get capacity(): number {
+    return this.posX.length;
+  }
+
+  /**
+   * Add a particle, growing storage geometrically when full. Returns its index.
+   */
+  spawn(
+    x: number, y: number,
+    vx: number, vy: number,
+    life: number,
+    radius: number,
+    rgba: number
+  ): number {
+    if (this.count === this.posX.length) {
+      this.grow(this.count * 2);
+    }
+    const i = this.count++;
+    this.posX[i] = x;
+    this.posY[i] = y;
+    this.velX[i] = vx;
+    this.velY[i] = vy;
+    this.life[i] = life;
+    this.maxLife[i] = life;
+    this.radius[i] = radius;
+    this.color[i] = rgba;
+    return i;
+  }
+
+  /**
+   * Advance every particle by deltaTime ms under a shared acceleration
+   * (units/s^2) and per-update friction, then drop the dead ones.
+   * Same integration as Particle.update.
+   */
+  update(deltaTime: number, ax: number, ay: number, friction: number): void {
+    const n = this.count;
+    const dt = deltaTime / 1000;
+    const dvx = ax * dt;
+    const dvy = ay * dt;
+    const posX = this.posX, posY = this.posY;
+    const velX = this.velX, velY = this.velY;
+    const life = this.life;
+
+    // Independent straight-line loops over typed arrays
+    for (let i = 0; i < n; i++) {
+      velX[i] = (velX[i] + dvx) * friction;
+    }
+    for (let i = 0; i < n; i++) {
+      velY[i] = (velY[i] + dvy) * friction;
+    }
+    for (let i = 0; i < n; i++) {
+      posX[i] += velX[i] * dt;
+    }
+    for (let i = 0; i < n; i++) {
+      posY[i] += velY[i] * dt;
+    }
+    for (let i = 0; i < n; i++) {
+      life[i] -= deltaTime;
+    }
+
+    this.removeDead();
+  }
+
+  /**
+   * Swap-remove every particle whose life has run out
+   */
+  removeDead(): void {
+    const life = this.life;
+    let n = this.count;
+    let i = 0;
+    while (i < n) {
+      if (life[i] > 0) {
+        i++;
+      } else {
+        n--;
+        if (i !== n) {
+          this.move(n, i);
+        }
+      }
+    }
+    this.count = n;
+  }
+
+  clear(): void {
+    this.count = 0;
+  }
+
+  /**
+   * Alpha (0-1) of particle i: base alpha fading out over its life
+   */
+  alphaAt(i: number): number {
+    return ((this.color[i] >>> 24) / 255) * lifeFade(this.life[i], this.maxLife[i]);
+  }
+
+  /**
+   * Blend every particle into target as a filled disc, fading with life
+   */
+  render(target: RenderTarget): void {
+    const pixels = target.pixels;
+    const width = target.width;
+    const height = target.height;
+    const posX = this.posX, posY = this.posY;
+    const life = this.life, maxLife = this.maxLife;
+    const radius = this.radius, color = this.color;
+
+    for (let i = 0; i < this.count; i++) {
+      const rgba = color[i];
+      const a = Math.round((rgba >>> 24) * lifeFade(life[i], maxLife[i]));
+      if (a === 0) continue;
+      const inv = 255 - a;
+      const r = (rgba & 255) * a;
+      const g = (rgba >>> 8 & 255) * a;
+      const b = (rgba >>> 16 & 255) * a;
+
+      const cx = posX[i];
+      const cy = posY[i];
+      const rad = radius[i];
+
+      const y0 = Math.max(0, Math.ceil(cy - rad));
+      const y1 = Math.min(height - 1, Math.floor(cy + rad));
+      if (rad < 1 || y0 > y1) {
+        // Sub-pixel particle: a single blended pixel
+        const px = Math.round(cx), py = Math.round(cy);
+        if (px < 0 || px >= width || py < 0 || py >= height) continue;
+        const o = (py * width + px) * 4;
+        pixels[o] = (r + pixels[o] * inv + 127) / 255;
+        pixels[o + 1] = (g + pixels[o + 1] * inv + 127) / 255;
+        pixels[o + 2] = (b + pixels[o + 2] * inv + 127) / 255;
+        pixels[o + 3] = Math.min(255, pixels[o + 3] + a);
+        continue;
+      }
+
+      const r2 = rad * rad;
+      for (let y = y0; y <= y1; y++) {
+        const dy = y - cy;
+        const half = Math.sqrt(r2 - dy * dy);
+        const x0 = Math.max(0, Math.ceil(cx - half));
+        const x1 = Math.min(width - 1, Math.floor(cx + half));
+        let o = (y * width + x0) * 4;
+        for (let x = x0; x <= x1; x++, o += 4) {
+          pixels[o] = (r + pixels[o] * inv + 127) / 255;
+          pixels[o + 1] = (g + pixels[o + 1] * inv + 127) / 255;
+          pixels[o + 2] = (b + pixels[o + 2] * inv + 127) / 255;
+          pixels[o + 3] = Math.min(255, pixels[o + 3] + a);
+        }
+      }
+    }
+  }
+
+  private move(from: number, to: number): void {
+    this.posX[to] = this.posX[from];
+    this.posY[to] = this.posY[from];
+    this.velX[to] = this.velX[from];
+    this.velY[to] = this.velY[from];
+    this.life[to] = this.life[from];
+    this.maxLife[to] = this.maxLife[from];
+    this.radius[to] = this.radius[from];
+    this.color[to] = this.color[from];
+  }
+
+  private grow(capacity: number): void {
+    this.posX = resized(this.posX, capacity);
+    this.posY = resized(this.posY, capacity);
+    this.velX = resized(this.velX, capacity);
+    this.velY = resized(this.velY, capacity);
+    this.life = resized(this.life, capacity);
+    this.maxLife = resized(this.maxLife, capacity);
+    this.radius = resized(this.radius, capacity);
+    const color = new Uint32Array(capacity);
+    color.set(this.color);
+    this.color = color;
+  }
+}
+
+function resized(array: Float32Array, capacity: number): Float32Array {
+  const next = new Float32Array(capacity);
+  next.set(array);
+  return next;
+}
@@ -3,6 +3,10 @@
  */
 
 import { CosyneContext } from './context';
+import { ParticleStore, packRGBA, lifeFade } from './particle-store';
+import { FrameScheduler, getFrameScheduler } from './frame-scheduler';
+import { RenderTarget } from '../../core/dist/src/graphics/platform';
+import { parseColor } from '../../core/dist/src/graphics/rasterizer';
 
 export interface Vector2D {
   x: number;
@@ -19,6 +23,24 @@ export interface ParticleOptions {
   friction?: number;  // Velocity damping (0-1)
 }
 
+// '#rrggbb' per packed RGB, so rendering doesn't format a string per particle
+const colorStrings = new Map<number, string>();
+const MAX_COLOR_STRINGS = 256;
+
+function colorString(rgba: number): string {
+  const rgb = rgba & 0xffffff;
+  let color = colorStrings.get(rgb);
+  if (color === undefined) {
+    if (colorStrings.size >= MAX_COLOR_STRINGS) {
+      colorStrings.clear();
+    }
+    color = '#' + [rgb & 255, rgb >>> 8 & 255, rgb >>> 16 & 255]
+      .map((c) => c.toString(16).padStart(2, '0')).join('');
+    colorStrings.set(rgb, color);
+  }
+  return color;
+}
+
 /**
  * Single particle
  */
@@ -69,7 +91,7 @@ export class Particle {
   }
 
   getAlpha(): number {
-    return this.alpha * Math.max(0, this.life / this.maxLife);
+    return this.alpha * lifeFade(this.life, this.maxLife);
   }
 }
 
@@ -99,7 +121,13 @@ export class Emitter {
   particleVelocity: Vector2D = { x: 0, y: 0 };
   particleAcceleration: Vector2D = { x: 0, y: 0 };
 
-  particles: Particle[] = [];
+  /** Live particles, structure-of-arrays */
+  readonly store = new ParticleStore();
+
+  // particleColor/particleAlpha packed for the store, refreshed when they change
+  private packedColor = 0;
+  private packedColorKey = '';
+  private packedAlpha = NaN;
 
   constructor(x: number, y: number, options: EmitterOptions = {}) {
     this.position = { x, y };
@@ -116,7 +144,39 @@ export class Emitter {
     this.particleAcceleration = options.acceleration ?? { x: 0, y: 0 };
   }
 
-  update(deltaTime: number): void {
+  /**
+   * Snapshot of the live particles as Particle objects.
+   *
+   * This used to be the emitter's own mutable array; particles now live in
+   * `store`, so the snapshot is rebuilt (one Particle per live particle) on
+   * every read and changes made to it are not seen by the emitter. Use
+   * `store` or getParticleCount() in per-frame code.
+   */
+  get particles(): Particle[] {
+    const store = this.store;
+    const particles: Particle[] = [];
+    for (let i = 0; i < store.count; i++) {
+      const rgba = store.color[i];
+      const particle = new Particle(store.posX[i], store.posY[i], {
+        velocity: { x: store.velX[i], y: store.velY[i] },
+        acceleration: { x: this.particleAcceleration.x, y: this.particleAcceleration.y },
+        life: store.maxLife[i],
+        radius: store.radius[i],
+        color: colorString(rgba),
+        alpha: (rgba >>> 24) / 255,
+        friction: this.particleFriction,
+      });
+      particle.life = store.life[i];
+      particles.push(particle);
+    }
+    return particles;
+  }
+
+  /**
+   * Emit and advance particles. gravityX/gravityY (units/s^2) are added to
+   * the emitter's particle acceleration.
+   */
+  update(deltaTime: number, gravityX: number = 0, gravityY: number = 0): void {
     if (!this.active) return;
 
     // Emit new particles
@@ -129,13 +189,13 @@ export class Emitter {
       this.emitTime = 0;
     }
 
-    // Update existing particles
-    for (const particle of this.particles) {
-      particle.update(deltaTime);
-    }
-
-    // Remove dead particles
-    this.particles = this.particles.filter((p) => p.isAlive());
+    // Update existing particles (dead ones are swap-removed)
+    this.store.update(
+      deltaTime,
+      this.particleAcceleration.x + gravityX,
+      this.particleAcceleration.y + gravityY,
+      this.particleFriction
+    );
   }
 
   private emit(): void {
@@ -156,22 +216,26 @@ export class Emitter {
 
     const variatedSpeed = baseSpeed * (1 + (Math.random() - 0.5) * this.speedVariation);
 
-    const velocity = {
-      x: Math.cos(angle) * variatedSpeed,
-      y: Math.sin(angle) * variatedSpeed,
-    };
+    this.store.spawn(
+      this.position.x,
+      this.position.y,
+      Math.cos(angle) * variatedSpeed,
+      Math.sin(angle) * variatedSpeed,
+      this.particleLife,
+      this.particleRadius,
+      this.getPackedColor()
+    );
+  }
 
-    const particle = new Particle(this.position.x, this.position.y, {
-      velocity,
-      acceleration: this.particleAcceleration,
-      life: this.particleLife,
-      radius: this.particleRadius,
-      color: this.particleColor,
-      alpha: this.particleAlpha,
-      friction: this.particleFriction,
-    });
-
-    this.particles.push(particle);
+  private getPackedColor(): number {
+    if (this.particleColor !== this.packedColorKey || this.particleAlpha !== this.packedAlpha) {
+      const c = parseColor(this.particleColor);
+      const alpha = Math.max(0, Math.min(1, this.particleAlpha));
+      this.packedColor = packRGBA(c.r, c.g, c.b, Math.round(c.a * alpha));
+      this.packedColorKey = this.particleColor;
+      this.packedAlpha = this.particleAlpha;
+    }
+    return this.packedColor;
   }
 
   private getRandomAngle(): number {
@@ -192,7 +256,7 @@ export class Emitter {
   }
 
   getParticleCount(): number {
-    return this.particles.length;
+    return this.store.count;
   }
 }
 
@@ -202,12 +266,16 @@ export class Emitter {
 export class ParticleSystem {
   private emitters: Emitter[] = [];
   private gravity: Vector2D = { x: 0, y: 0 };
-  private timerId: ReturnType<typeof setTimeout> | null = null;
-  private lastFrameTime: number = 0;
+  private scheduler: FrameScheduler;
+  private unsubscribe: (() => void) | null = null;
   private listeners: Array<() => void> = [];
   private targetFps: number = 60;
   private running: boolean = false;
 
+  constructor(scheduler?: FrameScheduler) {
+    this.scheduler = scheduler ?? getFrameScheduler();
+  }
+
   addEmitter(emitter: Emitter): this {
     this.emitters.push(emitter);
     return this;
@@ -226,15 +294,15 @@ export class ParticleSystem {
   start(): void {
     if (this.running) return;
     this.running = true;
-    this.lastFrameTime = Date.now();
-    this.step();
+    // Fixed timestep at the target rate, ticked with every other system
+    this.unsubscribe = this.scheduler.subscribe(this.step, { stepMs: 1000 / this.targetFps });
   }
 
   stop(): void {
     this.running = false;
-    if (this.timerId !== null) {
-      clearTimeout(this.timerId);
-      this.timerId = null;
+    if (this.unsubscribe) {
+      this.unsubscribe();
+      this.unsubscribe = null;
     }
   }
 
@@ -244,38 +312,25 @@ export class ParticleSystem {
 
   setTargetFps(fps: number): this {
     this.targetFps = fps;
+    if (this.running) {
+      this.stop();
+      this.start();
+    }
     return this;
   }
 
-  private step = (): void => {
-    // Check if we should still be running
-    if (!this.running) {
-      this.timerId = null;
-      return;
-    }
-
-    const now = Date.now();
-    const deltaTime = Math.max(1, now - this.lastFrameTime);
-    this.lastFrameTime = now;
-
+  private step = (deltaTime: number): void => {
     // Update all emitters
     for (const emitter of this.emitters) {
-      // Apply gravity to particles
-      emitter.particles.forEach((p) => {
-        p.acceleration.x += this.gravity.x;
-        p.acceleration.y += this.gravity.y;
-      });
-
-      emitter.update(deltaTime);
+      emitter.update(deltaTime, this.gravity.x, this.gravity.y);
     }
 
-    this.listeners.forEach((l) => l());
+    // Catch-up ticks run several steps; listeners hear once, after the last
+    this.scheduler.requestFlush(this.notify);
+  };
 
-    // Schedule next frame using setTimeout (works in Node.js unlike requestAnimationFrame)
-    if (this.running) {
-      const frameInterval = 1000 / this.targetFps;
-      this.timerId = setTimeout(this.step, frameInterval);
-    }
+  private notify = (): void => {
+    this.listeners.forEach((l) => l());
   };
 
   subscribe(listener: () => void): () => void {
@@ -287,15 +342,27 @@ export class ParticleSystem {
 
   render(ctx: CosyneContext): void {
     for (const emitter of this.emitters) {
-      for (const particle of emitter.particles) {
-        ctx.circle(particle.position.x, particle.position.y, particle.radius)
-          .fill(particle.color)
-          .setAlpha(particle.getAlpha())
+      // Straight from the store: the `particles` getter allocates per particle
+      const store = emitter.store;
+      for (let i = 0; i < store.count; i++) {
+        ctx.circle(store.posX[i], store.posY[i], store.radius[i])
+          .fill(colorString(store.color[i]))
+          .setAlpha(store.alphaAt(i))
           .withId(`particle-${Math.random()}`);
       }
     }
   }
 
+  /**
+   * Blend every live particle straight into a raster buffer (no per-particle
+   * canvas primitives; suited to tens of thousands of particles)
+   */
+  renderToBuffer(target: RenderTarget): void {
+    for (const emitter of this.emitters) {
+      emitter.store.render(target);
+    }
+  }
+
   getTotalParticleCount(): number {
     return this.emitters.reduce((sum, e) => sum + e.getParticleCount(), 0);
   }
@@ -103,6 +103,9 @@ export abstract class Primitive3D {
   protected _localMatrix: Matrix4 | null = null;
   protected _worldMatrix: Matrix4 | null = null;
 
+  // Bumped whenever world bounds may have changed (transform or shape)
+  protected _boundsVersion: number = 0;
+
   // Material
   protected _material: Material = Material.default();
 
@@ -397,6 +400,7 @@ export abstract class Primitive3D {
   protected invalidateTransform(): void {
     this._localMatrix = null;
     this._worldMatrix = null;
+    this._boundsVersion++;
 
     // Also invalidate children
     for (const child of this._children) {
@@ -404,6 +408,21 @@ export abstract class Primitive3D {
     }
   }
 
+  /**
+   * Mark world bounds as changed after a shape parameter (radius, size) changes
+   */
+  protected invalidateBounds(): void {
+    this._boundsVersion++;
+  }
+
+  /**
+   * Counter that changes whenever world bounds may have changed. Spatial
+   * indexes compare it against a stored value to refit only moved primitives.
+   */
+  get boundsVersion(): number {
+    return this._boundsVersion;
+  }
+
   // ==================== Hierarchy ====================
 
   get parent(): Primitive3D | null {
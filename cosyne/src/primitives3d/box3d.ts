@@ -61,6 +61,7 @@ export class Box3D extends Primitive3D {
 
   set width(value: number) {
     this._width = Math.max(0.001, value);
+    this.invalidateBounds();
   }
 
   get height(): number {
@@ -69,6 +70,7 @@ export class Box3D extends Primitive3D {
 
   set height(value: number) {
     this._height = Math.max(0.001, value);
+    this.invalidateBounds();
   }
 
   get depth(): number {
@@ -77,6 +79,7 @@ export class Box3D extends Primitive3D {
 
   set depth(value: number) {
     this._depth = Math.max(0.001, value);
+    this.invalidateBounds();
   }
 
   setSize(size: number | [number, number, number]): this {
@@ -87,6 +90,7 @@ export class Box3D extends Primitive3D {
       this._height = Math.max(0.001, size[1]);
       this._depth = Math.max(0.001, size[2]);
     }
+    this.invalidateBounds();
     return this;
   }
 
@@ -70,6 +70,7 @@ export class Cylinder3D extends Primitive3D {
 
   set radiusTop(value: number) {
     this._radiusTop = Math.max(0, value);
+    this.invalidateBounds();
   }
 
   get radiusBottom(): number {
@@ -78,6 +79,7 @@ export class Cylinder3D extends Primitive3D {
 
   set radiusBottom(value: number) {
     this._radiusBottom = Math.max(0, value);
+    this.invalidateBounds();
   }
 
   get height(): number {
@@ -86,15 +88,18 @@ export class Cylinder3D extends Primitive3D {
 
   set height(value: number) {
     this._height = Math.max(0.001, value);
+    this.invalidateBounds();
   }
 
   setRadius(radius: number): this {
     this._radiusTop = this._radiusBottom = Math.max(0, radius);
+    this.invalidateBounds();
     return this;
   }
 
   setHeight(height: number): this {
     this._height = Math.max(0.001, height);
+    this.invalidateBounds();
     return this;
   }
 
@@ -328,10 +333,17 @@ export class Cylinder3D extends Primitive3D {
 
     if (this._radiusBinding) {
       const r = Math.max(0, this._radiusBinding.evaluate());
-      this._radiusTop = this._radiusBottom = r;
+      if (r !== this._radiusTop || r !== this._radiusBottom) {
+        this._radiusTop = this._radiusBottom = r;
+        this.invalidateBounds();
+      }
     }
     if (this._heightBinding) {
-      this._height = Math.max(0.001, this._heightBinding.evaluate());
+      const h = Math.max(0.001, this._heightBinding.evaluate());
+      if (h !== this._height) {
+        this._height = h;
+        this.invalidateBounds();
+      }
     }
   }
 
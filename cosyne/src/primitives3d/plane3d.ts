@@ -68,6 +68,7 @@ export class Plane3D extends Primitive3D {
 
   set width(value: number) {
     this._width = Math.max(0.001, value);
+    this.invalidateBounds();
   }
 
   get height(): number {
@@ -76,6 +77,7 @@ export class Plane3D extends Primitive3D {
 
   set height(value: number) {
     this._height = Math.max(0.001, value);
+    this.invalidateBounds();
   }
 
   setSize(size: number | [number, number]): this {
@@ -85,6 +87,7 @@ export class Plane3D extends Primitive3D {
       this._width = Math.max(0.001, size[0]);
       this._height = Math.max(0.001, size[1]);
     }
+    this.invalidateBounds();
     return this;
   }
 
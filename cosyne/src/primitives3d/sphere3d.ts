@@ -50,10 +50,12 @@ export class Sphere3D extends Primitive3D {
 
   set radius(value: number) {
     this._radius = Math.max(0.001, value);
+    this.invalidateBounds();
   }
 
   setRadius(radius: number): this {
     this._radius = Math.max(0.001, radius);
+    this.invalidateBounds();
     return this;
   }
 
@@ -200,7 +202,11 @@ export class Sphere3D extends Primitive3D {
     super.refreshBindings();
 
     if (this._radiusBinding) {
-      this._radius = Math.max(0.001, this._radiusBinding.evaluate());
+      const r = Math.max(0.001, this._radiusBinding.evaluate());
+      if (r !== this._radius) {
+        this._radius = r;
+        this.invalidateBounds();
+      }
     }
   }
 
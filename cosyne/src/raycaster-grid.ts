@@ -0,0 +1,345 @@
+/**
+ * Uniform grid over raycaster walls
+ *
+ * Raycaster.castRay used to test every wall for every ray, so a frame cost
+ * O(columns x walls). WallGrid buckets walls into square cells once per level
+ * and walks rays through the grid with a DDA (Amanatides & Woo), testing only
+ * the walls in cells the ray actually crosses and stopping at the first cell
+ * that contains a hit.
+ *
+ * sync() keeps the grid in step with the caller's walls by comparing endpoint
+ * coordinates, so callers may rebuild the array and wall objects every frame.
+ * A different wall count (or most walls moving) rebuilds the grid, while
+ * walls whose endpoints moved (doors, lifts) are re-bucketed individually.
+ */
+
+import { rayLineIntersect2D } from './math3d';
+import type { RaycasterWall } from './raycaster';
+
+// Cells are grown until the grid has at most this many cells per wall
+const MAX_CELLS_PER_WALL = 4;
+
+// Walls are registered in every cell they touch, expanded by this much
+const CELL_EPSILON = 1e-6;
+
+/**
+ * Result of WallGrid.castRay (reused between calls)
+ */
+export interface WallGridHit {
+  /** Index into the synced wall array */
+  index: number;
+  /** Distance along the (unit) ray */
+  t: number;
+  /** Position along the wall [0, 1] */
+  u: number;
+}
+
+export class WallGrid {
+  private count = 0;
+  private rebuilds = 0;
+
+  // Endpoint snapshot per wall (x1, y1, x2, y2): what rays are tested
+  // against, and what sync() diffs to find moved walls
+  private snapshot = new Float64Array(0);
+
+  // Grid geometry
+  private originX = 0;
+  private originY = 0;
+  private cellSize = 1;
+  private cols = 0;
+  private rows = 0;
+
+  // Wall indices per cell, and the cells each wall occupies
+  private cells: number[][] = [];
+  private wallCells: number[][] = [];
+
+  // Walls entirely outside the grid bounds (tested on every ray)
+  private overflow: number[] = [];
+
+  // Per-wall ray stamp so a wall spanning several cells is tested once per ray
+  private stamps = new Uint32Array(0);
+  private rayId = 0;
+
+  private hit: WallGridHit = { index: -1, t: 0, u: 0 };
+
+  /**
+   * Make the grid match `walls`. Cheap when nothing changed (one pass over
+   * the endpoint snapshot).
+   */
+  sync(walls: RaycasterWall[]): void {
+    if (walls.length !== this.count || this.rebuilds === 0) {
+      this.build(walls);
+      return;
+    }
+
+    const snap = this.snapshot;
+    let moved = 0;
+    for (let i = 0; i < walls.length; i++) {
+      const wall = walls[i];
+      const o = i * 4;
+      if (wall.p1.x !== snap[o] || wall.p1.y !== snap[o + 1] ||
+          wall.p2.x !== snap[o + 2] || wall.p2.y !== snap[o + 3]) {
+        // Most of the level changed (a new level with the same wall count):
+        // rebuild so the grid bounds and cell size fit it
+        if (++moved > walls.length / 2) {
+          this.build(walls);
+          return;
+        }
+        this.updateWall(i, wall);
+      }
+    }
+  }
+
+  /**
+   * Rebuild from scratch, choosing a cell size from the walls' extent
+   */
+  build(walls: RaycasterWall[]): void {
+    const n = walls.length;
+    this.count = n;
+    this.rebuilds++;
+    this.snapshot = new Float64Array(n * 4);
+    this.stamps = new Uint32Array(n);
+    this.rayId = 0;
+    this.overflow = [];
+    this.wallCells = new Array(n);
+
+    let minX = Infinity, minY = Infinity, maxX = -Infinity, maxY = -Infinity;
+    let totalLength = 0;
+    for (const wall of walls) {
+      minX = Math.min(minX, wall.p1.x, wall.p2.x);
+      minY = Math.min(minY, wall.p1.y, wall.p2.y);
+      maxX = Math.max(maxX, wall.p1.x, wall.p2.x);
+      maxY = Math.max(maxY, wall.p1.y, wall.p2.y);
+      totalLength += Math.hypot(wall.p2.x - wall.p1.x, wall.p2.y - wall.p1.y);
+    }
+    if (n === 0) {
+      minX = minY = 0;
+      maxX = maxY = 1;
+    }
+
+    // Roughly one wall length per cell, capped so the grid stays small
+    const spanX = Math.max(maxX - minX, 1e-3);
+    const spanY = Math.max(maxY - minY, 1e-3);
+    let cellSize = n > 0 ? Math.max(totalLength / n, 1e-3) : 1;
+    const maxCells = Math.max(16, n * MAX_CELLS_PER_WALL);
+    while (Math.ceil(spanX / cellSize) * Math.ceil(spanY / cellSize) > maxCells) {
+      cellSize *= 1.5;
+    }
+
+    this.cellSize = cellSize;
+    this.originX = minX;
+    this.originY = minY;
+    this.cols = Math.max(1, Math.ceil(spanX / cellSize));
+    this.rows = Math.max(1, Math.ceil(spanY / cellSize));
+    this.cells = new Array(this.cols * this.rows);
+    for (let c = 0; c < this.cells.length; c++) {
+      this.cells[c] = [];
+    }
+
+    for (let i = 0; i < n; i++) {
+      this.wallCells[i] = [];
+      this.insertWall(i, walls[i]);
+    }
+  }
+
+  /**
+   * Nearest wall hit along a unit-length ray with t in (minT, maxT),
+   * or null. Ties on t resolve to the lowest wall index, matching a linear
+   * scan of the wall array.
+   */
+  castRay(
+    ox: number, oy: number,
+    dirX: number, dirY: number,
+    minT: number, maxT: number
+  ): WallGridHit | null {
+    const hit = this.hit;
+    hit.index = -1;
+    hit.t = maxT;
+
+    if (++this.rayId === 0xffffffff) {
+      this.stamps.fill(0);
+      this.rayId = 1;
+    }
+
+    for (let k = 0; k < this.overflow.length; k++) {
+      this.testWall(this.overflow[k], ox, oy, dirX, dirY, minT);
+    }
+
+    // Clip the ray to the grid rectangle (slab test)
+    const size = this.cellSize;
+    const gx0 = this.originX;
+    const gy0 = this.originY;
+    const gx1 = gx0 + this.cols * size;
+    const gy1 = gy0 + this.rows * size;
+
+    let tEnter = 0;
+    let tLeave = hit.t;
+    if (dirX !== 0) {
+      let ta = (gx0 - ox) / dirX;
+      let tb = (gx1 - ox) / dirX;
+      if (ta > tb) { const t = ta; ta = tb; tb = t; }
+      tEnter = Math.max(tEnter, ta);
+      tLeave = Math.min(tLeave, tb);
+    } else if (ox < gx0 || ox > gx1) {
+      return hit.index >= 0 ? hit : null;
+    }
+    if (dirY !== 0) {
+      let ta = (gy0 - oy) / dirY;
+      let tb = (gy1 - oy) / dirY;
+      if (ta > tb) { const t = ta; ta = tb; tb = t; }
+      tEnter = Math.max(tEnter, ta);
+      tLeave = Math.min(tLeave, tb);
+    } else if (oy < gy0 || oy > gy1) {
+      return hit.index >= 0 ? hit : null;
+    }
+    if (tEnter > tLeave) {
+      return hit.index >= 0 ? hit : null;
+    }
+
+    // DDA setup at the entry point
+    const ex = ox + dirX * tEnter;
+    const ey = oy + dirY * tEnter;
+    let cx = Math.min(this.cols - 1, Math.max(0, Math.floor((ex - gx0) / size)));
+    let cy = Math.min(this.rows - 1, Math.max(0, Math.floor((ey - gy0) / size)));
+    const stepX = dirX > 0 ? 1 : -1;
+    const stepY = dirY > 0 ? 1 : -1;
+    const tDeltaX = dirX !== 0 ? Math.abs(size / dirX) : Infinity;
+    const tDeltaY = dirY !== 0 ? Math.abs(size / dirY) : Infinity;
+    let tMaxX = dirX !== 0
+      ? (gx0 + (cx + (dirX > 0 ? 1 : 0)) * size - ox) / dirX
+      : Infinity;
+    let tMaxY = dirY !== 0
+      ? (gy0 + (cy + (dirY > 0 ? 1 : 0)) * size - oy) / dirY
+      : Infinity;
+
+    for (;;) {
+      const bucket = this.cells[cy * this.cols + cx];
+      for (let k = 0; k < bucket.length; k++) {
+        this.testWall(bucket[k], ox, oy, dirX, dirY, minT);
+      }
+
+      // A hit before the ray leaves this cell cannot be beaten further on
+      const tExit = Math.min(tMaxX, tMaxY);
+      if (hit.index >= 0 && hit.t <= tExit) {
+        break;
+      }
+      if (tExit > tLeave) {
+        break;
+      }
+
+      if (tMaxX < tMaxY) {
+        cx += stepX;
+        if (cx < 0 || cx >= this.cols) break;
+        tMaxX += tDeltaX;
+      } else {
+        cy += stepY;
+        if (cy < 0 || cy >= this.rows) break;
+        tMaxY += tDeltaY;
+      }
+    }
+
+    return hit.index >= 0 ? hit : null;
+  }
+
+  /**
+   * Number of cells in the grid (for diagnostics)
+   */
+  getCellCount(): number {
+    return this.cells.length;
+  }
+
+  /**
+   * Number of full rebuilds so far (for diagnostics)
+   */
+  getRebuildCount(): number {
+    return this.rebuilds;
+  }
+
+  private testWall(
+    index: number,
+    ox: number, oy: number,
+    dirX: number, dirY: number,
+    minT: number
+  ): void {
+    if (this.stamps[index] === this.rayId) {
+      return;
+    }
+    this.stamps[index] = this.rayId;
+
+    const snap = this.snapshot;
+    const o = index * 4;
+    const r = rayLineIntersect2D(ox, oy, dirX, dirY, snap[o], snap[o + 1], snap[o + 2], snap[o + 3]);
+    if (!r || r.t <= minT) {
+      return;
+    }
+    const hit = this.hit;
+    if (r.t < hit.t || (r.t === hit.t && hit.index >= 0 && index < hit.index)) {
+      hit.index = index;
+      hit.t = r.t;
+      hit.u = r.u;
+    }
+  }
+
+  private updateWall(index: number, wall: RaycasterWall): void {
+    for (const cell of this.wallCells[index]) {
+      const bucket = cell < 0 ? this.overflow : this.cells[cell];
+      const at = bucket.indexOf(index);
+      if (at !== -1) bucket.splice(at, 1);
+    }
+    this.wallCells[index] = [];
+    this.insertWall(index, wall);
+  }
+
+  private insertWall(index: number, wall: RaycasterWall): void {
+    const x1 = wall.p1.x, y1 = wall.p1.y, x2 = wall.p2.x, y2 = wall.p2.y;
+    const o = index * 4;
+    this.snapshot[o] = x1;
+    this.snapshot[o + 1] = y1;
+    this.snapshot[o + 2] = x2;
+    this.snapshot[o + 3] = y2;
+
+    const size = this.cellSize;
+    const c0 = Math.floor((Math.min(x1, x2) - CELL_EPSILON - this.originX) / size);
+    const c1 = Math.floor((Math.max(x1, x2) + CELL_EPSILON - this.originX) / size);
+    const r0 = Math.floor((Math.min(y1, y2) - CELL_EPSILON - this.originY) / size);
+    const r1 = Math.floor((Math.max(y1, y2) + CELL_EPSILON - this.originY) / size);
+
+    const occupied = this.wallCells[index];
+    const clippedC0 = Math.max(0, c0), clippedC1 = Math.min(this.cols - 1, c1);
+    const clippedR0 = Math.max(0, r0), clippedR1 = Math.min(this.rows - 1, r1);
+
+    // Any part outside the grid (a wall moved past the level bounds) is
+    // covered by the overflow list
+    if (c0 < 0 || r0 < 0 || c1 >= this.cols || r1 >= this.rows) {
+      this.overflow.push(index);
+      occupied.push(-1);
+    }
+
+    // Normal of the wall's line, for rejecting cells the segment misses
+    const nx = y1 - y2;
+    const ny = x2 - x1;
+    const d = nx * x1 + ny * y1;
+
+    for (let r = clippedR0; r <= clippedR1; r++) {
+      for (let c = clippedC0; c <= clippedC1; c++) {
+        if (c1 > c0 && r1 > r0) {
+          // Diagonal wall: skip cells whose corners all lie on one side
+          const bx0 = this.originX + c * size - CELL_EPSILON;
+          const by0 = this.originY + r * size - CELL_EPSILON;
+          const bx1 = bx0 + size + 2 * CELL_EPSILON;
+          const by1 = by0 + size + 2 * CELL_EPSILON;
+          const s0 = nx * bx0 + ny * by0 - d;
+          const s1 = nx * bx1 + ny * by0 - d;
+          const s2 = nx * bx0 + ny * by1 - d;
+          const s3 = nx * bx1 + ny * by1 - d;
+          if ((s0 > 0 && s1 > 0 && s2 > 0 && s3 > 0) || (s0 < 0 && s1 < 0 && s2 < 0 && s3 < 0)) {
+            continue;
+          }
+        }
+        const cell = r * this.cols + c;
+        this.cells[cell].push(index);
+        occupied.push(cell);
+      }
+    }
+  }
+}
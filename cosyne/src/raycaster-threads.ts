@@ -0,0 +1,499 @@
+/**
+ * Worker-thread support for column-parallel Raycaster rendering
+ *
+ * Every column of a raycaster frame is independent: clearing, the wall
+ * stripe and the sprite pixels of column x only touch that column (shifted
+ * by the render offset) and depthBuffer[x]. With `threads: N` the Raycaster
+ * hands out column slices from a shared counter to N worker threads and to
+ * the calling thread, all drawing into one SharedArrayBuffer target and
+ * depth buffer, then waits on a frame barrier before returning.
+ *
+ * Scene data crosses threads as flat Float64Arrays in shared memory,
+ * repacked on the calling thread each frame. Textures are copied into shared
+ * memory once when registered; configuration and buffer changes are posted
+ * as messages that workers drain synchronously at the start of each frame,
+ * so they always apply to the next frame rendered.
+ */
+
+import type { Worker, MessagePort } from 'worker_threads';
+import type {
+  RaycasterCamera,
+  RaycasterConfig,
+  RaycasterMaterial,
+  RaycasterSprite,
+  RaycasterTexture,
+  RaycasterWall,
+} from './raycaster';
+
+/** Columns per work item handed out to a thread */
+export const SLICE_COLUMNS = 16;
+
+// Control block (Int32Array over shared memory)
+export const CTRL_FRAME = 0;
+export const CTRL_DONE = 1;
+export const CTRL_NEXT_SLICE = 2;
+export const CTRL_READY = 3;
+export const CTRL_QUIT = 4;
+const CTRL_SIZE = 5;
+
+// Frame parameters (Float64Array over shared memory)
+export const PARAM_CAMERA = 0; // x, y, z, angle, pitch, roll, height
+export const PARAM_WALL_COUNT = 7;
+export const PARAM_WALL_VERSION = 8;
+export const PARAM_SPRITE_COUNT = 9;
+export const PARAM_SLICE_COUNT = 10;
+const PARAM_SIZE = 11;
+
+// Packed wall: endpoints (4), floor/ceiling height (2), color (3, -1 = texture
+// id), back color (3, -1 = none), material kind (1), material color or
+// texture slot (3)
+export const WALL_STRIDE = 16;
+
+// Packed sprite: position (3), width, height, alpha, zOffset, color (3,
+// -1 = texture id), material kind (1), material color or texture slot (3)
+export const SPRITE_STRIDE = 14;
+
+export const MATERIAL_NONE = 0;
+export const MATERIAL_SOLID = 1;
+export const MATERIAL_TEXTURE = 2;
+
+// Give up on the workers if a frame takes longer than this
+const FRAME_TIMEOUT_MS = 10000;
+
+/**
+ * Messages from the rendering thread to a worker
+ */
+export type RaycasterWorkerMessage =
+  | { type: 'config'; config: RaycasterConfig }
+  | { type: 'buffers'; width: number; height: number; target: SharedArrayBuffer; depth: SharedArrayBuffer }
+  | { type: 'walls'; buffer: SharedArrayBuffer }
+  | { type: 'sprites'; buffer: SharedArrayBuffer }
+  | { type: 'texture'; id: number | string; texture: RaycasterTexture }
+  | { type: 'slot'; slot: number; id: number | string };
+
+/**
+ * Data every worker starts with
+ */
+export interface RaycasterWorkerData {
+  control: SharedArrayBuffer;
+  params: SharedArrayBuffer;
+  port: MessagePort;
+}
+
+/**
+ * Whether a material can be rendered by a worker (procedural samplers are
+ * functions and cannot cross threads)
+ */
+export function isThreadSafeMaterial(material: RaycasterMaterial | null | undefined): boolean {
+  return !material || material.type !== 'procedural';
+}
+
+/**
+ * Calling-thread side of the worker pool
+ */
+export class RaycasterThreadPool {
+  /** Shared depth buffer (one entry per column) */
+  depthBuffer: Float32Array;
+
+  private target: Uint8Array;
+  private width: number;
+  private height: number;
+  private workers: Worker[] = [];
+  private ports: MessagePort[] = [];
+  private control = new Int32Array(new SharedArrayBuffer(CTRL_SIZE * 4));
+  private params = new Float64Array(new SharedArrayBuffer(PARAM_SIZE * 8));
+  private walls = new Float64Array(0);
+  private sprites = new Float64Array(0);
+  private wallScratch = new Float64Array(WALL_STRIDE);
+  private textureSlots = new Map<number | string, number>();
+  private sliceCount = 0;
+  private failed = false;
+
+  /**
+   * Start `threads` workers, or return null when worker threads or shared
+   * memory are unavailable
+   */
+  static create(
+    threads: number,
+    width: number,
+    height: number,
+    config: RaycasterConfig,
+    textures: Map<number | string, RaycasterTexture>
+  ): RaycasterThreadPool | null {
+    const script = resolveWorkerScript();
+    if (!script || typeof SharedArrayBuffer === 'undefined') {
+      return null;
+    }
+    try {
+      return new RaycasterThreadPool(script, threads, width, height, config, textures);
+    } catch {
+      return null;
+    }
+  }
+
+  private constructor(
+    script: WorkerScript,
+    threads: number,
+    width: number,
+    height: number,
+    config: RaycasterConfig,
+    textures: Map<number | string, RaycasterTexture>
+  ) {
+    const { Worker, MessageChannel } = require('worker_threads') as typeof import('worker_threads');
+
+    this.width = width;
+    this.height = height;
+    this.target = new Uint8Array(new SharedArrayBuffer(width * height * 4));
+    this.depthBuffer = new Float32Array(new SharedArrayBuffer(width * 4));
+
+    for (let i = 0; i < threads; i++) {
+      const channel = new MessageChannel();
+      const workerData: RaycasterWorkerData = {
+        control: this.control.buffer as SharedArrayBuffer,
+        params: this.params.buffer as SharedArrayBuffer,
+        port: channel.port2,
+      };
+      const worker = new Worker(script.filename, {
+        workerData,
+        transferList: [channel.port2],
+        execArgv: script.execArgv,
+      });
+      worker.on('error', () => this.fail());
+      worker.on('exit', () => this.fail());
+      worker.unref();
+      this.workers.push(worker);
+      this.ports.push(channel.port1);
+    }
+
+    this.postBuffers();
+    this.configure(config);
+    for (const [id, texture] of textures) {
+      this.addTexture(id, texture);
+    }
+  }
+
+  /**
+   * Number of workers, once every one of them is up and running
+   */
+  getActiveThreads(): number {
+    return this.isReady() ? this.workers.length : 0;
+  }
+
+  isFailed(): boolean {
+    return this.failed;
+  }
+
+  configure(config: RaycasterConfig): void {
+    this.post({ type: 'config', config });
+  }
+
+  resize(width: number, height: number): void {
+    this.width = width;
+    this.height = height;
+    this.target = new Uint8Array(new SharedArrayBuffer(width * height * 4));
+    this.depthBuffer = new Float32Array(new SharedArrayBuffer(width * 4));
+    this.postBuffers();
+  }
+
+  addTexture(id: number | string, texture: RaycasterTexture): void {
+    const data = new Uint8Array(new SharedArrayBuffer(texture.data.length));
+    data.set(texture.data);
+    this.post({ type: 'texture', id, texture: { width: texture.width, height: texture.height, data } });
+  }
+
+  /**
+   * Render one frame across the workers. renderHere(target, nextSlice) is
+   * called to let the calling thread take slices as well. Returns false
+   * (having drawn nothing) when the scene cannot be rendered off-thread.
+   */
+  render(
+    buffer: Uint8Array,
+    camera: RaycasterCamera,
+    walls: RaycasterWall[],
+    sprites: RaycasterSprite[] | undefined,
+    renderHere: (target: Uint8Array, nextSlice: () => number) => void
+  ): boolean {
+    if (this.failed || !this.isReady()) {
+      return false;
+    }
+    if (!this.packWalls(walls) || !this.packSprites(sprites)) {
+      return false;
+    }
+
+    const params = this.params;
+    params[PARAM_CAMERA] = camera.position.x;
+    params[PARAM_CAMERA + 1] = camera.position.y;
+    params[PARAM_CAMERA + 2] = camera.position.z;
+    params[PARAM_CAMERA + 3] = camera.angle;
+    params[PARAM_CAMERA + 4] = camera.pitch || 0;
+    params[PARAM_CAMERA + 5] = camera.roll || 0;
+    params[PARAM_CAMERA + 6] = camera.height;
+    this.sliceCount = Math.ceil(this.width / SLICE_COLUMNS);
+    params[PARAM_SLICE_COUNT] = this.sliceCount;
+
+    // Start the frame
+    const control = this.control;
+    Atomics.store(control, CTRL_NEXT_SLICE, 0);
+    Atomics.store(control, CTRL_DONE, 0);
+    Atomics.add(control, CTRL_FRAME, 1);
+    Atomics.notify(control, CTRL_FRAME);
+
+    renderHere(this.target, this.nextSlice);
+
+    // Frame barrier: wait for every worker to finish its last slice
+    const deadline = Date.now() + FRAME_TIMEOUT_MS;
+    for (;;) {
+      const done = Atomics.load(control, CTRL_DONE);
+      if (done >= this.workers.length) {
+        break;
+      }
+      const remaining = deadline - Date.now();
+      if (remaining <= 0) {
+        this.fail();
+        return false;
+      }
+      Atomics.wait(control, CTRL_DONE, done, remaining);
+    }
+
+    if (buffer !== this.target) {
+      buffer.set(this.target);
+    }
+    return true;
+  }
+
+  /**
+   * The shared target the workers draw into. Passing it to render() skips
+   * the copy into the caller's buffer.
+   */
+  getTarget(): Uint8Array {
+    return this.target;
+  }
+
+  dispose(): void {
+    Atomics.store(this.control, CTRL_QUIT, 1);
+    Atomics.add(this.control, CTRL_FRAME, 1);
+    Atomics.notify(this.control, CTRL_FRAME);
+    for (const worker of this.workers) {
+      worker.removeAllListeners('exit');
+      worker.terminate();
+    }
+    for (const port of this.ports) {
+      port.close();
+    }
+    this.workers = [];
+    this.ports = [];
+    this.failed = true;
+  }
+
+  private nextSlice = (): number => {
+    const slice = Atomics.add(this.control, CTRL_NEXT_SLICE, 1);
+    return slice < this.sliceCount ? slice * SLICE_COLUMNS : -1;
+  };
+
+  private isReady(): boolean {
+    return Atomics.load(this.control, CTRL_READY) === this.workers.length;
+  }
+
+  private fail(): void {
+    if (!this.failed) {
+      this.dispose();
+    }
+  }
+
+  private post(message: RaycasterWorkerMessage): void {
+    for (const port of this.ports) {
+      port.postMessage(message);
+    }
+  }
+
+  private postBuffers(): void {
+    this.post({
+      type: 'buffers',
+      width: this.width,
+      height: this.height,
+      target: this.target.buffer as SharedArrayBuffer,
+      depth: this.depthBuffer.buffer as SharedArrayBuffer,
+    });
+  }
+
+  private textureSlot(id: number | string): number {
+    let slot = this.textureSlots.get(id);
+    if (slot === undefined) {
+      slot = this.textureSlots.size;
+      this.textureSlots.set(id, slot);
+      this.post({ type: 'slot', slot, id });
+    }
+    return slot;
+  }
+
+  /**
+   * Pack walls into shared memory, bumping the wall version if anything
+   * changed so workers know to resync their wall grids
+   */
+  private packWalls(walls: RaycasterWall[]): boolean {
+    const n = walls.length;
+    let changed = n !== this.params[PARAM_WALL_COUNT];
+    if (this.walls.length < n * WALL_STRIDE) {
+      this.walls = new Float64Array(new SharedArrayBuffer(Math.max(n, 64) * 2 * WALL_STRIDE * 8));
+      this.post({ type: 'walls', buffer: this.walls.buffer as SharedArrayBuffer });
+      changed = true;
+    }
+
+    const data = this.walls;
+    const scratch = this.wallScratch;
+    let ok = true;
+    for (let i = 0; i < n; i++) {
+      const wall = walls[i];
+      scratch[0] = wall.p1.x;
+      scratch[1] = wall.p1.y;
+      scratch[2] = wall.p2.x;
+      scratch[3] = wall.p2.y;
+      scratch[4] = wall.floorHeight;
+      scratch[5] = wall.ceilingHeight;
+      packColor(typeof wall.color === 'number' ? null : wall.color, scratch, 6);
+      packColor(wall.backColor || null, scratch, 9);
+      if (!this.packMaterial(wall.material, scratch, 12)) {
+        ok = false;
+        break;
+      }
+      const o = i * WALL_STRIDE;
+      for (let k = 0; k < WALL_STRIDE; k++) {
+        if (data[o + k] !== scratch[k]) {
+          data[o + k] = scratch[k];
+          changed = true;
+        }
+      }
+    }
+
+    if (changed || !ok) {
+      this.params[PARAM_WALL_VERSION]++;
+    }
+    this.params[PARAM_WALL_COUNT] = ok ? n : 0;
+    return ok;
+  }
+
+  private packSprites(sprites: RaycasterSprite[] | undefined): boolean {
+    const n = sprites ? sprites.length : 0;
+    if (this.sprites.length < n * SPRITE_STRIDE) {
+      this.sprites = new Float64Array(new SharedArrayBuffer(Math.max(n, 16) * 2 * SPRITE_STRIDE * 8));
+      this.post({ type: 'sprites', buffer: this.sprites.buffer as SharedArrayBuffer });
+    }
+
+    const data = this.sprites;
+    for (let i = 0; i < n; i++) {
+      const sprite = sprites![i];
+      const o = i * SPRITE_STRIDE;
+      data[o] = sprite.position.x;
+      data[o + 1] = sprite.position.y;
+      data[o + 2] = sprite.position.z;
+      data[o + 3] = sprite.width;
+      data[o + 4] = sprite.height;
+      data[o + 5] = sprite.alpha !== undefined ? sprite.alpha : 1;
+      data[o + 6] = sprite.zOffset || 0;
+      packColor(typeof sprite.color === 'number' ? null : sprite.color, data, o + 7);
+      if (!this.packMaterial(sprite.material, data, o + 10)) {
+        return false;
+      }
+    }
+    this.params[PARAM_SPRITE_COUNT] = n;
+    return true;
+  }
+
+  private packMaterial(material: RaycasterMaterial | undefined, data: Float64Array, o: number): boolean {
+    data[o + 1] = data[o + 2] = data[o + 3] = 0;
+    if (!material) {
+      data[o] = MATERIAL_NONE;
+    } else if (material.type === 'solid') {
+      data[o] = MATERIAL_SOLID;
+      packColor(material.color, data, o + 1);
+    } else if (material.type === 'texture') {
+      data[o] = MATERIAL_TEXTURE;
+      data[o + 1] = this.textureSlot(material.textureId);
+    } else {
+      return false;
+    }
+    return true;
+  }
+}
+
+function packColor(color: [number, number, number] | null, data: Float64Array, o: number): void {
+  data[o] = color ? color[0] : -1;
+  data[o + 1] = color ? color[1] : -1;
+  data[o + 2] = color ? color[2] : -1;
+}
+
+/**
+ * Worker side: rebuild material objects from packed data
+ */
+export function unpackMaterial(
+  data: Float64Array,
+  offset: number,
+  slotIds: Array<number | string>,
+  previous: RaycasterMaterial | undefined
+): RaycasterMaterial | undefined {
+  const kind = data[offset];
+  if (kind === MATERIAL_SOLID) {
+    const r = data[offset + 1], g = data[offset + 2], b = data[offset + 3];
+    if (previous && previous.type === 'solid' &&
+        previous.color[0] === r && previous.color[1] === g && previous.color[2] === b) {
+      return previous;
+    }
+    return { type: 'solid', color: [r, g, b] };
+  }
+  if (kind === MATERIAL_TEXTURE) {
+    const textureId = slotIds[data[offset + 1]];
+    if (previous && previous.type === 'texture' && previous.textureId === textureId) {
+      return previous;
+    }
+    return { type: 'texture', textureId };
+  }
+  return undefined;
+}
+
+/**
+ * Worker side: color from packed data (-1 means a legacy texture id)
+ */
+export function unpackColor(data: Float64Array, offset: number): [number, number, number] | number {
+  const r = data[offset];
+  return r < 0 ? 0 : [r, data[offset + 1], data[offset + 2]];
+}
+
+/**
+ * Worker side: optional color from packed data (-1 means none)
+ */
+export function unpackOptionalColor(data: Float64Array, offset: number): [number, number, number] | undefined {
+  const r = data[offset];
+  return r < 0 ? undefined : [r, data[offset + 1], data[offset + 2]];
+}
+
+interface WorkerScript {
+  filename: string;
+  execArgv?: string[];
+}
+
+/**
+ * Find the worker entry point next to this module: compiled JavaScript in
+ * a build, or the TypeScript source when running under ts-jest/tsx
+ */
+function resolveWorkerScript(): WorkerScript | null {
+  try {
+    const fs = require('fs') as typeof import('fs');
+    const path = require('path') as typeof import('path');
+    const js = path.join(__dirname, 'raycaster-worker.js');
+    if (fs.existsSync(js)) {
+      return { filename: js };
+    }
+    const ts = path.join(__dirname, 'raycaster-worker.ts');
+    if (!fs.existsSync(ts)) {
+      return null;
+    }
+    try {
+      require.resolve('tsx/cjs');
+      return { filename: ts, execArgv: [...process.execArgv, '--require', 'tsx/cjs'] };
+    } catch {
+      return { filename: ts };
+    }
+  } catch {
+    return null;
+  }
+}
@@ -0,0 +1,168 @@
+/**
+ * Raycaster worker thread entry point (see raycaster-threads.ts)
+ *
+ * Waits on the shared frame counter, applies any queued messages, rebuilds
+ * walls and sprites from shared memory, then renders column slices until
+ * the shared slice counter runs out and reports in at the frame barrier.
+ */
+
+import { workerData, receiveMessageOnPort } from 'worker_threads';
+import { Vector3 } from './math3d';
+import { Raycaster, RaycasterCamera, RaycasterSprite, RaycasterWall } from './raycaster';
+import {
+  CTRL_DONE,
+  CTRL_FRAME,
+  CTRL_NEXT_SLICE,
+  CTRL_QUIT,
+  CTRL_READY,
+  PARAM_CAMERA,
+  PARAM_SLICE_COUNT,
+  PARAM_SPRITE_COUNT,
+  PARAM_WALL_COUNT,
+  PARAM_WALL_VERSION,
+  SLICE_COLUMNS,
+  SPRITE_STRIDE,
+  WALL_STRIDE,
+  RaycasterWorkerData,
+  RaycasterWorkerMessage,
+  unpackColor,
+  unpackMaterial,
+  unpackOptionalColor,
+} from './raycaster-threads';
+
+const { control: controlBuffer, params: paramsBuffer, port } = workerData as RaycasterWorkerData;
+const control = new Int32Array(controlBuffer);
+const params = new Float64Array(paramsBuffer);
+
+const raycaster = new Raycaster(1, 1);
+let target = new Uint8Array(0);
+let depth = new Float32Array(0);
+let wallData = new Float64Array(0);
+let spriteData = new Float64Array(0);
+const slotIds: Array<number | string> = [];
+
+let walls: RaycasterWall[] = [];
+let wallVersion = -1;
+const spritePool: RaycasterSprite[] = [];
+const sprites: RaycasterSprite[] = [];
+
+const camera: RaycasterCamera = { position: new Vector3(), angle: 0, height: 0 };
+
+function applyMessage(message: RaycasterWorkerMessage): void {
+  switch (message.type) {
+    case 'config':
+      raycaster.configure(message.config);
+      break;
+    case 'buffers':
+      raycaster.resize(message.width, message.height);
+      target = new Uint8Array(message.target);
+      depth = new Float32Array(message.depth);
+      break;
+    case 'walls':
+      wallData = new Float64Array(message.buffer);
+      break;
+    case 'sprites':
+      spriteData = new Float64Array(message.buffer);
+      break;
+    case 'texture':
+      raycaster.addTexture(message.id, message.texture);
+      break;
+    case 'slot':
+      slotIds[message.slot] = message.id;
+      break;
+  }
+}
+
+function syncWalls(): void {
+  const version = params[PARAM_WALL_VERSION];
+  if (version === wallVersion) {
+    return;
+  }
+  wallVersion = version;
+
+  const n = params[PARAM_WALL_COUNT];
+  if (n !== walls.length) {
+    // A new array makes the wall grid rebuild
+    walls = walls.slice(0, n);
+    while (walls.length < n) {
+      walls.push({ p1: new Vector3(), p2: new Vector3(), floorHeight: 0, ceilingHeight: 0, color: 0 });
+    }
+  }
+
+  // Updated in place so the wall grid only re-buckets walls that moved
+  for (let i = 0; i < n; i++) {
+    const wall = walls[i];
+    const o = i * WALL_STRIDE;
+    wall.p1.x = wallData[o];
+    wall.p1.y = wallData[o + 1];
+    wall.p2.x = wallData[o + 2];
+    wall.p2.y = wallData[o + 3];
+    wall.floorHeight = wallData[o + 4];
+    wall.ceilingHeight = wallData[o + 5];
+    wall.color = unpackColor(wallData, o + 6);
+    wall.backColor = unpackOptionalColor(wallData, o + 9);
+    wall.material = unpackMaterial(wallData, o + 12, slotIds, wall.material);
+  }
+}
+
+function syncSprites(): void {
+  const n = params[PARAM_SPRITE_COUNT];
+  sprites.length = 0;
+  for (let i = 0; i < n; i++) {
+    if (i === spritePool.length) {
+      spritePool.push({ position: new Vector3(), width: 0, height: 0, color: 0 });
+    }
+    const sprite = spritePool[i];
+    const o = i * SPRITE_STRIDE;
+    sprite.position.x = spriteData[o];
+    sprite.position.y = spriteData[o + 1];
+    sprite.position.z = spriteData[o + 2];
+    sprite.width = spriteData[o + 3];
+    sprite.height = spriteData[o + 4];
+    sprite.alpha = spriteData[o + 5];
+    sprite.zOffset = spriteData[o + 6];
+    sprite.color = unpackColor(spriteData, o + 7);
+    sprite.material = unpackMaterial(spriteData, o + 10, slotIds, sprite.material);
+    sprites.push(sprite);
+  }
+}
+
+function nextSlice(): number {
+  const slice = Atomics.add(control, CTRL_NEXT_SLICE, 1);
+  return slice < params[PARAM_SLICE_COUNT] ? slice * SLICE_COLUMNS : -1;
+}
+
+let frame = Atomics.load(control, CTRL_FRAME);
+Atomics.add(control, CTRL_READY, 1);
+
+for (;;) {
+  Atomics.wait(control, CTRL_FRAME, frame);
+  const next = Atomics.load(control, CTRL_FRAME);
+  if (next === frame) {
+    continue;
+  }
+  frame = next;
+  if (Atomics.load(control, CTRL_QUIT)) {
+    break;
+  }
+
+  for (let m = receiveMessageOnPort(port); m; m = receiveMessageOnPort(port)) {
+    applyMessage(m.message as RaycasterWorkerMessage);
+  }
+  syncWalls();
+  syncSprites();
+  camera.position.x = params[PARAM_CAMERA];
+  camera.position.y = params[PARAM_CAMERA + 1];
+  camera.position.z = params[PARAM_CAMERA + 2];
+  camera.angle = params[PARAM_CAMERA + 3];
+  camera.pitch = params[PARAM_CAMERA + 4];
+  camera.roll = params[PARAM_CAMERA + 5];
+  camera.height = params[PARAM_CAMERA + 6];
+
+  raycaster.renderSlices(target, depth, camera, walls, sprites, nextSlice);
+
+  Atomics.add(control, CTRL_DONE, 1);
+  Atomics.notify(control, CTRL_DONE);
+}
+
+port.close();
@@ -12,6 +12,11 @@
  */
 
 import { Vector3, clamp, lerp, rayLineIntersect2D } from './math3d';
+import { WallGrid } from './raycaster-grid';
+import { RaycasterThreadPool, SLICE_COLUMNS, isThreadSafeMaterial } from './raycaster-threads';
+
+// Below this many walls a linear scan beats maintaining the grid
+const WALL_GRID_MIN_WALLS = 32;
 
 /**
  * Configuration options for the raycaster
@@ -55,6 +60,17 @@ export interface RaycasterConfig {
 
   /** Vertical projection scale multiplier (default: 1.0). Higher values make walls/sprites taller. */
   projectionScale?: number;
+
+  /** Index walls in a uniform grid for ray casting when there are many (default: true) */
+  spatialIndex?: boolean;
+
+  /**
+   * Worker threads to split columns across, rendering into shared memory
+   * (default: 0 = render on the calling thread). Frames using procedural
+   * materials, and frames before the workers have started, render on the
+   * calling thread.
+   */
+  threads?: number;
 }
 
 /**
@@ -248,6 +264,13 @@ export class Raycaster {
   private overlayColor: [number, number, number, number] | null = null;
   private renderOffset: [number, number] = [0, 0];
   private projectionScale: number = 1.0;
+  private spatialIndex: boolean = true;
+  private wallGrid: WallGrid = new WallGrid();
+  // Wall list (and its length) the grid was last synced to
+  private gridWalls: RaycasterWall[] | null = null;
+  private gridWallCount = 0;
+  private threads: number = 0;
+  private threadPool: RaycasterThreadPool | null = null;
 
   constructor(width: number, height: number, config?: RaycasterConfig) {
     this.width = width;
@@ -264,6 +287,7 @@ export class Raycaster {
    */
   addTexture(id: number | string, texture: RaycasterTexture): void {
     this.textures.set(id, texture);
+    this.threadPool?.addTexture(id, texture);
   }
 
   /**
@@ -272,7 +296,12 @@ export class Raycaster {
   resize(width: number, height: number): void {
     this.width = width;
     this.height = height;
-    this.depthBuffer = new Float32Array(width);
+    if (this.threadPool) {
+      this.threadPool.resize(width, height);
+      this.depthBuffer = this.threadPool.depthBuffer;
+    } else {
+      this.depthBuffer = new Float32Array(width);
+    }
   }
 
   /**
@@ -292,6 +321,73 @@ export class Raycaster {
     if (config.overlayColor !== undefined) this.overlayColor = config.overlayColor;
     if (config.renderOffset !== undefined) this.renderOffset = config.renderOffset;
     if (config.projectionScale !== undefined) this.projectionScale = config.projectionScale;
+    if (config.spatialIndex !== undefined) this.spatialIndex = config.spatialIndex;
+
+    if (config.threads !== undefined && config.threads !== this.threads) {
+      this.threads = Math.max(0, Math.floor(config.threads));
+      this.startThreads();
+    } else if (this.threadPool) {
+      this.threadPool.configure(this.getThreadConfig());
+    }
+  }
+
+  /**
+   * Number of worker threads currently sharing the rendering (0 until they
+   * have all started, or when threading is off or unavailable)
+   */
+  getActiveThreads(): number {
+    return this.threadPool ? this.threadPool.getActiveThreads() : 0;
+  }
+
+  /**
+   * Shared-memory buffer the worker threads draw into, when threading is
+   * on. Rendering into it directly avoids copying each frame.
+   */
+  getSharedBuffer(): Uint8Array | null {
+    return this.threadPool ? this.threadPool.getTarget() : null;
+  }
+
+  /**
+   * Stop any worker threads
+   */
+  dispose(): void {
+    this.threadPool?.dispose();
+    this.threadPool = null;
+    this.depthBuffer = new Float32Array(this.width);
+  }
+
+  private startThreads(): void {
+    this.threadPool?.dispose();
+    this.threadPool = null;
+    if (this.threads > 0) {
+      this.threadPool = RaycasterThreadPool.create(
+        this.threads, this.width, this.height, this.getThreadConfig(), this.textures
+      );
+    }
+    this.depthBuffer = this.threadPool ? this.threadPool.depthBuffer : new Float32Array(this.width);
+  }
+
+  /**
+   * Configuration forwarded to worker threads (procedural materials cannot
+   * cross threads; frames that need them render on the calling thread)
+   */
+  private getThreadConfig(): RaycasterConfig {
+    return {
+      fov: this.fov,
+      maxDistance: this.maxDistance,
+      renderFloorCeiling: this.renderFloorCeiling,
+      enableFog: this.enableFog,
+      fogDensity: this.fogDensity,
+      ceilingColor: this.ceilingColor,
+      floorColor: this.floorColor,
+      // null (no material) is passed through so it clears the worker's copy
+      ceilingMaterial: isThreadSafeMaterial(this.ceilingMaterial) ? this.ceilingMaterial! : undefined,
+      floorMaterial: isThreadSafeMaterial(this.floorMaterial) ? this.floorMaterial! : undefined,
+      fogColor: this.fogColor,
+      renderOffset: this.renderOffset,
+      projectionScale: this.projectionScale,
+      spatialIndex: this.spatialIndex,
+    };
   }
 
   /**
@@ -324,29 +420,16 @@ export class Raycaster {
     sprites?: RaycasterSprite[],
     objects?: RenderableObject[]
   ): void {
-    // Create render context wrapping internal state
-    const context: RaycasterRenderContext = {
-      width: this.width,
-      height: this.height,
-      depthBuffer: this.depthBuffer,
-      camera: camera,
-      textures: this.textures,
-      renderOffset: this.renderOffset,
-      projectionScale: this.projectionScale
-    };
-
-    // 1. Clear buffer with floor/ceiling colors
-    this.clearBuffer(buffer, context);
-
-    // 2. Reset depth buffer
-    context.depthBuffer.fill(this.maxDistance);
+    // 1-4. Background, walls and sprites (split across worker threads when
+    // enabled)
+    const threaded = this.renderThreaded(buffer, camera, walls, sprites);
 
-    // 3. Render walls (one ray per column)
-    this.renderWalls(buffer, context, walls);
+    // Create render context wrapping internal state
+    const context = this.createContext(this.depthBuffer, camera);
 
-    // 4. Render sprites (sorted back-to-front)
-    if (sprites && sprites.length > 0) {
-      this.renderSprites(buffer, context, sprites);
+    if (!threaded) {
+      const sorted = this.sortSprites(camera, sprites);
+      this.renderColumns(buffer, context, walls, this.prepareWalls(walls), sorted, 0, this.width);
     }
 
     // 5. Render custom objects
@@ -362,6 +445,94 @@ export class Raycaster {
     }
   }
 
+  /**
+   * Render the column slices [x, x + SLICE_COLUMNS) handed out by
+   * nextSlice() until it returns -1. Used by the worker threads, and by the
+   * calling thread while it waits for them.
+   */
+  renderSlices(
+    buffer: Uint8Array,
+    depthBuffer: Float32Array,
+    camera: RaycasterCamera,
+    walls: RaycasterWall[],
+    sprites: RaycasterSprite[] | undefined,
+    nextSlice: () => number
+  ): void {
+    const context = this.createContext(depthBuffer, camera);
+    const indexed = this.prepareWalls(walls);
+    const sorted = this.sortSprites(camera, sprites);
+
+    for (let x0 = nextSlice(); x0 >= 0; x0 = nextSlice()) {
+      this.renderColumns(buffer, context, walls, indexed, sorted, x0, Math.min(context.width, x0 + SLICE_COLUMNS));
+    }
+  }
+
+  /**
+   * Render everything that is independent per column for columns [x0, x1)
+   */
+  private renderColumns(
+    buffer: Uint8Array,
+    context: RaycasterRenderContext,
+    walls: RaycasterWall[],
+    indexed: boolean,
+    sprites: Array<{ sprite: RaycasterSprite; distance: number }> | null,
+    x0: number,
+    x1: number
+  ): void {
+    // 1. Clear buffer with floor/ceiling colors
+    this.clearBuffer(buffer, context, x0, x1);
+
+    // 2. Reset depth buffer
+    context.depthBuffer.fill(this.maxDistance, x0, x1);
+
+    // 3. Render walls (one ray per column)
+    this.renderWalls(buffer, context, walls, indexed, x0, x1);
+
+    // 4. Render sprites (sorted back-to-front)
+    if (sprites) {
+      this.renderSprites(buffer, context, sprites, x0, x1);
+    }
+  }
+
+  private createContext(depthBuffer: Float32Array, camera: RaycasterCamera): RaycasterRenderContext {
+    return {
+      width: this.width,
+      height: this.height,
+      depthBuffer,
+      camera,
+      textures: this.textures,
+      renderOffset: this.renderOffset,
+      projectionScale: this.projectionScale
+    };
+  }
+
+  /**
+   * Render background, walls and sprites on the worker threads. Returns
+   * false when the frame has to be rendered on this thread instead.
+   */
+  private renderThreaded(
+    buffer: Uint8Array,
+    camera: RaycasterCamera,
+    walls: RaycasterWall[],
+    sprites: RaycasterSprite[] | undefined
+  ): boolean {
+    const pool = this.threadPool;
+    if (!pool) {
+      return false;
+    }
+    if (pool.isFailed()) {
+      this.dispose();
+      return false;
+    }
+    if (this.renderFloorCeiling &&
+        !(isThreadSafeMaterial(this.floorMaterial) && isThreadSafeMaterial(this.ceilingMaterial))) {
+      return false;
+    }
+    return pool.render(buffer, camera, walls, sprites, (target, nextSlice) => {
+      this.renderSlices(target, this.depthBuffer, camera, walls, sprites, nextSlice);
+    });
+  }
+
   /**
    * Apply a full-screen color overlay
    */
@@ -380,17 +551,61 @@ export class Raycaster {
   /**
    * Cast a single ray and return hit information
    * Useful for collision detection, shooting, etc.
+   *
+   * Rays go through the wall grid (see raycaster-grid.ts) when `walls` is the
+   * list it was last synced to, and test every wall otherwise. The grid is
+   * synced once per frame by render(); castRay never syncs it, so casting
+   * against several lists does not rebuild it over and over.
    */
   castRay(
     origin: Vector3,
     angle: number,
     walls: RaycasterWall[]
+  ): RaycastHit | null {
+    const indexed = walls === this.gridWalls && walls.length === this.gridWallCount;
+    return this.castRayPrepared(origin, angle, walls, indexed);
+  }
+
+  /**
+   * Index walls for castRay(). render() does this for the walls it draws;
+   * call it after moving walls between frames, or to cast many rays against
+   * a list that is not rendered. Cheap when nothing moved.
+   */
+  syncWalls(walls: RaycasterWall[]): void {
+    this.prepareWalls(walls);
+  }
+
+  /**
+   * Sync the wall grid if it should be used for this wall list
+   */
+  private prepareWalls(walls: RaycasterWall[]): boolean {
+    if (!this.spatialIndex || walls.length < WALL_GRID_MIN_WALLS) {
+      this.gridWalls = null;
+      return false;
+    }
+    this.wallGrid.sync(walls);
+    this.gridWalls = walls;
+    this.gridWallCount = walls.length;
+    return true;
+  }
+
+  private castRayPrepared(
+    origin: Vector3,
+    angle: number,
+    walls: RaycasterWall[],
+    indexed: boolean
   ): RaycastHit | null {
     const dirX = Math.cos(angle);
     const dirY = Math.sin(angle);
 
-    let closestHit: RaycastHit | null = null;
+    if (indexed) {
+      const hit = this.wallGrid.castRay(origin.x, origin.y, dirX, dirY, 0.001, this.maxDistance);
+      return hit ? this.makeHit(origin, dirX, dirY, walls[hit.index], hit.t, hit.u) : null;
+    }
+
+    let closestWall: RaycasterWall | null = null;
     let closestDistance = this.maxDistance;
+    let closestU = 0;
 
     for (const wall of walls) {
       const hit = rayLineIntersect2D(
@@ -402,39 +617,50 @@ export class Raycaster {
 
       if (hit && hit.t < closestDistance && hit.t > 0.001) {
         closestDistance = hit.t;
+        closestWall = wall;
+        closestU = hit.u;
+      }
+    }
 
-        // Calculate wall normal
-        const wallDx = wall.p2.x - wall.p1.x;
-        const wallDy = wall.p2.y - wall.p1.y;
-        const wallLen = Math.sqrt(wallDx * wallDx + wallDy * wallDy);
+    return closestWall ? this.makeHit(origin, dirX, dirY, closestWall, closestDistance, closestU) : null;
+  }
 
-        // Normal perpendicular to wall
-        let normalX = -wallDy / wallLen;
-        let normalY = wallDx / wallLen;
+  private makeHit(
+    origin: Vector3,
+    dirX: number,
+    dirY: number,
+    wall: RaycasterWall,
+    t: number,
+    u: number
+  ): RaycastHit {
+    // Calculate wall normal
+    const wallDx = wall.p2.x - wall.p1.x;
+    const wallDy = wall.p2.y - wall.p1.y;
+    const wallLen = Math.sqrt(wallDx * wallDx + wallDy * wallDy);
 
-        // Determine which side we hit (0 = front, 1 = back)
-        const side = (dirX * normalX + dirY * normalY) > 0 ? 1 : 0;
-        if (side === 1) {
-          normalX = -normalX;
-          normalY = -normalY;
-        }
+    // Normal perpendicular to wall
+    let normalX = -wallDy / wallLen;
+    let normalY = wallDx / wallLen;
 
-        closestHit = {
-          distance: hit.t,
-          point: new Vector3(
-            origin.x + dirX * hit.t,
-            origin.y + dirY * hit.t,
-            0
-          ),
-          wallU: hit.u,
-          wall,
-          normal: new Vector3(normalX, normalY, 0),
-          side,
-        };
-      }
+    // Determine which side we hit (0 = front, 1 = back)
+    const side = (dirX * normalX + dirY * normalY) > 0 ? 1 : 0;
+    if (side === 1) {
+      normalX = -normalX;
+      normalY = -normalY;
     }
 
-    return closestHit;
+    return {
+      distance: t,
+      point: new Vector3(
+        origin.x + dirX * t,
+        origin.y + dirY * t,
+        0
+      ),
+      wallU: u,
+      wall,
+      normal: new Vector3(normalX, normalY, 0),
+      side,
+    };
   }
 
   /**
@@ -561,13 +787,13 @@ export class Raycaster {
   /**
    * Clear the buffer with floor and ceiling colors
    */
-  private clearBuffer(buffer: Uint8Array, context: RaycasterRenderContext): void {
+  private clearBuffer(buffer: Uint8Array, context: RaycasterRenderContext, x0: number, x1: number): void {
     const halfHeight = context.height / 2;
     const pitch = context.camera.pitch || 0;
     const roll = context.camera.roll || 0;
     const pitchOffset = pitch * context.height * 0.5;
 
-    for (let x = 0; x < context.width; x++) {
+    for (let x = x0; x < x1; x++) {
       // Ray direction for this column
       // Left edge (x=0) should be camera.angle + fov/2 (counterclockwise)
       // Right edge (x=width) should be camera.angle - fov/2 (clockwise)
@@ -660,14 +886,17 @@ export class Raycaster {
   }
 
   /**
-   * Render all walls by casting rays
+   * Render walls in columns [x0, x1) by casting rays
    */
   private renderWalls(
     buffer: Uint8Array,
     context: RaycasterRenderContext,
-    walls: RaycasterWall[]
+    walls: RaycasterWall[],
+    indexed: boolean,
+    x0: number,
+    x1: number
   ): void {
-    for (let x = 0; x < context.width; x++) {
+    for (let x = x0; x < x1; x++) {
       // Calculate ray angle for this column
       // Left edge (x=0) should be camera.angle + fov/2 (counterclockwise)
       // Right edge (x=width) should be camera.angle - fov/2 (clockwise)
@@ -675,7 +904,7 @@ export class Raycaster {
       const rayAngle = context.camera.angle - rayScreenPos * this.fov;
 
       // Cast ray
-      const hit = this.castRay(context.camera.position, rayAngle, walls);
+      const hit = this.castRayPrepared(context.camera.position, rayAngle, walls, indexed);
 
       if (hit) {
         // Fisheye correction: use perpendicular distance
@@ -803,29 +1032,43 @@ export class Raycaster {
   }
 
   /**
-   * Render all sprites
+   * Sort sprites far to near from the camera
    */
-  private renderSprites(
-    buffer: Uint8Array,
-    context: RaycasterRenderContext,
-    sprites: RaycasterSprite[]
-  ): void {
+  private sortSprites(
+    camera: RaycasterCamera,
+    sprites: RaycasterSprite[] | undefined
+  ): Array<{ sprite: RaycasterSprite; distance: number }> | null {
+    if (!sprites || sprites.length === 0) {
+      return null;
+    }
+
     // Calculate distance from camera to each sprite and sort
     const spriteData: Array<{ sprite: RaycasterSprite; distance: number }> = [];
 
     for (const sprite of sprites) {
-      const dx = sprite.position.x - context.camera.position.x;
-      const dy = sprite.position.y - context.camera.position.y;
+      const dx = sprite.position.x - camera.position.x;
+      const dy = sprite.position.y - camera.position.y;
       const distance = Math.sqrt(dx * dx + dy * dy);
       spriteData.push({ sprite, distance });
     }
 
     // Sort by distance (far to near)
     spriteData.sort((a, b) => b.distance - a.distance);
+    return spriteData;
+  }
 
-    // Render each sprite
-    for (const { sprite, distance } of spriteData) {
-      this.renderSprite(buffer, context, sprite, distance);
+  /**
+   * Render sorted sprites into columns [x0, x1)
+   */
+  private renderSprites(
+    buffer: Uint8Array,
+    context: RaycasterRenderContext,
+    sprites: Array<{ sprite: RaycasterSprite; distance: number }>,
+    x0: number,
+    x1: number
+  ): void {
+    for (const { sprite, distance } of sprites) {
+      this.renderSprite(buffer, context, sprite, distance, x0, x1);
     }
   }
 
@@ -836,7 +1079,9 @@ export class Raycaster {
     buffer: Uint8Array,
     context: RaycasterRenderContext,
     sprite: RaycasterSprite,
-    distance: number
+    distance: number,
+    x0: number,
+    x1: number
   ): void {
     // Calculate sprite position relative to camera
     const dx = sprite.position.x - context.camera.position.x;
@@ -887,7 +1132,7 @@ export class Raycaster {
     const alpha = sprite.alpha !== undefined ? sprite.alpha : 1.0;
 
     // Draw sprite pixels
-    for (let x = Math.max(0, spriteStartX); x < Math.min(context.width, spriteEndX); x++) {
+    for (let x = Math.max(x0, spriteStartX); x < Math.min(x1, spriteEndX); x++) {
       // Check depth buffer - only draw if sprite is closer than wall
       if (transformY >= context.depthBuffer[x]) continue;
 
@@ -0,0 +1,131 @@
+/**
+ * Frame arena for Renderer3D buffer rendering
+ *
+ * Owns every piece of scratch storage the buffer pipeline touches per frame:
+ * per-vertex clip coordinates and shading, the MVP matrix, and the pool of
+ * render items (translucent primitives awaiting sorting). Storage is
+ * preallocated typed arrays that only grow (geometrically) when a frame
+ * needs more than any previous frame did; reset() just rewinds counters.
+ * A steady-state frame therefore allocates nothing.
+ */
+
+import { Matrix4 } from './math3d';
+import { Primitive3D } from './primitives3d/base3d';
+
+export class FrameArena {
+  /** Clip-space coordinates per vertex (x, y, z, w) */
+  clipCoords: Float32Array;
+  /** Lighting intensity per vertex */
+  vertexShade: Float32Array;
+  /** Scratch model-view-projection matrix */
+  readonly mvp = new Matrix4();
+
+  // Render item pool: parallel arrays indexed by item slot
+  private itemPrimitives: Array<Primitive3D | null>;
+  private itemDepths: Float64Array;
+  private itemOrder: Uint32Array;
+  private count = 0;
+
+  // Number of times any pool had to grow (steady state: unchanged per frame)
+  private growCount = 0;
+
+  constructor(vertexCapacity = 1024, itemCapacity = 64) {
+    this.clipCoords = new Float32Array(vertexCapacity * 4);
+    this.vertexShade = new Float32Array(vertexCapacity);
+    this.itemPrimitives = new Array(itemCapacity).fill(null);
+    this.itemDepths = new Float64Array(itemCapacity);
+    this.itemOrder = new Uint32Array(itemCapacity);
+  }
+
+  /**
+   * Rewind the item pool for a new frame (keeps all storage)
+   */
+  reset(): void {
+    for (let i = 0; i < this.count; i++) {
+      this.itemPrimitives[i] = null;
+    }
+    this.count = 0;
+  }
+
+  /**
+   * Make sure the vertex buffers hold at least vertexCount vertices
+   */
+  reserveVertices(vertexCount: number): void {
+    if (this.vertexShade.length >= vertexCount) {
+      return;
+    }
+    const capacity = Math.max(vertexCount, this.vertexShade.length * 2);
+    this.clipCoords = new Float32Array(capacity * 4);
+    this.vertexShade = new Float32Array(capacity);
+    this.growCount++;
+  }
+
+  /**
+   * Queue a primitive with its sort depth
+   */
+  pushItem(primitive: Primitive3D, depth: number): void {
+    if (this.count === this.itemDepths.length) {
+      this.growItems();
+    }
+    const i = this.count++;
+    this.itemPrimitives[i] = primitive;
+    this.itemDepths[i] = depth;
+    this.itemOrder[i] = i;
+  }
+
+  get itemCount(): number {
+    return this.count;
+  }
+
+  /**
+   * Sort queued items far-to-near in place (shell sort: no allocation,
+   * and no comparator closure as Array.prototype.sort would need)
+   */
+  sortItemsBackToFront(): void {
+    const order = this.itemOrder;
+    const depths = this.itemDepths;
+    const n = this.count;
+    let gap = 1;
+    while (gap < n / 3) gap = gap * 3 + 1;
+    for (; gap > 0; gap = (gap - 1) / 3) {
+      for (let i = gap; i < n; i++) {
+        const item = order[i];
+        const d = depths[item];
+        let j = i;
+        while (j >= gap && depths[order[j - gap]] < d) {
+          order[j] = order[j - gap];
+          j -= gap;
+        }
+        order[j] = item;
+      }
+    }
+  }
+
+  /**
+   * Primitive at position i in the current (possibly sorted) item order
+   */
+  itemAt(i: number): Primitive3D {
+    return this.itemPrimitives[this.itemOrder[i]]!;
+  }
+
+  /**
+   * How many times storage has grown since creation (for diagnostics/tests)
+   */
+  getGrowCount(): number {
+    return this.growCount;
+  }
+
+  private growItems(): void {
+    const capacity = this.itemDepths.length * 2;
+    const depths = new Float64Array(capacity);
+    depths.set(this.itemDepths);
+    const order = new Uint32Array(capacity);
+    order.set(this.itemOrder);
+    for (let i = this.itemPrimitives.length; i < capacity; i++) {
+      this.itemPrimitives.push(null);
+    }
+    this.itemDepths = depths;
+    this.itemOrder = order;
+    this.growCount++;
+  }
+}
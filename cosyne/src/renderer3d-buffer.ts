@@ -1,434 +1,462 @@
 /**
  * Buffer rendering functions for Renderer3D
  * Renders 3D primitives to pixel buffers using software rasterization
+ *
+ * Pipeline: each primitive's cached triangle mesh (renderer3d-mesh.ts) is
+ * transformed in one batch per primitive, lit per vertex, clipped against the
+ * near plane, then scan-converted with per-scanline interpolation of depth and
+ * intensity into a float depth buffer on the RenderTarget. Intersecting
+ * objects therefore resolve per pixel rather than per object.
+ *
+ * The frame loop is allocation-free in steady state: scratch storage lives in
+ * a FrameArena (renderer3d-arena.ts), lighting uses the scalar LightManager
+ * API, and colors are parsed when set rather than per frame. Primitives come
+ * from the context's BVH, already frustum (and optionally occlusion) culled.
  */
 
 import { Cosyne3dContext } from './context3d';
 import { Primitive3D } from './primitives3d/base3d';
-import { Sphere3D } from './primitives3d/sphere3d';
-import { Box3D } from './primitives3d/box3d';
-import { Plane3D } from './primitives3d/plane3d';
-import { Cylinder3D } from './primitives3d/cylinder3d';
 import { Camera } from './camera';
-import { Vector3 } from './math3d';
 import { LightManager } from './light';
-import { BufferRenderItem, ScreenPoint } from './renderer3d-types';
+import { Mesh3D, getPrimitiveMesh } from './renderer3d-mesh';
+import { FrameArena } from './renderer3d-arena';
 
 import {
   RenderTarget,
   createRenderTarget,
   clearRenderTarget,
+  clearDepthBuffer,
 } from '../../core/dist/src/graphics/platform';
 import {
-  drawCircle as rasterDrawCircle,
-  fillPolygon as rasterFillPolygon,
+  Color,
   parseColor as rasterParseColor,
-  Color as RasterColor,
 } from '../../core/dist/src/graphics/rasterizer';
 
+// Smallest clip-space w kept after near-plane clipping
+const NEAR_EPSILON = 1e-5;
+
+// Arena used when the caller does not supply one
+const defaultArena = new FrameArena();
+
+// Clipped polygon scratch (a triangle clipped by one plane has at most 4 vertices)
+const polyIn = new Float32Array(5 * 4);         // x, y, z, w, shade
+const polyOut = new Float32Array(5 * 4);
+
+// Background color parsed once per distinct value
+let backgroundKey = '';
+let backgroundColor: Color = { r: 0, g: 0, b: 0, a: 255 };
+
 /**
  * Render a Cosyne3D context to a pixel buffer (software rendering)
  * Use this for high-frequency animation to avoid widget creation overhead.
  *
  * @param ctx - The Cosyne3D context to render
  * @param target - Optional existing RenderTarget to reuse (for performance)
+ * @param arena - Optional frame arena (one per concurrently rendered scene
+ *   avoids regrowing scratch storage when scenes differ greatly in size)
  * @returns The pixel buffer as a Uint8Array (RGBA format)
  */
-export function renderToBuffer(ctx: Cosyne3dContext, target?: RenderTarget): Uint8Array {
+export function renderToBuffer(
+  ctx: Cosyne3dContext,
+  target?: RenderTarget,
+  arena: FrameArena = defaultArena
+): Uint8Array {
   const camera = ctx.getCamera();
-  const width = ctx.getWidth();
-  const height = ctx.getHeight();
   const lightManager = ctx.getLightManager();
-  const primitives = ctx.getVisiblePrimitives();
+  const primitives = ctx.getRenderablePrimitives();
 
   // Create or reuse render target
-  const renderTarget = target || createRenderTarget(width, height);
+  const renderTarget = target || createRenderTarget(ctx.getWidth(), ctx.getHeight());
 
-  // Clear to background color
-  const bgColor = rasterParseColor(ctx.getBackgroundColor());
+  // Clear to background color and reset depth to the far plane
+  const bgColor = getBackgroundColor(ctx.getBackgroundColor());
   clearRenderTarget(renderTarget, bgColor.r, bgColor.g, bgColor.b, bgColor.a);
+  clearDepthBuffer(renderTarget, 1);
 
-  // Collect all render items with depth
-  const bufferItems: BufferRenderItem[] = [];
+  arena.reset();
+  const ambient = lightManager.calculateAmbient();
+  const camPos = camera.position;
 
-  // Process each primitive
-  for (const primitive of primitives) {
-    const items = processPrimitiveToBuffer(primitive, camera, width, height, lightManager);
-    bufferItems.push(...items);
+  // Opaque geometry first in any order; translucent geometry afterwards,
+  // back to front, tested against (but not writing) depth
+  for (let i = 0; i < primitives.length; i++) {
+    const primitive = primitives[i];
+    if (!primitive.visible) {
+      continue;
+    }
+    const material = primitive.material;
+    if (material.opacity < 1 || material.getParsedColor().a < 255) {
+      const world = primitive.getWorldMatrix().elements;
+      const dx = world[12] - camPos.x;
+      const dy = world[13] - camPos.y;
+      const dz = world[14] - camPos.z;
+      arena.pushItem(primitive, Math.sqrt(dx * dx + dy * dy + dz * dz));
+      continue;
+    }
+    drawPrimitive(renderTarget, primitive, camera, lightManager, ambient, arena);
   }
 
-  // Sort by depth (back to front - painter's algorithm)
-  bufferItems.sort((a, b) => b.depth - a.depth);
-
-  // Render all items to buffer
-  for (const item of bufferItems) {
-    item.renderToBuffer(renderTarget);
+  arena.sortItemsBackToFront();
+  for (let i = 0; i < arena.itemCount; i++) {
+    drawPrimitive(renderTarget, arena.itemAt(i), camera, lightManager, ambient, arena);
   }
+  arena.reset();
 
   return renderTarget.pixels;
 }
 
-/**
- * Process a primitive for buffer rendering
- */
-function processPrimitiveToBuffer(
-  primitive: Primitive3D,
-  camera: Camera,
-  width: number,
-  height: number,
-  lightManager: LightManager
-): BufferRenderItem[] {
-  if (primitive instanceof Sphere3D) {
-    return renderSphereToBuffer(primitive, camera, width, height, lightManager);
-  } else if (primitive instanceof Box3D) {
-    return renderBoxToBuffer(primitive, camera, width, height, lightManager);
-  } else if (primitive instanceof Plane3D) {
-    return renderPlaneToBuffer(primitive, camera, width, height, lightManager);
-  } else if (primitive instanceof Cylinder3D) {
-    return renderCylinderToBuffer(primitive, camera, width, height, lightManager);
+function getBackgroundColor(value: string): Color {
+  if (value !== backgroundKey) {
+    backgroundColor = rasterParseColor(value);
+    backgroundKey = value;
   }
-  return [];
-}
-
-/**
- * Project a 3D world point to screen coordinates
- */
-function projectToScreen(
-  point: Vector3,
-  camera: Camera,
-  width: number,
-  height: number
-): ScreenPoint {
-  const projected = camera.projectToPixel(point, width, height);
-  const ndc = camera.projectToNDC(point);
-
-  return {
-    x: projected.x,
-    y: projected.y,
-    z: ndc.z,
-    visible: ndc.z >= -1 && ndc.z <= 1,
-  };
+  return backgroundColor;
 }
 
 /**
- * Calculate perspective-correct screen radius for a sphere
+ * Transform, light, clip and rasterize one primitive's mesh
  */
-function calculateScreenRadius(
-  center: Vector3,
-  radius: number,
+function drawPrimitive(
+  target: RenderTarget,
+  primitive: Primitive3D,
   camera: Camera,
-  width: number,
-  height: number
-): number {
-  const centerScreen = camera.projectToPixel(center, width, height);
-  const right = camera.getRight();
-  const edgePoint = center.add(right.multiplyScalar(radius));
-  const edgeScreen = camera.projectToPixel(edgePoint, width, height);
-
-  const dx = edgeScreen.x - centerScreen.x;
-  const dy = edgeScreen.y - centerScreen.y;
-  return Math.sqrt(dx * dx + dy * dy);
-}
+  lightManager: LightManager,
+  ambient: number,
+  arena: FrameArena
+): void {
+  const mesh = getPrimitiveMesh(primitive);
+  if (!mesh) {
+    return;
+  }
 
-/**
- * Calculate lighting at a point on a surface
- */
-function calculateLighting(
-  point: Vector3,
-  normal: Vector3,
-  camera: Camera,
-  lightManager: LightManager
-): { diffuse: number; ambient: number } {
-  const viewDir = camera.position.sub(point).normalize();
-  const lighting = lightManager.calculateLightingAt(point, normal, viewDir);
-  return {
-    diffuse: lighting.diffuse,
-    ambient: lighting.ambient,
-  };
-}
+  const material = primitive.material;
+  const baseColor = material.getParsedColor();
+  const alpha = Math.round(baseColor.a * material.opacity);
+  if (alpha <= 0) {
+    return;
+  }
+  const doubleSided = mesh.doubleSided || material.doubleSided;
 
-/**
- * Apply lighting to a RasterColor
- */
-function applyLightingToRasterColor(
-  baseColor: RasterColor,
-  diffuse: number,
-  ambient: number
-): RasterColor {
-  const intensity = Math.min(1.0, Math.max(0.2, ambient + diffuse * 0.6));
-  return {
-    r: Math.min(255, Math.round(baseColor.r * intensity)),
-    g: Math.min(255, Math.round(baseColor.g * intensity)),
-    b: Math.min(255, Math.round(baseColor.b * intensity)),
-    a: baseColor.a,
-  };
-}
+  transformMesh(mesh, primitive, camera, lightManager, ambient, doubleSided, material.unlit, arena);
+  const clipCoords = arena.clipCoords;
+  const vertexShade = arena.vertexShade;
 
-/**
- * Render a sphere to buffer
- */
-function renderSphereToBuffer(
-  sphere: Sphere3D,
-  camera: Camera,
-  width: number,
-  height: number,
-  lightManager: LightManager
-): BufferRenderItem[] {
-  const worldPos = sphere.getWorldPosition();
-  const screenPos = projectToScreen(worldPos, camera, width, height);
+  const depth = target.depth!;
+  const width = target.width;
+  const height = target.height;
+  const indices = mesh.indices;
 
-  if (!screenPos.visible) {
-    return [];
-  }
+  for (let t = 0; t < indices.length; t += 3) {
+    const i0 = indices[t];
+    const i1 = indices[t + 1];
+    const i2 = indices[t + 2];
 
-  const scale = sphere.scale;
-  const avgScale = (scale.x + scale.y + scale.z) / 3;
-  const worldRadius = sphere.radius * avgScale;
-  const screenRadius = calculateScreenRadius(worldPos, worldRadius, camera, width, height);
+    loadClipVertex(polyIn, 0, clipCoords, vertexShade, i0);
+    loadClipVertex(polyIn, 1, clipCoords, vertexShade, i1);
+    loadClipVertex(polyIn, 2, clipCoords, vertexShade, i2);
 
-  if (screenRadius < 1) {
-    return [];
-  }
+    const count = clipNear(polyIn, 3, polyOut);
+    if (count < 3) {
+      continue;
+    }
 
-  const material = sphere.material;
-  const baseColor = rasterParseColor(material.color);
-  const depth = camera.position.distanceTo(worldPos);
+    // Perspective divide and viewport transform, in place
+    for (let k = 0; k < count; k++) {
+      const o = k * 5;
+      const invW = 1 / polyOut[o + 3];
+      polyOut[o] = (polyOut[o] * invW + 1) * 0.5 * width;
+      polyOut[o + 1] = (1 - polyOut[o + 1] * invW) * 0.5 * height;
+      polyOut[o + 2] = polyOut[o + 2] * invW;
+    }
 
-  const normal = camera.position.sub(worldPos).normalize();
-  const lighting = calculateLighting(worldPos, normal, camera, lightManager);
-  const litColor = applyLightingToRasterColor(baseColor, lighting.diffuse, lighting.ambient);
+    // Backface culling: front faces are CCW in NDC, i.e. negative area with y down
+    if (!doubleSided) {
+      const area = (polyOut[5] - polyOut[0]) * (polyOut[11] - polyOut[1]) -
+        (polyOut[10] - polyOut[0]) * (polyOut[6] - polyOut[1]);
+      if (area >= 0) {
+        continue;
+      }
+    }
 
-  return [{
-    depth,
-    renderToBuffer: (target: RenderTarget) => {
-      rasterDrawCircle(target, screenPos.x, screenPos.y, screenRadius, litColor, true);
-    },
-  }];
+    for (let k = 1; k + 1 < count; k++) {
+      const a = 0;
+      const b = k * 5;
+      const c = (k + 1) * 5;
+      rasterizeTriangle(
+        target.pixels, depth, width, height,
+        polyOut[a], polyOut[a + 1], polyOut[a + 2], polyOut[a + 4],
+        polyOut[b], polyOut[b + 1], polyOut[b + 2], polyOut[b + 4],
+        polyOut[c], polyOut[c + 1], polyOut[c + 2], polyOut[c + 4],
+        baseColor.r, baseColor.g, baseColor.b, alpha
+      );
+    }
+  }
 }
 
 /**
- * Render a box to buffer
+ * Batch-transform mesh vertices to clip space and compute per-vertex lighting
  */
-function renderBoxToBuffer(
-  box: Box3D,
+function transformMesh(
+  mesh: Mesh3D,
+  primitive: Primitive3D,
   camera: Camera,
-  width: number,
-  height: number,
-  lightManager: LightManager
-): BufferRenderItem[] {
-  const items: BufferRenderItem[] = [];
-  const faces: Array<'front' | 'back' | 'left' | 'right' | 'top' | 'bottom'> = [
-    'front', 'back', 'left', 'right', 'top', 'bottom',
-  ];
-
-  const material = box.material;
-  const baseColor = rasterParseColor(material.color);
-
-  const faceNormals: Record<string, Vector3> = {
-    front: new Vector3(0, 0, 1),
-    back: new Vector3(0, 0, -1),
-    left: new Vector3(-1, 0, 0),
-    right: new Vector3(1, 0, 0),
-    top: new Vector3(0, 1, 0),
-    bottom: new Vector3(0, -1, 0),
-  };
-
-  for (const face of faces) {
-    const vertices = box.getFaceVertices(face);
-    const faceCenter = box.getFaceCenter(face);
-
-    const localNormal = faceNormals[face];
-    const worldNormal = localNormal.applyMatrix4(box.getWorldMatrix().extractRotation()).normalize();
-
-    const toCamera = camera.position.sub(faceCenter).normalize();
-    if (worldNormal.dot(toCamera) < 0) {
+  lightManager: LightManager,
+  ambient: number,
+  doubleSided: boolean,
+  unlit: boolean,
+  arena: FrameArena
+): void {
+  const vertexCount = mesh.positions.length / 3;
+  arena.reserveVertices(vertexCount);
+  const clipCoords = arena.clipCoords;
+  const vertexShade = arena.vertexShade;
+
+  const worldMatrix = primitive.getWorldMatrix();
+  const world = worldMatrix.elements;
+  const mvp = arena.mvp.multiplyMatrices(camera.getViewProjectionMatrix(), worldMatrix).elements;
+
+  // Normal matrix = cofactor matrix of the upper 3x3 (inverse-transpose up to scale)
+  const a00 = world[0], a01 = world[4], a02 = world[8];
+  const a10 = world[1], a11 = world[5], a12 = world[9];
+  const a20 = world[2], a21 = world[6], a22 = world[10];
+  const c00 = a11 * a22 - a12 * a21, c01 = a12 * a20 - a10 * a22, c02 = a10 * a21 - a11 * a20;
+  const c10 = a02 * a21 - a01 * a22, c11 = a00 * a22 - a02 * a20, c12 = a01 * a20 - a00 * a21;
+  const c20 = a01 * a12 - a02 * a11, c21 = a02 * a10 - a00 * a12, c22 = a00 * a11 - a01 * a10;
+  const det = a00 * c00 + a01 * c01 + a02 * c02;
+  const sign = det < 0 ? -1 : 1;
+
+  const camPos = camera.position;
+  const positions = mesh.positions;
+  const normals = mesh.normals;
+
+  for (let i = 0; i < vertexCount; i++) {
+    const p = i * 3;
+    const x = positions[p], y = positions[p + 1], z = positions[p + 2];
+
+    const o = i * 4;
+    clipCoords[o] = mvp[0] * x + mvp[4] * y + mvp[8] * z + mvp[12];
+    clipCoords[o + 1] = mvp[1] * x + mvp[5] * y + mvp[9] * z + mvp[13];
+    clipCoords[o + 2] = mvp[2] * x + mvp[6] * y + mvp[10] * z + mvp[14];
+    clipCoords[o + 3] = mvp[3] * x + mvp[7] * y + mvp[11] * z + mvp[15];
+
+    if (unlit) {
+      vertexShade[i] = 1;
       continue;
     }
 
-    const screenPoints: ScreenPoint[] = vertices.map(v =>
-      projectToScreen(v, camera, width, height)
-    );
-
-    if (screenPoints.some(p => !p.visible)) {
-      continue;
+    const wx = world[0] * x + world[4] * y + world[8] * z + world[12];
+    const wy = world[1] * x + world[5] * y + world[9] * z + world[13];
+    const wz = world[2] * x + world[6] * y + world[10] * z + world[14];
+
+    const lnx = normals[p], lny = normals[p + 1], lnz = normals[p + 2];
+    let nx = sign * (c00 * lnx + c01 * lny + c02 * lnz);
+    let ny = sign * (c10 * lnx + c11 * lny + c12 * lnz);
+    let nz = sign * (c20 * lnx + c21 * lny + c22 * lnz);
+    const nLen = Math.sqrt(nx * nx + ny * ny + nz * nz) || 1;
+    nx /= nLen;
+    ny /= nLen;
+    nz /= nLen;
+
+    let vx = camPos.x - wx, vy = camPos.y - wy, vz = camPos.z - wz;
+    const vLen = Math.sqrt(vx * vx + vy * vy + vz * vz) || 1;
+    vx /= vLen;
+    vy /= vLen;
+    vz /= vLen;
+
+    // Double-sided surfaces are lit from whichever side faces the camera
+    if (doubleSided && nx * vx + ny * vy + nz * vz < 0) {
+      nx = -nx;
+      ny = -ny;
+      nz = -nz;
     }
 
-    const lighting = calculateLighting(faceCenter, worldNormal, camera, lightManager);
-    const litColor = applyLightingToRasterColor(baseColor, lighting.diffuse, lighting.ambient);
-    const depth = camera.position.distanceTo(faceCenter);
-    const finalPoints = screenPoints.map(p => ({ x: p.x, y: p.y }));
-
-    items.push({
-      depth,
-      renderToBuffer: (target: RenderTarget) => {
-        rasterFillPolygon(target, finalPoints, litColor);
-      },
-    });
+    const diffuse = lightManager.calculateDiffuseAt(wx, wy, wz, nx, ny, nz);
+    vertexShade[i] = Math.min(1.0, Math.max(0.2, ambient + diffuse * 0.6));
   }
+}
 
-  return items;
+function loadClipVertex(
+  poly: Float32Array,
+  slot: number,
+  clipCoords: Float32Array,
+  vertexShade: Float32Array,
+  index: number
+): void {
+  const o = slot * 5;
+  const c = index * 4;
+  poly[o] = clipCoords[c];
+  poly[o + 1] = clipCoords[c + 1];
+  poly[o + 2] = clipCoords[c + 2];
+  poly[o + 3] = clipCoords[c + 3];
+  poly[o + 4] = vertexShade[index];
 }
 
 /**
- * Render a plane to buffer
+ * Clip a polygon against the near plane (z >= -w, w > 0).
+ * Vertices are [x, y, z, w, shade]. Returns the output vertex count.
  */
-function renderPlaneToBuffer(
-  plane: Plane3D,
-  camera: Camera,
-  width: number,
-  height: number,
-  lightManager: LightManager
-): BufferRenderItem[] {
-  const corners = plane.getCorners();
-  const worldNormal = plane.getWorldNormal();
-  const worldPos = plane.getWorldPosition();
-
-  const toCamera = camera.position.sub(worldPos).normalize();
-  const facingCamera = worldNormal.dot(toCamera);
-  const effectiveNormal = facingCamera >= 0 ? worldNormal : worldNormal.negate();
-
-  const screenPoints: ScreenPoint[] = corners.map(v =>
-    projectToScreen(v, camera, width, height)
-  );
-
-  if (screenPoints.every(p => !p.visible)) {
-    return [];
+function clipNear(input: Float32Array, count: number, output: Float32Array): number {
+  let allInside = true;
+  let allOutside = true;
+  for (let i = 0; i < count; i++) {
+    const o = i * 5;
+    const inside = input[o + 2] + input[o + 3] >= 0 && input[o + 3] > NEAR_EPSILON;
+    allInside = allInside && inside;
+    allOutside = allOutside && !inside;
+  }
+  if (allOutside) {
+    return 0;
+  }
+  if (allInside) {
+    for (let k = 0; k < count * 5; k++) {
+      output[k] = input[k];
+    }
+    return count;
   }
 
-  const material = plane.material;
-  const baseColor = rasterParseColor(material.color);
-  const lighting = calculateLighting(worldPos, effectiveNormal, camera, lightManager);
-  const litColor = applyLightingToRasterColor(baseColor, lighting.diffuse, lighting.ambient);
-  const depth = camera.position.distanceTo(worldPos);
-
-  return [{
-    depth,
-    renderToBuffer: (target: RenderTarget) => {
-      rasterFillPolygon(target, screenPoints.map(p => ({ x: p.x, y: p.y })), litColor);
-    },
-  }];
+  let n = 0;
+  for (let i = 0; i < count; i++) {
+    const a = i * 5;
+    const b = ((i + 1) % count) * 5;
+    const da = input[a + 2] + input[a + 3];
+    const db = input[b + 2] + input[b + 3];
+    const aIn = da >= 0 && input[a + 3] > NEAR_EPSILON;
+    const bIn = db >= 0 && input[b + 3] > NEAR_EPSILON;
+
+    if (aIn) {
+      const o = n * 5;
+      for (let k = 0; k < 5; k++) {
+        output[o + k] = input[a + k];
+      }
+      n++;
+    }
+    if (aIn !== bIn) {
+      const t = da / (da - db);
+      const o = n * 5;
+      for (let k = 0; k < 5; k++) {
+        output[o + k] = input[a + k] + (input[b + k] - input[a + k]) * t;
+      }
+      if (output[o + 3] <= NEAR_EPSILON) {
+        output[o + 3] = NEAR_EPSILON;
+      }
+      n++;
+    }
+  }
+  return n;
 }
 
 /**
- * Render a cylinder to buffer
+ * Scan-convert a screen-space triangle with depth testing.
+ * Depth (NDC z) and shade are interpolated along edges, then per scanline.
+ * Pixel centers are at +0.5; alpha < 255 blends without writing depth.
  */
-function renderCylinderToBuffer(
-  cylinder: Cylinder3D,
-  camera: Camera,
+function rasterizeTriangle(
+  pixels: Uint8Array,
+  depth: Float32Array,
   width: number,
   height: number,
-  lightManager: LightManager
-): BufferRenderItem[] {
-  const items: BufferRenderItem[] = [];
-  const worldMatrix = cylinder.getWorldMatrix();
-  const material = cylinder.material;
-  const baseColor = rasterParseColor(material.color);
-
-  const halfHeight = cylinder.height / 2;
-  const radiusTop = cylinder.radiusTop;
-  const radiusBottom = cylinder.radiusBottom;
-  const segments = Math.max(16, cylinder.radialSegments);
-
-  const generateCapVertices = (y: number, radius: number): Vector3[] => {
-    const vertices: Vector3[] = [];
-    for (let i = 0; i < segments; i++) {
-      const angle = (i / segments) * Math.PI * 2;
-      const x = Math.cos(angle) * radius;
-      const z = Math.sin(angle) * radius;
-      const localPoint = new Vector3(x, y, z);
-      vertices.push(localPoint.applyMatrix4(worldMatrix));
-    }
-    return vertices;
-  };
-
-  // Top cap
-  if (!cylinder.openEnded && radiusTop > 0) {
-    const topVertices = generateCapVertices(halfHeight, radiusTop);
-    const topCenter = new Vector3(0, halfHeight, 0).applyMatrix4(worldMatrix);
-    const localNormal = new Vector3(0, 1, 0);
-    const worldNormal = localNormal.applyMatrix4(worldMatrix.extractRotation()).normalize();
-    const toCamera = camera.position.sub(topCenter).normalize();
-
-    if (worldNormal.dot(toCamera) >= 0) {
-      const screenPoints = topVertices.map(v => projectToScreen(v, camera, width, height));
-      if (screenPoints.some(p => p.visible)) {
-        const lighting = calculateLighting(topCenter, worldNormal, camera, lightManager);
-        const litColor = applyLightingToRasterColor(baseColor, lighting.diffuse, lighting.ambient);
-        const depth = camera.position.distanceTo(topCenter);
-        const points = screenPoints.map(p => ({ x: p.x, y: p.y }));
-        items.push({
-          depth,
-          renderToBuffer: (target: RenderTarget) => {
-            rasterFillPolygon(target, points, litColor);
-          },
-        });
-      }
-    }
+  x0: number, y0: number, z0: number, s0: number,
+  x1: number, y1: number, z1: number, s1: number,
+  x2: number, y2: number, z2: number, s2: number,
+  r: number, g: number, b: number, a: number
+): void {
+  // Sort vertices by y (0 top, 2 bottom)
+  let tx: number, ty: number, tz: number, ts: number;
+  if (y1 < y0) {
+    tx = x0; ty = y0; tz = z0; ts = s0;
+    x0 = x1; y0 = y1; z0 = z1; s0 = s1;
+    x1 = tx; y1 = ty; z1 = tz; s1 = ts;
   }
-
-  // Bottom cap
-  if (!cylinder.openEnded && radiusBottom > 0) {
-    const bottomVertices = generateCapVertices(-halfHeight, radiusBottom);
-    const bottomCenter = new Vector3(0, -halfHeight, 0).applyMatrix4(worldMatrix);
-    const localNormal = new Vector3(0, -1, 0);
-    const worldNormal = localNormal.applyMatrix4(worldMatrix.extractRotation()).normalize();
-    const toCamera = camera.position.sub(bottomCenter).normalize();
-
-    if (worldNormal.dot(toCamera) >= 0) {
-      const screenPoints = bottomVertices.map(v => projectToScreen(v, camera, width, height)).reverse();
-      if (screenPoints.some(p => p.visible)) {
-        const lighting = calculateLighting(bottomCenter, worldNormal, camera, lightManager);
-        const litColor = applyLightingToRasterColor(baseColor, lighting.diffuse, lighting.ambient);
-        const depth = camera.position.distanceTo(bottomCenter);
-        const points = screenPoints.map(p => ({ x: p.x, y: p.y }));
-        items.push({
-          depth,
-          renderToBuffer: (target: RenderTarget) => {
-            rasterFillPolygon(target, points, litColor);
-          },
-        });
-      }
-    }
+  if (y2 < y0) {
+    tx = x0; ty = y0; tz = z0; ts = s0;
+    x0 = x2; y0 = y2; z0 = z2; s0 = s2;
+    x2 = tx; y2 = ty; z2 = tz; s2 = ts;
+  }
+  if (y2 < y1) {
+    tx = x1; ty = y1; tz = z1; ts = s1;
+    x1 = x2; y1 = y2; z1 = z2; s1 = s2;
+    x2 = tx; y2 = ty; z2 = tz; s2 = ts;
   }
 
-  // Curved surface quads
-  const topVertices = generateCapVertices(halfHeight, radiusTop);
-  const bottomVertices = generateCapVertices(-halfHeight, radiusBottom);
+  const totalHeight = y2 - y0;
+  if (totalHeight <= 0) {
+    return;
+  }
 
-  for (let i = 0; i < segments; i++) {
-    const nextI = (i + 1) % segments;
-    const quadVertices = [
-      topVertices[i], topVertices[nextI],
-      bottomVertices[nextI], bottomVertices[i],
-    ];
+  const yStart = Math.max(0, Math.ceil(y0 - 0.5));
+  const yEnd = Math.min(height - 1, Math.ceil(y2 - 0.5) - 1);
+  const opaque = a >= 255;
+  const alpha = a / 255;
+  const invAlpha = 1 - alpha;
+
+  for (let y = yStart; y <= yEnd; y++) {
+    const py = y + 0.5;
+
+    // Long edge 0 -> 2
+    const tl = (py - y0) / totalHeight;
+    let xa = x0 + (x2 - x0) * tl;
+    let za = z0 + (z2 - z0) * tl;
+    let sa = s0 + (s2 - s0) * tl;
+
+    // Short edge 0 -> 1 or 1 -> 2
+    let xb: number, zb: number, sb: number;
+    if (py < y1) {
+      const ts2 = (py - y0) / (y1 - y0);
+      xb = x0 + (x1 - x0) * ts2;
+      zb = z0 + (z1 - z0) * ts2;
+      sb = s0 + (s1 - s0) * ts2;
+    } else {
+      const h = y2 - y1;
+      const ts2 = h > 0 ? (py - y1) / h : 1;
+      xb = x1 + (x2 - x1) * ts2;
+      zb = z1 + (z2 - z1) * ts2;
+      sb = s1 + (s2 - s1) * ts2;
+    }
 
-    const faceCenter = quadVertices.reduce((acc, v) => acc.add(v), new Vector3(0, 0, 0)).multiplyScalar(0.25);
-    const midAngle = ((i + 0.5) / segments) * Math.PI * 2;
-    const localNormal = new Vector3(Math.cos(midAngle), 0, Math.sin(midAngle));
-    const worldNormal = localNormal.applyMatrix4(worldMatrix.extractRotation()).normalize();
+    if (xb < xa) {
+      tx = xa; xa = xb; xb = tx;
+      tz = za; za = zb; zb = tz;
+      ts = sa; sa = sb; sb = ts;
+    }
 
-    const toCamera = camera.position.sub(faceCenter).normalize();
-    if (worldNormal.dot(toCamera) < 0) {
+    const spanWidth = xb - xa;
+    if (spanWidth <= 0) {
       continue;
     }
 
-    const screenPoints = quadVertices.map(v => projectToScreen(v, camera, width, height));
-    if (screenPoints.every(p => !p.visible)) {
+    const xStart = Math.max(0, Math.ceil(xa - 0.5));
+    const xEnd = Math.min(width - 1, Math.ceil(xb - 0.5) - 1);
+    if (xStart > xEnd) {
       continue;
     }
 
-    const lighting = calculateLighting(faceCenter, worldNormal, camera, lightManager);
-    const litColor = applyLightingToRasterColor(baseColor, lighting.diffuse, lighting.ambient);
-    const depth = camera.position.distanceTo(faceCenter);
-    const points = screenPoints.map(p => ({ x: p.x, y: p.y }));
-
-    items.push({
-      depth,
-      renderToBuffer: (target: RenderTarget) => {
-        rasterFillPolygon(target, points, litColor);
-      },
-    });
-  }
+    const dz = (zb - za) / spanWidth;
+    const ds = (sb - sa) / spanWidth;
+    const offset = xStart + 0.5 - xa;
+    let z = za + dz * offset;
+    let s = sa + ds * offset;
+    let idx = y * width + xStart;
 
-  return items;
+    for (let x = xStart; x <= xEnd; x++, idx++, z += dz, s += ds) {
+      if (z >= depth[idx]) {
+        continue;
+      }
+      const p = idx * 4;
+      const cr = r * s;
+      const cg = g * s;
+      const cb = b * s;
+      if (opaque) {
+        depth[idx] = z;
+        pixels[p] = cr > 255 ? 255 : cr + 0.5;
+        pixels[p + 1] = cg > 255 ? 255 : cg + 0.5;
+        pixels[p + 2] = cb > 255 ? 255 : cb + 0.5;
+        pixels[p + 3] = 255;
+      } else {
+        pixels[p] = pixels[p] * invAlpha + (cr > 255 ? 255 : cr) * alpha + 0.5;
+        pixels[p + 1] = pixels[p + 1] * invAlpha + (cg > 255 ? 255 : cg) * alpha + 0.5;
+        pixels[p + 2] = pixels[p + 2] * invAlpha + (cb > 255 ? 255 : cb) * alpha + 0.5;
+        pixels[p + 3] = Math.min(255, pixels[p + 3] + a);
+      }
+    }
+  }
 }
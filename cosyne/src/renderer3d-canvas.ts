@@ -1,6 +1,11 @@
 /**
  * Canvas rendering functions for Renderer3D
  * Renders 3D primitives to Tsyne canvas using canvas primitives
+ *
+ * Primitives are first turned into screen-space draw ops, which are then
+ * either emitted as new canvas widgets (renderToCanvas) or diffed against the
+ * widgets of a previous frame (CanvasSceneRenderer.update) so that only
+ * changed widgets get bridge updates.
  */
 
 import { Cosyne3dContext } from './context3d';
@@ -12,8 +17,8 @@ import { Cylinder3D } from './primitives3d/cylinder3d';
 import { Camera } from './camera';
 import { Vector3 } from './math3d';
 import { LightManager, DirectionalLight, AmbientLight } from './light';
-import { colorToHex, parseColor, ColorRGBA } from './material';
-import { RenderItem, ScreenPoint } from './renderer3d-types';
+import { Material, colorToHex, parseColor, ColorRGBA } from './material';
+import { CanvasDrawOp, RenderItem, ScreenPoint, SphereLighting } from './renderer3d-types';
 
 /**
  * Render a Cosyne3D context to the app using canvas primitives
@@ -23,7 +28,7 @@ export function renderToCanvas(ctx: Cosyne3dContext, app: any): void {
   const width = ctx.getWidth();
   const height = ctx.getHeight();
   const lightManager = ctx.getLightManager();
-  const primitives = ctx.getVisiblePrimitives();
+  const primitives = ctx.getRenderablePrimitives();
 
   // Collect all render items with depth
   const renderItems: RenderItem[] = [];
@@ -39,8 +44,9 @@ export function renderToCanvas(ctx: Cosyne3dContext, app: any): void {
 
   // Process each primitive
   for (const primitive of primitives) {
-    const items = processPrimitive(primitive, camera, width, height, lightManager);
-    renderItems.push(...items);
+    for (const op of processPrimitive(primitive, camera, width, height, lightManager)) {
+      renderItems.push({ depth: op.depth, render: (a) => emitDrawOp(a, op) });
+    }
   }
 
   // Sort by depth (back to front - painter's algorithm)
@@ -53,7 +59,293 @@ export function renderToCanvas(ctx: Cosyne3dContext, app: any): void {
 }
 
 /**
- * Process a single primitive into render items
+ * Draw ops a primitive produced, and the state they were produced under
+ */
+interface PrimitiveOps {
+  boundsVersion: number;
+  material: Material;
+  materialVersion: number;
+  shapeKey: number;
+  ops: CanvasDrawOp[];
+}
+
+/**
+ * Counters from the last CanvasSceneRenderer render/update
+ */
+export interface CanvasSceneStats {
+  /** Primitives whose cached draw ops were reused */
+  reused: number;
+  /** Primitives projected and lit again */
+  recomputed: number;
+  /** Widget updates sent to the bridge */
+  updates: number;
+}
+
+/**
+ * Retained-mode canvas renderer for one Cosyne3D context
+ *
+ * render() emits widgets like renderToCanvas and remembers them. update()
+ * then re-projects only primitives whose transform, shape or material changed
+ * (everything, if the camera, lights or size changed) and sends updates only
+ * for widgets whose polygon or sphere actually moved or changed color. Each
+ * widget keeps its painter's-order slot; if the new frame needs more widgets,
+ * or a different kind of widget in some slot, update() returns false and the
+ * caller must render() into a fresh container.
+ */
+export class CanvasSceneRenderer {
+  private cache: Map<Primitive3D, PrimitiveOps> = new Map();
+  private viewKey = new Float64Array(18);
+  private lightKey = '';
+  private widgets: any[] = [];
+  private kinds: Array<CanvasDrawOp['kind']> = [];
+  // What each widget shows now; null for a hidden spare slot
+  private shown: Array<CanvasDrawOp | null> = [];
+  private background: string | null = null;
+  private width = 0;
+  private height = 0;
+  private stats: CanvasSceneStats = { reused: 0, recomputed: 0, updates: 0 };
+
+  /**
+   * Emit every widget for the scene into the current container
+   */
+  render(ctx: Cosyne3dContext, app: any): void {
+    const ops = this.collect(ctx);
+    const width = ctx.getWidth();
+    const height = ctx.getHeight();
+    const bgColor = ctx.getBackgroundColor();
+
+    app.canvasRectangle({ x: 0, y: 0, x2: width, y2: height, fillColor: bgColor });
+    this.widgets = ops.map(op => emitDrawOp(app, op));
+    this.kinds = ops.map(op => op.kind);
+    this.shown = ops.slice();
+    this.background = bgColor;
+    this.width = width;
+    this.height = height;
+    this.stats.updates = ops.length + 1;
+  }
+
+  /**
+   * Bring the widgets from the last render() up to date. Returns false when
+   * the scene no longer fits them and needs a full render().
+   */
+  update(ctx: Cosyne3dContext): boolean {
+    if (
+      this.background === null ||
+      ctx.getBackgroundColor() !== this.background ||
+      ctx.getWidth() !== this.width ||
+      ctx.getHeight() !== this.height
+    ) {
+      return false;
+    }
+
+    const ops = this.collect(ctx);
+    if (ops.length > this.widgets.length) {
+      return false;
+    }
+    for (let i = 0; i < this.widgets.length; i++) {
+      const op = i < ops.length ? ops[i] : null;
+      if (op ? op.kind !== this.kinds[i] : this.kinds[i] !== 'polygon') {
+        return false;
+      }
+      // canvasSphere can't change its solid color after creation
+      const shown = this.shown[i];
+      if (op && op.kind === 'sphere' && shown && shown.color !== op.color) {
+        return false;
+      }
+    }
+
+    let updates = 0;
+    for (let i = 0; i < this.widgets.length; i++) {
+      const op = i < ops.length ? ops[i] : null;
+      const shown = this.shown[i];
+      const widget = this.widgets[i];
+
+      if (!op) {
+        if (shown) {
+          // Spare slot: keep the widget but stop drawing it
+          widget.update({ fillColor: 'transparent', strokeColor: 'transparent' });
+          this.shown[i] = null;
+          updates++;
+        }
+        continue;
+      }
+
+      if (op.kind === 'polygon') {
+        const prev = shown as Extract<CanvasDrawOp, { kind: 'polygon' }> | null;
+        const pointsChanged = !prev || !samePoints(prev.points, op.points);
+        const colorChanged = !prev || prev.color !== op.color;
+        if (pointsChanged || colorChanged) {
+          const changes: Record<string, unknown> = {};
+          if (pointsChanged) changes.points = op.points;
+          if (colorChanged) {
+            changes.fillColor = op.color;
+            changes.strokeColor = op.color;
+          }
+          widget.update(changes);
+          updates++;
+        }
+      } else {
+        const prev = shown as Extract<CanvasDrawOp, { kind: 'sphere' }>;
+        if (
+          prev.cx !== op.cx ||
+          prev.cy !== op.cy ||
+          prev.radius !== op.radius ||
+          !sameLighting(prev.lighting, op.lighting)
+        ) {
+          widget.update({ cx: op.cx, cy: op.cy, radius: op.radius, lighting: op.lighting });
+          updates++;
+        }
+      }
+      this.shown[i] = op;
+    }
+
+    this.stats.updates = updates;
+    return true;
+  }
+
+  /**
+   * Counters from the last render() or update()
+   */
+  getStats(): CanvasSceneStats {
+    return { ...this.stats };
+  }
+
+  /**
+   * Draw ops for the whole scene, back to front, reusing cached ops for
+   * primitives that haven't changed under an unchanged view
+   */
+  private collect(ctx: Cosyne3dContext): CanvasDrawOp[] {
+    const camera = ctx.getCamera();
+    const width = ctx.getWidth();
+    const height = ctx.getHeight();
+    const lightManager = ctx.getLightManager();
+    const primitives = ctx.getRenderablePrimitives();
+
+    // Any view or lighting change invalidates every primitive
+    let viewChanged = false;
+    const viewProjection = camera.getViewProjectionMatrix().elements;
+    const viewKey = this.viewKey;
+    for (let i = 0; i < 16; i++) {
+      if (viewKey[i] !== viewProjection[i]) {
+        viewKey[i] = viewProjection[i];
+        viewChanged = true;
+      }
+    }
+    if (viewKey[16] !== width || viewKey[17] !== height) {
+      viewKey[16] = width;
+      viewKey[17] = height;
+      viewChanged = true;
+    }
+    const lightKey = JSON.stringify(lightManager.getLights());
+    if (lightKey !== this.lightKey) {
+      this.lightKey = lightKey;
+      viewChanged = true;
+    }
+    if (viewChanged) {
+      this.cache.clear();
+    }
+
+    let reused = 0;
+    const ops: CanvasDrawOp[] = [];
+    const live = new Set<Primitive3D>();
+    for (const primitive of primitives) {
+      live.add(primitive);
+      const material = primitive.material;
+      const shapeKey = getShapeKey(primitive);
+      let entry = this.cache.get(primitive);
+      if (
+        entry &&
+        entry.boundsVersion === primitive.boundsVersion &&
+        entry.material === material &&
+        entry.materialVersion === material.version &&
+        entry.shapeKey === shapeKey
+      ) {
+        reused++;
+      } else {
+        entry = {
+          boundsVersion: primitive.boundsVersion,
+          material,
+          materialVersion: material.version,
+          shapeKey,
+          ops: processPrimitive(primitive, camera, width, height, lightManager),
+        };
+        this.cache.set(primitive, entry);
+      }
+      for (const op of entry.ops) {
+        ops.push(op);
+      }
+    }
+
+    // Forget primitives that were removed or culled
+    if (this.cache.size > live.size) {
+      for (const primitive of this.cache.keys()) {
+        if (!live.has(primitive)) {
+          this.cache.delete(primitive);
+        }
+      }
+    }
+
+    this.stats.reused = reused;
+    this.stats.recomputed = primitives.length - reused;
+
+    // Sort by depth (back to front - painter's algorithm)
+    ops.sort((a, b) => b.depth - a.depth);
+    return ops;
+  }
+}
+
+/**
+ * Shape parameters that change canvas output without changing bounds
+ */
+function getShapeKey(primitive: Primitive3D): number {
+  if (primitive instanceof Cylinder3D) {
+    return primitive.radialSegments * 2 + (primitive.openEnded ? 1 : 0);
+  }
+  return 0;
+}
+
+function samePoints(a: Array<{ x: number; y: number }>, b: Array<{ x: number; y: number }>): boolean {
+  if (a.length !== b.length) return false;
+  for (let i = 0; i < a.length; i++) {
+    if (a[i].x !== b[i].x || a[i].y !== b[i].y) return false;
+  }
+  return true;
+}
+
+function sameLighting(a: SphereLighting, b: SphereLighting): boolean {
+  return a.ambient === b.ambient &&
+    a.diffuse === b.diffuse &&
+    a.direction.x === b.direction.x &&
+    a.direction.y === b.direction.y &&
+    a.direction.z === b.direction.z;
+}
+
+/**
+ * Create the canvas widget for a draw op; returns the widget handle
+ */
+function emitDrawOp(app: any, op: CanvasDrawOp): any {
+  if (op.kind === 'sphere') {
+    return app.canvasSphere({
+      cx: op.cx,
+      cy: op.cy,
+      radius: op.radius,
+      pattern: 'solid',
+      solidColor: op.color,
+      latBands: 16,
+      lonSegments: 16,
+      lighting: op.lighting,
+    });
+  }
+  return app.canvasPolygon({
+    points: op.points,
+    fillColor: op.color,
+    strokeColor: op.color,
+    strokeWidth: 0,
+  });
+}
+
+/**
+ * Process a single primitive into draw ops
  */
 function processPrimitive(
   primitive: Primitive3D,
@@ -61,7 +353,7 @@ function processPrimitive(
   width: number,
   height: number,
   lightManager: LightManager
-): RenderItem[] {
+): CanvasDrawOp[] {
   if (primitive instanceof Sphere3D) {
     return renderSphere(primitive, camera, width, height, lightManager);
   } else if (primitive instanceof Box3D) {
@@ -176,7 +468,7 @@ function renderSphere(
   width: number,
   height: number,
   lightManager: LightManager
-): RenderItem[] {
+): CanvasDrawOp[] {
   const worldPos = sphere.getWorldPosition();
   const screenPos = projectToScreen(worldPos, camera, width, height);
 
@@ -209,36 +501,30 @@ function renderSphere(
 
   const depth = camera.position.distanceTo(worldPos);
 
+  let finalColor = baseColor;
+  if (emissiveIntensity > 0 && emissive !== '#000000') {
+    const baseParsed = parseColor(baseColor);
+    const emissiveParsed = parseColor(emissive);
+    const blended: ColorRGBA = {
+      r: Math.min(255, baseParsed.r * (1 - emissiveIntensity) + emissiveParsed.r * emissiveIntensity),
+      g: Math.min(255, baseParsed.g * (1 - emissiveIntensity) + emissiveParsed.g * emissiveIntensity),
+      b: Math.min(255, baseParsed.b * (1 - emissiveIntensity) + emissiveParsed.b * emissiveIntensity),
+      a: 255,
+    };
+    finalColor = colorToHex(blended);
+  }
+
   return [{
+    kind: 'sphere',
     depth,
-    render: (a) => {
-      let finalColor = baseColor;
-      if (emissiveIntensity > 0 && emissive !== '#000000') {
-        const baseParsed = parseColor(baseColor);
-        const emissiveParsed = parseColor(emissive);
-        const blended: ColorRGBA = {
-          r: Math.min(255, baseParsed.r * (1 - emissiveIntensity) + emissiveParsed.r * emissiveIntensity),
-          g: Math.min(255, baseParsed.g * (1 - emissiveIntensity) + emissiveParsed.g * emissiveIntensity),
-          b: Math.min(255, baseParsed.b * (1 - emissiveIntensity) + emissiveParsed.b * emissiveIntensity),
-          a: 255,
-        };
-        finalColor = colorToHex(blended);
-      }
-
-      a.canvasSphere({
-        cx: screenPos.x,
-        cy: screenPos.y,
-        radius: screenRadius,
-        pattern: 'solid',
-        solidColor: finalColor,
-        latBands: 16,
-        lonSegments: 16,
-        lighting: {
-          direction: { x: lightDir[0], y: lightDir[1], z: lightDir[2] },
-          ambient: ambientIntensity,
-          diffuse: material.unlit ? 0 : 0.8,
-        },
-      });
+    cx: screenPos.x,
+    cy: screenPos.y,
+    radius: screenRadius,
+    color: finalColor,
+    lighting: {
+      direction: { x: lightDir[0], y: lightDir[1], z: lightDir[2] },
+      ambient: ambientIntensity,
+      diffuse: material.unlit ? 0 : 0.8,
     },
   }];
 }
@@ -252,8 +538,8 @@ function renderBox(
   width: number,
   height: number,
   lightManager: LightManager
-): RenderItem[] {
-  const items: RenderItem[] = [];
+): CanvasDrawOp[] {
+  const items: CanvasDrawOp[] = [];
   const faces: Array<'front' | 'back' | 'left' | 'right' | 'top' | 'bottom'> = [
     'front', 'back', 'left', 'right', 'top', 'bottom',
   ];
@@ -293,20 +579,11 @@ function renderBox(
     const lighting = calculateLighting(faceCenter, worldNormal, camera, lightManager);
     const litColor = applyLightingToColor(baseColor, lighting.diffuse, lighting.ambient);
 
-    const depth = camera.position.distanceTo(faceCenter);
-    const finalColor = litColor;
-    const finalPoints = screenPoints.map(p => ({ x: p.x, y: p.y }));
-
     items.push({
-      depth,
-      render: (a) => {
-        a.canvasPolygon({
-          points: finalPoints,
-          fillColor: finalColor,
-          strokeColor: finalColor,
-          strokeWidth: 0,
-        });
-      },
+      kind: 'polygon',
+      depth: camera.position.distanceTo(faceCenter),
+      points: screenPoints.map(p => ({ x: p.x, y: p.y })),
+      color: litColor,
     });
   }
 
@@ -322,7 +599,7 @@ function renderPlane(
   width: number,
   height: number,
   lightManager: LightManager
-): RenderItem[] {
+): CanvasDrawOp[] {
   const corners = plane.getCorners();
   const worldNormal = plane.getWorldNormal();
   const worldPos = plane.getWorldPosition();
@@ -346,15 +623,10 @@ function renderPlane(
   const depth = camera.position.distanceTo(worldPos);
 
   return [{
+    kind: 'polygon',
     depth,
-    render: (a) => {
-      a.canvasPolygon({
-        points: screenPoints.map(p => ({ x: p.x, y: p.y })),
-        fillColor: litColor,
-        strokeColor: litColor,
-        strokeWidth: 0,
-      });
-    },
+    points: screenPoints.map(p => ({ x: p.x, y: p.y })),
+    color: litColor,
   }];
 }
 
@@ -367,8 +639,8 @@ function renderCylinder(
   width: number,
   height: number,
   lightManager: LightManager
-): RenderItem[] {
-  const items: RenderItem[] = [];
+): CanvasDrawOp[] {
+  const items: CanvasDrawOp[] = [];
   const worldMatrix = cylinder.getWorldMatrix();
 
   const material = cylinder.material;
@@ -408,17 +680,7 @@ function renderCylinder(
         const depth = camera.position.distanceTo(topCenter);
         const points = screenPoints.map(p => ({ x: p.x, y: p.y }));
 
-        items.push({
-          depth,
-          render: (a) => {
-            a.canvasPolygon({
-              points,
-              fillColor: litColor,
-              strokeColor: litColor,
-              strokeWidth: 0,
-            });
-          },
-        });
+        items.push({ kind: 'polygon', depth, points, color: litColor });
       }
     }
   }
@@ -440,17 +702,7 @@ function renderCylinder(
         const depth = camera.position.distanceTo(bottomCenter);
         const points = screenPoints.map(p => ({ x: p.x, y: p.y }));
 
-        items.push({
-          depth,
-          render: (a) => {
-            a.canvasPolygon({
-              points,
-              fillColor: litColor,
-              strokeColor: litColor,
-              strokeWidth: 0,
-            });
-          },
-        });
+        items.push({ kind: 'polygon', depth, points, color: litColor });
       }
     }
   }
@@ -487,17 +739,7 @@ function renderCylinder(
     const depth = camera.position.distanceTo(faceCenter);
     const points = screenPoints.map(p => ({ x: p.x, y: p.y }));
 
-    items.push({
-      depth,
-      render: (a) => {
-        a.canvasPolygon({
-          points,
-          fillColor: litColor,
-          strokeColor: litColor,
-          strokeWidth: 0,
-        });
-      },
-    });
+    items.push({ kind: 'polygon', depth, points, color: litColor });
   }
 
   return items;
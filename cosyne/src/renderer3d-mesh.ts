@@ -0,0 +1,320 @@
+/**
+ * Triangle meshes for Renderer3D buffer rendering
+ *
+ * Tessellates each primitive into an indexed triangle mesh in local space.
+ * Meshes are cached per Primitive3D and only rebuilt when a shape parameter
+ * (radius, size, segment count) changes - transforms are applied per frame
+ * by the pipeline, so moving or rotating a primitive never re-tessellates.
+ *
+ * Winding is counter-clockwise when viewed from outside (front faces).
+ */
+
+import { Primitive3D } from './primitives3d/base3d';
+import { Sphere3D } from './primitives3d/sphere3d';
+import { Box3D } from './primitives3d/box3d';
+import { Plane3D } from './primitives3d/plane3d';
+import { Cylinder3D } from './primitives3d/cylinder3d';
+
+/**
+ * Indexed triangle mesh in a primitive's local space
+ */
+export interface Mesh3D {
+  /** Vertex positions (x, y, z per vertex) */
+  positions: Float32Array;
+  /** Vertex normals (x, y, z per vertex, unit length) */
+  normals: Float32Array;
+  /** Triangle vertex indices (3 per triangle) */
+  indices: Uint32Array;
+  /** Render both faces (no backface culling, normals flip toward the viewer) */
+  doubleSided: boolean;
+}
+
+interface MeshCacheEntry {
+  params: number[];
+  mesh: Mesh3D;
+}
+
+const meshCache = new WeakMap<Primitive3D, MeshCacheEntry>();
+
+// Scratch array for shape parameters (avoids allocating per lookup)
+const shapeScratch: number[] = [];
+
+/**
+ * Get the cached mesh for a primitive, tessellating it if its shape changed.
+ * Returns null for primitive types without a mesh.
+ */
+export function getPrimitiveMesh(primitive: Primitive3D): Mesh3D | null {
+  shapeScratch.length = 0;
+  if (!writeShapeParams(primitive, shapeScratch)) {
+    return null;
+  }
+
+  const cached = meshCache.get(primitive);
+  if (cached && sameParams(cached.params, shapeScratch)) {
+    return cached.mesh;
+  }
+
+  const mesh = tessellate(primitive);
+  if (!mesh) {
+    return null;
+  }
+  meshCache.set(primitive, { params: shapeScratch.slice(), mesh });
+  return mesh;
+}
+
+/**
+ * Drop a primitive's cached mesh (e.g. after disposing it)
+ */
+export function invalidatePrimitiveMesh(primitive: Primitive3D): void {
+  meshCache.delete(primitive);
+}
+
+function sameParams(a: number[], b: number[]): boolean {
+  if (a.length !== b.length) return false;
+  for (let i = 0; i < a.length; i++) {
+    if (a[i] !== b[i]) return false;
+  }
+  return true;
+}
+
+function writeShapeParams(primitive: Primitive3D, out: number[]): boolean {
+  if (primitive instanceof Sphere3D) {
+    out.push(1, primitive.radius, primitive.widthSegments, primitive.heightSegments);
+  } else if (primitive instanceof Box3D) {
+    out.push(2, primitive.width, primitive.height, primitive.depth);
+  } else if (primitive instanceof Plane3D) {
+    out.push(3, primitive.width, primitive.height);
+  } else if (primitive instanceof Cylinder3D) {
+    out.push(4, primitive.radiusTop, primitive.radiusBottom, primitive.height,
+      primitive.radialSegments, primitive.heightSegments, primitive.openEnded ? 1 : 0);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+function tessellate(primitive: Primitive3D): Mesh3D | null {
+  if (primitive instanceof Sphere3D) {
+    return tessellateSphere(primitive.radius, primitive.widthSegments, primitive.heightSegments);
+  } else if (primitive instanceof Box3D) {
+    return tessellateBox(primitive.width, primitive.height, primitive.depth);
+  } else if (primitive instanceof Plane3D) {
+    return tessellatePlane(primitive.width, primitive.height);
+  } else if (primitive instanceof Cylinder3D) {
+    return tessellateCylinder(
+      primitive.radiusTop,
+      primitive.radiusBottom,
+      primitive.height,
+      Math.max(16, primitive.radialSegments),
+      Math.max(1, primitive.heightSegments),
+      primitive.openEnded
+    );
+  }
+  return null;
+}
+
+/**
+ * UV sphere with smooth normals
+ */
+export function tessellateSphere(radius: number, widthSegments: number, heightSegments: number): Mesh3D {
+  const ws = Math.max(3, Math.floor(widthSegments));
+  const hs = Math.max(2, Math.floor(heightSegments));
+  const vertexCount = (ws + 1) * (hs + 1);
+  const positions = new Float32Array(vertexCount * 3);
+  const normals = new Float32Array(vertexCount * 3);
+
+  let v = 0;
+  for (let iy = 0; iy <= hs; iy++) {
+    const theta = (iy / hs) * Math.PI;
+    const sinTheta = Math.sin(theta);
+    const cosTheta = Math.cos(theta);
+    for (let ix = 0; ix <= ws; ix++) {
+      const phi = (ix / ws) * Math.PI * 2;
+      const nx = -Math.cos(phi) * sinTheta;
+      const ny = cosTheta;
+      const nz = Math.sin(phi) * sinTheta;
+      normals[v] = nx;
+      normals[v + 1] = ny;
+      normals[v + 2] = nz;
+      positions[v] = nx * radius;
+      positions[v + 1] = ny * radius;
+      positions[v + 2] = nz * radius;
+      v += 3;
+    }
+  }
+
+  // Pole rows contribute one triangle per quad instead of two
+  const indices = new Uint32Array((ws * (hs - 1) * 2) * 3);
+  let t = 0;
+  const row = ws + 1;
+  for (let iy = 0; iy < hs; iy++) {
+    for (let ix = 0; ix < ws; ix++) {
+      const a = iy * row + ix + 1;
+      const b = iy * row + ix;
+      const c = (iy + 1) * row + ix;
+      const d = (iy + 1) * row + ix + 1;
+      if (iy !== 0) {
+        indices[t++] = a; indices[t++] = b; indices[t++] = d;
+      }
+      if (iy !== hs - 1) {
+        indices[t++] = b; indices[t++] = c; indices[t++] = d;
+      }
+    }
+  }
+
+  return { positions, normals, indices, doubleSided: false };
+}
+
+/**
+ * Box with flat per-face normals (24 vertices, 12 triangles)
+ */
+export function tessellateBox(width: number, height: number, depth: number): Mesh3D {
+  const hw = width / 2;
+  const hh = height / 2;
+  const hd = depth / 2;
+
+  // Same corner order as Box3D.getFaceVertices (CCW from outside)
+  const faces: Array<{ n: [number, number, number]; v: number[] }> = [
+    { n: [0, 0, 1], v: [-hw, -hh, hd, hw, -hh, hd, hw, hh, hd, -hw, hh, hd] },
+    { n: [0, 0, -1], v: [hw, -hh, -hd, -hw, -hh, -hd, -hw, hh, -hd, hw, hh, -hd] },
+    { n: [-1, 0, 0], v: [-hw, -hh, -hd, -hw, -hh, hd, -hw, hh, hd, -hw, hh, -hd] },
+    { n: [1, 0, 0], v: [hw, -hh, hd, hw, -hh, -hd, hw, hh, -hd, hw, hh, hd] },
+    { n: [0, 1, 0], v: [-hw, hh, hd, hw, hh, hd, hw, hh, -hd, -hw, hh, -hd] },
+    { n: [0, -1, 0], v: [-hw, -hh, -hd, hw, -hh, -hd, hw, -hh, hd, -hw, -hh, hd] },
+  ];
+
+  const positions = new Float32Array(24 * 3);
+  const normals = new Float32Array(24 * 3);
+  const indices = new Uint32Array(36);
+
+  faces.forEach((face, f) => {
+    for (let i = 0; i < 4; i++) {
+      const o = (f * 4 + i) * 3;
+      positions[o] = face.v[i * 3];
+      positions[o + 1] = face.v[i * 3 + 1];
+      positions[o + 2] = face.v[i * 3 + 2];
+      normals[o] = face.n[0];
+      normals[o + 1] = face.n[1];
+      normals[o + 2] = face.n[2];
+    }
+    const base = f * 4;
+    indices.set([base, base + 1, base + 2, base, base + 2, base + 3], f * 6);
+  });
+
+  return { positions, normals, indices, doubleSided: false };
+}
+
+/**
+ * Plane in the XZ plane facing +Y; rendered double-sided
+ */
+export function tessellatePlane(width: number, height: number): Mesh3D {
+  const hw = width / 2;
+  const hh = height / 2;
+  const positions = new Float32Array([
+    -hw, 0, -hh,
+    hw, 0, -hh,
+    hw, 0, hh,
+    -hw, 0, hh,
+  ]);
+  const normals = new Float32Array([0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0]);
+  const indices = new Uint32Array([0, 2, 1, 0, 3, 2]);
+  return { positions, normals, indices, doubleSided: true };
+}
+
+/**
+ * Cylinder (or cone frustum) with smooth side normals and flat caps
+ */
+export function tessellateCylinder(
+  radiusTop: number,
+  radiusBottom: number,
+  height: number,
+  radialSegments: number,
+  heightSegments: number,
+  openEnded: boolean
+): Mesh3D {
+  const halfHeight = height / 2;
+  const slope = height !== 0 ? (radiusBottom - radiusTop) / height : 0;
+  const capTop = !openEnded && radiusTop > 0;
+  const capBottom = !openEnded && radiusBottom > 0;
+
+  const sideVerts = (radialSegments + 1) * (heightSegments + 1);
+  const capVerts = radialSegments + 2;
+  const vertexCount = sideVerts + (capTop ? capVerts : 0) + (capBottom ? capVerts : 0);
+  const triCount = radialSegments * heightSegments * 2 +
+    (capTop ? radialSegments : 0) + (capBottom ? radialSegments : 0);
+
+  const positions = new Float32Array(vertexCount * 3);
+  const normals = new Float32Array(vertexCount * 3);
+  const indices = new Uint32Array(triCount * 3);
+
+  let v = 0;
+  let t = 0;
+
+  // Side
+  for (let iy = 0; iy <= heightSegments; iy++) {
+    const frac = iy / heightSegments;
+    const radius = frac * (radiusBottom - radiusTop) + radiusTop;
+    const y = -frac * height + halfHeight;
+    for (let ix = 0; ix <= radialSegments; ix++) {
+      const theta = (ix / radialSegments) * Math.PI * 2;
+      const sin = Math.sin(theta);
+      const cos = Math.cos(theta);
+      const o = v * 3;
+      positions[o] = radius * sin;
+      positions[o + 1] = y;
+      positions[o + 2] = radius * cos;
+      const len = Math.sqrt(1 + slope * slope);
+      normals[o] = sin / len;
+      normals[o + 1] = slope / len;
+      normals[o + 2] = cos / len;
+      v++;
+    }
+  }
+  const row = radialSegments + 1;
+  for (let iy = 0; iy < heightSegments; iy++) {
+    for (let ix = 0; ix < radialSegments; ix++) {
+      const a = iy * row + ix;
+      const b = (iy + 1) * row + ix;
+      const c = (iy + 1) * row + ix + 1;
+      const d = iy * row + ix + 1;
+      indices[t++] = a; indices[t++] = b; indices[t++] = d;
+      indices[t++] = b; indices[t++] = c; indices[t++] = d;
+    }
+  }
+
+  // Caps: a center vertex plus a ring, fanned
+  const addCap = (top: boolean) => {
+    const radius = top ? radiusTop : radiusBottom;
+    const y = top ? halfHeight : -halfHeight;
+    const ny = top ? 1 : -1;
+    const center = v;
+    positions[v * 3 + 1] = y;
+    normals[v * 3 + 1] = ny;
+    v++;
+    const ringStart = v;
+    for (let ix = 0; ix <= radialSegments; ix++) {
+      const theta = (ix / radialSegments) * Math.PI * 2;
+      const o = v * 3;
+      positions[o] = radius * Math.sin(theta);
+      positions[o + 1] = y;
+      positions[o + 2] = radius * Math.cos(theta);
+      normals[o + 1] = ny;
+      v++;
+    }
+    for (let ix = 0; ix < radialSegments; ix++) {
+      indices[t++] = center;
+      if (top) {
+        indices[t++] = ringStart + ix;
+        indices[t++] = ringStart + ix + 1;
+      } else {
+        indices[t++] = ringStart + ix + 1;
+        indices[t++] = ringStart + ix;
+      }
+    }
+  };
+
+  if (capTop) addCap(true);
+  if (capBottom) addCap(false);
+
+  return { positions, normals, indices, doubleSided: openEnded };
+}
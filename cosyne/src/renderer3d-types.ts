@@ -12,6 +12,36 @@ export interface RenderItem {
   render: (app: any) => void;
 }
 
+/**
+ * Lighting parameters passed to canvasSphere
+ */
+export interface SphereLighting {
+  direction: { x: number; y: number; z: number };
+  ambient: number;
+  diffuse: number;
+}
+
+/**
+ * One canvas widget's worth of drawing, in screen space. Kept between frames
+ * so unchanged primitives can be reused and diffed against.
+ */
+export type CanvasDrawOp =
+  | {
+      kind: 'polygon';
+      depth: number;
+      points: Array<{ x: number; y: number }>;
+      color: string;
+    }
+  | {
+      kind: 'sphere';
+      depth: number;
+      cx: number;
+      cy: number;
+      radius: number;
+      color: string;
+      lighting: SphereLighting;
+    };
+
 /**
  * A renderable item for buffer rendering
  */
@@ -7,26 +7,63 @@
  * This module re-exports from split files:
  * - renderer3d-types.ts: Type definitions
  * - renderer3d-buffer.ts: Buffer rendering (software rasterization)
+ * - renderer3d-arena.ts: Per-frame scratch storage for buffer rendering
  * - renderer3d-canvas.ts: Canvas rendering (Tsyne canvas primitives)
  */
 
 import { Cosyne3dContext } from './context3d';
 import { RenderTarget } from '../../core/dist/src/graphics/platform';
-import { renderToCanvas } from './renderer3d-canvas';
+import { CanvasSceneRenderer, CanvasSceneStats } from './renderer3d-canvas';
 import { renderToBuffer as bufferRenderToBuffer } from './renderer3d-buffer';
+import { FrameArena } from './renderer3d-arena';
+
+export { FrameArena } from './renderer3d-arena';
+export { CanvasSceneRenderer, type CanvasSceneStats } from './renderer3d-canvas';
 
 // Re-export types
-export type { RenderItem, BufferRenderItem, ScreenPoint } from './renderer3d-types';
+export type { RenderItem, BufferRenderItem, ScreenPoint, CanvasDrawOp, SphereLighting } from './renderer3d-types';
 
 /**
  * Renderer3D class - renders Cosyne3D scenes to Tsyne canvas primitives
  */
 export class Renderer3D {
+  // Scratch storage reused by every renderToBuffer call on this renderer
+  private arena = new FrameArena();
+
+  // Retained widgets per context, for incremental canvas updates
+  private scenes: WeakMap<Cosyne3dContext, CanvasSceneRenderer> = new WeakMap();
+
   /**
    * Render a Cosyne3D context to the app using canvas primitives
    */
   render(ctx: Cosyne3dContext, app: any): void {
-    renderToCanvas(ctx, app);
+    this.getScene(ctx).render(ctx, app);
+  }
+
+  /**
+   * Update the widgets from the context's last render() in place, sending
+   * bridge updates only for primitives that changed. Returns false when the
+   * scene needs a full render() into a fresh container instead.
+   */
+  update(ctx: Cosyne3dContext): boolean {
+    const scene = this.scenes.get(ctx);
+    return scene ? scene.update(ctx) : false;
+  }
+
+  /**
+   * Counters from the context's last canvas render() or update()
+   */
+  getCanvasStats(ctx: Cosyne3dContext): CanvasSceneStats | null {
+    return this.scenes.get(ctx)?.getStats() ?? null;
+  }
+
+  private getScene(ctx: Cosyne3dContext): CanvasSceneRenderer {
+    let scene = this.scenes.get(ctx);
+    if (!scene) {
+      scene = new CanvasSceneRenderer();
+      this.scenes.set(ctx, scene);
+    }
+    return scene;
   }
 
   /**
@@ -38,7 +75,7 @@ export class Renderer3D {
    * @returns The pixel buffer as a Uint8Array (RGBA format)
    */
   renderToBuffer(ctx: Cosyne3dContext, target?: RenderTarget): Uint8Array {
-    return bufferRenderToBuffer(ctx, target);
+    return bufferRenderToBuffer(ctx, target, this.arena);
   }
 }
 
@@ -0,0 +1,537 @@
+/**
+ * Bounding volume hierarchy over primitive world bounds
+ *
+ * Used by Cosyne3dContext to hand renderers only the primitives that can
+ * appear on screen. The tree is built once (median split on the longest
+ * centroid axis) and then refit incrementally: each primitive exposes a
+ * boundsVersion counter that changes whenever its transform or shape does,
+ * so a frame only recomputes the leaves that actually moved. If refitting
+ * degrades the tree too far it is rebuilt.
+ *
+ * Culling is frustum-based (against the camera's view-projection planes),
+ * with optional coarse occlusion culling: large opaque primitives rasterize
+ * a conservative inner rectangle into a low-resolution depth grid, and
+ * candidates whose projected bounds lie entirely behind it are dropped.
+ */
+
+import { Camera } from './camera';
+import { Frustum, FrustumTest } from './math3d';
+import { Primitive3D } from './primitives3d/base3d';
+import { Sphere3D } from './primitives3d/sphere3d';
+import { Box3D } from './primitives3d/box3d';
+import { Cylinder3D } from './primitives3d/cylinder3d';
+
+// Primitives per leaf node
+const LEAF_SIZE = 4;
+
+// Rebuild once refitting has grown total node surface area by this factor
+const REBUILD_AREA_RATIO = 2;
+
+// Occlusion grid resolution (cells across NDC x and y)
+const OCCLUSION_GRID = 64;
+
+/**
+ * Per-frame culling counters
+ */
+export interface CullingStats {
+  /** Primitives in the scene */
+  total: number;
+  /** Primitives returned to the renderer */
+  visible: number;
+  /** Dropped by the view frustum */
+  frustumCulled: number;
+  /** Dropped by occlusion culling */
+  occlusionCulled: number;
+  /** Leaves whose bounds were recomputed in the last sync */
+  refitLeaves: number;
+  /** Total full rebuilds since creation */
+  rebuilds: number;
+}
+
+export class SceneBVH {
+  // Leaves (one per primitive, in scene order)
+  private primitives: Primitive3D[] = [];
+  private leafVersions = new Float64Array(0);
+  private leafBounds = new Float64Array(0);     // minX, minY, minZ, maxX, maxY, maxZ
+  private leafOrder = new Uint32Array(0);       // leaves permuted into node ranges
+
+  // Nodes (preorder: children always have larger indices than parents)
+  private nodeBounds = new Float64Array(0);
+  private nodeLeft = new Int32Array(0);         // -1 for leaf nodes
+  private nodeRight = new Int32Array(0);
+  private nodeStart = new Int32Array(0);        // leafOrder range covered by each node
+  private nodeCount = new Int32Array(0);
+  private nodesUsed = 0;
+
+  private builtVersion = -1;
+  private builtArea = 0;
+
+  // Query scratch
+  private frustum = new Frustum();
+  private stack = new Int32Array(64);
+  private outLeaves = new Int32Array(64);       // leaf index of each cull() result
+  private occlusionDepth = new Float32Array(OCCLUSION_GRID * OCCLUSION_GRID);
+
+  /** Minimum occluder size as a fraction of the viewport (NDC half-extent) */
+  minOccluderSize = 0.05;
+
+  private stats: CullingStats = {
+    total: 0,
+    visible: 0,
+    frustumCulled: 0,
+    occlusionCulled: 0,
+    refitLeaves: 0,
+    rebuilds: 0,
+  };
+
+  /**
+   * Bring the tree up to date with the scene. `structureVersion` must change
+   * whenever primitives are added or removed; moved or resized primitives
+   * are picked up through their boundsVersion.
+   */
+  sync(primitives: readonly Primitive3D[], structureVersion: number): void {
+    if (structureVersion !== this.builtVersion || primitives.length !== this.primitives.length) {
+      this.build(primitives);
+      this.builtVersion = structureVersion;
+      return;
+    }
+
+    let refit = 0;
+    for (let i = 0; i < primitives.length; i++) {
+      const primitive = this.primitives[i];
+      if (primitive.boundsVersion !== this.leafVersions[i]) {
+        this.updateLeafBounds(i);
+        refit++;
+      }
+    }
+    this.stats.refitLeaves = refit;
+
+    if (refit > 0 && this.refitNodes() > this.builtArea * REBUILD_AREA_RATIO) {
+      this.build(this.primitives);
+    }
+  }
+
+  /**
+   * Collect visible primitives inside the camera frustum into `out`
+   * (cleared first). With `occlusion`, also drop primitives hidden behind
+   * large opaque ones. Returns the number collected.
+   */
+  cull(camera: Camera, out: Primitive3D[], occlusion: boolean = false): number {
+    out.length = 0;
+    const stats = this.stats;
+    stats.total = this.primitives.length;
+    stats.frustumCulled = 0;
+    stats.occlusionCulled = 0;
+
+    if (this.nodesUsed > 0) {
+      this.frustum.setFromMatrix(camera.getViewProjectionMatrix());
+      let stack = this.stack;
+      let sp = 0;
+      stack[sp++] = 0;
+      stack[sp++] = FrustumTest.Intersects;
+
+      while (sp > 0) {
+        const state = stack[--sp];
+        const node = stack[--sp];
+        const b = node * 6;
+        let test = state;
+        if (test !== FrustumTest.Inside) {
+          const nb = this.nodeBounds;
+          test = this.frustum.testBox(nb[b], nb[b + 1], nb[b + 2], nb[b + 3], nb[b + 4], nb[b + 5]);
+          if (test === FrustumTest.Outside) {
+            stats.frustumCulled += this.nodeCount[node];
+            continue;
+          }
+        }
+
+        const left = this.nodeLeft[node];
+        if (left >= 0) {
+          if (sp + 4 > stack.length) {
+            const grown = new Int32Array(stack.length * 2);
+            grown.set(stack);
+            this.stack = stack = grown;
+          }
+          stack[sp++] = left;
+          stack[sp++] = test;
+          stack[sp++] = this.nodeRight[node];
+          stack[sp++] = test;
+          continue;
+        }
+
+        const start = this.nodeStart[node];
+        const end = start + this.nodeCount[node];
+        for (let k = start; k < end; k++) {
+          const leaf = this.leafOrder[k];
+          const primitive = this.primitives[leaf];
+          if (!primitive.visible) {
+            continue;
+          }
+          if (test !== FrustumTest.Inside) {
+            const lb = this.leafBounds;
+            const o = leaf * 6;
+            if (this.frustum.testBox(lb[o], lb[o + 1], lb[o + 2], lb[o + 3], lb[o + 4], lb[o + 5]) ===
+                FrustumTest.Outside) {
+              stats.frustumCulled++;
+              continue;
+            }
+          }
+          if (out.length === this.outLeaves.length) {
+            const grown = new Int32Array(this.outLeaves.length * 2);
+            grown.set(this.outLeaves);
+            this.outLeaves = grown;
+          }
+          this.outLeaves[out.length] = leaf;
+          out.push(primitive);
+        }
+      }
+    }
+
+    if (occlusion && camera.projection === 'perspective' && out.length > 1) {
+      stats.occlusionCulled = this.cullOccluded(camera, out);
+    }
+
+    stats.visible = out.length;
+    return out.length;
+  }
+
+  getStats(): CullingStats {
+    return { ...this.stats };
+  }
+
+  // ==================== Build / refit ====================
+
+  private build(primitives: readonly Primitive3D[]): void {
+    const n = primitives.length;
+    this.primitives = primitives.slice();
+    if (this.leafVersions.length < n) {
+      this.leafVersions = new Float64Array(n);
+      this.leafBounds = new Float64Array(n * 6);
+      this.leafOrder = new Uint32Array(n);
+    }
+    const maxNodes = Math.max(1, 2 * n);
+    if (this.nodeLeft.length < maxNodes) {
+      this.nodeBounds = new Float64Array(maxNodes * 6);
+      this.nodeLeft = new Int32Array(maxNodes);
+      this.nodeRight = new Int32Array(maxNodes);
+      this.nodeStart = new Int32Array(maxNodes);
+      this.nodeCount = new Int32Array(maxNodes);
+    }
+
+    for (let i = 0; i < n; i++) {
+      this.updateLeafBounds(i);
+      this.leafOrder[i] = i;
+    }
+
+    this.nodesUsed = 0;
+    if (n > 0) {
+      this.buildNode(0, n);
+    }
+    this.builtArea = this.refitNodes();
+    this.stats.rebuilds++;
+    this.stats.refitLeaves = n;
+  }
+
+  private buildNode(start: number, end: number): number {
+    const node = this.nodesUsed++;
+    const count = end - start;
+
+    if (count <= LEAF_SIZE) {
+      this.nodeLeft[node] = -1;
+      this.nodeRight[node] = -1;
+      this.nodeStart[node] = start;
+      this.nodeCount[node] = count;
+      return node;
+    }
+
+    // Split at the median centroid along the longest centroid axis
+    const lb = this.leafBounds;
+    let minX = Infinity, minY = Infinity, minZ = Infinity;
+    let maxX = -Infinity, maxY = -Infinity, maxZ = -Infinity;
+    for (let k = start; k < end; k++) {
+      const o = this.leafOrder[k] * 6;
+      const cx = lb[o] + lb[o + 3];
+      const cy = lb[o + 1] + lb[o + 4];
+      const cz = lb[o + 2] + lb[o + 5];
+      if (cx < minX) minX = cx;
+      if (cx > maxX) maxX = cx;
+      if (cy < minY) minY = cy;
+      if (cy > maxY) maxY = cy;
+      if (cz < minZ) minZ = cz;
+      if (cz > maxZ) maxZ = cz;
+    }
+    const ex = maxX - minX, ey = maxY - minY, ez = maxZ - minZ;
+    const axis = ex >= ey && ex >= ez ? 0 : (ey >= ez ? 1 : 2);
+    const mid = (start + end) >> 1;
+    this.selectMedian(start, end - 1, mid, axis);
+
+    this.nodeStart[node] = start;
+    this.nodeCount[node] = count;
+    this.nodeLeft[node] = this.buildNode(start, mid);
+    this.nodeRight[node] = this.buildNode(mid, end);
+    return node;
+  }
+
+  /**
+   * Partially order leafOrder[lo..hi] so position k holds the k-th smallest
+   * centroid along axis (quickselect)
+   */
+  private selectMedian(lo: number, hi: number, k: number, axis: number): void {
+    const order = this.leafOrder;
+    const lb = this.leafBounds;
+    const key = (leaf: number) => lb[leaf * 6 + axis] + lb[leaf * 6 + axis + 3];
+
+    while (hi > lo) {
+      const pivot = key(order[(lo + hi) >> 1]);
+      let i = lo;
+      let j = hi;
+      while (i <= j) {
+        while (key(order[i]) < pivot) i++;
+        while (key(order[j]) > pivot) j--;
+        if (i <= j) {
+          const t = order[i];
+          order[i] = order[j];
+          order[j] = t;
+          i++;
+          j--;
+        }
+      }
+      if (k <= j) {
+        hi = j;
+      } else if (k >= i) {
+        lo = i;
+      } else {
+        return;
+      }
+    }
+  }
+
+  /**
+   * Recompute internal node bounds bottom-up; returns the summed node
+   * surface area (a cheap tree quality measure)
+   */
+  private refitNodes(): number {
+    const nb = this.nodeBounds;
+    const lb = this.leafBounds;
+    let area = 0;
+
+    for (let node = this.nodesUsed - 1; node >= 0; node--) {
+      const b = node * 6;
+      let minX = Infinity, minY = Infinity, minZ = Infinity;
+      let maxX = -Infinity, maxY = -Infinity, maxZ = -Infinity;
+
+      const left = this.nodeLeft[node];
+      if (left >= 0) {
+        const l = left * 6;
+        const r = this.nodeRight[node] * 6;
+        minX = Math.min(nb[l], nb[r]);
+        minY = Math.min(nb[l + 1], nb[r + 1]);
+        minZ = Math.min(nb[l + 2], nb[r + 2]);
+        maxX = Math.max(nb[l + 3], nb[r + 3]);
+        maxY = Math.max(nb[l + 4], nb[r + 4]);
+        maxZ = Math.max(nb[l + 5], nb[r + 5]);
+      } else {
+        const start = this.nodeStart[node];
+        const end = start + this.nodeCount[node];
+        for (let k = start; k < end; k++) {
+          const o = this.leafOrder[k] * 6;
+          if (lb[o] < minX) minX = lb[o];
+          if (lb[o + 1] < minY) minY = lb[o + 1];
+          if (lb[o + 2] < minZ) minZ = lb[o + 2];
+          if (lb[o + 3] > maxX) maxX = lb[o + 3];
+          if (lb[o + 4] > maxY) maxY = lb[o + 4];
+          if (lb[o + 5] > maxZ) maxZ = lb[o + 5];
+        }
+      }
+
+      nb[b] = minX;
+      nb[b + 1] = minY;
+      nb[b + 2] = minZ;
+      nb[b + 3] = maxX;
+      nb[b + 4] = maxY;
+      nb[b + 5] = maxZ;
+
+      const dx = maxX - minX, dy = maxY - minY, dz = maxZ - minZ;
+      if (dx >= 0 && dy >= 0 && dz >= 0) {
+        area += dx * dy + dy * dz + dz * dx;
+      }
+    }
+    return area;
+  }
+
+  /**
+   * Transform a primitive's local bounds into a world AABB (center/extent
+   * form, so no corner vectors are allocated)
+   */
+  private updateLeafBounds(leaf: number): void {
+    const primitive = this.primitives[leaf];
+    const local = primitive.getLocalBoundingBox();
+    const m = primitive.getWorldMatrix().elements;
+
+    const cx = (local.min.x + local.max.x) / 2;
+    const cy = (local.min.y + local.max.y) / 2;
+    const cz = (local.min.z + local.max.z) / 2;
+    const hx = (local.max.x - local.min.x) / 2;
+    const hy = (local.max.y - local.min.y) / 2;
+    const hz = (local.max.z - local.min.z) / 2;
+
+    const wx = m[0] * cx + m[4] * cy + m[8] * cz + m[12];
+    const wy = m[1] * cx + m[5] * cy + m[9] * cz + m[13];
+    const wz = m[2] * cx + m[6] * cy + m[10] * cz + m[14];
+    const ex = Math.abs(m[0]) * hx + Math.abs(m[4]) * hy + Math.abs(m[8]) * hz;
+    const ey = Math.abs(m[1]) * hx + Math.abs(m[5]) * hy + Math.abs(m[9]) * hz;
+    const ez = Math.abs(m[2]) * hx + Math.abs(m[6]) * hy + Math.abs(m[10]) * hz;
+
+    const o = leaf * 6;
+    const lb = this.leafBounds;
+    lb[o] = wx - ex;
+    lb[o + 1] = wy - ey;
+    lb[o + 2] = wz - ez;
+    lb[o + 3] = wx + ex;
+    lb[o + 4] = wy + ey;
+    lb[o + 5] = wz + ez;
+    this.leafVersions[leaf] = primitive.boundsVersion;
+  }
+
+  // ==================== Occlusion ====================
+
+  /**
+   * Coarse occlusion pass over frustum survivors (perspective cameras only).
+   * Compacts `out` in place and returns how many were removed.
+   */
+  private cullOccluded(camera: Camera, out: Primitive3D[]): number {
+    const grid = this.occlusionDepth;
+    grid.fill(Infinity);
+    const vp = camera.getViewProjectionMatrix().elements;
+    const proj = camera.getProjectionMatrix().elements;
+    const near = camera.near;
+    let occluders = 0;
+
+    // Occluders write depth only where they are certain to cover: the
+    // primitive's inscribed sphere contains a disc facing the camera at the
+    // center's depth, and that disc projects to an ellipse in NDC.
+    for (let i = 0; i < out.length; i++) {
+      const primitive = out[i];
+      const material = primitive.material;
+      if (material.opacity < 1 || material.getParsedColor().a < 255) continue;
+
+      const m = primitive.getWorldMatrix().elements;
+      const radius = innerRadius(primitive) * minAxisScale(m);
+      if (radius <= 0) continue;
+
+      const x = m[12], y = m[13], z = m[14];
+      const w = vp[3] * x + vp[7] * y + vp[11] * z + vp[15];
+      if (w <= near) continue;
+
+      // Inscribed rectangle of the ellipse (semi-axes / sqrt 2)
+      const hx = (radius * proj[0] / w) * Math.SQRT1_2;
+      const hy = (radius * proj[5] / w) * Math.SQRT1_2;
+      if (hx < this.minOccluderSize && hy < this.minOccluderSize) continue;
+
+      const nx = (vp[0] * x + vp[4] * y + vp[8] * z + vp[12]) / w;
+      const ny = (vp[1] * x + vp[5] * y + vp[9] * z + vp[13]) / w;
+
+      // Only cells lying entirely inside the rectangle
+      const c0 = Math.ceil(toGrid(nx - hx));
+      const c1 = Math.floor(toGrid(nx + hx)) - 1;
+      const r0 = Math.ceil(toGrid(ny - hy));
+      const r1 = Math.floor(toGrid(ny + hy)) - 1;
+      for (let r = Math.max(0, r0); r <= Math.min(OCCLUSION_GRID - 1, r1); r++) {
+        for (let c = Math.max(0, c0); c <= Math.min(OCCLUSION_GRID - 1, c1); c++) {
+          const idx = r * OCCLUSION_GRID + c;
+          if (w < grid[idx]) grid[idx] = w;
+        }
+      }
+      occluders++;
+    }
+
+    if (occluders === 0) {
+      return 0;
+    }
+
+    // Occludees test their whole projected AABB at its nearest depth
+    const lb = this.leafBounds;
+    const leaves = this.outLeaves;
+    let kept = 0;
+    for (let i = 0; i < out.length; i++) {
+      const o = leaves[i] * 6;
+      if (!this.isOccluded(vp, near, lb[o], lb[o + 1], lb[o + 2], lb[o + 3], lb[o + 4], lb[o + 5])) {
+        leaves[kept] = leaves[i];
+        out[kept++] = out[i];
+      }
+    }
+    const removed = out.length - kept;
+    out.length = kept;
+    return removed;
+  }
+
+  private isOccluded(
+    vp: Float32Array, near: number,
+    minX: number, minY: number, minZ: number,
+    maxX: number, maxY: number, maxZ: number
+  ): boolean {
+    let nMinX = Infinity, nMinY = Infinity, nMaxX = -Infinity, nMaxY = -Infinity;
+    let nearest = Infinity;
+    for (let corner = 0; corner < 8; corner++) {
+      const x = corner & 1 ? maxX : minX;
+      const y = corner & 2 ? maxY : minY;
+      const z = corner & 4 ? maxZ : minZ;
+      const w = vp[3] * x + vp[7] * y + vp[11] * z + vp[15];
+      if (w <= near) {
+        return false;
+      }
+      const nx = (vp[0] * x + vp[4] * y + vp[8] * z + vp[12]) / w;
+      const ny = (vp[1] * x + vp[5] * y + vp[9] * z + vp[13]) / w;
+      if (nx < nMinX) nMinX = nx;
+      if (nx > nMaxX) nMaxX = nx;
+      if (ny < nMinY) nMinY = ny;
+      if (ny > nMaxY) nMaxY = ny;
+      if (w < nearest) nearest = w;
+    }
+
+    // Every overlapped cell must hold a nearer occluder
+    const c0 = Math.max(0, Math.floor(toGrid(nMinX)));
+    const c1 = Math.min(OCCLUSION_GRID - 1, Math.floor(toGrid(nMaxX)));
+    const r0 = Math.max(0, Math.floor(toGrid(nMinY)));
+    const r1 = Math.min(OCCLUSION_GRID - 1, Math.floor(toGrid(nMaxY)));
+    if (c0 > c1 || r0 > r1) {
+      return false;
+    }
+    const grid = this.occlusionDepth;
+    for (let r = r0; r <= r1; r++) {
+      for (let c = c0; c <= c1; c++) {
+        if (grid[r * OCCLUSION_GRID + c] >= nearest) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+}
+
+// NDC [-1, 1] to occlusion grid coordinates [0, OCCLUSION_GRID]
+function toGrid(ndc: number): number {
+  return (ndc + 1) * 0.5 * OCCLUSION_GRID;
+}
+
+/**
+ * Radius of a sphere around the local origin that the primitive fully
+ * contains (0 if it cannot occlude)
+ */
+function innerRadius(primitive: Primitive3D): number {
+  if (primitive instanceof Sphere3D) {
+    return primitive.radius;
+  } else if (primitive instanceof Box3D) {
+    return Math.min(primitive.width, primitive.height, primitive.depth) / 2;
+  } else if (primitive instanceof Cylinder3D) {
+    if (primitive.openEnded) return 0;
+    return Math.min(primitive.radiusTop, primitive.radiusBottom, primitive.height / 2);
+  }
+  return 0;
+}
+
+function minAxisScale(m: Float32Array): number {
+  const sx = Math.sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+  const sy = Math.sqrt(m[4] * m[4] + m[5] * m[5] + m[6] * m[6]);
+  const sz = Math.sqrt(m[8] * m[8] + m[9] * m[9] + m[10] * m[10]);
+  return Math.min(sx, sy, sz);
+}
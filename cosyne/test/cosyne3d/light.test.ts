@@ -288,5 +288,28 @@ describe('Cosyne 3D Lights', () => {
       const { ambient } = manager.calculateLightingAt(Vector3.zero(), Vector3.up());
       expect(ambient).toBeCloseTo(0.7);
     });
+
+    test('scalar diffuse and ambient match calculateLightingAt', () => {
+      const manager = new LightManager();
+      manager.addLight(new AmbientLight({ type: 'ambient', intensity: 0.25 }));
+      manager.addLight(new DirectionalLight({ type: 'directional', direction: [1, -2, -1] }));
+      manager.addLight(new PointLight({ type: 'point', position: [2, 3, 4], decay: 1 }));
+      manager.addLight(new SpotLight({
+        type: 'spot',
+        position: [0, 5, 0],
+        direction: [0, -1, 0],
+        outerAngle: Math.PI / 3,
+      }));
+
+      const point = new Vector3(0.5, 0.2, -0.3);
+      const normal = new Vector3(0.3, 0.9, 0.1).normalize();
+      const { diffuse, ambient } = manager.calculateLightingAt(point, normal);
+
+      expect(manager.calculateAmbient()).toBeCloseTo(ambient);
+      expect(manager.calculateDiffuseAt(
+        point.x, point.y, point.z, normal.x, normal.y, normal.z
+      )).toBeCloseTo(diffuse);
+      expect(diffuse).toBeGreaterThan(0);
+    });
   });
 });
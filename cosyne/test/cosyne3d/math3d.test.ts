@@ -209,6 +209,17 @@ describe('Cosyne 3D Math', () => {
         expect(c.elements[13]).toBe(20);
       });
 
+      test('multiplyMatrices writes into an existing matrix', () => {
+        const a = Matrix4.translation(10, 0, 0);
+        const b = Matrix4.scaling(2, 2, 2);
+        const out = new Matrix4();
+        expect(out.multiplyMatrices(a, b)).toBe(out);
+        expect(Array.from(out.elements)).toEqual(Array.from(a.multiply(b).elements));
+        // Aliasing the output with an operand is allowed
+        a.multiplyMatrices(a, b);
+        expect(Array.from(a.elements)).toEqual(Array.from(out.elements));
+      });
+
       test('transpose works correctly', () => {
         const m = new Matrix4();
         m.elements[4] = 5; // Column 1, Row 0
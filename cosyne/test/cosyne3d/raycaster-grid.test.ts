@@ -0,0 +1,142 @@
+/**
+ * Tests for the Raycaster wall grid
+ */
+
+import { Raycaster, RaycasterWall, RaycasterCamera, createRoom, createWall } from '../../src/raycaster';
+import { WallGrid } from '../../src/raycaster-grid';
+import { Vector3 } from '../../src/math3d';
+
+function makeRand(seed: number): () => number {
+  return () => {
+    seed = (seed * 16807) % 2147483647;
+    return seed / 2147483647;
+  };
+}
+
+function makeLevel(rooms: number, strays: number, rand: () => number): RaycasterWall[] {
+  const walls: RaycasterWall[] = [];
+  const perRow = Math.ceil(Math.sqrt(rooms));
+  for (let i = 0; i < rooms; i++) {
+    walls.push(...createRoom((i % perRow) * 20, Math.floor(i / perRow) * 20, 10 + rand() * 8, 10 + rand() * 8));
+  }
+  const extent = perRow * 20;
+  for (let i = 0; i < strays; i++) {
+    walls.push(createWall(rand() * extent, rand() * extent, rand() * extent, rand() * extent));
+  }
+  return walls;
+}
+
+describe('WallGrid', () => {
+  test('matches a linear scan on random rays', () => {
+    const rand = makeRand(7);
+    const walls = makeLevel(400, 100, rand);
+    const indexed = new Raycaster(320, 200, { maxDistance: 1000 });
+    const linear = new Raycaster(320, 200, { maxDistance: 1000, spatialIndex: false });
+    indexed.syncWalls(walls);
+
+    let hits = 0;
+    for (let i = 0; i < 2000; i++) {
+      const origin = new Vector3(rand() * 440 - 20, rand() * 440 - 20, 0);
+      const angle = rand() * Math.PI * 2;
+      const expected = linear.castRay(origin, angle, walls);
+      const actual = indexed.castRay(origin, angle, walls);
+      if (expected) hits++;
+      expect(actual?.wall).toBe(expected?.wall);
+      expect(actual?.distance).toBe(expected?.distance);
+    }
+    expect(hits).toBeGreaterThan(1000);
+  });
+
+  test('follows walls moved in place', () => {
+    const walls = makeLevel(64, 0, makeRand(3));
+    const raycaster = new Raycaster(320, 200);
+    const door = walls[0];
+    const origin = new Vector3(door.p1.x + 1, door.p1.y - 5, 0);
+
+    raycaster.syncWalls(walls);
+    expect(raycaster.castRay(origin, Math.PI / 2, walls)!.distance).toBeCloseTo(5, 6);
+
+    door.p1.y -= 3;
+    door.p2.y -= 3;
+    raycaster.syncWalls(walls);
+    expect(raycaster.castRay(origin, Math.PI / 2, walls)!.distance).toBeCloseTo(2, 6);
+
+    // Moved right out of the level bounds
+    door.p1.y -= 1000;
+    door.p2.y -= 1000;
+    raycaster.syncWalls(walls);
+    const outside = new Vector3(door.p1.x + 1, door.p1.y + 2, 0);
+    expect(raycaster.castRay(outside, -Math.PI / 2, walls)!.wall).toBe(door);
+  });
+
+  test('rebuilds when walls are added', () => {
+    const walls = makeLevel(64, 0, makeRand(5));
+    const raycaster = new Raycaster(320, 200);
+    const origin = new Vector3(5, 5, 0);
+    raycaster.syncWalls(walls);
+    raycaster.castRay(origin, 0, walls);
+
+    // Until the next sync the grown list is scanned linearly
+    const blocker = createWall(6, 0, 6, 10);
+    walls.push(blocker);
+    expect(raycaster.castRay(origin, 0, walls)!.wall).toBe(blocker);
+    raycaster.syncWalls(walls);
+    expect(raycaster.castRay(origin, 0, walls)!.wall).toBe(blocker);
+  });
+
+  test('castRay does not sync the grid, render does once per frame', () => {
+    const level = makeLevel(64, 0, makeRand(13));
+    const doors = makeLevel(16, 0, makeRand(17));
+    const raycaster = new Raycaster(64, 40);
+    const sync = jest.spyOn(WallGrid.prototype, 'sync');
+    try {
+      const camera: RaycasterCamera = { position: new Vector3(5, 5, 0), angle: 0, pitch: 0, height: 0.5 } as RaycasterCamera;
+      raycaster.render(new Uint8Array(64 * 40 * 4), camera, level);
+      expect(sync).toHaveBeenCalledTimes(1);
+
+      // Alternating lists between frames neither syncs nor rebuilds
+      const origin = new Vector3(5, 5, 0);
+      for (let i = 0; i < 20; i++) {
+        raycaster.castRay(origin, i * 0.3, i % 2 ? level : doors);
+      }
+      expect(sync).toHaveBeenCalledTimes(1);
+    } finally {
+      sync.mockRestore();
+    }
+  });
+
+  test('keeps cell count proportional to wall count', () => {
+    const grid = new WallGrid();
+    const walls = makeLevel(100, 50, makeRand(11));
+    grid.build(walls);
+    expect(grid.getCellCount()).toBeLessThanOrEqual(walls.length * 4);
+  });
+
+  test('does not rebuild when the wall array is recreated each frame', () => {
+    const level = makeLevel(100, 50, makeRand(9));
+    const grid = new WallGrid();
+    // Fresh array and wall objects every frame, as renderers mapping their map walls do
+    const frame = () => level.map((w) => ({ ...w, p1: { ...w.p1 }, p2: { ...w.p2 } }) as RaycasterWall);
+
+    for (let i = 0; i < 10; i++) {
+      grid.sync(frame());
+    }
+    expect(grid.getRebuildCount()).toBe(1);
+
+    // One wall moving is re-bucketed, not rebuilt
+    level[0].p1.x += 2;
+    grid.sync(frame());
+    expect(grid.getRebuildCount()).toBe(1);
+
+    // A different wall count rebuilds
+    grid.sync(frame().slice(1));
+    expect(grid.getRebuildCount()).toBe(2);
+  });
+
+  test('rebuilds when most walls move', () => {
+    const grid = new WallGrid();
+    grid.sync(makeLevel(100, 0, makeRand(9)));
+    grid.sync(makeLevel(100, 0, makeRand(21)));
+    expect(grid.getRebuildCount()).toBe(2);
+  });
+});
@@ -0,0 +1,111 @@
+/**
+ * Tests for column-parallel Raycaster rendering on worker threads
+ */
+
+import { Raycaster, RaycasterCamera, RaycasterWall, createRoom, createSprite } from '../../src/raycaster';
+import { Vector3 } from '../../src/math3d';
+
+async function waitForThreads(raycaster: Raycaster): Promise<void> {
+  for (let i = 0; i < 250 && raycaster.getActiveThreads() === 0; i++) {
+    await new Promise(resolve => setTimeout(resolve, 20));
+  }
+}
+
+function makeLevel(): RaycasterWall[] {
+  const walls: RaycasterWall[] = [];
+  for (let i = 0; i < 100; i++) {
+    walls.push(...createRoom((i % 10) * 20, Math.floor(i / 10) * 20, 12 + (i % 3) * 2, 14 - (i % 4)));
+  }
+  walls[1].material = { type: 'texture', textureId: 'brick' };
+  walls[2].material = { type: 'solid', color: [10, 200, 30] };
+  walls[3].backColor = [90, 20, 20];
+  return walls;
+}
+
+function countDifferences(a: Uint8Array, b: Uint8Array): number {
+  let diff = 0;
+  for (let i = 0; i < a.length; i++) {
+    if (a[i] !== b[i]) diff++;
+  }
+  return diff;
+}
+
+describe('Raycaster worker threads', () => {
+  const texture = {
+    width: 4,
+    height: 4,
+    data: new Uint8Array(64).map((_, i) => (i * 37) & 255),
+  };
+  const config = {
+    renderOffset: [3, -2] as [number, number],
+    floorMaterial: { type: 'texture' as const, textureId: 'brick' },
+  };
+  const camera: RaycasterCamera = { position: new Vector3(-2, -2, 0), angle: 0.7, height: 15, pitch: 0.1, roll: 0.01 };
+
+  let single: Raycaster;
+  let threaded: Raycaster;
+
+  beforeAll(async () => {
+    single = new Raycaster(320, 200, config);
+    threaded = new Raycaster(320, 200, { ...config, threads: 2 });
+    single.addTexture('brick', texture);
+    threaded.addTexture('brick', texture);
+    await waitForThreads(threaded);
+    // Without this every test below would pass on the single-thread fallback
+    expect(threaded.getActiveThreads()).toBe(2);
+  }, 10000);
+
+  afterAll(() => {
+    threaded.dispose();
+  });
+
+  test('matches single-threaded output', () => {
+    const walls = makeLevel();
+    const sprites = [createSprite(3, 3, [255, 0, 0]), createSprite(4, 1, [0, 255, 0])];
+    sprites[1].alpha = 0.5;
+    const expected = new Uint8Array(320 * 200 * 4);
+    const actual = new Uint8Array(320 * 200 * 4);
+
+    for (let frame = 0; frame < 3; frame++) {
+      camera.angle += 0.3;
+      walls[0].p1.x += 1;
+      single.render(expected, camera, walls, sprites);
+      threaded.render(actual, camera, walls, sprites);
+      // The frame went through the workers' shared target
+      expect(threaded.getActiveThreads()).toBe(2);
+      expect(countDifferences(threaded.getSharedBuffer()!, actual)).toBe(0);
+      expect(countDifferences(expected, actual)).toBe(0);
+      expect(Array.from(threaded.getDepthBuffer())).toEqual(Array.from(single.getDepthBuffer()));
+    }
+  });
+
+  test('renders procedural materials on the calling thread', () => {
+    const walls = makeLevel();
+    const sample = (u: number, v: number): [number, number, number] => [u * 255, v * 255, 0];
+    walls[4].material = { type: 'procedural', sample };
+    const expected = new Uint8Array(320 * 200 * 4);
+    const actual = new Uint8Array(320 * 200 * 4);
+    single.render(expected, camera, walls);
+    threaded.render(actual, camera, walls);
+    expect(countDifferences(expected, actual)).toBe(0);
+  });
+
+  test('follows resizes', () => {
+    const walls = makeLevel();
+    single.resize(160, 100);
+    threaded.resize(160, 100);
+    expect(threaded.getActiveThreads()).toBe(2);
+    const expected = new Uint8Array(160 * 100 * 4);
+    const actual = threaded.getSharedBuffer() || new Uint8Array(160 * 100 * 4);
+    expect(actual.length).toBe(expected.length);
+    single.render(expected, camera, walls);
+    threaded.render(actual, camera, walls);
+    expect(countDifferences(expected, actual)).toBe(0);
+  });
+
+  test('is off by default', () => {
+    const raycaster = new Raycaster(64, 64);
+    expect(raycaster.getActiveThreads()).toBe(0);
+    expect(raycaster.getSharedBuffer()).toBeNull();
+  });
+});
@@ -0,0 +1,138 @@
+/**
+ * Tests for the z-buffered triangle pipeline behind renderToBuffer
+ */
+
+import { Cosyne3dContext } from '../../src/context3d';
+import { renderToBuffer } from '../../src/renderer3d-buffer';
+import { getPrimitiveMesh, tessellateSphere, tessellateBox } from '../../src/renderer3d-mesh';
+import { FrameArena } from '../../src/renderer3d-arena';
+import { createRenderTarget } from '../../../core/dist/src/graphics/platform';
+
+function pixelAt(pixels: Uint8Array, width: number, x: number, y: number): [number, number, number] {
+  const i = (y * width + x) * 4;
+  return [pixels[i], pixels[i + 1], pixels[i + 2]];
+}
+
+function makeContext(): Cosyne3dContext {
+  const ctx = new Cosyne3dContext({}, { width: 64, height: 64, backgroundColor: '#000000' });
+  ctx.setCamera({ fov: 60, position: [0, 0, 10], lookAt: [0, 0, 0] });
+  return ctx;
+}
+
+describe('renderer3d-mesh', () => {
+  test('sphere tessellation has closed poles', () => {
+    const mesh = tessellateSphere(1, 8, 4);
+    expect(mesh.positions.length / 3).toBe(9 * 5);
+    expect(mesh.indices.length / 3).toBe(8 * 3 * 2);
+  });
+
+  test('box tessellation has 12 triangles', () => {
+    const mesh = tessellateBox(1, 2, 3);
+    expect(mesh.indices.length).toBe(36);
+    expect(mesh.doubleSided).toBe(false);
+  });
+
+  test('meshes are cached until a shape parameter changes', () => {
+    const ctx = makeContext();
+    const sphere = ctx.sphere({ radius: 1 });
+    const first = getPrimitiveMesh(sphere);
+    sphere.setPosition([1, 2, 3]);
+    expect(getPrimitiveMesh(sphere)).toBe(first);
+    sphere.setRadius(2);
+    expect(getPrimitiveMesh(sphere)).not.toBe(first);
+  });
+});
+
+describe('renderToBuffer', () => {
+  test('allocates and clears a depth buffer on the target', () => {
+    const ctx = makeContext();
+    const target = createRenderTarget(64, 64);
+    renderToBuffer(ctx, target);
+    expect(target.depth).toBeDefined();
+    expect(target.depth!.length).toBe(64 * 64);
+    expect(target.depth![0]).toBe(1);
+  });
+
+  test('renders a sphere at the screen center', () => {
+    const ctx = makeContext();
+    ctx.sphere({ radius: 2, material: { color: '#ff0000', unlit: true } });
+    const pixels = renderToBuffer(ctx, createRenderTarget(64, 64));
+    expect(pixelAt(pixels, 64, 32, 32)).toEqual([255, 0, 0]);
+    expect(pixelAt(pixels, 64, 1, 1)).toEqual([0, 0, 0]);
+  });
+
+  test('resolves intersecting primitives per pixel', () => {
+    const ctx = makeContext();
+    // A wide thin slab poking through a box: the slab is nearer on the left,
+    // the box is nearer on the right, so neither object order can be right.
+    ctx.box({ size: [4, 4, 4], material: { color: '#0000ff', unlit: true } });
+    ctx.box({
+      size: [8, 1, 0.2],
+      rotation: [0, 1.0, 0],
+      material: { color: '#00ff00', unlit: true },
+    });
+    const pixels = renderToBuffer(ctx, createRenderTarget(64, 64));
+    const row = 32;
+    const colors = new Set<string>();
+    // Only sample columns inside the box's silhouette
+    for (let x = 20; x <= 44; x++) {
+      colors.add(pixelAt(pixels, 64, x, row).join(','));
+    }
+    expect(colors.has('0,0,255')).toBe(true);
+    expect(colors.has('0,255,0')).toBe(true);
+  });
+
+  test('culls geometry behind the camera', () => {
+    const ctx = makeContext();
+    ctx.box({ size: 2, position: [0, 0, 20], material: { color: '#ffffff', unlit: true } });
+    const pixels = renderToBuffer(ctx, createRenderTarget(64, 64));
+    for (let i = 0; i < pixels.length; i += 4) {
+      expect(pixels[i]).toBe(0);
+    }
+  });
+});
+
+describe('FrameArena', () => {
+  test('sorts queued items far to near', () => {
+    const ctx = makeContext();
+    const near = ctx.sphere({ radius: 1 });
+    const far = ctx.sphere({ radius: 1 });
+    const mid = ctx.sphere({ radius: 1 });
+    const arena = new FrameArena(16, 1);
+    arena.pushItem(near, 1);
+    arena.pushItem(far, 9);
+    arena.pushItem(mid, 5);
+    arena.sortItemsBackToFront();
+    expect([arena.itemAt(0), arena.itemAt(1), arena.itemAt(2)]).toEqual([far, mid, near]);
+    arena.reset();
+    expect(arena.itemCount).toBe(0);
+  });
+
+  test('stops growing once warmed up', () => {
+    const ctx = makeContext();
+    ctx.sphere({ radius: 1, widthSegments: 32, heightSegments: 16 });
+    ctx.box({ size: 1, position: [2, 0, 0], material: { color: '#00ff00', opacity: 0.5 } });
+    ctx.box({ size: 1, position: [-2, 0, 0], material: { color: '#ff0000', opacity: 0.5 } });
+    const target = createRenderTarget(64, 64);
+    const arena = new FrameArena(8, 1);
+
+    renderToBuffer(ctx, target, arena);
+    const warm = arena.getGrowCount();
+    expect(warm).toBeGreaterThan(0);
+    for (let i = 0; i < 10; i++) {
+      ctx.getCamera().setPosition([Math.sin(i), 0, 10]);
+      renderToBuffer(ctx, target, arena);
+    }
+    expect(arena.getGrowCount()).toBe(warm);
+  });
+
+  test('translucent primitives blend back to front', () => {
+    const ctx = makeContext();
+    ctx.box({ size: 4, position: [0, 0, -2], material: { color: '#0000ff', unlit: true, opacity: 0.5 } });
+    ctx.box({ size: 2, position: [0, 0, 2], material: { color: '#ff0000', unlit: true, opacity: 0.5 } });
+    const pixels = renderToBuffer(ctx, createRenderTarget(64, 64), new FrameArena());
+    const [r, , b] = pixelAt(pixels, 64, 32, 32);
+    // Red is nearer, so it is blended last and dominates
+    expect(r).toBeGreaterThan(b);
+  });
+});
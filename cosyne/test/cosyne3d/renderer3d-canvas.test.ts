@@ -0,0 +1,137 @@
+/**
+ * Tests for incremental canvas rendering of 3D scenes
+ */
+
+import { Cosyne3dContext } from '../../src/context3d';
+import { CanvasSceneRenderer, renderToCanvas } from '../../src/renderer3d-canvas';
+
+interface MockWidget {
+  type: string;
+  props: any;
+  update: jest.Mock;
+}
+
+function makeApp(): { widgets: MockWidget[] } & Record<string, any> {
+  const widgets: MockWidget[] = [];
+  const create = (type: string) => (props: any) => {
+    const widget: MockWidget = { type, props, update: jest.fn() };
+    widgets.push(widget);
+    return widget;
+  };
+  return {
+    widgets,
+    canvasRectangle: create('rectangle'),
+    canvasPolygon: create('polygon'),
+    canvasSphere: create('sphere'),
+  };
+}
+
+function makeScene(): Cosyne3dContext {
+  const ctx = new Cosyne3dContext({}, { width: 200, height: 200, backgroundColor: '#000000' });
+  ctx.setCamera({ fov: 60, position: [4, 5, 10], lookAt: [0, 0, 0] });
+  ctx.box({ size: 1, position: [-2, 0, 0], material: { color: '#ff0000' } });
+  ctx.box({ size: 1, position: [2, 0, 0], material: { color: '#00ff00' } });
+  ctx.sphere({ radius: 0.8, position: [0, 0, -2], material: { color: '#0000ff' } });
+  return ctx;
+}
+
+function updateCount(app: { widgets: MockWidget[] }): number {
+  return app.widgets.reduce((sum, w) => sum + w.update.mock.calls.length, 0);
+}
+
+describe('CanvasSceneRenderer', () => {
+  test('emits the same widgets as renderToCanvas', () => {
+    const ctx = makeScene();
+    const expected = makeApp();
+    const actual = makeApp();
+    renderToCanvas(ctx, expected);
+    new CanvasSceneRenderer().render(ctx, actual);
+    expect(actual.widgets.map(w => [w.type, w.props])).toEqual(expected.widgets.map(w => [w.type, w.props]));
+  });
+
+  test('sends nothing for an unchanged scene', () => {
+    const ctx = makeScene();
+    const app = makeApp();
+    const scene = new CanvasSceneRenderer();
+    scene.render(ctx, app);
+
+    expect(scene.update(ctx)).toBe(true);
+    expect(updateCount(app)).toBe(0);
+    expect(scene.getStats()).toEqual({ reused: 3, recomputed: 0, updates: 0 });
+  });
+
+  test('updates only the primitive that moved', () => {
+    const ctx = makeScene();
+    const app = makeApp();
+    const scene = new CanvasSceneRenderer();
+    scene.render(ctx, app);
+
+    const [left] = ctx.getAllPrimitives();
+    left.setPosition([-2, 0.1, 0]);
+    expect(scene.update(ctx)).toBe(true);
+
+    const stats = scene.getStats();
+    expect(stats.recomputed).toBe(1);
+    expect(stats.reused).toBe(2);
+    expect(stats.updates).toBeGreaterThan(0);
+    expect(stats.updates).toBeLessThanOrEqual(3);
+    const sphere = app.widgets.find(w => w.type === 'sphere')!;
+    expect(sphere.update).not.toHaveBeenCalled();
+  });
+
+  test('recolors polygons when a material changes', () => {
+    const ctx = makeScene();
+    const app = makeApp();
+    const scene = new CanvasSceneRenderer();
+    scene.render(ctx, app);
+
+    const [, right] = ctx.getAllPrimitives();
+    right.material.color = '#ffff00';
+    expect(scene.update(ctx)).toBe(true);
+    const recolored = app.widgets.filter(w => w.update.mock.calls.length > 0);
+    expect(recolored.length).toBeGreaterThan(0);
+    for (const widget of recolored) {
+      expect(widget.update.mock.calls[0][0].points).toBeUndefined();
+      expect(widget.update.mock.calls[0][0].fillColor).toMatch(/^#/);
+    }
+  });
+
+  test('reprojects everything when the camera moves', () => {
+    const ctx = makeScene();
+    const app = makeApp();
+    const scene = new CanvasSceneRenderer();
+    scene.render(ctx, app);
+
+    ctx.getCamera().setPosition([4.2, 5, 10]);
+    expect(scene.update(ctx)).toBe(true);
+    expect(scene.getStats().recomputed).toBe(3);
+    expect(app.widgets.find(w => w.type === 'sphere')!.update).toHaveBeenCalled();
+  });
+
+  test('asks for a full render when more widgets are needed', () => {
+    const ctx = makeScene();
+    const scene = new CanvasSceneRenderer();
+    scene.render(ctx, makeApp());
+
+    ctx.box({ size: 1, position: [0, 2, 0] });
+    expect(scene.update(ctx)).toBe(false);
+    expect(new CanvasSceneRenderer().update(ctx)).toBe(false);
+  });
+
+  test('hides spare polygon slots when fewer faces are visible', () => {
+    const ctx = new Cosyne3dContext({}, { width: 200, height: 200 });
+    ctx.setCamera({ fov: 60, position: [4, 5, 10], lookAt: [0, 0, 0] });
+    ctx.box({ size: 1 });
+    const app = makeApp();
+    const scene = new CanvasSceneRenderer();
+    scene.render(ctx, app);
+    expect(app.widgets.filter(w => w.type === 'polygon').length).toBe(3);
+
+    // Straight on, only the front face is visible
+    ctx.getCamera().setPosition([0, 0, 10]);
+    expect(scene.update(ctx)).toBe(true);
+    const hidden = app.widgets.filter(w =>
+      w.update.mock.calls.some(([changes]) => changes.fillColor === 'transparent'));
+    expect(hidden.length).toBe(2);
+  });
+});
@@ -0,0 +1,112 @@
+/**
+ * Tests for BVH-based frustum and occlusion culling
+ */
+
+import { Cosyne3dContext } from '../../src/context3d';
+import { Frustum } from '../../src/math3d';
+
+function makeContext(options: { occlusionCulling?: boolean } = {}): Cosyne3dContext {
+  const ctx = new Cosyne3dContext({}, { width: 64, height: 64, ...options });
+  ctx.setCamera({ fov: 60, position: [0, 0, 10], lookAt: [0, 0, 0] });
+  return ctx;
+}
+
+describe('SceneBVH culling', () => {
+  test('drops primitives outside the frustum', () => {
+    const ctx = makeContext();
+    const inView = ctx.sphere({ radius: 1 });
+    ctx.sphere({ radius: 1, position: [0, 0, 20] });   // behind the camera
+    ctx.sphere({ radius: 1, position: [50, 0, 0] });   // far off to the side
+
+    expect(ctx.getRenderablePrimitives()).toEqual([inView]);
+    expect(ctx.getCullingStats().frustumCulled).toBe(2);
+  });
+
+  test('skips hidden primitives', () => {
+    const ctx = makeContext();
+    const hidden = ctx.box({ size: 1 });
+    hidden.visible = false;
+    expect(ctx.getRenderablePrimitives().length).toBe(0);
+  });
+
+  test('refits moved primitives without rebuilding', () => {
+    const ctx = makeContext();
+    for (let i = 0; i < 50; i++) {
+      ctx.box({ size: 0.5, position: [(i % 10) - 5, Math.floor(i / 10) - 2, 0] });
+    }
+    const mover = ctx.sphere({ radius: 0.5, position: [100, 0, 0] });
+
+    expect(ctx.getRenderablePrimitives()).not.toContain(mover);
+    const rebuilds = ctx.getCullingStats().rebuilds;
+
+    mover.setPosition([0, 0, 2]);
+    expect(ctx.getRenderablePrimitives()).toContain(mover);
+    expect(ctx.getCullingStats().refitLeaves).toBe(1);
+    expect(ctx.getCullingStats().rebuilds).toBe(rebuilds);
+  });
+
+  test('picks up shape changes', () => {
+    const ctx = makeContext();
+    // Centered off-screen, but a large radius reaches into view
+    const sphere = ctx.sphere({ radius: 1, position: [12, 0, 0] });
+    expect(ctx.getRenderablePrimitives().length).toBe(0);
+    sphere.setRadius(10);
+    expect(ctx.getRenderablePrimitives()).toEqual([sphere]);
+  });
+
+  test('rebuilds when primitives are added', () => {
+    const ctx = makeContext();
+    ctx.box({ size: 1 });
+    ctx.getRenderablePrimitives();
+    const added = ctx.box({ size: 1, position: [1, 0, 0] });
+    expect(ctx.getRenderablePrimitives()).toContain(added);
+  });
+
+  test('matches brute-force frustum tests on a large scene', () => {
+    const ctx = makeContext();
+    let seed = 1;
+    const rand = () => {
+      seed = (seed * 16807) % 2147483647;
+      return seed / 2147483647;
+    };
+    for (let i = 0; i < 10000; i++) {
+      ctx.box({
+        size: 0.2 + rand(),
+        position: [rand() * 200 - 100, rand() * 200 - 100, rand() * 200 - 100],
+        rotation: [rand() * 3, rand() * 3, 0],
+      });
+    }
+
+    const frustum = new Frustum().setFromMatrix(ctx.getCamera().getViewProjectionMatrix());
+    const expected = ctx.getAllPrimitives().filter(p => frustum.intersectsBox(p.getWorldBoundingBox()));
+    const actual = ctx.getRenderablePrimitives();
+
+    expect(actual.length).toBe(expected.length);
+    expect(new Set(actual)).toEqual(new Set(expected));
+    expect(actual.length).toBeLessThan(10000);
+  });
+
+  test('occlusion culling hides primitives behind a large opaque one', () => {
+    const ctx = makeContext({ occlusionCulling: true });
+    const wall = ctx.sphere({ radius: 3 });
+    const hiddenBox = ctx.box({ size: 0.5, position: [0, 0, -10] });
+    const besideBox = ctx.box({ size: 0.5, position: [8, 0, -10] });
+
+    const renderable = ctx.getRenderablePrimitives();
+    expect(renderable).toContain(wall);
+    expect(renderable).toContain(besideBox);
+    expect(renderable).not.toContain(hiddenBox);
+    expect(ctx.getCullingStats().occlusionCulled).toBe(1);
+
+    // Translucent primitives never occlude
+    wall.material.opacity = 0.5;
+    expect(ctx.getRenderablePrimitives()).toContain(hiddenBox);
+  });
+
+  test('occlusion culling is off by default', () => {
+    const ctx = makeContext();
+    ctx.sphere({ radius: 3 });
+    ctx.box({ size: 0.5, position: [0, 0, -10] });
+    expect(ctx.getRenderablePrimitives().length).toBe(2);
+  });
+});
@@ -0,0 +1,119 @@
+/**
+ * Tests for the central frame scheduler
+ */
+
+import { FrameScheduler } from '../src/frame-scheduler';
+import { AnimationManager } from '../src/animation-manager';
+import { Animation } from '../src/animation';
+import { Emitter, ParticleSystem } from '../src/particle-system';
+
+describe('FrameScheduler', () => {
+  let time: number;
+  let scheduler: FrameScheduler;
+
+  beforeEach(() => {
+    time = 1000;
+    scheduler = new FrameScheduler({ manual: true, now: () => time });
+  });
+
+  it('accumulates whole fixed steps', () => {
+    const deltas: number[] = [];
+    scheduler.subscribe((dt) => deltas.push(dt), { stepMs: 10 });
+
+    time += 25;
+    scheduler.tick();
+    expect(deltas).toEqual([10, 10]);
+
+    // The 5ms remainder carries over
+    time += 5;
+    scheduler.tick();
+    expect(deltas).toEqual([10, 10, 10]);
+  });
+
+  it('passes real elapsed time to variable-step subscribers', () => {
+    const deltas: number[] = [];
+    scheduler.subscribe((dt) => deltas.push(dt));
+    time += 7;
+    scheduler.tick();
+    time += 13;
+    scheduler.tick();
+    expect(deltas).toEqual([7, 13]);
+  });
+
+  it('caps catch-up steps after a stall', () => {
+    let steps = 0;
+    scheduler = new FrameScheduler({ manual: true, now: () => time, maxStepsPerTick: 3 });
+    scheduler.subscribe(() => steps++, { stepMs: 10 });
+    time += 1000;
+    scheduler.tick();
+    expect(steps).toBe(3);
+    time += 10;
+    scheduler.tick();
+    expect(steps).toBe(4);
+  });
+
+  it('runs each requested flush once per tick, after all subscribers', () => {
+    const order: string[] = [];
+    const flush = () => order.push('flush');
+    scheduler.subscribe(() => {
+      order.push('a');
+      scheduler.requestFlush(flush);
+    });
+    scheduler.subscribe(() => {
+      order.push('b');
+      scheduler.requestFlush(flush);
+    });
+    time += 16;
+    scheduler.tick();
+    expect(order).toEqual(['a', 'b', 'flush']);
+  });
+
+  it('allows unsubscribing during a tick', () => {
+    let calls = 0;
+    const unsubscribe = scheduler.subscribe(() => {
+      calls++;
+      unsubscribe();
+    });
+    scheduler.tick();
+    scheduler.tick();
+    expect(calls).toBe(1);
+    expect(scheduler.getSubscriberCount()).toBe(0);
+  });
+
+  it('drives animations and particles in the same tick with one refresh', () => {
+    const manager = new AnimationManager(scheduler);
+    const refresh = jest.fn();
+    manager.setRefreshCallback(refresh);
+    const target: Record<string, any> = {};
+    manager.add(new Animation({ from: 0, to: 100, duration: 100 }), target, 'value');
+
+    const ps = new ParticleSystem(scheduler);
+    const emitter = new Emitter(0, 0, { rate: 1000 });
+    ps.addEmitter(emitter);
+    ps.subscribe(() => scheduler.requestFlush(refresh));
+    ps.start();
+
+    time += 50;
+    scheduler.tick();
+    expect(target.value).toBeGreaterThan(0);
+    expect(emitter.getParticleCount()).toBeGreaterThan(0);
+    expect(refresh).toHaveBeenCalledTimes(1);
+
+    ps.stop();
+    manager.clear();
+    expect(scheduler.getSubscriberCount()).toBe(0);
+  });
+
+  it('ticks on its own timer until the last subscriber leaves', (done) => {
+    const timed = new FrameScheduler({ frameMs: 5 });
+    let ticks = 0;
+    const unsubscribe = timed.subscribe(() => ticks++);
+    expect(timed.isRunning()).toBe(true);
+    setTimeout(() => {
+      unsubscribe();
+      expect(ticks).toBeGreaterThan(2);
+      expect(timed.isRunning()).toBe(false);
+      done();
+    }, 60);
+  });
+});
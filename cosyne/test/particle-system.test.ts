@@ -1,4 +1,7 @@
 import { Particle, Emitter, ParticleSystem } from '../src/particle-system';
+import { ParticleStore, packRGBA } from '../src/particle-store';
+import { FrameScheduler } from '../src/frame-scheduler';
+import { createRenderTarget } from '../../core/dist/src/graphics/platform';
 
 describe('Particle', () => {
   it('should initialize with position', () => {
@@ -100,13 +103,13 @@ describe('Emitter', () => {
   it('should emit particles', () => {
     const e = new Emitter(0, 0, { rate: 100 });
     e.update(50);  // 5 particles at 100/sec
-    expect(e.particles.length).toBeGreaterThan(0);
+    expect(e.store.count).toBeGreaterThan(0);
   });
 
   it('should respect rate', () => {
     const e = new Emitter(0, 0, { rate: 10, life: 2000 });
     e.update(1000);  // Should emit ~10 particles
-    const count = e.particles.length;
+    const count = e.store.count;
     expect(count).toBeGreaterThan(5);
     expect(count).toBeLessThan(15);
   });
@@ -118,8 +121,8 @@ describe('Emitter', () => {
       spreadAngle: 0,
     });
     e.update(100);
-    for (const p of e.particles) {
-      expect(p.position.x).toBeGreaterThan(100);
+    for (let i = 0; i < e.store.count; i++) {
+      expect(e.store.posX[i]).toBeGreaterThan(100);
     }
   });
 
@@ -129,7 +132,7 @@ describe('Emitter', () => {
       life: 100,
     });
     e.update(500);
-    expect(e.particles.length).toBe(0);
+    expect(e.store.count).toBe(0);
   });
 
   it('should set position', () => {
@@ -159,7 +162,8 @@ describe('Emitter', () => {
       velocity: { x: 100, y: 0 },
     });
     e.update(50);
-    const angles = e.particles.map((p) => Math.atan2(p.velocity.y, p.velocity.x));
+    const { store } = e;
+    const angles = Array.from({ length: store.count }, (_, i) => Math.atan2(store.velY[i], store.velX[i]));
     const hasVariation = angles.some((a) => Math.abs(a - angles[0]) > 0.1);
     expect(hasVariation).toBe(true);
   });
@@ -171,8 +175,9 @@ describe('Emitter', () => {
       velocity: { x: 100, y: 0 },
     });
     e.update(50);
-    const speeds = e.particles.map((p) =>
-      Math.sqrt(p.velocity.x ** 2 + p.velocity.y ** 2)
+    const { store } = e;
+    const speeds = Array.from({ length: store.count }, (_, i) =>
+      Math.sqrt(store.velX[i] ** 2 + store.velY[i] ** 2)
     );
     const hasVariation = speeds.some((s) => Math.abs(s - speeds[0]) > 1);
     expect(hasVariation).toBe(true);
@@ -215,7 +220,7 @@ describe('ParticleSystem', () => {
     setTimeout(() => {
       ps.stop();
       // Particles should fall downward due to gravity
-      const avgY = e.particles.reduce((sum, p) => sum + p.position.y, 0) / e.particles.length;
+      const avgY = e.store.posY.subarray(0, e.store.count).reduce((sum, y) => sum + y, 0) / e.store.count;
       expect(avgY).toBeGreaterThan(0);
     }, 50);
   });
@@ -246,6 +251,29 @@ describe('ParticleSystem', () => {
     }, 50);
   });
 
+  it('should notify listeners once per tick after catch-up steps', () => {
+    let now = 0;
+    const scheduler = new FrameScheduler({ manual: true, now: () => now });
+    const ps = new ParticleSystem(scheduler);
+    const e = new Emitter(0, 0, { rate: 100, life: 10000 });
+    ps.addEmitter(e);
+
+    const seen: number[] = [];
+    ps.subscribe(() => seen.push(e.getParticleCount()));
+    ps.start();
+
+    // One late tick covers 4 fixed steps
+    now += 4 * (1000 / 60) + 1;
+    scheduler.tick(now);
+    expect(seen.length).toBe(1);
+    // Listener ran after the last step
+    expect(seen[0]).toBe(e.getParticleCount());
+
+    scheduler.tick(now);
+    expect(seen.length).toBe(1);
+    ps.stop();
+  });
+
   it('should clear', () => {
     const ps = new ParticleSystem();
     const e = new Emitter(0, 0, { rate: 100 });
@@ -270,3 +298,125 @@ describe('ParticleSystem', () => {
     }, 50);
   });
 });
+
+describe('ParticleStore', () => {
+  it('should swap-remove dead particles', () => {
+    const store = new ParticleStore(2);
+    store.spawn(0, 0, 0, 0, 100, 1, 0);
+    store.spawn(1, 0, 0, 0, 500, 1, 0);
+    store.spawn(2, 0, 0, 0, 100, 1, 0);
+    store.spawn(3, 0, 0, 0, 500, 1, 0);
+    expect(store.capacity).toBeGreaterThanOrEqual(4);
+
+    store.update(200, 0, 0, 1);
+    expect(store.count).toBe(2);
+    expect(Array.from(store.posX.subarray(0, 2)).sort()).toEqual([1, 3]);
+  });
+
+  it('should integrate like Particle', () => {
+    const store = new ParticleStore();
+    const p = new Particle(10, 20, { velocity: { x: 30, y: -40 }, acceleration: { x: 5, y: 98 }, friction: 0.99 });
+    store.spawn(10, 20, 30, -40, 1000, 3, packRGBA(255, 255, 255, 255));
+    for (let i = 0; i < 10; i++) {
+      p.update(16);
+      store.update(16, 5, 98, 0.99);
+    }
+    expect(store.posX[0]).toBeCloseTo(p.position.x, 3);
+    expect(store.posY[0]).toBeCloseTo(p.position.y, 3);
+    expect(store.life[0]).toBe(p.life);
+    expect(store.alphaAt(0) * 255).toBeCloseTo(255 * p.getAlpha(), 3);
+  });
+
+  it('should render discs into a buffer', () => {
+    const target = createRenderTarget(20, 20);
+    const store = new ParticleStore();
+    store.spawn(10, 10, 0, 0, 1000, 3, packRGBA(255, 0, 0, 255));
+    store.render(target);
+    const at = (x: number, y: number) => Array.from(target.pixels.subarray((y * 20 + x) * 4, (y * 20 + x) * 4 + 4));
+    expect(at(10, 10)).toEqual([255, 0, 0, 255]);
+    expect(at(13, 10)).toEqual([255, 0, 0, 255]);
+    expect(at(15, 10)[3]).toBe(0);
+  });
+
+  it('should keep emitter particles in the store', () => {
+    const e = new Emitter(5, 5, { rate: 1000, color: '#00ff00', alpha: 0.5 });
+    e.update(10);
+    expect(e.store.count).toBe(e.getParticleCount());
+    expect(e.particles[0].color).toBe('#00ff00');
+    expect(e.particles[0].alpha).toBeCloseTo(0.5, 2);
+  });
+
+  it('should return a fresh particles snapshot on every read', () => {
+    const e = new Emitter(5, 5, { rate: 1000 });
+    e.update(10);
+    const x = e.store.posX[0];
+    const snapshot = e.particles;
+    expect(e.particles).not.toBe(snapshot);
+    snapshot[0].position.x = x + 1000;
+    expect(e.store.posX[0]).toBe(x);
+  });
+
+  it('should not accumulate gravity into emitter acceleration', () => {
+    let now = 0;
+    const scheduler = new FrameScheduler({ manual: true, now: () => now });
+    const ps = new ParticleSystem(scheduler);
+    const e = new Emitter(0, 0, { rate: 100, life: 10000 });
+    ps.addEmitter(e);
+    ps.setGravity(0, 100);
+    e.update(100);
+    ps.start();
+    for (let i = 0; i < 10; i++) {
+      now += 1000 / 60;
+      scheduler.tick(now);
+    }
+    ps.stop();
+    expect(e.particleAcceleration.y).toBe(0);
+    // Gravity still reached the particles: ~10 steps of 100 units/s^2
+    expect(e.store.velY[0]).toBeGreaterThan(10);
+    expect(e.store.velY[0]).toBeLessThan(20);
+  });
+
+  it('should render circles from the store', () => {
+    const calls: Array<{ x: number; y: number; r: number; fill?: string; alpha?: number }> = [];
+    const ctx = {
+      circle: (x: number, y: number, r: number) => {
+        const call: (typeof calls)[number] = { x, y, r };
+        calls.push(call);
+        const shape = {
+          fill: (c: string) => { call.fill = c; return shape; },
+          setAlpha: (a: number) => { call.alpha = a; return shape; },
+          withId: () => shape,
+        };
+        return shape;
+      },
+    };
+    const ps = new ParticleSystem();
+    const e = new Emitter(5, 6, { rate: 1000, color: '#00ff80', alpha: 0.5, life: 100, radius: 4 });
+    ps.addEmitter(e);
+    e.update(10);
+    e.update(50);
+
+    ps.render(ctx as any);
+    expect(calls.length).toBe(e.getParticleCount());
+    expect(calls[0].fill).toBe('#00ff80');
+    expect(calls[0].r).toBe(4);
+    expect(calls[0].alpha).toBeCloseTo(e.store.alphaAt(0), 6);
+    expect(e.store.alphaAt(0)).toBeCloseTo(e.particles[0].getAlpha(), 6);
+  });
+
+  it('should update and render 100k particles', () => {
+    const store = new ParticleStore();
+    for (let i = 0; i < 100000; i++) {
+      store.spawn((i * 7) % 640, (i * 13) % 480, (i % 21) - 10, (i % 17) - 8, 1e6, 1.5, packRGBA(255, 128, 0, 200));
+    }
+    const target = createRenderTarget(640, 480);
+    const start = performance.now();
+    for (let frame = 0; frame < 10; frame++) {
+      store.update(16, 0, 98, 0.99);
+      store.render(target);
+    }
+    const ms = (performance.now() - start) / 10;
+    console.log(`particle store: 100k particles ${ms.toFixed(2)}ms/frame`);
+    expect(store.count).toBe(100000);
+  });
+});